@@ -68,4 +68,18 @@ inline uint32_t playerPaletteColor(uint8_t paletteIndex)
 	return playerColorPalette()[paletteIndex];
 }
 
+inline bool findPlayerPaletteIndex(uint32_t color, uint8_t &outIndex)
+{
+	const std::array<uint32_t, PLAYER_COLOR_PALETTE_SIZE> &palette = playerColorPalette();
+	for (size_t index = 0; index < palette.size(); index++)
+	{
+		if (palette[index] == color)
+		{
+			outIndex = static_cast<uint8_t>(index);
+			return true;
+		}
+	}
+	return false;
+}
+
 #endif
@@ -0,0 +1,111 @@
+#ifndef CHUNK_POOL_H
+#define CHUNK_POOL_H
+
+#include <VoxelChunkData.h>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class ChunkPool;
+
+struct ChunkPoolDeleter
+{
+	void operator()(VoxelChunkData *chunk) const;
+};
+
+// Handle propriétaire d'un chunk du pool: le pipeline serveur (worker -> ready -> monde -> sauvegarde)
+// se transmet ces handles, un transfert de propriété n'est qu'un échange de pointeur.
+using ChunkHandle = std::unique_ptr<VoxelChunkData, ChunkPoolDeleter>;
+
+// Slab allocator de VoxelChunkData: les slots libérés sont recyclés au lieu de repasser par malloc.
+// Les sections restent allouées à part (partagées en copy-on-write), le slot ne garde que l'en-tête.
+class ChunkPool
+{
+public:
+	static constexpr size_t SLAB_CHUNK_COUNT = 256;
+
+	static ChunkPool &instance()
+	{
+		// Volontairement jamais détruit: des handles peuvent survivre aux statiques à la fermeture.
+		static ChunkPool *pool = new ChunkPool();
+		return *pool;
+	}
+
+	ChunkHandle acquire(int cx, int cz)
+	{
+		VoxelChunkData *chunk = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (freeChunks.empty())
+			{
+				allocateSlabNoLock();
+			}
+			chunk = freeChunks.back();
+			freeChunks.pop_back();
+		}
+		chunk->setChunkCoord(cx, cz);
+		chunk->revision = 0;
+		return ChunkHandle(chunk);
+	}
+
+	// Copie d'un chunk dans un nouveau handle: ne partage que les sections (copy-on-write).
+	ChunkHandle acquireCopy(const VoxelChunkData &source)
+	{
+		ChunkHandle handle = acquire(source.chunkX, source.chunkZ);
+		*handle = source;
+		return handle;
+	}
+
+	size_t capacity() const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return slabs.size() * SLAB_CHUNK_COUNT;
+	}
+
+	size_t freeCount() const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return freeChunks.size();
+	}
+
+private:
+	friend struct ChunkPoolDeleter;
+
+	mutable std::mutex mutex;
+	std::vector<std::unique_ptr<VoxelChunkData[]>> slabs;
+	std::vector<VoxelChunkData *> freeChunks;
+
+	ChunkPool() = default;
+
+	void allocateSlabNoLock()
+	{
+		slabs.push_back(std::make_unique<VoxelChunkData[]>(SLAB_CHUNK_COUNT));
+		VoxelChunkData *slab = slabs.back().get();
+		freeChunks.reserve(freeChunks.size() + SLAB_CHUNK_COUNT);
+		for (size_t index = SLAB_CHUNK_COUNT; index > 0; index--)
+		{
+			freeChunks.push_back(&slab[index - 1]);
+		}
+	}
+
+	void release(VoxelChunkData *chunk)
+	{
+		// Libère les sections hors verrou, seul le slot retourne dans la liste libre.
+		chunk->clearBlocks();
+		std::lock_guard<std::mutex> lock(mutex);
+		freeChunks.push_back(chunk);
+	}
+};
+
+inline void ChunkPoolDeleter::operator()(VoxelChunkData *chunk) const
+{
+	if (chunk == nullptr)
+	{
+		return;
+	}
+	ChunkPool::instance().release(chunk);
+}
+
+#endif
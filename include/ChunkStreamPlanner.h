@@ -0,0 +1,54 @@
+#ifndef CHUNK_STREAM_PLANNER_H
+#define CHUNK_STREAM_PLANNER_H
+
+#include <Frustum.h>
+#include <VoxelChunkData.h>
+#include <WorldBounds.h>
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+struct ChunkStreamPlanInput
+{
+	glm::vec3 position = glm::vec3(0.0f);
+	glm::vec3 velocity = glm::vec3(0.0f);
+	uint32_t roundTripTimeMs = 0;
+	float serverTerrainGenMsAvg = 0.0f;
+	float serverSqliteLoadMsAvg = 0.0f;
+	float deltaTime = 0.0f;
+	bool hasWorldFrontier = false;
+	WorldFrontier frontier;
+	int renderDistanceChunks = 0;
+	int classicStreamingPaddingChunks = 0;
+	size_t classicMaxInflightChunkRequests = 0;
+	size_t classicMaxChunkRequestsPerFrame = 0;
+};
+
+struct ChunkStreamPlan
+{
+	// Par priorité: d'abord le frustum, puis du plus proche au plus lointain.
+	std::vector<ChunkCoord> requests;
+	std::vector<int64_t> drops;
+};
+
+// Logique de streaming par distance de rendu, sans dépendance GL: le client la pilote
+// depuis la caméra, le bot-swarm depuis une trajectoire simulée.
+class ChunkStreamPlanner
+{
+public:
+	static bool usesClassicStreaming(bool hasWorldFrontier, const WorldFrontier &frontier);
+	static bool canStreamChunk(bool hasWorldFrontier, const WorldFrontier &frontier, int chunkX, int chunkZ);
+	// streamedChunkKeys = chunks demandés et pas encore lâchés; inflightRequests = ceux
+	// d'entre eux encore sans réponse.
+	static void plan(const ChunkStreamPlanInput &input,
+					 const Frustum &streamFrustum,
+					 const std::unordered_set<int64_t> &streamedChunkKeys,
+					 size_t inflightRequests,
+					 ChunkStreamPlan &plan);
+};
+
+#endif
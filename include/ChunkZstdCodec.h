@@ -0,0 +1,43 @@
+#ifndef CHUNK_ZSTD_CODEC_H
+#define CHUNK_ZSTD_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class ChunkZstdDictionary;
+
+// Compression Zstd des chunks avec un ZSTD_CCtx / ZSTD_DCtx par thread:
+// ni contexte ni table de hachage réalloués à chaque chunk.
+// Le dictionnaire actif est utilisé s'il existe (voir ChunkZstdDictionary.h).
+
+// Mêmes conventions de retour que ZSTD_compress / ZSTD_decompress (tester avec ZSTD_isError).
+size_t compressChunkZstd(void *destination,
+						 size_t destinationCapacity,
+						 const void *source,
+						 size_t sourceSize,
+						 int compressionLevel);
+size_t compressChunkZstd(void *destination,
+						 size_t destinationCapacity,
+						 const void *source,
+						 size_t sourceSize,
+						 int compressionLevel,
+						 const ChunkZstdDictionary *dictionary);
+size_t decompressChunkZstd(void *destination,
+						   size_t destinationCapacity,
+						   const void *source,
+						   size_t sourceSize);
+
+// Écrit dans le vecteur de l'appelant sans jamais réduire sa capacité:
+// un tampon gardé d'un appel à l'autre ne réalloue plus.
+bool compressChunkZstdInto(const void *source,
+						   size_t sourceSize,
+						   int compressionLevel,
+						   std::vector<uint8_t> &output);
+// expectedSize == 0: taille lue dans l'en-tête de trame (lignes SQLite).
+bool decompressChunkZstdInto(const void *source,
+							 size_t sourceSize,
+							 size_t expectedSize,
+							 std::vector<uint8_t> &output);
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef CHUNK_ZSTD_DICTIONARY_H
+#define CHUNK_ZSTD_DICTIONARY_H
+
+#include <zstd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Dictionnaire Zstd entraîné sur des snapshots de chunks.
+// L'id est écrit dans chaque trame: le décodeur retrouve le bon dictionnaire,
+// et une trame d'id 0 (lignes chunk_snapshot_sections_zstd_v1) se lit sans.
+class ChunkZstdDictionary
+{
+public:
+	~ChunkZstdDictionary();
+
+	ChunkZstdDictionary(const ChunkZstdDictionary &) = delete;
+	ChunkZstdDictionary &operator=(const ChunkZstdDictionary &) = delete;
+
+	static std::shared_ptr<const ChunkZstdDictionary> create(std::vector<uint8_t> content,
+															 std::string *errorMessage = nullptr);
+
+	uint32_t id() const;
+	const std::vector<uint8_t> &content() const;
+	// Un CDict par niveau, construit à la première demande.
+	const ZSTD_CDict *compressionDictionary(int compressionLevel) const;
+	const ZSTD_DDict *decompressionDictionary() const;
+
+private:
+	ChunkZstdDictionary() = default;
+
+	uint32_t m_id = 0;
+	std::vector<uint8_t> m_content;
+	ZSTD_DDict *m_decompressionDictionary = nullptr;
+	mutable std::mutex m_compressionMutex;
+	mutable std::map<int, ZSTD_CDict *> m_compressionDictionaries;
+};
+
+bool trainChunkZstdDictionary(const std::vector<std::vector<uint8_t>> &samples,
+							  size_t dictionaryCapacity,
+							  std::vector<uint8_t> &outContent,
+							  std::string &errorMessage);
+
+// Registre du processus: tous les dictionnaires connus restent décodables,
+// seul l'actif sert à compresser.
+void registerChunkZstdDictionary(std::shared_ptr<const ChunkZstdDictionary> dictionary, bool makeActive);
+std::shared_ptr<const ChunkZstdDictionary> activeChunkZstdDictionary();
+std::shared_ptr<const ChunkZstdDictionary> findChunkZstdDictionary(uint32_t id);
+
+#endif
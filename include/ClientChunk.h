@@ -8,6 +8,9 @@
 #include <glad/glad.h>
 
 #include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 class ClientChunk
@@ -41,6 +44,8 @@ public:
 	};
 
 	VoxelChunkData storage;
+	// storage.revision bouge à chaque setBlock local (remesh); celle-ci suit la révision du serveur.
+	uint64_t serverRevision = 0;
 	ChunkRenderState renderState;
 	ChunkGpuResources gpuResources;
 
@@ -61,6 +66,7 @@ public:
 	void copyFromData(const VoxelChunkData &data)
 	{
 		storage = data;
+		serverRevision = data.revision;
 		renderState.isEmpty = storage.isCompletelyEmpty();
 		renderState.needsMeshRebuild = true;
 	}
@@ -89,13 +95,18 @@ public:
 		std::vector<uint32_t> packedFaces;
 		packedFaces.reserve(8192);
 
+		// Le stockage est compressé par palette: on décode une fois en dense pour le meshing.
+		std::vector<uint32_t> denseBlocks(CHUNK_BLOCK_COUNT);
+		chunk.copyBlocksTo(denseBlocks.data());
+		const uint32_t *blocks = denseBlocks.data();
+
 		auto packFace = [&](int x, int y, int z, int faceDir, uint32_t blockColor)
 		{
-			int ao0 = computeVertexAO(chunk, neighbors, x, y, z, faceDir, 0);
-			int ao1 = computeVertexAO(chunk, neighbors, x, y, z, faceDir, 1);
-			int ao2 = computeVertexAO(chunk, neighbors, x, y, z, faceDir, 2);
-			int ao3 = computeVertexAO(chunk, neighbors, x, y, z, faceDir, 3);
-			int sunQ = computeSunblockQ127(chunk, neighbors, x, y, z);
+			int ao0 = computeVertexAO(blocks, neighbors, x, y, z, faceDir, 0);
+			int ao1 = computeVertexAO(blocks, neighbors, x, y, z, faceDir, 1);
+			int ao2 = computeVertexAO(blocks, neighbors, x, y, z, faceDir, 2);
+			int ao3 = computeVertexAO(blocks, neighbors, x, y, z, faceDir, 3);
+			int sunQ = computeSunblockQ127(blocks, neighbors, x, y, z);
 
 			uint32_t word0 = static_cast<uint32_t>(x)
 				| (static_cast<uint32_t>(y) << 4)
@@ -115,7 +126,7 @@ public:
 		{
 			for (int sectionIndex = 0; sectionIndex < CHUNK_SECTION_COUNT; sectionIndex++)
 			{
-				if (chunk.isSectionEmpty(sectionIndex))
+				if (chunk.sectionIfPresent(sectionIndex) == nullptr)
 				{
 					continue;
 				}
@@ -126,33 +137,33 @@ public:
 				{
 					for (int z = 0; z < CHUNK_SIZE_Z; z++)
 					{
-						uint32_t block = chunk.blocks[x][y][z];
+						uint32_t block = blocks[VoxelChunkData::denseBlockIndex(x, y, z)];
 						if (block == 0)
 						{
 							continue;
 						}
 
-						if (chunk.getBlock(x, y + 1, z) == 0)
+						if (getBlockOrNeighbor(blocks, neighbors, x, y + 1, z) == 0)
 						{
 							packFace(x, y, z, 0, block);
 						}
-						if (y > 0 && chunk.getBlock(x, y - 1, z) == 0)
+						if (y > 0 && getBlockOrNeighbor(blocks, neighbors, x, y - 1, z) == 0)
 						{
 							packFace(x, y, z, 1, block);
 						}
-						if (getBlockOrNeighbor(chunk, neighbors, x, y, z + 1) == 0)
+						if (getBlockOrNeighbor(blocks, neighbors, x, y, z + 1) == 0)
 						{
 							packFace(x, y, z, 2, block);
 						}
-						if (getBlockOrNeighbor(chunk, neighbors, x, y, z - 1) == 0)
+						if (getBlockOrNeighbor(blocks, neighbors, x, y, z - 1) == 0)
 						{
 							packFace(x, y, z, 3, block);
 						}
-						if (getBlockOrNeighbor(chunk, neighbors, x + 1, y, z) == 0)
+						if (getBlockOrNeighbor(blocks, neighbors, x + 1, y, z) == 0)
 						{
 							packFace(x, y, z, 4, block);
 						}
-						if (getBlockOrNeighbor(chunk, neighbors, x - 1, y, z) == 0)
+						if (getBlockOrNeighbor(blocks, neighbors, x - 1, y, z) == 0)
 						{
 							packFace(x, y, z, 5, block);
 						}
@@ -293,7 +304,7 @@ public:
 			{
 				for (int z = 0; z < CHUNK_SIZE_Z; z++)
 				{
-					if (storage.blocks[x][y][z] != 0)
+					if (storage.getBlock(x, y, z) != 0)
 					{
 						stats.solidBlocks++;
 					}
@@ -306,7 +317,7 @@ public:
 		{
 			stats.fillPercent = static_cast<float>(stats.solidBlocks) / static_cast<float>(stats.totalBlocks) * 100.0f;
 		}
-		stats.ramBytes = sizeof(storage) + sizeof(renderState) + gpuResources.packedFacesCpu.size() * sizeof(uint32_t);
+		stats.ramBytes = sizeof(storage) + storage.storedBlockBytes() + sizeof(renderState) + gpuResources.packedFacesCpu.size() * sizeof(uint32_t);
 		stats.vramBytes = static_cast<size_t>(renderState.faceCount) * sizeof(uint32_t) * 2;
 		return stats;
 	}
@@ -324,7 +335,7 @@ private:
 		{
 			for (int y = 0; y < CHUNK_SIZE_Y; y++)
 			{
-				neighborhood.north[x][y] = north->blocks[x][y][0];
+				neighborhood.north[x][y] = north->getBlock(x, y, 0);
 			}
 		}
 	}
@@ -344,7 +355,7 @@ private:
 				for (int depth = 0; depth < SUNBLOCK_TRACE_DEPTH; depth++)
 				{
 					int sourceZ = CHUNK_SIZE_Z - 1 - depth;
-					neighborhood.south[x][y][depth] = south->blocks[x][y][sourceZ];
+					neighborhood.south[x][y][depth] = south->getBlock(x, y, sourceZ);
 				}
 			}
 		}
@@ -362,7 +373,7 @@ private:
 		{
 			for (int z = 0; z < CHUNK_SIZE_Z; z++)
 			{
-				neighborhood.east[y][z] = east->blocks[0][y][z];
+				neighborhood.east[y][z] = east->getBlock(0, y, z);
 			}
 		}
 	}
@@ -379,7 +390,7 @@ private:
 		{
 			for (int z = 0; z < CHUNK_SIZE_Z; z++)
 			{
-				neighborhood.west[y][z] = west->blocks[CHUNK_SIZE_X - 1][y][z];
+				neighborhood.west[y][z] = west->getBlock(CHUNK_SIZE_X - 1, y, z);
 			}
 		}
 	}
@@ -394,7 +405,7 @@ private:
 
 		for (int y = 0; y < CHUNK_SIZE_Y; y++)
 		{
-			neighborhood.ne[y] = ne->blocks[0][y][0];
+			neighborhood.ne[y] = ne->getBlock(0, y, 0);
 		}
 	}
 
@@ -408,7 +419,7 @@ private:
 
 		for (int y = 0; y < CHUNK_SIZE_Y; y++)
 		{
-			neighborhood.nw[y] = nw->blocks[CHUNK_SIZE_X - 1][y][0];
+			neighborhood.nw[y] = nw->getBlock(CHUNK_SIZE_X - 1, y, 0);
 		}
 	}
 
@@ -422,7 +433,7 @@ private:
 
 		for (int y = 0; y < CHUNK_SIZE_Y; y++)
 		{
-			neighborhood.se[y] = se->blocks[0][y][CHUNK_SIZE_Z - 1];
+			neighborhood.se[y] = se->getBlock(0, y, CHUNK_SIZE_Z - 1);
 		}
 	}
 
@@ -436,11 +447,11 @@ private:
 
 		for (int y = 0; y < CHUNK_SIZE_Y; y++)
 		{
-			neighborhood.sw[y] = sw->blocks[CHUNK_SIZE_X - 1][y][CHUNK_SIZE_Z - 1];
+			neighborhood.sw[y] = sw->getBlock(CHUNK_SIZE_X - 1, y, CHUNK_SIZE_Z - 1);
 		}
 	}
 
-	static int computeVertexAO(const VoxelChunkData &chunk,
+	static int computeVertexAO(const uint32_t *blocks,
 							   const MeshNeighborhood &neighbors,
 							   int bx,
 							   int by,
@@ -450,19 +461,19 @@ private:
 	{
 		const int (*offsets)[3] = AO_OFFSETS[faceDir][vertIdx];
 		bool side1 = getBlockOrNeighbor(
-						 chunk,
+						 blocks,
 						 neighbors,
 						 bx + offsets[0][0],
 						 by + offsets[0][1],
 						 bz + offsets[0][2]) != 0;
 		bool side2 = getBlockOrNeighbor(
-						 chunk,
+						 blocks,
 						 neighbors,
 						 bx + offsets[1][0],
 						 by + offsets[1][1],
 						 bz + offsets[1][2]) != 0;
 		bool corner = getBlockOrNeighbor(
-						  chunk,
+						  blocks,
 						  neighbors,
 						  bx + offsets[2][0],
 						  by + offsets[2][1],
@@ -474,7 +485,7 @@ private:
 		return 3 - (side1 + side2 + corner);
 	}
 
-	static int computeSunblockQ127(const VoxelChunkData &chunk,
+	static int computeSunblockQ127(const uint32_t *blocks,
 								   const MeshNeighborhood &neighbors,
 								   int bx,
 								   int by,
@@ -493,7 +504,7 @@ private:
 			{
 				break;
 			}
-			if (getBlockOrNeighbor(chunk, neighbors, bx, cy, cz) != 0)
+			if (getBlockOrNeighbor(blocks, neighbors, bx, cy, cz) != 0)
 			{
 				value -= dec;
 			}
@@ -511,7 +522,7 @@ private:
 		return value;
 	}
 
-	static uint32_t getBlockOrNeighbor(const VoxelChunkData &chunk,
+	static uint32_t getBlockOrNeighbor(const uint32_t *blocks,
 									   const MeshNeighborhood &neighbors,
 									   int x,
 									   int y,
@@ -589,7 +600,7 @@ private:
 			return 0;
 		}
 
-		return chunk.blocks[x][y][z];
+		return blocks[VoxelChunkData::denseBlockIndex(x, y, z)];
 	}
 
 	void ensureMeshBuffer(size_t requiredWords)
@@ -654,4 +665,36 @@ private:
 	}
 };
 
+// Blocs des chunks quittés, gardés pour redemander un delta de sections au retour.
+struct ClientRetainedChunkCache
+{
+	struct Entry
+	{
+		VoxelChunkData storage;
+		uint64_t sequence = 0;
+	};
+
+	std::unordered_map<int64_t, Entry> entries;
+	// Ordre d'insertion; une paire dont la séquence ne correspond plus est ignorée.
+	std::deque<std::pair<int64_t, uint64_t>> order;
+	uint64_t nextSequence = 1;
+
+	bool knownRevision(int64_t key, uint64_t &outRevision) const
+	{
+		auto it = entries.find(key);
+		if (it == entries.end())
+		{
+			return false;
+		}
+		outRevision = it->second.storage.revision;
+		return true;
+	}
+
+	void clear()
+	{
+		entries.clear();
+		order.clear();
+	}
+};
+
 #endif
@@ -0,0 +1,89 @@
+#ifndef PACKET_TRACE_H
+#define PACKET_TRACE_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Trace binaire des messages reçus par le serveur, rejouée par VoxPlaceReplay.
+// En-tête "VPTRACE" + version + heure murale de début, puis des enregistrements
+// kind:u8 | channel:u8 | session:u32 | delta_us:u32 [| size:u32 | payload], en octets natifs comme WorldProtocol.
+enum class PacketTraceRecordKind : uint8_t
+{
+	Connect = 1,
+	Disconnect = 2,
+	Packet = 3
+};
+
+struct PacketTraceRecord
+{
+	PacketTraceRecordKind kind = PacketTraceRecordKind::Packet;
+	uint8_t channel = 0;
+	// Identifiant de connexion propre à la trace (les slots ENet sont réutilisés).
+	uint32_t sessionId = 0;
+	// Depuis l'ouverture de la trace.
+	uint64_t timeUs = 0;
+	std::vector<uint8_t> payload;
+};
+
+// Une trace ne contient aucun mot de passe: login et suppression de compte sont écrits
+// avec un mot de passe vide, que le rejeu remplace par le sien.
+class PacketTraceWriter
+{
+public:
+	PacketTraceWriter() = default;
+	~PacketTraceWriter();
+
+	PacketTraceWriter(const PacketTraceWriter &) = delete;
+	PacketTraceWriter &operator=(const PacketTraceWriter &) = delete;
+
+	bool open(const std::string &path);
+	void close();
+	bool isOpen() const;
+
+	// Rend l'identifiant de la nouvelle session, 0 en cas d'échec d'écriture.
+	uint32_t recordConnect();
+	bool recordDisconnect(uint32_t sessionId);
+	bool recordPacket(uint32_t sessionId, uint8_t channel, const uint8_t *data, size_t size);
+
+	uint64_t recordCount() const;
+	const std::string &lastError() const;
+
+private:
+	std::ofstream m_file;
+	std::chrono::steady_clock::time_point m_openedAt;
+	std::chrono::steady_clock::time_point m_lastFlushAt;
+	uint64_t m_lastTimeUs = 0;
+	uint32_t m_nextSessionId = 1;
+	uint64_t m_recordCount = 0;
+	std::vector<uint8_t> m_redacted;
+	std::string m_lastError;
+
+	bool writeRecord(PacketTraceRecordKind kind, uint32_t sessionId, uint8_t channel, const uint8_t *data, size_t size);
+};
+
+class PacketTraceReader
+{
+public:
+	bool open(const std::string &path);
+	// false en fin de fichier; lastError() n'est rempli que si la trace est tronquée ou invalide.
+	bool next(PacketTraceRecord &record);
+
+	uint64_t startedAtMs() const;
+	const std::string &lastError() const;
+
+private:
+	std::ifstream m_file;
+	uint64_t m_startedAtMs = 0;
+	uint64_t m_timeUs = 0;
+	std::string m_lastError;
+};
+
+// Réécrit le mot de passe d'un LoginRequest ou AccountDeleteRequest. false (et payload
+// inchangé) pour tout autre paquet.
+bool replacePacketTracePassword(std::vector<uint8_t> &payload, const std::string &password);
+
+#endif
@@ -6,6 +6,7 @@
 #include <sqlite3.h>
 
 #include <string>
+#include <vector>
 
 class PlayerTable
 {
@@ -29,15 +30,28 @@ public:
 	bool updateAdminFlag(uint64_t playerId, bool admin);
 	bool deletePlayer(uint64_t playerId);
 	bool savePlayer(const Player &player);
+	// Écrit tout le lot dans une transaction; rien n'est écrit en cas d'échec.
+	bool savePlayers(const std::vector<Player> &players);
 
 	const std::string &lastError() const;
 
 private:
 	sqlite3 *m_db = nullptr;
 	std::string m_lastError;
+	// Préparés une fois à l'ouverture, remis à zéro après chaque usage.
+	sqlite3_stmt *m_loadStatement = nullptr;
+	sqlite3_stmt *m_createStatement = nullptr;
+	sqlite3_stmt *m_updatePasswordStatement = nullptr;
+	sqlite3_stmt *m_updateAdminStatement = nullptr;
+	sqlite3_stmt *m_deleteStatement = nullptr;
+	sqlite3_stmt *m_saveStatement = nullptr;
 
 	bool executeStatement(const char *sql);
 	bool prepareStatement(const char *sql, sqlite3_stmt **statement);
+	bool prepareStatements();
+	void finalizeStatements();
+	void resetStatement(sqlite3_stmt *statement);
+	bool writePlayerRow(const Player &player, uint64_t nowMs);
 	void setLastErrorFromDatabase(const std::string &prefix);
 };
 
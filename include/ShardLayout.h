@@ -0,0 +1,50 @@
+#ifndef SHARD_LAYOUT_H
+#define SHARD_LAYOUT_H
+
+#include <VoxelChunkData.h>
+
+#include <cstddef>
+#include <cstdint>
+
+// Régions carrées de chunks réparties par hachage entre les processus serveur d'un
+// monde shardé. Le shard 0 est le primaire: chat, commandes et frontière font foi chez lui.
+constexpr int SHARD_REGION_SIZE_CHUNKS = 16;
+constexpr uint16_t MAX_SHARD_COUNT = 64;
+// Secret partagé par la passerelle et ses shards: seul son détenteur peut leur imposer une frontière.
+constexpr const char *SHARD_TOKEN_ENV = "VOXPLACE_SHARD_TOKEN";
+constexpr size_t SHARD_TOKEN_MIN_LENGTH = 16;
+
+struct ShardLayout
+{
+	uint16_t index = 0;
+	uint16_t count = 1;
+
+	bool isSharded() const
+	{
+		return count > 1;
+	}
+
+	bool isPrimary() const
+	{
+		return index == 0;
+	}
+
+	uint16_t ownerOf(int chunkX, int chunkZ) const
+	{
+		if (count <= 1)
+		{
+			return 0;
+		}
+		uint32_t regionX = static_cast<uint32_t>(floorDiv(chunkX, SHARD_REGION_SIZE_CHUNKS));
+		uint32_t regionZ = static_cast<uint32_t>(floorDiv(chunkZ, SHARD_REGION_SIZE_CHUNKS));
+		uint32_t hash = (regionX * 73856093u) ^ (regionZ * 19349663u);
+		return static_cast<uint16_t>(hash % count);
+	}
+
+	bool owns(int chunkX, int chunkZ) const
+	{
+		return ownerOf(chunkX, chunkZ) == index;
+	}
+};
+
+#endif
@@ -8,6 +8,7 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
+#include <vector>
 
 class TerrainGenerator
 {
@@ -484,7 +485,8 @@ public:
 
 	void fillChunk(VoxelChunkData &chunk) const
 	{
-		chunk.clearBlocks();
+		// On génère dans un tableau dense puis on compresse section par section.
+		std::vector<uint32_t> blocks(CHUNK_BLOCK_COUNT, VOXEL_AIR);
 		for (int x = 0; x < CHUNK_SIZE_X; x++)
 		{
 			for (int z = 0; z < CHUNK_SIZE_Z; z++)
@@ -503,13 +505,13 @@ public:
 				int slope = std::abs(eastH - westH) + std::abs(northH - southH);
 
 				ColorProfile profile = buildColorProfile(worldX, worldZ, height, slope, biome01);
-				chunk.blocks[x][0][z] = stoneColor(worldX, 0, worldZ);
+				blocks[VoxelChunkData::denseBlockIndex(x, 0, z)] = stoneColor(worldX, 0, worldZ);
 
 				for (int y = 1; y <= height && y < CHUNK_SIZE_Y; y++)
 				{
 					if (profile.rockySurface)
 					{
-						chunk.blocks[x][y][z] = stoneColor(worldX, y, worldZ);
+						blocks[VoxelChunkData::denseBlockIndex(x, y, z)] = stoneColor(worldX, y, worldZ);
 					}
 					else
 					{
@@ -517,7 +519,7 @@ public:
 						uint32_t dirtLayerColor = dirtColor(worldX, y, worldZ);
 						if (depthFromSurface <= 3)
 						{
-							chunk.blocks[x][y][z] = blendSurfaceToDirt(
+							blocks[VoxelChunkData::denseBlockIndex(x, y, z)] = blendSurfaceToDirt(
 								profile.surfaceColor,
 								dirtLayerColor,
 								depthFromSurface,
@@ -525,11 +527,11 @@ public:
 						}
 						else if (y > height - profile.dirtDepth)
 						{
-							chunk.blocks[x][y][z] = dirtLayerColor;
+							blocks[VoxelChunkData::denseBlockIndex(x, y, z)] = dirtLayerColor;
 						}
 						else
 						{
-							chunk.blocks[x][y][z] = stoneColor(worldX, y, worldZ);
+							blocks[VoxelChunkData::denseBlockIndex(x, y, z)] = stoneColor(worldX, y, worldZ);
 						}
 					}
 				}
@@ -538,7 +540,7 @@ public:
 				{
 					for (int y = height + 1; y <= seaLevel && y < CHUNK_SIZE_Y; y++)
 					{
-						chunk.blocks[x][y][z] = waterColor(worldX, y, worldZ);
+						blocks[VoxelChunkData::denseBlockIndex(x, y, z)] = waterColor(worldX, y, worldZ);
 					}
 				}
 			}
@@ -552,7 +554,7 @@ public:
 		{
 			chunk.revision++;
 		}
-		chunk.rebuildSectionMask();
+		chunk.loadBlocks(blocks.data());
 	}
 
 private:
@@ -2,9 +2,14 @@
 #define VOXEL_CHUNK_DATA_H
 
 #include <algorithm>
+#include <atomic>
 #include <bit>
 #include <cstdint>
 #include <cstring>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <vector>
 
 constexpr uint8_t CHUNK_SIZE_X = 16;
 constexpr uint8_t CHUNK_SIZE_Y = 64;
@@ -17,6 +22,14 @@ constexpr uint32_t VOXEL_SOLID_COLOR_FLAG = 0x01000000u;
 
 static_assert(CHUNK_SIZE_Y % CHUNK_SECTION_HEIGHT == 0,
 			  "CHUNK_SIZE_Y must stay divisible by CHUNK_SECTION_HEIGHT");
+static_assert(CHUNK_SECTION_COUNT <= 32,
+			  "ChunkSectionMask holds at most 32 sections");
+
+// Le masque suit CHUNK_SECTION_COUNT: on peut monter la hauteur du monde sans changer le code.
+using ChunkSectionMask = std::conditional_t<
+	(CHUNK_SECTION_COUNT <= 8),
+	uint8_t,
+	std::conditional_t<(CHUNK_SECTION_COUNT <= 16), uint16_t, uint32_t>>;
 
 constexpr size_t CHUNK_BLOCK_COUNT =
 	static_cast<size_t>(CHUNK_SIZE_X) *
@@ -49,6 +62,14 @@ inline int64_t chunkKey(const ChunkCoord &coord)
 	return chunkKey(coord.x, coord.z);
 }
 
+inline ChunkCoord chunkCoordFromKey(int64_t key)
+{
+	ChunkCoord coord;
+	coord.x = static_cast<int>(key >> 32);
+	coord.z = static_cast<int>(key & 0xFFFFFFFF);
+	return coord;
+}
+
 inline int floorDiv(int value, int divisor)
 {
 	int quotient = value / divisor;
@@ -70,22 +91,448 @@ inline int floorMod(int value, int divisor)
 	return remainder;
 }
 
+// Stockage compressé d'une section 16x16x16: palette de couleurs + indices bit-packés.
+// bitsPerEntry == 0 : section uniforme (uniformValue pour tous les voxels, aucune allocation).
+// bitsPerEntry == 32 : palette trop large, les couleurs sont stockées directement.
+struct ChunkSectionStorage
+{
+	static constexpr uint8_t UNIFORM_BITS = 0;
+	static constexpr uint8_t MAX_PALETTE_BITS = 11;
+	static constexpr uint8_t DIRECT_BITS = 32;
+
+	ChunkSectionStorage()
+	{
+		fill(VOXEL_AIR);
+	}
+
+	// Sentinelle partagée pour les sections absentes (tout air).
+	static const ChunkSectionStorage &airSection()
+	{
+		static const ChunkSectionStorage sentinel;
+		return sentinel;
+	}
+
+	static size_t localIndex(int x, int localY, int z)
+	{
+		return (static_cast<size_t>(x) * CHUNK_SECTION_HEIGHT + static_cast<size_t>(localY)) *
+			CHUNK_SIZE_Z + static_cast<size_t>(z);
+	}
+
+	void fill(uint32_t value)
+	{
+		uniformValue = value;
+		std::vector<uint32_t>().swap(palette);
+		std::vector<uint16_t>().swap(paletteRefCounts);
+		std::vector<uint64_t>().swap(words);
+		bits = UNIFORM_BITS;
+		livePaletteEntries = 1;
+		directAirCount = 0;
+		directWritesSinceLoad = 0;
+	}
+
+	bool isUniform() const
+	{
+		return bits == UNIFORM_BITS;
+	}
+
+	bool isEmpty() const
+	{
+		return bits == UNIFORM_BITS && uniformValue == VOXEL_AIR;
+	}
+
+	uint8_t bitsPerEntry() const
+	{
+		return bits;
+	}
+
+	size_t paletteSize() const
+	{
+		if (bits == DIRECT_BITS)
+		{
+			return 0;
+		}
+		return livePaletteEntries;
+	}
+
+	size_t storedBytes() const
+	{
+		return sizeof(ChunkSectionStorage) +
+			palette.capacity() * sizeof(uint32_t) +
+			paletteRefCounts.capacity() * sizeof(uint16_t) +
+			words.capacity() * sizeof(uint64_t);
+	}
+
+	uint32_t get(size_t index) const
+	{
+		if (bits == UNIFORM_BITS)
+		{
+			return uniformValue;
+		}
+		uint32_t entry = readEntry(index);
+		if (bits == DIRECT_BITS)
+		{
+			return entry;
+		}
+		return palette[entry];
+	}
+
+	bool set(size_t index, uint32_t value)
+	{
+		if (bits == UNIFORM_BITS)
+		{
+			if (uniformValue == value)
+			{
+				return false;
+			}
+			palette.assign(1, uniformValue);
+			paletteRefCounts.assign(1, static_cast<uint16_t>(CHUNK_SECTION_BLOCK_COUNT));
+			resizeEntries(1);
+		}
+
+		if (bits == DIRECT_BITS)
+		{
+			uint32_t previous = readEntry(index);
+			if (previous == value)
+			{
+				return false;
+			}
+			writeDirect(index, previous, value);
+			return true;
+		}
+
+		uint32_t previousEntry = readEntry(index);
+		if (palette[previousEntry] == value)
+		{
+			return false;
+		}
+
+		uint32_t entry = 0;
+		if (!findOrAddPaletteEntry(value, entry))
+		{
+			// Palette saturée: on repasse en couleurs directes.
+			uint32_t previous = palette[readEntry(index)];
+			switchToDirect();
+			writeDirect(index, previous, value);
+			return true;
+		}
+
+		writeEntry(index, entry);
+		paletteRefCounts[entry]++;
+		paletteRefCounts[previousEntry]--;
+		if (paletteRefCounts[previousEntry] == 0)
+		{
+			livePaletteEntries--;
+			shrinkIfNeeded();
+		}
+		return true;
+	}
+
+	void load(const uint32_t *values)
+	{
+		// Table de hachage locale (adressage ouvert) pour construire la palette en O(n).
+		constexpr size_t HASH_SLOT_COUNT = CHUNK_SECTION_BLOCK_COUNT * 2;
+		constexpr uint16_t EMPTY_SLOT = 0xFFFF;
+		uint32_t slotKeys[HASH_SLOT_COUNT];
+		uint16_t slotEntries[HASH_SLOT_COUNT];
+		uint16_t entries[CHUNK_SECTION_BLOCK_COUNT];
+		std::fill(std::begin(slotEntries), std::end(slotEntries), EMPTY_SLOT);
+
+		palette.clear();
+		paletteRefCounts.clear();
+		for (size_t index = 0; index < CHUNK_SECTION_BLOCK_COUNT; index++)
+		{
+			uint32_t value = values[index];
+			size_t slot = static_cast<size_t>((value * 0x9E3779B1u) >> 19) & (HASH_SLOT_COUNT - 1);
+			while (slotEntries[slot] != EMPTY_SLOT && slotKeys[slot] != value)
+			{
+				slot = (slot + 1) & (HASH_SLOT_COUNT - 1);
+			}
+			if (slotEntries[slot] == EMPTY_SLOT)
+			{
+				slotKeys[slot] = value;
+				slotEntries[slot] = static_cast<uint16_t>(palette.size());
+				palette.push_back(value);
+				paletteRefCounts.push_back(0);
+			}
+			uint16_t entry = slotEntries[slot];
+			paletteRefCounts[entry]++;
+			entries[index] = entry;
+		}
+
+		livePaletteEntries = palette.size();
+		if (palette.size() == 1)
+		{
+			fill(palette[0]);
+			return;
+		}
+
+		uint8_t requiredBits = bitsForPaletteSize(palette.size());
+		if (requiredBits > MAX_PALETTE_BITS)
+		{
+			loadDirect(values);
+			return;
+		}
+
+		palette.shrink_to_fit();
+		paletteRefCounts.shrink_to_fit();
+		directAirCount = 0;
+		directWritesSinceLoad = 0;
+		bits = requiredBits;
+		words.assign(wordCountForBits(bits), 0);
+		for (size_t index = 0; index < CHUNK_SECTION_BLOCK_COUNT; index++)
+		{
+			writeEntry(index, entries[index]);
+		}
+	}
+
+	void copyTo(uint32_t *values) const
+	{
+		if (bits == UNIFORM_BITS)
+		{
+			std::fill(values, values + CHUNK_SECTION_BLOCK_COUNT, uniformValue);
+			return;
+		}
+		if (bits == DIRECT_BITS)
+		{
+			for (size_t index = 0; index < CHUNK_SECTION_BLOCK_COUNT; index++)
+			{
+				values[index] = readEntry(index);
+			}
+			return;
+		}
+		for (size_t index = 0; index < CHUNK_SECTION_BLOCK_COUNT; index++)
+		{
+			values[index] = palette[readEntry(index)];
+		}
+	}
+
+	bool sameBlocks(const ChunkSectionStorage &other) const
+	{
+		if (bits == UNIFORM_BITS && other.bits == UNIFORM_BITS)
+		{
+			return uniformValue == other.uniformValue;
+		}
+		for (size_t index = 0; index < CHUNK_SECTION_BLOCK_COUNT; index++)
+		{
+			if (get(index) != other.get(index))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+private:
+	std::vector<uint32_t> palette;
+	std::vector<uint16_t> paletteRefCounts;
+	uint32_t uniformValue = VOXEL_AIR;
+	std::vector<uint64_t> words;
+	size_t livePaletteEntries = 1;
+	uint16_t directAirCount = 0;
+	uint16_t directWritesSinceLoad = 0;
+	uint8_t bits = UNIFORM_BITS;
+
+	static uint8_t bitsForPaletteSize(size_t paletteSize)
+	{
+		if (paletteSize <= 1)
+		{
+			return UNIFORM_BITS;
+		}
+		return static_cast<uint8_t>(std::bit_width(paletteSize - 1));
+	}
+
+	static size_t wordCountForBits(uint8_t entryBits)
+	{
+		// +1 mot de garde: une entrée peut chevaucher deux mots sans test de borne.
+		return (CHUNK_SECTION_BLOCK_COUNT * entryBits + 63) / 64 + 1;
+	}
+
+	static uint32_t readPacked(const std::vector<uint64_t> &packedWords, uint8_t entryBits, size_t index)
+	{
+		size_t bitOffset = index * entryBits;
+		size_t wordIndex = bitOffset >> 6;
+		unsigned int shift = static_cast<unsigned int>(bitOffset & 63);
+		uint64_t value = packedWords[wordIndex] >> shift;
+		if (shift + entryBits > 64)
+		{
+			value |= packedWords[wordIndex + 1] << (64 - shift);
+		}
+		uint64_t mask = (uint64_t{1} << entryBits) - 1;
+		return static_cast<uint32_t>(value & mask);
+	}
+
+	static void writePacked(std::vector<uint64_t> &packedWords, uint8_t entryBits, size_t index, uint32_t entry)
+	{
+		size_t bitOffset = index * entryBits;
+		size_t wordIndex = bitOffset >> 6;
+		unsigned int shift = static_cast<unsigned int>(bitOffset & 63);
+		uint64_t mask = (uint64_t{1} << entryBits) - 1;
+		packedWords[wordIndex] = (packedWords[wordIndex] & ~(mask << shift)) |
+			(static_cast<uint64_t>(entry) << shift);
+		if (shift + entryBits > 64)
+		{
+			unsigned int spill = 64 - shift;
+			packedWords[wordIndex + 1] = (packedWords[wordIndex + 1] & ~(mask >> spill)) |
+				(static_cast<uint64_t>(entry) >> spill);
+		}
+	}
+
+	uint32_t readEntry(size_t index) const
+	{
+		return readPacked(words, bits, index);
+	}
+
+	void writeEntry(size_t index, uint32_t entry)
+	{
+		writePacked(words, bits, index, entry);
+	}
+
+	bool findOrAddPaletteEntry(uint32_t value, uint32_t &entry)
+	{
+		size_t freeEntry = palette.size();
+		for (size_t index = 0; index < palette.size(); index++)
+		{
+			if (paletteRefCounts[index] == 0)
+			{
+				if (freeEntry == palette.size())
+				{
+					freeEntry = index;
+				}
+				continue;
+			}
+			if (palette[index] == value)
+			{
+				entry = static_cast<uint32_t>(index);
+				return true;
+			}
+		}
+
+		if (freeEntry == palette.size())
+		{
+			uint8_t requiredBits = bitsForPaletteSize(palette.size() + 1);
+			if (requiredBits > MAX_PALETTE_BITS)
+			{
+				return false;
+			}
+			if (requiredBits > bits)
+			{
+				resizeEntries(requiredBits);
+			}
+			palette.push_back(value);
+			paletteRefCounts.push_back(0);
+		}
+		else
+		{
+			palette[freeEntry] = value;
+		}
+		livePaletteEntries++;
+		entry = static_cast<uint32_t>(freeEntry);
+		return true;
+	}
+
+	void resizeEntries(uint8_t newBits)
+	{
+		std::vector<uint64_t> resized(wordCountForBits(newBits), 0);
+		if (bits != UNIFORM_BITS)
+		{
+			for (size_t index = 0; index < CHUNK_SECTION_BLOCK_COUNT; index++)
+			{
+				writePacked(resized, newBits, index, readEntry(index));
+			}
+		}
+		words.swap(resized);
+		bits = newBits;
+	}
+
+	void loadDirect(const uint32_t *values)
+	{
+		std::vector<uint32_t>().swap(palette);
+		std::vector<uint16_t>().swap(paletteRefCounts);
+		livePaletteEntries = 0;
+		directAirCount = 0;
+		directWritesSinceLoad = 0;
+		bits = DIRECT_BITS;
+		words.assign(wordCountForBits(DIRECT_BITS), 0);
+		for (size_t index = 0; index < CHUNK_SECTION_BLOCK_COUNT; index++)
+		{
+			writeEntry(index, values[index]);
+			if (values[index] == VOXEL_AIR)
+			{
+				directAirCount++;
+			}
+		}
+	}
+
+	void switchToDirect()
+	{
+		uint32_t values[CHUNK_SECTION_BLOCK_COUNT];
+		copyTo(values);
+		loadDirect(values);
+	}
+
+	void writeDirect(size_t index, uint32_t previous, uint32_t value)
+	{
+		writeEntry(index, value);
+		if (previous == VOXEL_AIR)
+		{
+			directAirCount--;
+		}
+		if (value == VOXEL_AIR)
+		{
+			directAirCount++;
+		}
+		if (directAirCount == CHUNK_SECTION_BLOCK_COUNT)
+		{
+			fill(VOXEL_AIR);
+			return;
+		}
+
+		// En mode direct on ne connaît pas le nombre de couleurs distinctes:
+		// on réévalue la palette de temps en temps pour pouvoir redescendre.
+		directWritesSinceLoad++;
+		if (directWritesSinceLoad >= CHUNK_SECTION_BLOCK_COUNT / 4)
+		{
+			uint32_t values[CHUNK_SECTION_BLOCK_COUNT];
+			copyTo(values);
+			load(values);
+		}
+	}
+
+	void shrinkIfNeeded()
+	{
+		// Hystérésis d'un bit pour éviter de repacker à chaque ajout/retrait de couleur.
+		uint8_t requiredBits = bitsForPaletteSize(livePaletteEntries);
+		if (requiredBits != UNIFORM_BITS && requiredBits + 1 >= bits)
+		{
+			return;
+		}
+
+		uint32_t values[CHUNK_SECTION_BLOCK_COUNT];
+		copyTo(values);
+		load(values);
+	}
+};
+
 struct VoxelChunkData
 {
 	int chunkX = 0;
 	int chunkZ = 0;
 	uint64_t revision = 0;
-	uint8_t nonEmptySectionMask = 0;
-	uint32_t blocks[CHUNK_SIZE_X][CHUNK_SIZE_Y][CHUNK_SIZE_Z];
+	ChunkSectionMask nonEmptySectionMask = 0;
+	// nullptr = section d'air: aucune allocation pour les sections vides.
+	// Les sections sont partagées en copy-on-write: copier un chunk ne copie que des pointeurs.
+	std::shared_ptr<ChunkSectionStorage> sections[CHUNK_SECTION_COUNT];
 
 	VoxelChunkData(int cx = 0, int cz = 0) : chunkX(cx), chunkZ(cz)
 	{
-		clearBlocks();
 	}
 
 	void clearBlocks()
 	{
-		std::memset(blocks, 0, sizeof(blocks));
+		for (std::shared_ptr<ChunkSectionStorage> &section : sections)
+		{
+			section.reset();
+		}
 		nonEmptySectionMask = 0;
 	}
 
@@ -118,7 +565,19 @@ struct VoxelChunkData
 		return sectionYBegin(sectionIndex) + CHUNK_SECTION_HEIGHT;
 	}
 
-	uint8_t sectionMask() const
+	// Index dans un tableau dense [x][y][z] (ancien layout, utilisé par les formats legacy).
+	static size_t denseBlockIndex(int x, int y, int z)
+	{
+		return (static_cast<size_t>(x) * CHUNK_SIZE_Y + static_cast<size_t>(y)) *
+			CHUNK_SIZE_Z + static_cast<size_t>(z);
+	}
+
+	static ChunkSectionMask sectionBit(int sectionIndex)
+	{
+		return static_cast<ChunkSectionMask>(ChunkSectionMask{1} << sectionIndex);
+	}
+
+	ChunkSectionMask sectionMask() const
 	{
 		return nonEmptySectionMask;
 	}
@@ -129,8 +588,7 @@ struct VoxelChunkData
 		{
 			return true;
 		}
-		uint8_t bit = static_cast<uint8_t>(1u << sectionIndex);
-		if ((nonEmptySectionMask & bit) == 0)
+		if ((nonEmptySectionMask & sectionBit(sectionIndex)) == 0)
 		{
 			return true;
 		}
@@ -156,7 +614,13 @@ struct VoxelChunkData
 		{
 			return VOXEL_AIR;
 		}
-		return blocks[x][y][z];
+		int sectionIndex = sectionIndexFromY(y);
+		const ChunkSectionStorage *storage = sections[sectionIndex].get();
+		if (storage == nullptr)
+		{
+			return VOXEL_AIR;
+		}
+		return storage->get(ChunkSectionStorage::localIndex(x, y - sectionYBegin(sectionIndex), z));
 	}
 
 	bool setBlockRaw(int x, int y, int z, uint32_t color)
@@ -177,25 +641,135 @@ struct VoxelChunkData
 		{
 			return false;
 		}
-		if (blocks[x][y][z] == color)
+		int sectionIndex = sectionIndexFromY(y);
+		size_t localIndex = ChunkSectionStorage::localIndex(x, y - sectionYBegin(sectionIndex), z);
+		if (sections[sectionIndex] == nullptr && color == VOXEL_AIR)
 		{
 			return false;
 		}
-		blocks[x][y][z] = color;
-		int sectionIndex = sectionIndexFromY(y);
-		uint8_t sectionBit = static_cast<uint8_t>(1u << sectionIndex);
-		if (color != VOXEL_AIR)
+		if (sections[sectionIndex] != nullptr && sections[sectionIndex]->get(localIndex) == color)
 		{
-			nonEmptySectionMask |= sectionBit;
+			return false;
 		}
-		else if (!sectionHasAnyBlocks(sectionIndex))
+		mutableSection(sectionIndex).set(localIndex, color);
+		updateSectionMaskBit(sectionIndex);
+		revision++;
+		return true;
+	}
+
+	// nullptr si la section est entièrement vide.
+	const ChunkSectionStorage *sectionIfPresent(int sectionIndex) const
+	{
+		return sections[sectionIndex].get();
+	}
+
+	const ChunkSectionStorage &section(int sectionIndex) const
+	{
+		const ChunkSectionStorage *storage = sections[sectionIndex].get();
+		if (storage == nullptr)
 		{
-			nonEmptySectionMask &= static_cast<uint8_t>(~sectionBit);
+			return ChunkSectionStorage::airSection();
+		}
+		return *storage;
+	}
+
+	// Copie/charge une section dans l'ordre réseau [x][yLocal][z] (CHUNK_SECTION_BLOCK_COUNT valeurs).
+	void copySectionBlocks(int sectionIndex, uint32_t *values) const
+	{
+		section(sectionIndex).copyTo(values);
+	}
+
+	void loadSectionBlocks(int sectionIndex, const uint32_t *values)
+	{
+		std::shared_ptr<ChunkSectionStorage> &storage = sections[sectionIndex];
+		if (storage == nullptr || storage.use_count() > 1)
+		{
+			// Pas besoin de cloner: la section est entièrement remplacée.
+			storage = std::make_shared<ChunkSectionStorage>();
+		}
+		else
+		{
+			std::atomic_thread_fence(std::memory_order_acquire);
+		}
+		storage->load(values);
+		updateSectionMaskBit(sectionIndex);
+	}
+
+	// Remplace une section par celle d'un autre chunk (pointeur partagé, copy-on-write).
+	void copySectionFrom(const VoxelChunkData &other, int sectionIndex)
+	{
+		sections[sectionIndex] = other.sections[sectionIndex];
+		updateSectionMaskBit(sectionIndex);
+	}
+
+	void copyBlocksTo(uint32_t *values) const
+	{
+		uint32_t sectionValues[CHUNK_SECTION_BLOCK_COUNT];
+		for (int sectionIndex = 0; sectionIndex < CHUNK_SECTION_COUNT; sectionIndex++)
+		{
+			int yBegin = sectionYBegin(sectionIndex);
+			const ChunkSectionStorage *storage = sections[sectionIndex].get();
+			if (storage == nullptr)
+			{
+				for (int x = 0; x < CHUNK_SIZE_X; x++)
+				{
+					std::fill_n(values + denseBlockIndex(x, yBegin, 0),
+								static_cast<size_t>(CHUNK_SECTION_HEIGHT) * CHUNK_SIZE_Z,
+								VOXEL_AIR);
+				}
+				continue;
+			}
+			storage->copyTo(sectionValues);
+			for (int x = 0; x < CHUNK_SIZE_X; x++)
+			{
+				std::memcpy(values + denseBlockIndex(x, yBegin, 0),
+							sectionValues + ChunkSectionStorage::localIndex(x, 0, 0),
+							static_cast<size_t>(CHUNK_SECTION_HEIGHT) * CHUNK_SIZE_Z * sizeof(uint32_t));
+			}
+		}
+	}
+
+	void loadBlocks(const uint32_t *values)
+	{
+		uint32_t sectionValues[CHUNK_SECTION_BLOCK_COUNT];
+		for (int sectionIndex = 0; sectionIndex < CHUNK_SECTION_COUNT; sectionIndex++)
+		{
+			int yBegin = sectionYBegin(sectionIndex);
+			for (int x = 0; x < CHUNK_SIZE_X; x++)
+			{
+				std::memcpy(sectionValues + ChunkSectionStorage::localIndex(x, 0, 0),
+							values + denseBlockIndex(x, yBegin, 0),
+							static_cast<size_t>(CHUNK_SECTION_HEIGHT) * CHUNK_SIZE_Z * sizeof(uint32_t));
+			}
+			loadSectionBlocks(sectionIndex, sectionValues);
+		}
+	}
+
+	bool sameBlocks(const VoxelChunkData &other) const
+	{
+		for (int sectionIndex = 0; sectionIndex < CHUNK_SECTION_COUNT; sectionIndex++)
+		{
+			if (!section(sectionIndex).sameBlocks(other.section(sectionIndex)))
+			{
+				return false;
+			}
 		}
-		revision++;
 		return true;
 	}
 
+	size_t storedBlockBytes() const
+	{
+		size_t bytes = 0;
+		for (const std::shared_ptr<ChunkSectionStorage> &storage : sections)
+		{
+			if (storage != nullptr)
+			{
+				bytes += storage->storedBytes();
+			}
+		}
+		return bytes;
+	}
+
 	bool isCompletelyEmpty() const
 	{
 		if (nonEmptySectionMask == 0)
@@ -207,12 +781,12 @@ struct VoxelChunkData
 
 	void rebuildSectionMask()
 	{
-		uint8_t mask = 0;
+		ChunkSectionMask mask = 0;
 		for (int sectionIndex = 0; sectionIndex < CHUNK_SECTION_COUNT; sectionIndex++)
 		{
 			if (sectionHasAnyBlocks(sectionIndex))
 			{
-				mask |= static_cast<uint8_t>(1u << sectionIndex);
+				mask |= sectionBit(sectionIndex);
 			}
 		}
 		nonEmptySectionMask = mask;
@@ -251,24 +825,39 @@ private:
 		{
 			return false;
 		}
+		const ChunkSectionStorage *storage = sections[sectionIndex].get();
+		return storage != nullptr && !storage->isEmpty();
+	}
 
-		int yBegin = sectionYBegin(sectionIndex);
-		int yEndExclusive = sectionYEndExclusive(sectionIndex);
-		for (int x = 0; x < CHUNK_SIZE_X; x++)
+	void updateSectionMaskBit(int sectionIndex)
+	{
+		if (sectionHasAnyBlocks(sectionIndex))
 		{
-			for (int y = yBegin; y < yEndExclusive; y++)
-			{
-				for (int z = 0; z < CHUNK_SIZE_Z; z++)
-				{
-					if (blocks[x][y][z] != VOXEL_AIR)
-					{
-						return true;
-					}
-				}
-			}
+			nonEmptySectionMask |= sectionBit(sectionIndex);
+			return;
 		}
+		// Section redevenue vide: on rend la mémoire et on repasse sur la sentinelle.
+		sections[sectionIndex].reset();
+		nonEmptySectionMask &= static_cast<ChunkSectionMask>(~sectionBit(sectionIndex));
+	}
 
-		return false;
+	ChunkSectionStorage &mutableSection(int sectionIndex)
+	{
+		std::shared_ptr<ChunkSectionStorage> &storage = sections[sectionIndex];
+		if (storage == nullptr)
+		{
+			storage = std::make_shared<ChunkSectionStorage>();
+		}
+		else if (storage.use_count() > 1)
+		{
+			storage = std::make_shared<ChunkSectionStorage>(*storage);
+		}
+		else
+		{
+			// Seul propriétaire: on se synchronise avec les lectures faites avant les release des autres copies.
+			std::atomic_thread_fence(std::memory_order_acquire);
+		}
+		return *storage;
 	}
 };
 
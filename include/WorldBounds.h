@@ -28,6 +28,8 @@ struct ChunkBounds
 	int minChunkZ = 0;
 	int maxChunkZExclusive = 0;
 
+	bool operator==(const ChunkBounds &) const = default;
+
 	int widthChunks() const
 	{
 		return maxChunkXExclusive - minChunkX;
@@ -6,6 +6,7 @@
 #include <glm/vec3.hpp>
 #include <deque>
 #include <string>
+#include <unordered_map>
 
 struct WorldClientEvent
 {
@@ -16,22 +17,38 @@ struct WorldClientEvent
 			PlayerStateUpdated,
 			FrontierUpdated,
 			ChunkReceived,
+			ChunkDeltaReceived,
 			BlockUpdated,
+			BlockBatchUpdated,
 			ChatMessageReceived,
 			ExpansionStatusUpdated,
-			ServerProfileUpdated
+			ServerProfileUpdated,
+			RemotePlayersUpdated
 		};
 
 	Type type = Type::Disconnected;
 	PlayerStateMessage playerState;
 	WorldFrontier frontier;
 		VoxelChunkData chunk;
+		ChunkSectionDeltaMessage chunkDelta;
 		BlockUpdateBroadcastMessage blockUpdate;
+		BlockUpdateBatchMessage blockUpdateBatch;
 		ExpansionStatusMessage expansionStatus;
 		ServerChatMessage chatMessage;
 		ServerProfileMessage serverProfile;
 	};
 
+// Joueur répliqué par le serveur (rayon d'intérêt), indexé par replicationId.
+struct RemotePlayer
+{
+	uint64_t playerId = 0;
+	std::string username;
+	uint16_t skinId = 0;
+	QuantizedPlayerTransform transform;
+	glm::vec3 position = glm::vec3(0.0f);
+	glm::vec3 lookDirection = glm::vec3(0.0f, 0.0f, -1.0f);
+};
+
 class WorldClient
 {
 public:
@@ -52,12 +69,16 @@ public:
 		bool isConnected() const;
 		bool isLocalPlayerAdmin() const;
 		uint32_t getRoundTripTime() const;
+	// Octets de charge utile reçus via service() depuis la création du client.
+	uint64_t receivedPayloadBytes() const;
 	const Player &localPlayer() const;
+	const std::unordered_map<uint16_t, RemotePlayer> &remotePlayers() const;
 	uint64_t remainingBlockActionCooldownMs() const;
 	uint64_t remainingServerCooldownMs(uint64_t readyAtMs) const;
 	const std::string &lastConnectionError() const;
 
 	void sendChunkRequest(int chunkX, int chunkZ);
+	void sendChunkRequest(int chunkX, int chunkZ, uint64_t knownRevision);
 	void sendChunkDrop(int chunkX, int chunkZ);
 		void sendPlaceBlock(int worldX, int worldY, int worldZ, uint8_t paletteIndex);
 		void sendBreakBlock(int worldX, int worldY, int worldZ);
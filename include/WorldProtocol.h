@@ -13,6 +13,7 @@
 constexpr size_t PLAYER_PASSWORD_MAX_LENGTH = 128;
 constexpr size_t COMMAND_REQUEST_TEXT_MAX_LENGTH = 127;
 constexpr size_t SERVER_CHAT_TEXT_MAX_LENGTH = 255;
+constexpr size_t SHARD_TOKEN_MAX_LENGTH = 64;
 
 enum class PacketType : uint8_t
 {
@@ -36,7 +37,13 @@ enum class PacketType : uint8_t
 		ExpansionStatus = 18,
 		ChatMessageRequest = 19,
 		AccountDeleteRequest = 20,
-		AccountDeleteResponse = 21
+		AccountDeleteResponse = 21,
+		BlockUpdateBatch = 22,
+		ChunkSectionDelta = 23,
+		ChunkSnapshotSectionFrames = 24,
+		ChunkZstdDictionary = 25,
+		RemotePlayerBatch = 26,
+		ShardFrontierSync = 27
 };
 
 enum class BlockActionType : uint8_t
@@ -50,7 +57,9 @@ enum class LoginStatus : uint8_t
 	Accepted = 1,
 	InvalidUsername = 2,
 	UsernameAlreadyInUse = 3,
-	InvalidCredentials = 4
+	InvalidCredentials = 4,
+	// File d'authentification pleine: réessayer plus tard.
+	ServerBusy = 5
 };
 
 enum class AccountDeleteStatus : uint8_t
@@ -59,7 +68,8 @@ enum class AccountDeleteStatus : uint8_t
 	InvalidUsername = 2,
 	InvalidCredentials = 3,
 	UsernameAlreadyInUse = 4,
-	StorageError = 5
+	StorageError = 5,
+	ServerBusy = 6
 };
 
 enum class ServerChatMessageKind : uint8_t
@@ -69,10 +79,30 @@ enum class ServerChatMessageKind : uint8_t
 	Error = 3
 };
 
+// Codecs de snapshot qu'un client sait lire. Le décodage ne dépend que du type de paquet:
+// les niveaux Zstd ne changent que le coût d'encodage et la taille.
+enum class ChunkCodec : uint8_t
+{
+	Sections = 0,
+	ZstdFast = 1,
+	Zstd = 2,
+	ZstdDense = 3
+};
+
+constexpr size_t CHUNK_CODEC_COUNT = 4;
+constexpr uint32_t chunkCodecBit(ChunkCodec codec)
+{
+	return uint32_t{1} << static_cast<uint32_t>(codec);
+}
+constexpr uint32_t ALL_CHUNK_CODECS = (uint32_t{1} << CHUNK_CODEC_COUNT) - 1u;
+// Un client v1 n'annonce rien: il reçoit ce que le serveur envoyait avant (Zstd niveau 3).
+constexpr uint32_t LEGACY_CHUNK_CODECS = chunkCodecBit(ChunkCodec::Zstd);
+
 struct HelloMessage
 {
 	uint32_t magic = 0x5658504Cu;
-	uint16_t version = 1;
+	uint16_t version = 2;
+	uint32_t chunkCodecs = ALL_CHUNK_CODECS;
 };
 
 struct LoginRequestMessage
@@ -81,6 +111,14 @@ struct LoginRequestMessage
 	char password[PLAYER_PASSWORD_MAX_LENGTH + 1] = {};
 };
 
+// Passerelle -> shard uniquement: le jeton (VOXPLACE_SHARD_TOKEN) authentifie le lien de contrôle.
+// Le primaire y répond par sa WorldFrontier, les autres shards adoptent la frontière jointe.
+struct ShardFrontierSyncMessage
+{
+	char token[SHARD_TOKEN_MAX_LENGTH + 1] = {};
+	WorldFrontier frontier;
+};
+
 struct LoginResponseMessage
 {
 	LoginStatus status = LoginStatus::InvalidUsername;
@@ -111,6 +149,9 @@ struct ChunkRequestMessage
 {
 	int32_t chunkX = 0;
 	int32_t chunkZ = 0;
+	// Le client garde encore ce chunk à knownRevision: le serveur peut répondre par un delta.
+	bool hasKnownRevision = false;
+	uint64_t knownRevision = 0;
 };
 
 struct ChunkDropMessage
@@ -137,6 +178,84 @@ struct BlockUpdateBroadcastMessage
 	uint64_t revision = 0;
 };
 
+// Coordonnées locales au chunk: x 4 bits, y 6 bits, z 4 bits sur le fil.
+struct BlockUpdateBatchEntry
+{
+	uint8_t localX = 0;
+	uint8_t localY = 0;
+	uint8_t localZ = 0;
+	uint32_t finalColor = 0;
+};
+
+struct BlockUpdateBatchChunk
+{
+	int32_t chunkX = 0;
+	int32_t chunkZ = 0;
+	uint64_t revision = 0;
+	std::vector<BlockUpdateBatchEntry> updates;
+};
+
+struct BlockUpdateBatchMessage
+{
+	std::vector<BlockUpdateBatchChunk> chunks;
+};
+
+// Sections changées depuis baseRevision; une section absente de chunk.sectionMask() redevient de l'air.
+struct ChunkSectionDeltaMessage
+{
+	uint64_t baseRevision = 0;
+	ChunkSectionMask changedSections = 0;
+	VoxelChunkData chunk;
+};
+
+// Envoyé avant la LoginResponse acceptée, sur le même canal: le client l'a
+// toujours avant son premier chunk.
+struct ChunkZstdDictionaryMessage
+{
+	uint32_t dictionaryId = 0;
+	std::vector<uint8_t> content;
+};
+
+// Position au 1/32 de bloc, regard en lacet / tangage sur 16 bits.
+constexpr float REMOTE_PLAYER_POSITION_SCALE = 32.0f;
+
+constexpr uint8_t REMOTE_PLAYER_SPAWN = 1u << 0;
+constexpr uint8_t REMOTE_PLAYER_DESPAWN = 1u << 1;
+constexpr uint8_t REMOTE_PLAYER_POSITION = 1u << 2;
+// Écart depuis la dernière position envoyée à CE client (canal fiable et ordonné).
+constexpr uint8_t REMOTE_PLAYER_POSITION_DELTA = 1u << 3;
+constexpr uint8_t REMOTE_PLAYER_LOOK = 1u << 4;
+
+struct QuantizedPlayerTransform
+{
+	int32_t positionX = 0;
+	int32_t positionY = 0;
+	int32_t positionZ = 0;
+	uint16_t yaw = 0;
+	int16_t pitch = 0;
+
+	bool operator==(const QuantizedPlayerTransform &) const = default;
+};
+
+// replicationId identifie la session côté serveur; un SPAWN sur un id connu remplace le joueur.
+struct RemotePlayerUpdate
+{
+	uint16_t replicationId = 0;
+	uint8_t flags = 0;
+	uint64_t playerId = 0;
+	uint16_t skinId = 0;
+	std::string username;
+	QuantizedPlayerTransform transform;
+	int16_t deltaX = 0;
+	int16_t deltaY = 0;
+	int16_t deltaZ = 0;
+};
+
+struct RemotePlayerBatchMessage
+{
+	std::vector<RemotePlayerUpdate> updates;
+};
+
 struct PlayerStateMessage
 {
 	uint64_t playerId = 0;
@@ -233,6 +352,8 @@ struct DecodedChunkSnapshot
 	VoxelChunkData chunk;
 };
 
+const char *chunkCodecName(ChunkCodec codec);
+
 std::vector<uint8_t> encodeHello(const HelloMessage &message);
 bool decodeHello(const uint8_t *data, size_t size, HelloMessage &message);
 
@@ -251,6 +372,9 @@ bool decodeAccountDeleteResponse(const uint8_t *data, size_t size, AccountDelete
 std::vector<uint8_t> encodeWorldFrontier(const WorldFrontier &frontier);
 bool decodeWorldFrontier(const uint8_t *data, size_t size, WorldFrontier &frontier);
 
+std::vector<uint8_t> encodeShardFrontierSync(const ShardFrontierSyncMessage &message);
+bool decodeShardFrontierSync(const uint8_t *data, size_t size, ShardFrontierSyncMessage &message);
+
 std::vector<uint8_t> encodeChunkRequest(const ChunkRequestMessage &message);
 bool decodeChunkRequest(const uint8_t *data, size_t size, ChunkRequestMessage &message);
 
@@ -258,15 +382,48 @@ std::vector<uint8_t> encodeChunkDrop(const ChunkDropMessage &message);
 bool decodeChunkDrop(const uint8_t *data, size_t size, ChunkDropMessage &message);
 
 std::vector<uint8_t> encodeChunkSnapshot(const VoxelChunkData &chunk);
+// Réutilise la capacité de buffer (tampon gardé par l'appelant).
+void encodeChunkSnapshotInto(const VoxelChunkData &chunk, std::vector<uint8_t> &buffer);
 std::vector<uint8_t> encodeChunkSnapshotNetwork(const VoxelChunkData &chunk);
+std::vector<uint8_t> encodeChunkSnapshotNetwork(const VoxelChunkData &chunk, ChunkCodec codec);
+// Octets bruts d'une section, tels que compressés par compressChunkSectionFrame.
+std::vector<uint8_t> encodeChunkSectionData(const VoxelChunkData &chunk, int sectionIndex);
+// Une trame Zstd indépendante par section: une édition ne recompresse que sa section.
+bool compressChunkSectionFrame(const VoxelChunkData &chunk, int sectionIndex, std::vector<uint8_t> &outFrame);
+// sectionFrames[i] doit être non nul pour chaque section présente dans chunk.sectionMask().
+std::vector<uint8_t> encodeChunkSnapshotSectionFrames(const VoxelChunkData &chunk,
+													  const std::vector<uint8_t> *const *sectionFrames);
 bool decodeChunkSnapshot(const uint8_t *data, size_t size, DecodedChunkSnapshot &message);
 
+std::vector<uint8_t> encodeChunkSectionDelta(const VoxelChunkData &chunk,
+											 uint64_t baseRevision,
+											 ChunkSectionMask changedSections);
+bool decodeChunkSectionDelta(const uint8_t *data, size_t size, ChunkSectionDeltaMessage &message);
+
+std::vector<uint8_t> encodeChunkZstdDictionary(const ChunkZstdDictionaryMessage &message);
+bool decodeChunkZstdDictionary(const uint8_t *data, size_t size, ChunkZstdDictionaryMessage &message);
+
+QuantizedPlayerTransform quantizePlayerTransform(float positionX,
+												 float positionY,
+												 float positionZ,
+												 float lookX,
+												 float lookY,
+												 float lookZ);
+void dequantizePlayerPosition(const QuantizedPlayerTransform &transform, float &x, float &y, float &z);
+void dequantizePlayerLook(const QuantizedPlayerTransform &transform, float &x, float &y, float &z);
+
+std::vector<uint8_t> encodeRemotePlayerBatch(const RemotePlayerBatchMessage &message);
+bool decodeRemotePlayerBatch(const uint8_t *data, size_t size, RemotePlayerBatchMessage &message);
+
 std::vector<uint8_t> encodeBlockActionRequest(const BlockActionRequestMessage &message);
 bool decodeBlockActionRequest(const uint8_t *data, size_t size, BlockActionRequestMessage &message);
 
 std::vector<uint8_t> encodeBlockUpdateBroadcast(const BlockUpdateBroadcastMessage &message);
 bool decodeBlockUpdateBroadcast(const uint8_t *data, size_t size, BlockUpdateBroadcastMessage &message);
 
+std::vector<uint8_t> encodeBlockUpdateBatch(const BlockUpdateBatchMessage &message);
+bool decodeBlockUpdateBatch(const uint8_t *data, size_t size, BlockUpdateBatchMessage &message);
+
 std::vector<uint8_t> encodePlayerState(const PlayerStateMessage &message);
 bool decodePlayerState(const uint8_t *data, size_t size, PlayerStateMessage &message);
 
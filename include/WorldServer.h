@@ -18,7 +18,9 @@ public:
 				std::string playerDatabasePath = "voxplace_players.sqlite3",
 				std::string worldDatabasePath = "voxplace_world.sqlite3",
 				bool persistGeneratedChunks = false,
-				ServerEnvironmentOptions environmentOptions = {});
+				ServerEnvironmentOptions environmentOptions = {},
+				ShardLayout shard = {},
+				std::string shardToken = {});
 	~WorldServer();
 
 	bool start();
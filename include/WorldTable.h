@@ -5,6 +5,8 @@
 
 #include <sqlite3.h>
 
+class ChunkZstdDictionary;
+
 #include <cstdint>
 #include <mutex>
 #include <string>
@@ -17,6 +19,17 @@ enum class WorldTableLoadChunkResult : uint8_t
 	Error = 2
 };
 
+// Payload zstd prêt à écrire: la compression peut tourner hors du verrou SQLite.
+struct WorldTablePreparedChunk
+{
+	int64_t key = 0;
+	int chunkX = 0;
+	int chunkZ = 0;
+	uint64_t revision = 0;
+	uint64_t nowMs = 0;
+	std::vector<uint8_t> payload;
+};
+
 class WorldTable
 {
 public:
@@ -34,9 +47,14 @@ public:
 	bool loadChunk(int cx, int cz, VoxelChunkData &chunk);
 	bool loadAllChunkKeys(std::vector<int64_t> &outChunkKeys);
 	bool saveChunk(const VoxelChunkData &chunk);
-	bool saveChunksBatch(const std::vector<VoxelChunkData> &chunks);
+	bool saveChunksBatch(const std::vector<const VoxelChunkData *> &chunks);
+	bool prepareChunksBatch(const std::vector<const VoxelChunkData *> &chunks,
+							std::vector<WorldTablePreparedChunk> &outPrepared);
+	bool savePreparedChunksBatch(const std::vector<WorldTablePreparedChunk> &preparedChunks);
 	bool loadMetaValue(const std::string &key, std::string &outValue);
 	bool saveMetaValue(const std::string &key, const std::string &value);
+	// Ajoute le dictionnaire et le rend actif pour les prochaines ouvertures.
+	bool saveChunkDictionary(const ChunkZstdDictionary &dictionary);
 
 	const std::string &lastError() const;
 	std::string lastErrorCopy() const;
@@ -52,6 +70,7 @@ private:
 	bool prepareStatementNoLock(const char *sql, sqlite3_stmt **statement);
 	bool ensureMetaValueNoLock(const std::string &key, const std::string &value);
 	bool preparePersistentStatementsNoLock();
+	bool loadChunkDictionariesNoLock();
 	bool beginTransactionNoLock();
 	bool commitTransactionNoLock();
 	void rollbackTransactionNoLock();
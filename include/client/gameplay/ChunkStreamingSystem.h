@@ -34,6 +34,7 @@ public:
 		size_t classicMaxChunkRequestsPerFrame,
 		std::unordered_set<int64_t> &streamedChunkKeys,
 		std::unordered_map<int64_t, ClientChunk *> &chunkMap,
+		const ClientRetainedChunkCache &retainedChunks,
 		size_t &profileChunkRequestsWindow,
 		size_t &profileChunkDropsWindow,
 		const std::function<void(int64_t)> &dropChunkByKey);
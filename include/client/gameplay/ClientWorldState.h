@@ -32,6 +32,7 @@ struct ClientWorldState
 	std::unordered_map<int64_t, ClientChunk *> chunkMap;
 	std::unordered_set<int64_t> streamedChunkKeys;
 	std::unordered_map<int64_t, uint64_t> pendingMeshRevisions;
+	ClientRetainedChunkCache retainedChunks;
 	ExpansionStatusMessage expansionStatus;
 	ServerProfileMessage serverProfile;
 	std::deque<ClientChatMessage> chatMessages;
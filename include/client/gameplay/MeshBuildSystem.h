@@ -2,6 +2,7 @@
 #define CLIENT_WORLD_MESH_BUILD_SYSTEM_H
 
 #include <ClientChunk.h>
+#include <WorldProtocol.h>
 #include <client/rendering/ChunkIndirectRenderer.h>
 #include <client/rendering/ClientChunkMesher.h>
 #include <client/rendering/WorldRenderer.h>
@@ -29,6 +30,14 @@ public:
 									  int wy,
 									  int wz,
 									  uint32_t color);
+	static void applyBlockUpdateBatch(std::unordered_map<int64_t, ClientChunk *> &chunkMap,
+									  const BlockUpdateBatchMessage &batch);
+	static void retainChunkStorage(int64_t key,
+								   const std::unordered_map<int64_t, ClientChunk *> &chunkMap,
+								   ClientRetainedChunkCache &retainedChunks);
+	static bool applyChunkSectionDelta(std::unordered_map<int64_t, ClientChunk *> &chunkMap,
+									   ClientRetainedChunkCache &retainedChunks,
+									   const ChunkSectionDeltaMessage &delta);
 	static bool upsertChunkSnapshot(std::unordered_map<int64_t, ClientChunk *> &chunkMap,
 									const std::unordered_set<int64_t> &streamedChunkKeys,
 									const VoxelChunkData &snapshot);
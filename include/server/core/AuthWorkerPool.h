@@ -0,0 +1,48 @@
+#ifndef SERVER_CORE_AUTH_WORKER_POOL_H
+#define SERVER_CORE_AUTH_WORKER_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Threads dédiés à l'authentification, à part du JobSystem: un crypto_pwhash coûte des dizaines
+// de ms et 64 MiB. Le nombre de threads borne la mémoire, la file d'admission borne l'attente.
+class AuthWorkerPool
+{
+public:
+	using Job = std::move_only_function<void()>;
+
+	AuthWorkerPool() = default;
+	~AuthWorkerPool();
+
+	AuthWorkerPool(const AuthWorkerPool &) = delete;
+	AuthWorkerPool &operator=(const AuthWorkerPool &) = delete;
+
+	void start(size_t threadCount, size_t queueCapacity);
+	// Abandonne les jobs pas encore commencés (leurs clients partent avec le serveur)
+	// et attend ceux en cours.
+	void stop();
+	// false si la file est pleine (ou le pool arrêté): l'appelant répond « serveur occupé ».
+	bool trySubmit(Job job);
+
+	size_t threadCount() const;
+	size_t queuedCount() const;
+	size_t activeCount() const;
+
+private:
+	mutable std::mutex m_mutex;
+	std::condition_variable m_cv;
+	std::deque<Job> m_jobs;
+	std::vector<std::thread> m_threads;
+	size_t m_queueCapacity = 0;
+	size_t m_activeJobs = 0;
+	bool m_stopRequested = false;
+
+	void workerLoop();
+};
+
+#endif
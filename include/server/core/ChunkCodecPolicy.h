@@ -0,0 +1,27 @@
+#ifndef SERVER_CORE_CHUNK_CODEC_POLICY_H
+#define SERVER_CORE_CHUNK_CODEC_POLICY_H
+
+#include <WorldProtocol.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Ce que le serveur sait d'un lien au moment de choisir son codec de snapshots.
+struct ChunkCodecLinkState
+{
+	uint32_t roundTripTimeMs = 0;
+	// Octets fiables envoyés mais pas encore acquittés (ENetPeer::reliableDataInTransit).
+	uint32_t reliableDataInTransit = 0;
+	// Snapshots acquittés par le client, lissé sur quelques secondes.
+	double ackedBytesPerSecond = 0.0;
+	// Workers en retard: on évite les variantes qui demandent un encodage de plus.
+	bool cpuConstrained = false;
+};
+
+// Zstd niveau 3 est déjà encodé par le pipeline d'intégration, c'est le repli par défaut.
+// Les seuils dépendent de currentCodec pour ne pas osciller à la frontière.
+ChunkCodec chooseChunkCodec(const ChunkCodecLinkState &link, uint32_t supportedCodecs, ChunkCodec currentCodec);
+bool parseChunkCodecName(std::string_view name, ChunkCodec &codec);
+
+#endif
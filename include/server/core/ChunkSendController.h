@@ -0,0 +1,56 @@
+#ifndef SERVER_CORE_CHUNK_SEND_CONTROLLER_H
+#define SERVER_CORE_CHUNK_SEND_CONTROLLER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Échantillon périodique du lien d'une session (copie des compteurs de l'ENetPeer).
+struct ChunkSendLinkSample
+{
+	uint32_t roundTripTimeMs = 0;
+	// packetThrottle / ENET_PEER_PACKET_THROTTLE_SCALE: ENet le baisse quand le RTT s'envole.
+	float throttle = 1.0f;
+	// packetLoss / ENET_PEER_PACKET_LOSS_SCALE.
+	float lossRate = 0.0f;
+	// Snapshots acquittés depuis l'échantillon précédent.
+	size_t ackedBytes = 0;
+	// Pic de snapshots en vol sur la période: sous la moitié de la fenêtre, on ne l'agrandit pas.
+	size_t peakInFlightBytes = 0;
+	double elapsedSeconds = 0.0;
+};
+
+// AIMD sur la fenêtre d'octets de snapshots en vol, avec plancher au BDP mesuré
+// (débit acquitté max * RTT min) pour ne pas s'effondrer sur une perte isolée.
+class ChunkSendController
+{
+public:
+	void onLinkSample(const ChunkSendLinkSample &sample);
+
+	size_t windowBytes() const;
+	// Octets à émettre par stream tick: la fenêtre étalée sur un RTT.
+	size_t tickByteBudget(uint32_t streamTickMs) const;
+	uint32_t minRoundTripTimeMs() const;
+	double deliveryRateBytesPerSecond() const;
+	bool inSlowStart() const;
+	// Décroissances depuis la création (profil).
+	uint64_t decreaseCount() const;
+
+private:
+	// ~10 s de RTT et ~2 s de débit à un échantillon toutes les 250 ms.
+	static constexpr size_t MIN_RTT_SAMPLES = 40;
+	static constexpr size_t DELIVERY_RATE_SAMPLES = 8;
+
+	size_t m_windowBytes = 256 * 1024;
+	bool m_slowStart = true;
+	uint32_t m_roundTripTimeMs = 0;
+	std::array<uint32_t, MIN_RTT_SAMPLES> m_rttSamples = {};
+	std::array<double, DELIVERY_RATE_SAMPLES> m_deliveryRateSamples = {};
+	size_t m_sampleCount = 0;
+	double m_secondsSinceDecrease = 0.0;
+	uint64_t m_decreaseCount = 0;
+
+	bool isCongested(const ChunkSendLinkSample &sample) const;
+};
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef SERVER_CORE_CHUNK_SEND_QUEUE_H
+#define SERVER_CORE_CHUNK_SEND_QUEUE_H
+
+#include <server/core/ChunkViewPriority.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+// File de snapshots d'une session, triée comme la génération (chunkViewPriority):
+// au plus proche du joueur, ce qu'il a dans le dos comptant comme plus loin.
+// Les priorités ne sont recalculées qu'après un déplacement d'un chunk ou un virage franc.
+// Une clé peut y figurer en double (abandon puis redemande): l'appelant filtre avec son propre ensemble.
+class ChunkSendQueue
+{
+public:
+	void push(int64_t key);
+	bool empty() const;
+	size_t size() const;
+	// Rafraîchit les priorités si la vue a changé depuis le dernier calcul.
+	int64_t top();
+	void pop();
+	void clear();
+	// Purge les entrées périmées (clés absentes de keys) sans toucher à l'ordre des autres.
+	void retainOnly(const std::unordered_set<int64_t> &keys);
+
+	// Position et regard (plan XZ) du joueur; ne fait que marquer la file à recalculer.
+	void updateView(float x, float z, float lookX, float lookZ);
+	// Recalculs complets depuis la création (profil).
+	uint64_t rekeyCount() const;
+
+private:
+	struct Entry
+	{
+		float priority = 0.0f;
+		uint64_t sequence = 0;
+		int64_t key = 0;
+	};
+
+	struct EntryLater
+	{
+		bool operator()(const Entry &a, const Entry &b) const
+		{
+			if (a.priority != b.priority)
+			{
+				return a.priority > b.priority;
+			}
+			return a.sequence > b.sequence;
+		}
+	};
+
+	std::vector<Entry> m_heap;
+	uint64_t m_nextSequence = 0;
+	// Vue utilisée pour les priorités du tas, et dernière vue reçue.
+	ChunkView m_keyed;
+	ChunkView m_view;
+	bool m_stale = false;
+	uint64_t m_rekeyCount = 0;
+
+	float priorityFor(int64_t key) const;
+	void rekeyIfStale();
+};
+
+#endif
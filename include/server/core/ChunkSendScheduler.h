@@ -0,0 +1,66 @@
+#ifndef SERVER_CORE_CHUNK_SEND_SCHEDULER_H
+#define SERVER_CORE_CHUNK_SEND_SCHEDULER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// État d'une session vis-à-vis du scheduler.
+struct ChunkSendFlow
+{
+	// Crédit DRR en octets. Peut devenir négatif: la taille d'un snapshot n'est connue
+	// qu'une fois le codec / delta choisis, la dette est remboursée au tour suivant.
+	int64_t deficitBytes = 0;
+	uint64_t servedBytes = 0;
+	uint64_t servedBytesWindow = 0;
+	uint64_t boostedBytesWindow = 0;
+};
+
+struct ChunkSendCandidate
+{
+	// Ordre stable d'un tick à l'autre (slot du peer): le tour reprend où il s'était arrêté.
+	uint64_t id = 0;
+	ChunkSendFlow *flow = nullptr;
+	uint32_t weight = 1;
+};
+
+// Deficit round robin entre les sessions sous un seau à jetons global (octets/s de l'hôte).
+// Sans plafond global, chaque session vide simplement sa propre fenêtre.
+class ChunkSendScheduler
+{
+public:
+	static constexpr size_t QUANTUM_BYTES = 16 * 1024;
+
+	// 0 = illimité.
+	void setHostBytesPerSecond(uint64_t bytesPerSecond);
+	uint64_t hostBytesPerSecond() const;
+
+	// sendNext(index) émet au plus un paquet pour candidates[index] et retourne ses octets;
+	// 0 = plus rien à émettre pour cette session ce tick (file vide ou fenêtre pleine).
+	// candidates doit être trié par id.
+	size_t schedule(std::chrono::steady_clock::time_point now,
+					std::vector<ChunkSendCandidate> &candidates,
+					const std::function<size_t(size_t)> &sendNext);
+
+	// Ticks où le seau global a coupé l'émission avant que les sessions soient vides (profil).
+	uint64_t hostLimitedTicks() const;
+
+private:
+	// Rafale maximale du seau global, en temps d'émission.
+	static constexpr int64_t HOST_BURST_MS = 50;
+
+	uint64_t m_hostBytesPerSecond = 0;
+	int64_t m_hostTokens = 0;
+	std::chrono::steady_clock::time_point m_lastRefill;
+	bool m_refilled = false;
+	uint64_t m_nextId = 0;
+	bool m_resumeWithCredit = false;
+	uint64_t m_hostLimitedTicks = 0;
+
+	void refill(std::chrono::steady_clock::time_point now);
+	bool hostBudgetAvailable() const;
+};
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef SERVER_CORE_CHUNK_VIEW_PRIORITY_H
+#define SERVER_CORE_CHUNK_VIEW_PRIORITY_H
+
+// Ordre commun à la génération et à l'envoi des chunks: distance horizontale au joueur,
+// pondérée par son regard. Un chunk généré en premier est aussi le premier envoyé.
+struct ChunkView
+{
+	float x = 0.0f;
+	float z = 0.0f;
+	// Regard normalisé dans le plan XZ; nul quand le joueur regarde à la verticale.
+	float lookX = 0.0f;
+	float lookZ = -1.0f;
+};
+
+ChunkView makeChunkView(float x, float z, float lookX, float lookZ);
+// Plus petit = plus urgent.
+float chunkViewPriority(const ChunkView &view, int chunkX, int chunkZ);
+// Vrai après un déplacement d'un chunk ou un virage franc: les priorités calculées depuis keyed sont périmées.
+bool chunkViewChanged(const ChunkView &keyed, const ChunkView &current);
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef SERVER_CORE_JOB_SYSTEM_H
+#define SERVER_CORE_JOB_SYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Ordre = priorité: un worker prend toujours le niveau le plus urgent,
+// chez lui d'abord puis en volant chez les autres.
+enum class JobPriority : uint8_t
+{
+	Encode = 0,
+	Load = 1,
+	Generate = 2,
+	SaveCompress = 3
+};
+
+constexpr size_t JOB_PRIORITY_COUNT = 4;
+
+class JobSystem
+{
+public:
+	using Job = std::move_only_function<void()>;
+
+	JobSystem() = default;
+	~JobSystem();
+
+	JobSystem(const JobSystem &) = delete;
+	JobSystem &operator=(const JobSystem &) = delete;
+
+	void start(size_t threadCount);
+	// Vide toutes les files avant de rejoindre les threads.
+	void stop();
+	// Sans thread (avant start ou après stop), le job tourne immédiatement sur l'appelant.
+	void submit(JobPriority priority, Job job);
+	void waitIdle();
+
+	size_t threadCount() const;
+	size_t pendingCount(JobPriority priority) const;
+	uint64_t takeStealCount();
+
+private:
+	struct WorkerQueue
+	{
+		std::mutex mutex;
+		std::deque<Job> jobs[JOB_PRIORITY_COUNT];
+	};
+
+	std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+	std::vector<std::thread> m_threads;
+	std::mutex m_sleepMutex;
+	std::condition_variable m_sleepCv;
+	std::condition_variable m_idleCv;
+	bool m_stopRequested = false;
+	std::atomic<size_t> m_pendingJobs = 0;
+	std::atomic<size_t> m_activeJobs = 0;
+	std::atomic<size_t> m_pendingByPriority[JOB_PRIORITY_COUNT] = {};
+	std::atomic<size_t> m_nextQueue = 0;
+	std::atomic<uint64_t> m_stealCount = 0;
+
+	void workerLoop(size_t workerIndex);
+	bool tryTakeJob(size_t workerIndex, Job &outJob);
+	void finishJob();
+};
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef SERVER_CORE_METRICS_EXPORTER_H
+#define SERVER_CORE_METRICS_EXPORTER_H
+
+#include <server/core/MetricsRegistry.h>
+
+#include <enet/enet.h>
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+
+// Sort le registre hors du processus, sur son propre thread:
+// - texte Prometheus sur http://127.0.0.1:<port>/metrics (jamais exposé hors de la machine);
+// - une ligne JSON par intervalle dans un fichier, pour les tendances longues.
+// enet_initialize doit avoir été appelé avant start.
+class MetricsExporter
+{
+public:
+	MetricsExporter() = default;
+	~MetricsExporter();
+
+	MetricsExporter(const MetricsExporter &) = delete;
+	MetricsExporter &operator=(const MetricsExporter &) = delete;
+
+	// port 0: pas d'écoute. jsonlPath vide: pas de fichier. Rien à faire: ne démarre pas de thread.
+	bool start(MetricsRegistry &registry, uint16_t port, const std::string &jsonlPath, uint32_t jsonlIntervalMs);
+	// Écrit une dernière ligne JSON puis ferme le port.
+	void stop();
+	const std::string &lastError() const;
+
+private:
+	MetricsRegistry *m_registry = nullptr;
+	ENetSocket m_listenSocket = ENET_SOCKET_NULL;
+	std::ofstream m_jsonlFile;
+	uint32_t m_jsonlIntervalMs = 0;
+	std::thread m_thread;
+	std::atomic<bool> m_stopRequested = false;
+	std::string m_lastError;
+
+	void exporterLoop();
+	void serveConnection(ENetSocket connection);
+	void writeJsonLine();
+};
+
+#endif
@@ -0,0 +1,154 @@
+#ifndef SERVER_CORE_METRICS_REGISTRY_H
+#define SERVER_CORE_METRICS_REGISTRY_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Compteur monotone. Tous les accès sont relaxed: on ne lit jamais une métrique pour décider.
+class MetricsCounter
+{
+public:
+	void add(uint64_t amount = 1)
+	{
+		m_value.fetch_add(amount, std::memory_order_relaxed);
+	}
+	uint64_t value() const
+	{
+		return m_value.load(std::memory_order_relaxed);
+	}
+
+private:
+	std::atomic<uint64_t> m_value = 0;
+};
+
+class MetricsGauge
+{
+public:
+	void set(int64_t value)
+	{
+		m_value.store(value, std::memory_order_relaxed);
+	}
+	void add(int64_t amount)
+	{
+		m_value.fetch_add(amount, std::memory_order_relaxed);
+	}
+	int64_t value() const
+	{
+		return m_value.load(std::memory_order_relaxed);
+	}
+
+private:
+	std::atomic<int64_t> m_value = 0;
+};
+
+// Histogramme log-linéaire façon HDR: 16 sous-seaux par puissance de deux, soit au plus
+// 6,25 % d'erreur sur un quantile, de 0 à 2^64 sans configuration. Cumulatif depuis le démarrage.
+class MetricsHistogram
+{
+public:
+	static constexpr uint32_t SUB_BUCKET_BITS = 4;
+	static constexpr size_t SUB_BUCKET_COUNT = size_t{1} << SUB_BUCKET_BITS;
+	static constexpr size_t BUCKET_COUNT = SUB_BUCKET_COUNT * (64 - SUB_BUCKET_BITS + 1);
+
+	void record(uint64_t value);
+
+	static size_t bucketIndex(uint64_t value);
+	static uint64_t bucketLowerBound(size_t index);
+	static uint64_t bucketUpperBound(size_t index);
+
+	uint64_t bucketCount(size_t index) const
+	{
+		return m_buckets[index].load(std::memory_order_relaxed);
+	}
+	uint64_t count() const
+	{
+		return m_count.load(std::memory_order_relaxed);
+	}
+	uint64_t sum() const
+	{
+		return m_sum.load(std::memory_order_relaxed);
+	}
+
+private:
+	std::array<std::atomic<uint64_t>, BUCKET_COUNT> m_buckets{};
+	std::atomic<uint64_t> m_count = 0;
+	std::atomic<uint64_t> m_sum = 0;
+};
+
+// Mesure la durée d'une portée en microsecondes.
+class MetricsScopeTimer
+{
+public:
+	explicit MetricsScopeTimer(MetricsHistogram &histogram)
+		: m_histogram(histogram),
+		  m_start(std::chrono::steady_clock::now())
+	{
+	}
+	~MetricsScopeTimer()
+	{
+		m_histogram.record(static_cast<uint64_t>(
+			std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_start).count()));
+	}
+
+	MetricsScopeTimer(const MetricsScopeTimer &) = delete;
+	MetricsScopeTimer &operator=(const MetricsScopeTimer &) = delete;
+
+private:
+	MetricsHistogram &m_histogram;
+	std::chrono::steady_clock::time_point m_start;
+};
+
+// Métriques nommées du serveur. L'enregistrement prend un verrou (au démarrage), la mise à jour
+// n'est qu'un atomique: les références rendues restent valides aussi longtemps que le registre.
+// labels est déjà au format Prometheus sans accolades, par exemple phase="integrate".
+class MetricsRegistry
+{
+public:
+	MetricsCounter &counter(std::string_view name, std::string_view help, std::string_view labels = {});
+	MetricsGauge &gauge(std::string_view name, std::string_view help, std::string_view labels = {});
+	MetricsHistogram &histogram(std::string_view name, std::string_view help, std::string_view labels = {});
+
+	// Format texte d'exposition Prometheus 0.0.4 (valeurs cumulées depuis le démarrage).
+	std::string renderPrometheus() const;
+	// Une ligne JSON: compteurs et gauges, et pour chaque histogramme les quantiles de
+	// l'intervalle écoulé depuis l'appel précédent.
+	std::string renderJsonLine(uint64_t timestampMs);
+
+private:
+	enum class Kind : uint8_t
+	{
+		Counter,
+		Gauge,
+		Histogram
+	};
+
+	struct Entry
+	{
+		Kind kind = Kind::Counter;
+		std::string name;
+		std::string help;
+		std::string labels;
+		std::unique_ptr<MetricsCounter> counter;
+		std::unique_ptr<MetricsGauge> gauge;
+		std::unique_ptr<MetricsHistogram> histogram;
+		// État au dernier renderJsonLine, pour les fenêtres.
+		std::vector<uint64_t> lastBuckets;
+		uint64_t lastSum = 0;
+	};
+
+	mutable std::mutex m_mutex;
+	std::vector<std::unique_ptr<Entry>> m_entries;
+	std::chrono::steady_clock::time_point m_lastJsonAt = std::chrono::steady_clock::now();
+
+	Entry &findOrCreate(Kind kind, std::string_view name, std::string_view help, std::string_view labels);
+};
+
+#endif
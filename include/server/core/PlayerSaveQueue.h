@@ -0,0 +1,78 @@
+#ifndef SERVER_CORE_PLAYER_SAVE_QUEUE_H
+#define SERVER_CORE_PLAYER_SAVE_QUEUE_H
+
+#include <Player.h>
+#include <PlayerTable.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+class MetricsHistogram;
+
+struct PlayerSaveQueueStats
+{
+	size_t enqueued = 0;
+	// Sauvegardes remplacées par une plus récente du même joueur avant d'être écrites.
+	size_t coalesced = 0;
+	size_t written = 0;
+	size_t batches = 0;
+	size_t failedBatches = 0;
+	uint64_t commitMicrosMax = 0;
+};
+
+// Écriture différée de l'état des joueurs: le thread de simulation dépose une copie,
+// un thread dédié garde la dernière par joueur et l'écrit par lots dans une transaction,
+// sur sa propre connexion SQLite.
+class PlayerSaveQueue
+{
+public:
+	PlayerSaveQueue() = default;
+	~PlayerSaveQueue();
+
+	PlayerSaveQueue(const PlayerSaveQueue &) = delete;
+	PlayerSaveQueue &operator=(const PlayerSaveQueue &) = delete;
+
+	bool open(const std::string &databasePath);
+	// Écrit tout ce qui reste avant de rendre la main, en réessayant quelques fois.
+	// false si des états n'ont pas pu être écrits (détail dans lastError()).
+	bool close();
+	bool isOpen() const;
+
+	void enqueue(const Player &player);
+	// Dernier état pas encore visible en base pour ce joueur. À consulter AVANT de lire la base:
+	// si rien n'est en attente à cet instant, une lecture faite ensuite est à jour.
+	bool pendingPlayer(const std::string &username, Player &player) const;
+
+	// Durée de chaque COMMIT réussi (µs). À régler avant open.
+	void setCommitHistogram(MetricsHistogram *histogram);
+
+	size_t pendingCount() const;
+	PlayerSaveQueueStats takeWindowStats();
+	const std::string &lastError() const;
+
+private:
+	PlayerTable m_table;
+	std::string m_lastError;
+	std::thread m_thread;
+	mutable std::mutex m_mutex;
+	std::condition_variable m_cv;
+	std::unordered_map<uint64_t, Player> m_pending;
+	// Lot en cours d'écriture: reste consultable jusqu'au COMMIT.
+	std::unordered_map<uint64_t, Player> m_writing;
+	PlayerSaveQueueStats m_windowStats;
+	MetricsHistogram *m_commitHistogram = nullptr;
+	bool m_stopRequested = false;
+	// Rempli par le thread d'écriture, lu par close() après le join.
+	std::string m_closeError;
+
+	void writerLoop();
+	bool writeBatch(std::unique_lock<std::mutex> &lock);
+	void flushBeforeStop(std::unique_lock<std::mutex> &lock);
+};
+
+#endif
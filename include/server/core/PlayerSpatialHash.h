@@ -0,0 +1,48 @@
+#ifndef SERVER_CORE_PLAYER_SPATIAL_HASH_H
+#define SERVER_CORE_PLAYER_SPATIAL_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Grille uniforme sur les colonnes de chunks (plan XZ): une requête de rayon r
+// ne parcourt que les cellules qui le recouvrent, quel que soit le nombre total de joueurs.
+class PlayerSpatialHash
+{
+public:
+	explicit PlayerSpatialHash(int cellSizeChunks = 2);
+
+	void update(uint16_t id, float x, float z);
+	void remove(uint16_t id);
+	bool contains(uint16_t id) const;
+	size_t size() const;
+
+	// outIds reçoit les ids à distance horizontale <= radius, l'appelant filtre lui-même.
+	// Retourne le nombre d'entrées examinées (coût de la requête).
+	size_t queryRadius(float x, float z, float radius, std::vector<uint16_t> &outIds) const;
+
+private:
+	// Position recopiée dans la cellule: une requête ne fait aucune recherche par id.
+	struct CellEntry
+	{
+		uint16_t id = 0;
+		float x = 0.0f;
+		float z = 0.0f;
+	};
+
+	struct Entry
+	{
+		int64_t cellKey = 0;
+		size_t slot = 0;
+	};
+
+	int m_cellSizeBlocks = 32;
+	std::unordered_map<int64_t, std::vector<CellEntry>> m_cells;
+	std::unordered_map<uint16_t, Entry> m_entries;
+
+	int cellCoord(float value) const;
+	void removeFromCell(int64_t cellKey, size_t slot);
+};
+
+#endif
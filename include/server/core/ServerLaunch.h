@@ -1,7 +1,9 @@
 #ifndef SERVER_CORE_SERVER_LAUNCH_H
 #define SERVER_CORE_SERVER_LAUNCH_H
 
+#include <ShardLayout.h>
 #include <WorldBounds.h>
+#include <WorldProtocol.h>
 
 #include <cstddef>
 #include <cstdint>
@@ -16,6 +18,10 @@ struct ServerLaunchOptions
 	std::string playerDatabasePath = "voxplace_players.sqlite3";
 	std::string worldDatabasePath = "voxplace_world.sqlite3";
 	bool persistGeneratedChunks = false;
+	// --shard <i>/<n>: ce processus ne sert que ses régions, derrière VoxPlaceGateway.
+	ShardLayout shard;
+	// VOXPLACE_SHARD_TOKEN, exigé avec --shard: authentifie le lien de contrôle de la passerelle.
+	std::string shardToken;
 };
 
 struct ServerEnvironmentOptions
@@ -23,6 +29,23 @@ struct ServerEnvironmentOptions
 	bool profileWorkersEnabled = false;
 	size_t requestedWorkerCount = 0;
 	uint32_t streamTickMs = 8;
+	// VOXPLACE_CHUNK_CODEC: même codec pour toutes les sessions (essais, mesures).
+	bool chunkCodecForced = false;
+	ChunkCodec forcedChunkCodec = ChunkCodec::Zstd;
+	// Rayon (en blocs, plan XZ) dans lequel un client reçoit les autres joueurs.
+	uint32_t playerViewRadiusBlocks = 128;
+	// VOXPLACE_HOST_EGRESS_BYTES_PER_SECOND: plafond des snapshots émis par l'hôte, partagé
+	// équitablement entre les sessions. 0 = pas de plafond global.
+	uint64_t hostEgressBytesPerSecond = 0;
+	// VOXPLACE_AUTH_WORKERS: logins / suppressions de compte traités en parallèle (64 MiB chacun).
+	size_t authWorkerCount = 0;
+	// VOXPLACE_METRICS_PORT: texte Prometheus sur 127.0.0.1:<port>/metrics. 0 = désactivé.
+	uint16_t metricsPort = 0;
+	// VOXPLACE_METRICS_JSONL: fichier où ajouter une ligne JSON de métriques par intervalle.
+	std::string metricsJsonlPath;
+	uint32_t metricsJsonlIntervalMs = 10000;
+	// VOXPLACE_PACKET_TRACE: trace binaire des messages entrants, rejouable avec VoxPlaceReplay.
+	std::string packetTracePath;
 };
 
 enum class ServerLaunchParseResult
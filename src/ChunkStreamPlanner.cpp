@@ -0,0 +1,200 @@
+#include <ChunkStreamPlanner.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	float chunkCenterDistanceSqToPos(const glm::vec3 &pos, int chunkX, int chunkZ)
+	{
+		float centerX = chunkX * CHUNK_SIZE_X + CHUNK_SIZE_X * 0.5f;
+		float centerZ = chunkZ * CHUNK_SIZE_Z + CHUNK_SIZE_Z * 0.5f;
+		float dx = centerX - pos.x;
+		float dz = centerZ - pos.z;
+		return dx * dx + dz * dz;
+	}
+
+	bool usesOptimizedStreamingBudgets(bool hasWorldFrontier, const WorldFrontier &frontier)
+	{
+		if (!hasWorldFrontier)
+		{
+			return false;
+		}
+		if (frontier.mode == WorldGenerationMode::ClassicStreaming)
+		{
+			return true;
+		}
+		if (frontier.mode == WorldGenerationMode::ActivityFrontier)
+		{
+			return true;
+		}
+		return false;
+	}
+}
+
+bool ChunkStreamPlanner::usesClassicStreaming(bool hasWorldFrontier, const WorldFrontier &frontier)
+{
+	if (!hasWorldFrontier)
+	{
+		return false;
+	}
+	return frontier.mode == WorldGenerationMode::ClassicStreaming;
+}
+
+bool ChunkStreamPlanner::canStreamChunk(bool hasWorldFrontier,
+										const WorldFrontier &frontier,
+										int chunkX,
+										int chunkZ)
+{
+	if (usesClassicStreaming(hasWorldFrontier, frontier))
+	{
+		return true;
+	}
+	return frontier.generatedBounds.containsChunk(chunkX, chunkZ);
+}
+
+void ChunkStreamPlanner::plan(const ChunkStreamPlanInput &input,
+							  const Frustum &streamFrustum,
+							  const std::unordered_set<int64_t> &streamedChunkKeys,
+							  size_t inflightRequests,
+							  ChunkStreamPlan &plan)
+{
+	plan.requests.clear();
+	plan.drops.clear();
+	if (!input.hasWorldFrontier)
+	{
+		return;
+	}
+
+	const WorldFrontier &frontier = input.frontier;
+	bool optimizedBudgets = usesOptimizedStreamingBudgets(input.hasWorldFrontier, frontier);
+	int streamDistanceChunks = input.renderDistanceChunks;
+	if (optimizedBudgets)
+	{
+		streamDistanceChunks += input.classicStreamingPaddingChunks;
+	}
+
+	float roundTripSec = input.roundTripTimeMs / 1000.0f;
+	float serverChunkReadyMs = std::max(input.serverTerrainGenMsAvg, input.serverSqliteLoadMsAvg);
+	float serverChunkReadySec = serverChunkReadyMs / 1000.0f;
+	// On prend le chemin serveur le plus lent entre lecture DB et génération.
+	// Cela évite de sous-estimer l'avance nécessaire quand les chunks viennent du disque.
+	float predictionTimeSec = (roundTripSec * 1.2f) + serverChunkReadySec;
+
+	// On anticipe la position du joueur avec la latence totale estimée
+	glm::vec3 predictedPos = input.position + (input.velocity * predictionTimeSec);
+
+	int centerChunkX = floorDiv(static_cast<int>(std::floor(predictedPos.x)), CHUNK_SIZE_X);
+	int centerChunkZ = floorDiv(static_cast<int>(std::floor(predictedPos.z)), CHUNK_SIZE_Z);
+	int radiusSq = streamDistanceChunks * streamDistanceChunks;
+
+	struct ChunkRequestCandidate
+	{
+		int chunkX = 0;
+		int chunkZ = 0;
+		float distSq = 0.0f;
+		bool inFrustum = false;
+	};
+	std::vector<ChunkRequestCandidate> requestCandidates;
+
+	for (int dz = -streamDistanceChunks; dz <= streamDistanceChunks; dz++)
+	{
+		for (int dx = -streamDistanceChunks; dx <= streamDistanceChunks; dx++)
+		{
+			if (dx * dx + dz * dz > radiusSq)
+			{
+				continue;
+			}
+
+			int cx = centerChunkX + dx;
+			int cz = centerChunkZ + dz;
+			if (!canStreamChunk(input.hasWorldFrontier, frontier, cx, cz))
+			{
+				continue;
+			}
+
+			int64_t key = chunkKey(cx, cz);
+			if (streamedChunkKeys.find(key) == streamedChunkKeys.end())
+			{
+				ChunkRequestCandidate candidate;
+				candidate.chunkX = cx;
+				candidate.chunkZ = cz;
+				candidate.distSq = chunkCenterDistanceSqToPos(predictedPos, cx, cz);
+				candidate.inFrustum = streamFrustum.isChunkVisible(cx, cz);
+				requestCandidates.push_back(candidate);
+			}
+		}
+	}
+
+	std::sort(requestCandidates.begin(), requestCandidates.end(),
+			  [](const ChunkRequestCandidate &left, const ChunkRequestCandidate &right)
+			  {
+				  if (left.inFrustum != right.inFrustum)
+				  {
+					  return left.inFrustum > right.inFrustum;
+				  }
+				  return left.distSq < right.distSq;
+			  });
+
+	size_t maxNewRequestsThisFrame = requestCandidates.size();
+	if (optimizedBudgets)
+	{
+		size_t frustumMissingChunks = 0;
+		for (const auto &candidate : requestCandidates)
+		{
+			if (!candidate.inFrustum)
+			{
+				break;
+			}
+			frustumMissingChunks++;
+		}
+
+		size_t backgroundBudget = 0;
+		if (inflightRequests < input.classicMaxInflightChunkRequests)
+		{
+			backgroundBudget = input.classicMaxInflightChunkRequests - inflightRequests;
+		}
+
+		size_t totalBudget = frustumMissingChunks + backgroundBudget;
+		maxNewRequestsThisFrame = std::min(maxNewRequestsThisFrame, totalBudget);
+
+		float distanceMoved = 0.0f;
+		if (input.deltaTime > 0.0f)
+		{
+			distanceMoved = glm::length(input.velocity) * input.deltaTime;
+		}
+
+		if (distanceMoved <= 2.0f)
+		{
+			size_t cappedLimit = std::min(maxNewRequestsThisFrame, input.classicMaxChunkRequestsPerFrame);
+			maxNewRequestsThisFrame = std::max(frustumMissingChunks, cappedLimit);
+		}
+	}
+
+	size_t requestCount = std::min(maxNewRequestsThisFrame, requestCandidates.size());
+	plan.requests.reserve(requestCount);
+	for (size_t index = 0; index < requestCount; index++)
+	{
+		plan.requests.push_back(ChunkCoord{requestCandidates[index].chunkX, requestCandidates[index].chunkZ});
+	}
+
+	int dropDistanceChunks = streamDistanceChunks;
+	if (optimizedBudgets)
+	{
+		dropDistanceChunks += input.classicStreamingPaddingChunks;
+	}
+	int dropRadiusSq = dropDistanceChunks * dropDistanceChunks;
+
+	for (int64_t key : streamedChunkKeys)
+	{
+		int cx = static_cast<int>(key >> 32);
+		int cz = static_cast<int>(key & 0xFFFFFFFF);
+		int dx = cx - centerChunkX;
+		int dz = cz - centerChunkZ;
+
+		if (dx * dx + dz * dz > dropRadiusSq || !canStreamChunk(input.hasWorldFrontier, frontier, cx, cz))
+		{
+			plan.drops.push_back(key);
+		}
+	}
+}
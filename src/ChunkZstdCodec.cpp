@@ -0,0 +1,187 @@
+#include <ChunkZstdCodec.h>
+
+#include <ChunkZstdDictionary.h>
+
+#include <zstd.h>
+#include <zstd_errors.h>
+
+#include <limits>
+#include <memory>
+
+namespace
+{
+	struct ThreadZstdContexts
+	{
+		ZSTD_CCtx *compression = nullptr;
+		ZSTD_DCtx *decompression = nullptr;
+
+		~ThreadZstdContexts()
+		{
+			ZSTD_freeCCtx(compression);
+			ZSTD_freeDCtx(decompression);
+		}
+	};
+
+	thread_local ThreadZstdContexts threadContexts;
+
+	ZSTD_CCtx *threadCompressionContext()
+	{
+		if (threadContexts.compression == nullptr)
+		{
+			threadContexts.compression = ZSTD_createCCtx();
+		}
+		return threadContexts.compression;
+	}
+
+	ZSTD_DCtx *threadDecompressionContext()
+	{
+		if (threadContexts.decompression == nullptr)
+		{
+			threadContexts.decompression = ZSTD_createDCtx();
+		}
+		return threadContexts.decompression;
+	}
+
+	size_t zstdErrorCode(ZSTD_ErrorCode code)
+	{
+		return static_cast<size_t>(0) - static_cast<size_t>(code);
+	}
+}
+
+size_t compressChunkZstd(void *destination,
+						 size_t destinationCapacity,
+						 const void *source,
+						 size_t sourceSize,
+						 int compressionLevel)
+{
+	std::shared_ptr<const ChunkZstdDictionary> dictionary = activeChunkZstdDictionary();
+	return compressChunkZstd(
+		destination,
+		destinationCapacity,
+		source,
+		sourceSize,
+		compressionLevel,
+		dictionary.get());
+}
+
+size_t compressChunkZstd(void *destination,
+						 size_t destinationCapacity,
+						 const void *source,
+						 size_t sourceSize,
+						 int compressionLevel,
+						 const ChunkZstdDictionary *dictionary)
+{
+	ZSTD_CCtx *context = threadCompressionContext();
+	if (context == nullptr)
+	{
+		return zstdErrorCode(ZSTD_error_memory_allocation);
+	}
+	if (dictionary == nullptr)
+	{
+		return ZSTD_compressCCtx(
+			context,
+			destination,
+			destinationCapacity,
+			source,
+			sourceSize,
+			compressionLevel);
+	}
+
+	const ZSTD_CDict *compressionDictionary = dictionary->compressionDictionary(compressionLevel);
+	if (compressionDictionary == nullptr)
+	{
+		return zstdErrorCode(ZSTD_error_dictionaryCreation_failed);
+	}
+	return ZSTD_compress_usingCDict(
+		context,
+		destination,
+		destinationCapacity,
+		source,
+		sourceSize,
+		compressionDictionary);
+}
+
+size_t decompressChunkZstd(void *destination,
+						   size_t destinationCapacity,
+						   const void *source,
+						   size_t sourceSize)
+{
+	ZSTD_DCtx *context = threadDecompressionContext();
+	if (context == nullptr)
+	{
+		return zstdErrorCode(ZSTD_error_memory_allocation);
+	}
+
+	uint32_t dictionaryId = ZSTD_getDictID_fromFrame(source, sourceSize);
+	if (dictionaryId == 0)
+	{
+		return ZSTD_decompressDCtx(context, destination, destinationCapacity, source, sourceSize);
+	}
+
+	std::shared_ptr<const ChunkZstdDictionary> dictionary = findChunkZstdDictionary(dictionaryId);
+	if (dictionary == nullptr)
+	{
+		return zstdErrorCode(ZSTD_error_dictionary_wrong);
+	}
+	return ZSTD_decompress_usingDDict(
+		context,
+		destination,
+		destinationCapacity,
+		source,
+		sourceSize,
+		dictionary->decompressionDictionary());
+}
+
+bool compressChunkZstdInto(const void *source,
+						   size_t sourceSize,
+						   int compressionLevel,
+						   std::vector<uint8_t> &output)
+{
+	output.resize(ZSTD_compressBound(sourceSize));
+	size_t compressedSize = compressChunkZstd(
+		output.data(),
+		output.size(),
+		source,
+		sourceSize,
+		compressionLevel);
+	if (ZSTD_isError(compressedSize))
+	{
+		output.clear();
+		return false;
+	}
+	output.resize(compressedSize);
+	return true;
+}
+
+bool decompressChunkZstdInto(const void *source,
+							 size_t sourceSize,
+							 size_t expectedSize,
+							 std::vector<uint8_t> &output)
+{
+	if (expectedSize == 0)
+	{
+		unsigned long long frameContentSize = ZSTD_getFrameContentSize(source, sourceSize);
+		if (frameContentSize == ZSTD_CONTENTSIZE_ERROR ||
+			frameContentSize == ZSTD_CONTENTSIZE_UNKNOWN ||
+			frameContentSize == 0 ||
+			frameContentSize > static_cast<unsigned long long>(std::numeric_limits<size_t>::max()))
+		{
+			output.clear();
+			return false;
+		}
+		expectedSize = static_cast<size_t>(frameContentSize);
+	}
+
+	output.resize(expectedSize);
+	size_t result = decompressChunkZstd(
+		output.data(),
+		output.size(),
+		source,
+		sourceSize);
+	if (ZSTD_isError(result) || result != expectedSize)
+	{
+		output.clear();
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,172 @@
+#include <ChunkZstdDictionary.h>
+
+#include <zdict.h>
+
+#include <unordered_map>
+#include <utility>
+
+namespace
+{
+	std::mutex registryMutex;
+	std::unordered_map<uint32_t, std::shared_ptr<const ChunkZstdDictionary>> registeredDictionaries;
+	std::shared_ptr<const ChunkZstdDictionary> activeDictionary;
+}
+
+ChunkZstdDictionary::~ChunkZstdDictionary()
+{
+	for (auto &[level, compressionDictionary] : m_compressionDictionaries)
+	{
+		ZSTD_freeCDict(compressionDictionary);
+	}
+	if (m_decompressionDictionary != nullptr)
+	{
+		ZSTD_freeDDict(m_decompressionDictionary);
+	}
+}
+
+std::shared_ptr<const ChunkZstdDictionary> ChunkZstdDictionary::create(std::vector<uint8_t> content,
+																	   std::string *errorMessage)
+{
+	uint32_t id = ZSTD_getDictID_fromDict(content.data(), content.size());
+	if (content.empty() || id == 0)
+	{
+		if (errorMessage != nullptr)
+		{
+			*errorMessage = "Chunk dictionary has no zstd dictionary id";
+		}
+		return nullptr;
+	}
+
+	std::shared_ptr<ChunkZstdDictionary> dictionary(new ChunkZstdDictionary());
+	dictionary->m_id = id;
+	dictionary->m_content = std::move(content);
+	dictionary->m_decompressionDictionary = ZSTD_createDDict(
+		dictionary->m_content.data(),
+		dictionary->m_content.size());
+	if (dictionary->m_decompressionDictionary == nullptr)
+	{
+		if (errorMessage != nullptr)
+		{
+			*errorMessage = "Failed to load chunk dictionary";
+		}
+		return nullptr;
+	}
+	return dictionary;
+}
+
+uint32_t ChunkZstdDictionary::id() const
+{
+	return m_id;
+}
+
+const std::vector<uint8_t> &ChunkZstdDictionary::content() const
+{
+	return m_content;
+}
+
+const ZSTD_CDict *ChunkZstdDictionary::compressionDictionary(int compressionLevel) const
+{
+	std::lock_guard<std::mutex> lock(m_compressionMutex);
+	auto it = m_compressionDictionaries.find(compressionLevel);
+	if (it != m_compressionDictionaries.end())
+	{
+		return it->second;
+	}
+
+	ZSTD_CDict *compressionDictionary = ZSTD_createCDict(
+		m_content.data(),
+		m_content.size(),
+		compressionLevel);
+	if (compressionDictionary == nullptr)
+	{
+		return nullptr;
+	}
+	m_compressionDictionaries.emplace(compressionLevel, compressionDictionary);
+	return compressionDictionary;
+}
+
+const ZSTD_DDict *ChunkZstdDictionary::decompressionDictionary() const
+{
+	return m_decompressionDictionary;
+}
+
+bool trainChunkZstdDictionary(const std::vector<std::vector<uint8_t>> &samples,
+							  size_t dictionaryCapacity,
+							  std::vector<uint8_t> &outContent,
+							  std::string &errorMessage)
+{
+	outContent.clear();
+	errorMessage.clear();
+	if (samples.empty() || dictionaryCapacity == 0)
+	{
+		errorMessage = "No samples to train a chunk dictionary";
+		return false;
+	}
+
+	std::vector<uint8_t> sampleBuffer;
+	std::vector<size_t> sampleSizes;
+	sampleSizes.reserve(samples.size());
+	for (const std::vector<uint8_t> &sample : samples)
+	{
+		if (sample.empty())
+		{
+			continue;
+		}
+		sampleBuffer.insert(sampleBuffer.end(), sample.begin(), sample.end());
+		sampleSizes.push_back(sample.size());
+	}
+	if (sampleSizes.empty())
+	{
+		errorMessage = "No samples to train a chunk dictionary";
+		return false;
+	}
+
+	outContent.resize(dictionaryCapacity);
+	size_t dictionarySize = ZDICT_trainFromBuffer(
+		outContent.data(),
+		outContent.size(),
+		sampleBuffer.data(),
+		sampleSizes.data(),
+		static_cast<unsigned>(sampleSizes.size()));
+	if (ZDICT_isError(dictionarySize))
+	{
+		errorMessage = "Failed to train chunk dictionary: ";
+		errorMessage += ZDICT_getErrorName(dictionarySize);
+		outContent.clear();
+		return false;
+	}
+	outContent.resize(dictionarySize);
+	return true;
+}
+
+void registerChunkZstdDictionary(std::shared_ptr<const ChunkZstdDictionary> dictionary, bool makeActive)
+{
+	if (dictionary == nullptr)
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(registryMutex);
+	if (makeActive)
+	{
+		activeDictionary = dictionary;
+	}
+	registeredDictionaries[dictionary->id()] = std::move(dictionary);
+}
+
+std::shared_ptr<const ChunkZstdDictionary> activeChunkZstdDictionary()
+{
+	std::lock_guard<std::mutex> lock(registryMutex);
+	return activeDictionary;
+}
+
+std::shared_ptr<const ChunkZstdDictionary> findChunkZstdDictionary(uint32_t id)
+{
+	std::lock_guard<std::mutex> lock(registryMutex);
+	auto it = registeredDictionaries.find(id);
+	if (it == registeredDictionaries.end())
+	{
+		return nullptr;
+	}
+	return it->second;
+}
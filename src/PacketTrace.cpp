@@ -0,0 +1,324 @@
+#include <PacketTrace.h>
+
+#include <WorldProtocol.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+namespace
+{
+	constexpr char PACKET_TRACE_MAGIC[7] = {'V', 'P', 'T', 'R', 'A', 'C', 'E'};
+	constexpr uint8_t PACKET_TRACE_VERSION = 1;
+	constexpr auto PACKET_TRACE_FLUSH_INTERVAL = std::chrono::seconds(1);
+	// Au-delà, un paquet reçu est forcément corrompu (ENet fragmente bien en dessous).
+	constexpr uint32_t PACKET_TRACE_MAX_PAYLOAD_BYTES = 16u * 1024u * 1024u;
+
+	template <typename T>
+	void writeValue(std::ofstream &file, const T &value)
+	{
+		file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+	}
+
+	template <typename T>
+	bool readValue(std::ifstream &file, T &value)
+	{
+		file.read(reinterpret_cast<char *>(&value), sizeof(T));
+		return file.gcount() == static_cast<std::streamsize>(sizeof(T));
+	}
+
+	template <typename Message>
+	void setMessagePassword(Message &message, const std::string &password)
+	{
+		std::fill(std::begin(message.password), std::end(message.password), '\0');
+		size_t length = std::min(password.size(), PLAYER_PASSWORD_MAX_LENGTH);
+		std::memcpy(message.password, password.data(), length);
+	}
+
+	bool rewritePassword(const uint8_t *data, size_t size, const std::string &password, std::vector<uint8_t> &output)
+	{
+		if (size == 0)
+		{
+			return false;
+		}
+		PacketType type = static_cast<PacketType>(data[0]);
+		if (type == PacketType::LoginRequest)
+		{
+			LoginRequestMessage message;
+			if (!decodeLoginRequest(data, size, message))
+			{
+				return false;
+			}
+			setMessagePassword(message, password);
+			output = encodeLoginRequest(message);
+			return true;
+		}
+		if (type == PacketType::AccountDeleteRequest)
+		{
+			AccountDeleteRequestMessage message;
+			if (!decodeAccountDeleteRequest(data, size, message))
+			{
+				return false;
+			}
+			setMessagePassword(message, password);
+			output = encodeAccountDeleteRequest(message);
+			return true;
+		}
+		return false;
+	}
+
+	bool carriesPassword(const uint8_t *data, size_t size)
+	{
+		if (size == 0)
+		{
+			return false;
+		}
+		PacketType type = static_cast<PacketType>(data[0]);
+		return type == PacketType::LoginRequest || type == PacketType::AccountDeleteRequest;
+	}
+}
+
+PacketTraceWriter::~PacketTraceWriter()
+{
+	close();
+}
+
+bool PacketTraceWriter::open(const std::string &path)
+{
+	close();
+	m_lastError.clear();
+	m_file.open(path, std::ios::binary | std::ios::trunc);
+	if (!m_file.is_open())
+	{
+		m_lastError = "Failed to open packet trace: " + path;
+		return false;
+	}
+
+	m_openedAt = std::chrono::steady_clock::now();
+	m_lastFlushAt = m_openedAt;
+	m_lastTimeUs = 0;
+	m_nextSessionId = 1;
+	m_recordCount = 0;
+	uint64_t startedAtMs = static_cast<uint64_t>(
+		std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::system_clock::now().time_since_epoch())
+			.count());
+	m_file.write(PACKET_TRACE_MAGIC, sizeof(PACKET_TRACE_MAGIC));
+	writeValue(m_file, PACKET_TRACE_VERSION);
+	writeValue(m_file, startedAtMs);
+	m_file.flush();
+	if (!m_file)
+	{
+		m_lastError = "Failed to write packet trace header: " + path;
+		m_file.close();
+		return false;
+	}
+	return true;
+}
+
+void PacketTraceWriter::close()
+{
+	if (m_file.is_open())
+	{
+		m_file.flush();
+		m_file.close();
+	}
+}
+
+bool PacketTraceWriter::isOpen() const
+{
+	return m_file.is_open();
+}
+
+uint32_t PacketTraceWriter::recordConnect()
+{
+	uint32_t sessionId = m_nextSessionId++;
+	if (!writeRecord(PacketTraceRecordKind::Connect, sessionId, 0, nullptr, 0))
+	{
+		return 0;
+	}
+	return sessionId;
+}
+
+bool PacketTraceWriter::recordDisconnect(uint32_t sessionId)
+{
+	return writeRecord(PacketTraceRecordKind::Disconnect, sessionId, 0, nullptr, 0);
+}
+
+bool PacketTraceWriter::recordPacket(uint32_t sessionId, uint8_t channel, const uint8_t *data, size_t size)
+{
+	if (carriesPassword(data, size))
+	{
+		// Illisible = pas de mot de passe à retirer sûrement: on ne l'écrit pas du tout.
+		if (!rewritePassword(data, size, std::string(), m_redacted))
+		{
+			return true;
+		}
+		data = m_redacted.data();
+		size = m_redacted.size();
+	}
+	if (size > PACKET_TRACE_MAX_PAYLOAD_BYTES)
+	{
+		return true;
+	}
+	return writeRecord(PacketTraceRecordKind::Packet, sessionId, channel, data, size);
+}
+
+uint64_t PacketTraceWriter::recordCount() const
+{
+	return m_recordCount;
+}
+
+const std::string &PacketTraceWriter::lastError() const
+{
+	return m_lastError;
+}
+
+bool PacketTraceWriter::writeRecord(PacketTraceRecordKind kind,
+									uint32_t sessionId,
+									uint8_t channel,
+									const uint8_t *data,
+									size_t size)
+{
+	if (!m_file.is_open())
+	{
+		return false;
+	}
+
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	uint64_t timeUs = static_cast<uint64_t>(
+		std::chrono::duration_cast<std::chrono::microseconds>(now - m_openedAt).count());
+	// Un silence de plus de 71 minutes est raccourci: le rejeu n'y perd rien d'utile.
+	uint32_t deltaUs = static_cast<uint32_t>(std::min<uint64_t>(
+		timeUs - m_lastTimeUs, std::numeric_limits<uint32_t>::max()));
+	m_lastTimeUs = timeUs;
+
+	writeValue(m_file, kind);
+	writeValue(m_file, channel);
+	writeValue(m_file, sessionId);
+	writeValue(m_file, deltaUs);
+	if (kind == PacketTraceRecordKind::Packet)
+	{
+		writeValue(m_file, static_cast<uint32_t>(size));
+		m_file.write(reinterpret_cast<const char *>(data), static_cast<std::streamsize>(size));
+	}
+	if (now - m_lastFlushAt >= PACKET_TRACE_FLUSH_INTERVAL)
+	{
+		m_file.flush();
+		m_lastFlushAt = now;
+	}
+	if (!m_file)
+	{
+		m_lastError = "Failed to write packet trace record";
+		return false;
+	}
+	m_recordCount++;
+	return true;
+}
+
+bool PacketTraceReader::open(const std::string &path)
+{
+	m_lastError.clear();
+	m_timeUs = 0;
+	m_file.open(path, std::ios::binary);
+	if (!m_file.is_open())
+	{
+		m_lastError = "Failed to open packet trace: " + path;
+		return false;
+	}
+
+	char magic[sizeof(PACKET_TRACE_MAGIC)] = {};
+	uint8_t version = 0;
+	m_file.read(magic, sizeof(magic));
+	if (m_file.gcount() != static_cast<std::streamsize>(sizeof(magic)) ||
+		std::memcmp(magic, PACKET_TRACE_MAGIC, sizeof(magic)) != 0)
+	{
+		m_lastError = "Not a packet trace: " + path;
+		return false;
+	}
+	if (!readValue(m_file, version) || version != PACKET_TRACE_VERSION)
+	{
+		m_lastError = "Unsupported packet trace version";
+		return false;
+	}
+	if (!readValue(m_file, m_startedAtMs))
+	{
+		m_lastError = "Truncated packet trace header";
+		return false;
+	}
+	return true;
+}
+
+bool PacketTraceReader::next(PacketTraceRecord &record)
+{
+	uint8_t kind = 0;
+	if (!readValue(m_file, kind))
+	{
+		// Fin propre: rien de lu. Sinon l'enregistrement est coupé en plein milieu.
+		if (m_file.gcount() != 0)
+		{
+			m_lastError = "Truncated packet trace record";
+		}
+		return false;
+	}
+
+	uint32_t deltaUs = 0;
+	if (kind < static_cast<uint8_t>(PacketTraceRecordKind::Connect) ||
+		kind > static_cast<uint8_t>(PacketTraceRecordKind::Packet))
+	{
+		m_lastError = "Invalid packet trace record kind";
+		return false;
+	}
+	if (!readValue(m_file, record.channel) ||
+		!readValue(m_file, record.sessionId) ||
+		!readValue(m_file, deltaUs))
+	{
+		m_lastError = "Truncated packet trace record";
+		return false;
+	}
+	record.kind = static_cast<PacketTraceRecordKind>(kind);
+	m_timeUs += deltaUs;
+	record.timeUs = m_timeUs;
+	record.payload.clear();
+	if (record.kind != PacketTraceRecordKind::Packet)
+	{
+		return true;
+	}
+
+	uint32_t size = 0;
+	if (!readValue(m_file, size) || size > PACKET_TRACE_MAX_PAYLOAD_BYTES)
+	{
+		m_lastError = "Invalid packet trace payload size";
+		return false;
+	}
+	record.payload.resize(size);
+	m_file.read(reinterpret_cast<char *>(record.payload.data()), static_cast<std::streamsize>(size));
+	if (m_file.gcount() != static_cast<std::streamsize>(size))
+	{
+		m_lastError = "Truncated packet trace payload";
+		return false;
+	}
+	return true;
+}
+
+uint64_t PacketTraceReader::startedAtMs() const
+{
+	return m_startedAtMs;
+}
+
+const std::string &PacketTraceReader::lastError() const
+{
+	return m_lastError;
+}
+
+bool replacePacketTracePassword(std::vector<uint8_t> &payload, const std::string &password)
+{
+	std::vector<uint8_t> rewritten;
+	if (!rewritePassword(payload.data(), payload.size(), password, rewritten))
+	{
+		return false;
+	}
+	payload = std::move(rewritten);
+	return true;
+}
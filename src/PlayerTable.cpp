@@ -5,6 +5,7 @@
 #include <chrono>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 namespace
 {
@@ -45,6 +46,8 @@ bool PlayerTable::open(const std::string &databasePath)
 		close();
 		return false;
 	}
+	// Le serveur ouvre deux connexions (simulation et authentification): un écrivain attend l'autre.
+	sqlite3_busy_timeout(m_db, 2000);
 
 	const char *schemaSql =
 		"CREATE TABLE IF NOT EXISTS player_table ("
@@ -104,12 +107,18 @@ bool PlayerTable::open(const std::string &databasePath)
 	{
 		return false;
 	}
+	if (!prepareStatements())
+	{
+		close();
+		return false;
+	}
 
 	return true;
 }
 
 void PlayerTable::close()
 {
+	finalizeStatements();
 	if (m_db != nullptr)
 	{
 		sqlite3_close(m_db);
@@ -139,20 +148,12 @@ bool PlayerTable::loadPlayerAuthByUsername(const std::string &username,
 		return false;
 	}
 
-	const char *sql =
-		"SELECT id, username, skin_id, position_x, position_y, position_z, block_action_ready_at_ms, password_hash, is_admin "
-		"FROM player_table WHERE username = ?1;";
-
-	sqlite3_stmt *statement = nullptr;
-	if (!prepareStatement(sql, &statement))
-	{
-		return false;
-	}
+	sqlite3_stmt *statement = m_loadStatement;
 
 	if (sqlite3_bind_text(statement, 1, username.c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK)
 	{
 		setLastErrorFromDatabase("Failed to bind username for player load");
-		sqlite3_finalize(statement);
+		resetStatement(statement);
 		return false;
 	}
 
@@ -185,13 +186,13 @@ bool PlayerTable::loadPlayerAuthByUsername(const std::string &username,
 			passwordHash.clear();
 		}
 		player.profile.admin = sqlite3_column_int(statement, 8) != 0;
-		sqlite3_finalize(statement);
+		resetStatement(statement);
 		return true;
 	}
 
 	if (stepResult == SQLITE_DONE)
 	{
-		sqlite3_finalize(statement);
+		resetStatement(statement);
 		return false;
 	}
 
@@ -200,7 +201,7 @@ bool PlayerTable::loadPlayerAuthByUsername(const std::string &username,
 		setLastErrorFromDatabase("Failed to read player row");
 	}
 
-	sqlite3_finalize(statement);
+	resetStatement(statement);
 	return false;
 }
 
@@ -215,15 +216,7 @@ bool PlayerTable::createPlayer(const std::string &username,
 		return false;
 	}
 
-	const char *sql =
-		"INSERT INTO player_table (username, skin_id, position_x, position_y, position_z, block_action_ready_at_ms, password_hash, created_at_ms, updated_at_ms) "
-		"VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9);";
-
-	sqlite3_stmt *statement = nullptr;
-	if (!prepareStatement(sql, &statement))
-	{
-		return false;
-	}
+	sqlite3_stmt *statement = m_createStatement;
 
 	player.profile.username = username;
 	player.profile.skinId = 0;
@@ -246,19 +239,19 @@ bool PlayerTable::createPlayer(const std::string &username,
 		|| sqlite3_bind_int64(statement, 9, static_cast<sqlite3_int64>(nowMs)) != SQLITE_OK)
 	{
 		setLastErrorFromDatabase("Failed to bind player creation statement");
-		sqlite3_finalize(statement);
+		resetStatement(statement);
 		return false;
 	}
 
 	if (sqlite3_step(statement) != SQLITE_DONE)
 	{
 		setLastErrorFromDatabase("Failed to insert new player");
-		sqlite3_finalize(statement);
+		resetStatement(statement);
 		return false;
 	}
 
 	player.profile.playerId = static_cast<uint64_t>(sqlite3_last_insert_rowid(m_db));
-	sqlite3_finalize(statement);
+	resetStatement(statement);
 	return true;
 }
 
@@ -299,14 +292,7 @@ bool PlayerTable::updatePasswordHash(uint64_t playerId, const std::string &passw
 		return false;
 	}
 
-	const char *sql =
-		"UPDATE player_table SET password_hash = ?1, updated_at_ms = ?2 WHERE id = ?3;";
-
-	sqlite3_stmt *statement = nullptr;
-	if (!prepareStatement(sql, &statement))
-	{
-		return false;
-	}
+	sqlite3_stmt *statement = m_updatePasswordStatement;
 
 	uint64_t nowMs = systemNowMs();
 	if (sqlite3_bind_text(statement, 1, passwordHash.c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK
@@ -314,18 +300,18 @@ bool PlayerTable::updatePasswordHash(uint64_t playerId, const std::string &passw
 		|| sqlite3_bind_int64(statement, 3, static_cast<sqlite3_int64>(playerId)) != SQLITE_OK)
 	{
 		setLastErrorFromDatabase("Failed to bind password hash update");
-		sqlite3_finalize(statement);
+		resetStatement(statement);
 		return false;
 	}
 
 	if (sqlite3_step(statement) != SQLITE_DONE)
 	{
 		setLastErrorFromDatabase("Failed to update password hash");
-		sqlite3_finalize(statement);
+		resetStatement(statement);
 		return false;
 	}
 
-	sqlite3_finalize(statement);
+	resetStatement(statement);
 	return true;
 }
 
@@ -343,14 +329,7 @@ bool PlayerTable::updateAdminFlag(uint64_t playerId, bool admin)
 		return false;
 	}
 
-	const char *sql =
-		"UPDATE player_table SET is_admin = ?1, updated_at_ms = ?2 WHERE id = ?3;";
-
-	sqlite3_stmt *statement = nullptr;
-	if (!prepareStatement(sql, &statement))
-	{
-		return false;
-	}
+	sqlite3_stmt *statement = m_updateAdminStatement;
 
 	uint64_t nowMs = systemNowMs();
 	if (sqlite3_bind_int(statement, 1, sqliteBool(admin)) != SQLITE_OK
@@ -358,18 +337,18 @@ bool PlayerTable::updateAdminFlag(uint64_t playerId, bool admin)
 		|| sqlite3_bind_int64(statement, 3, static_cast<sqlite3_int64>(playerId)) != SQLITE_OK)
 	{
 		setLastErrorFromDatabase("Failed to bind admin flag update");
-		sqlite3_finalize(statement);
+		resetStatement(statement);
 		return false;
 	}
 
 	if (sqlite3_step(statement) != SQLITE_DONE)
 	{
 		setLastErrorFromDatabase("Failed to update admin flag");
-		sqlite3_finalize(statement);
+		resetStatement(statement);
 		return false;
 	}
 
-	sqlite3_finalize(statement);
+	resetStatement(statement);
 	return true;
 }
 
@@ -387,25 +366,20 @@ bool PlayerTable::deletePlayer(uint64_t playerId)
 		return false;
 	}
 
-	const char *sql = "DELETE FROM player_table WHERE id = ?1;";
-	sqlite3_stmt *statement = nullptr;
-	if (!prepareStatement(sql, &statement))
-	{
-		return false;
-	}
+	sqlite3_stmt *statement = m_deleteStatement;
 	if (sqlite3_bind_int64(statement, 1, static_cast<sqlite3_int64>(playerId)) != SQLITE_OK)
 	{
 		setLastErrorFromDatabase("Failed to bind player delete");
-		sqlite3_finalize(statement);
+		resetStatement(statement);
 		return false;
 	}
 	if (sqlite3_step(statement) != SQLITE_DONE)
 	{
 		setLastErrorFromDatabase("Failed to delete player");
-		sqlite3_finalize(statement);
+		resetStatement(statement);
 		return false;
 	}
-	sqlite3_finalize(statement);
+	resetStatement(statement);
 	return true;
 }
 
@@ -422,21 +396,77 @@ bool PlayerTable::savePlayer(const Player &player)
 		m_lastError = "Cannot save player with invalid id";
 		return false;
 	}
+	return writePlayerRow(player, systemNowMs());
+}
 
-	const char *sql =
-		"UPDATE player_table "
-		"SET username = ?1, skin_id = ?2, position_x = ?3, position_y = ?4, position_z = ?5, "
-		"block_action_ready_at_ms = ?6, is_admin = ?7, updated_at_ms = ?8 "
-		"WHERE id = ?9;";
-
-	sqlite3_stmt *statement = nullptr;
-	if (!prepareStatement(sql, &statement))
+bool PlayerTable::savePlayers(const std::vector<Player> &players)
+{
+	m_lastError.clear();
+	if (!isOpen())
 	{
+		m_lastError = "Player database is not open";
 		return false;
 	}
+	if (players.empty())
+	{
+		return true;
+	}
 
+	// Une seule transaction: un fsync du WAL pour tout le lot au lieu d'un par joueur.
+	if (!executeStatement("BEGIN IMMEDIATE;"))
+	{
+		return false;
+	}
 	uint64_t nowMs = systemNowMs();
+	for (const Player &player : players)
+	{
+		if (player.profile.playerId == 0)
+		{
+			continue;
+		}
+		if (!writePlayerRow(player, nowMs))
+		{
+			std::string error = m_lastError;
+			executeStatement("ROLLBACK;");
+			m_lastError = error;
+			return false;
+		}
+	}
+	if (!executeStatement("COMMIT;"))
+	{
+		std::string error = m_lastError;
+		executeStatement("ROLLBACK;");
+		m_lastError = error;
+		return false;
+	}
+	return true;
+}
+
+const std::string &PlayerTable::lastError() const
+{
+	return m_lastError;
+}
 
+bool PlayerTable::executeStatement(const char *sql)
+{
+	char *errorMessage = nullptr;
+	if (sqlite3_exec(m_db, sql, nullptr, nullptr, &errorMessage) != SQLITE_OK)
+	{
+		m_lastError = "Failed to execute SQL statement";
+		if (errorMessage != nullptr)
+		{
+			m_lastError += ": ";
+			m_lastError += errorMessage;
+			sqlite3_free(errorMessage);
+		}
+		return false;
+	}
+	return true;
+}
+
+bool PlayerTable::writePlayerRow(const Player &player, uint64_t nowMs)
+{
+	sqlite3_stmt *statement = m_saveStatement;
 	if (sqlite3_bind_text(statement, 1, player.profile.username.c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK
 		|| sqlite3_bind_int(statement, 2, static_cast<int>(player.profile.skinId)) != SQLITE_OK
 		|| sqlite3_bind_double(statement, 3, static_cast<double>(player.state.position.x)) != SQLITE_OK
@@ -448,41 +478,72 @@ bool PlayerTable::savePlayer(const Player &player)
 		|| sqlite3_bind_int64(statement, 9, static_cast<sqlite3_int64>(player.profile.playerId)) != SQLITE_OK)
 	{
 		setLastErrorFromDatabase("Failed to bind player save statement");
-		sqlite3_finalize(statement);
+		resetStatement(statement);
 		return false;
 	}
 
 	if (sqlite3_step(statement) != SQLITE_DONE)
 	{
 		setLastErrorFromDatabase("Failed to update player");
-		sqlite3_finalize(statement);
+		resetStatement(statement);
 		return false;
 	}
 
-	sqlite3_finalize(statement);
+	resetStatement(statement);
 	return true;
 }
 
-const std::string &PlayerTable::lastError() const
+bool PlayerTable::prepareStatements()
 {
-	return m_lastError;
+	const char *loadSql =
+		"SELECT id, username, skin_id, position_x, position_y, position_z, block_action_ready_at_ms, password_hash, is_admin "
+		"FROM player_table WHERE username = ?1;";
+	const char *createSql =
+		"INSERT INTO player_table (username, skin_id, position_x, position_y, position_z, block_action_ready_at_ms, password_hash, created_at_ms, updated_at_ms) "
+		"VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9);";
+	const char *updatePasswordSql =
+		"UPDATE player_table SET password_hash = ?1, updated_at_ms = ?2 WHERE id = ?3;";
+	const char *updateAdminSql =
+		"UPDATE player_table SET is_admin = ?1, updated_at_ms = ?2 WHERE id = ?3;";
+	const char *deleteSql = "DELETE FROM player_table WHERE id = ?1;";
+	const char *saveSql =
+		"UPDATE player_table "
+		"SET username = ?1, skin_id = ?2, position_x = ?3, position_y = ?4, position_z = ?5, "
+		"block_action_ready_at_ms = ?6, is_admin = ?7, updated_at_ms = ?8 "
+		"WHERE id = ?9;";
+
+	return prepareStatement(loadSql, &m_loadStatement)
+		&& prepareStatement(createSql, &m_createStatement)
+		&& prepareStatement(updatePasswordSql, &m_updatePasswordStatement)
+		&& prepareStatement(updateAdminSql, &m_updateAdminStatement)
+		&& prepareStatement(deleteSql, &m_deleteStatement)
+		&& prepareStatement(saveSql, &m_saveStatement);
 }
 
-bool PlayerTable::executeStatement(const char *sql)
+void PlayerTable::finalizeStatements()
 {
-	char *errorMessage = nullptr;
-	if (sqlite3_exec(m_db, sql, nullptr, nullptr, &errorMessage) != SQLITE_OK)
-	{
-		m_lastError = "Failed to execute SQL statement";
-		if (errorMessage != nullptr)
+	sqlite3_stmt **statements[] = {
+		&m_loadStatement,
+		&m_createStatement,
+		&m_updatePasswordStatement,
+		&m_updateAdminStatement,
+		&m_deleteStatement,
+		&m_saveStatement,
+	};
+	for (sqlite3_stmt **statement : statements)
+	{
+		if (*statement != nullptr)
 		{
-			m_lastError += ": ";
-			m_lastError += errorMessage;
-			sqlite3_free(errorMessage);
+			sqlite3_finalize(*statement);
+			*statement = nullptr;
 		}
-		return false;
 	}
-	return true;
+}
+
+void PlayerTable::resetStatement(sqlite3_stmt *statement)
+{
+	sqlite3_reset(statement);
+	sqlite3_clear_bindings(statement);
 }
 
 bool PlayerTable::prepareStatement(const char *sql, sqlite3_stmt **statement)
@@ -1,4 +1,5 @@
 #include <WorldClient.h>
+#include <ChunkZstdDictionary.h>
 
 #include <PlayerState.h>
 #include <PlayerUsername.h>
@@ -58,8 +59,10 @@ struct WorldClient::Impl
 		bool localPlayerAdmin = false;
 		bool blockCooldownDisabled = false;
 		Player localPlayer;
+	std::unordered_map<uint16_t, RemotePlayer> remotePlayers;
 	std::string lastConnectionError;
 	int64_t serverTimeOffsetMs = 0;
+	uint64_t receivedPayloadBytes = 0;
 
 	uint64_t estimatedServerNowMs() const
 	{
@@ -112,6 +115,66 @@ struct WorldClient::Impl
 		int64_t serverNow = static_cast<int64_t>(message.serverNowMs);
 		serverTimeOffsetMs = serverNow - localNow;
 	}
+
+	void applyRemotePlayerBatch(const RemotePlayerBatchMessage &message)
+	{
+		for (const RemotePlayerUpdate &update : message.updates)
+		{
+			if ((update.flags & REMOTE_PLAYER_DESPAWN) != 0)
+			{
+				remotePlayers.erase(update.replicationId);
+				continue;
+			}
+
+			RemotePlayer *remotePlayer = nullptr;
+			if ((update.flags & REMOTE_PLAYER_SPAWN) != 0)
+			{
+				remotePlayer = &remotePlayers[update.replicationId];
+				*remotePlayer = RemotePlayer{};
+				remotePlayer->playerId = update.playerId;
+				remotePlayer->username = update.username;
+				remotePlayer->skinId = update.skinId;
+			}
+			else
+			{
+				auto remoteIt = remotePlayers.find(update.replicationId);
+				if (remoteIt == remotePlayers.end())
+				{
+					continue;
+				}
+				remotePlayer = &remoteIt->second;
+			}
+
+			QuantizedPlayerTransform &transform = remotePlayer->transform;
+			if ((update.flags & REMOTE_PLAYER_POSITION) != 0)
+			{
+				transform.positionX = update.transform.positionX;
+				transform.positionY = update.transform.positionY;
+				transform.positionZ = update.transform.positionZ;
+			}
+			else if ((update.flags & REMOTE_PLAYER_POSITION_DELTA) != 0)
+			{
+				transform.positionX += update.deltaX;
+				transform.positionY += update.deltaY;
+				transform.positionZ += update.deltaZ;
+			}
+			if ((update.flags & REMOTE_PLAYER_LOOK) != 0)
+			{
+				transform.yaw = update.transform.yaw;
+				transform.pitch = update.transform.pitch;
+			}
+			dequantizePlayerPosition(
+				transform,
+				remotePlayer->position.x,
+				remotePlayer->position.y,
+				remotePlayer->position.z);
+			dequantizePlayerLook(
+				transform,
+				remotePlayer->lookDirection.x,
+				remotePlayer->lookDirection.y,
+				remotePlayer->lookDirection.z);
+		}
+	}
 };
 
 WorldClient::WorldClient()
@@ -279,6 +342,10 @@ bool WorldClient::connectToServer(const std::string &hostName,
 							{
 								m_impl->lastConnectionError = "Invalid username/password";
 							}
+							else if (response.status == LoginStatus::ServerBusy)
+							{
+								m_impl->lastConnectionError = "Server busy, try again";
+							}
 							else
 							{
 								m_impl->lastConnectionError = "Login rejected";
@@ -436,6 +503,10 @@ bool WorldClient::deleteUserOnServer(const std::string &hostName,
 					{
 						m_impl->lastConnectionError = "Server failed to delete user";
 					}
+					else if (response.status == AccountDeleteStatus::ServerBusy)
+					{
+						m_impl->lastConnectionError = "Server busy, try again";
+					}
 					else
 					{
 						m_impl->lastConnectionError = "Invalid username/password";
@@ -489,6 +560,7 @@ void WorldClient::disconnect()
 	m_impl->peer = nullptr;
 	m_impl->connected = false;
 	m_impl->localPlayer = Player{};
+	m_impl->remotePlayers.clear();
 	m_impl->localPlayerAdmin = false;
 	m_impl->blockCooldownDisabled = false;
 	m_impl->serverTimeOffsetMs = 0;
@@ -511,6 +583,7 @@ void WorldClient::service()
 
 		if (event.type == ENET_EVENT_TYPE_RECEIVE)
 		{
+			m_impl->receivedPayloadBytes += event.packet->dataLength;
 			handlePacket(event.packet->data, event.packet->dataLength);
 			enet_packet_destroy(event.packet);
 			continue;
@@ -519,6 +592,7 @@ void WorldClient::service()
 		{
 			m_impl->peer = nullptr;
 			m_impl->connected = false;
+			m_impl->remotePlayers.clear();
 			m_impl->localPlayerAdmin = false;
 			m_impl->blockCooldownDisabled = false;
 			pushEvent(WorldClientEvent{WorldClientEvent::Type::Disconnected});
@@ -557,11 +631,21 @@ uint32_t WorldClient::getRoundTripTime() const
 	return 0;
 }
 
+uint64_t WorldClient::receivedPayloadBytes() const
+{
+	return m_impl->receivedPayloadBytes;
+}
+
 const Player &WorldClient::localPlayer() const
 {
 	return m_impl->localPlayer;
 }
 
+const std::unordered_map<uint16_t, RemotePlayer> &WorldClient::remotePlayers() const
+{
+	return m_impl->remotePlayers;
+}
+
 uint64_t WorldClient::remainingBlockActionCooldownMs() const
 {
 	if (m_impl->blockCooldownDisabled)
@@ -601,6 +685,23 @@ void WorldClient::sendChunkRequest(int chunkX, int chunkZ)
 	enet_peer_send(m_impl->peer, WORLD_CHANNEL_CHUNK, packet);
 }
 
+void WorldClient::sendChunkRequest(int chunkX, int chunkZ, uint64_t knownRevision)
+{
+	if (!m_impl->connected || m_impl->peer == nullptr)
+	{
+		return;
+	}
+
+	ChunkRequestMessage message;
+	message.chunkX = chunkX;
+	message.chunkZ = chunkZ;
+	message.hasKnownRevision = true;
+	message.knownRevision = knownRevision;
+	std::vector<uint8_t> payload = encodeChunkRequest(message);
+	ENetPacket *packet = enet_packet_create(payload.data(), payload.size(), ENET_PACKET_FLAG_RELIABLE);
+	enet_peer_send(m_impl->peer, WORLD_CHANNEL_CHUNK, packet);
+}
+
 void WorldClient::sendChunkDrop(int chunkX, int chunkZ)
 {
 	if (!m_impl->connected || m_impl->peer == nullptr)
@@ -764,6 +865,18 @@ void WorldClient::handlePacket(const uint8_t *data, size_t size)
 		return;
 	}
 
+	if (type == PacketType::RemotePlayerBatch)
+	{
+		RemotePlayerBatchMessage message;
+		if (!decodeRemotePlayerBatch(data, size, message))
+		{
+			return;
+		}
+		m_impl->applyRemotePlayerBatch(message);
+		pushEvent(WorldClientEvent{WorldClientEvent::Type::RemotePlayersUpdated});
+		return;
+	}
+
 	if (type == PacketType::WorldFrontier)
 	{
 		WorldFrontier frontier;
@@ -781,7 +894,8 @@ void WorldClient::handlePacket(const uint8_t *data, size_t size)
 	if (type == PacketType::ChunkSnapshot ||
 		type == PacketType::ChunkSnapshotRle ||
 		type == PacketType::ChunkSnapshotSections ||
-		type == PacketType::ChunkSnapshotSectionsZstd)
+		type == PacketType::ChunkSnapshotSectionsZstd ||
+		type == PacketType::ChunkSnapshotSectionFrames)
 	{
 		DecodedChunkSnapshot snapshot;
 		if (!decodeChunkSnapshot(data, size, snapshot))
@@ -795,6 +909,38 @@ void WorldClient::handlePacket(const uint8_t *data, size_t size)
 		return;
 	}
 
+	if (type == PacketType::ChunkZstdDictionary)
+	{
+		ChunkZstdDictionaryMessage message;
+		if (!decodeChunkZstdDictionary(data, size, message))
+		{
+			return;
+		}
+		std::string dictionaryError;
+		std::shared_ptr<const ChunkZstdDictionary> dictionary =
+			ChunkZstdDictionary::create(std::move(message.content), &dictionaryError);
+		if (dictionary == nullptr || dictionary->id() != message.dictionaryId)
+		{
+			std::cerr << "Ignoring invalid chunk dictionary from server" << std::endl;
+			return;
+		}
+		// Le client ne compresse pas de chunks: il suffit que l'id soit connu du décodeur.
+		registerChunkZstdDictionary(std::move(dictionary), false);
+		return;
+	}
+
+	if (type == PacketType::ChunkSectionDelta)
+	{
+		WorldClientEvent event;
+		event.type = WorldClientEvent::Type::ChunkDeltaReceived;
+		if (!decodeChunkSectionDelta(data, size, event.chunkDelta))
+		{
+			return;
+		}
+		pushEvent(event);
+		return;
+	}
+
 	if (type == PacketType::BlockUpdateBroadcast)
 	{
 		BlockUpdateBroadcastMessage message;
@@ -809,6 +955,18 @@ void WorldClient::handlePacket(const uint8_t *data, size_t size)
 		return;
 	}
 
+	if (type == PacketType::BlockUpdateBatch)
+	{
+		WorldClientEvent event;
+		if (!decodeBlockUpdateBatch(data, size, event.blockUpdateBatch))
+		{
+			return;
+		}
+		event.type = WorldClientEvent::Type::BlockBatchUpdated;
+		pushEvent(event);
+		return;
+	}
+
 	if (type == PacketType::ServerChatMessage)
 	{
 		ServerChatMessage message;
@@ -1,8 +1,14 @@
 #include <WorldProtocol.h>
 
+#include <ChunkPalette.h>
+#include <ChunkZstdCodec.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
 #include <cstring>
 #include <limits>
-#include <zstd.h>
+#include <numbers>
 
 namespace
 {
@@ -12,12 +18,24 @@ namespace
 		uint32_t value = 0;
 	};
 
-	constexpr uint8_t VALID_CHUNK_SECTION_MASK =
-		static_cast<uint8_t>((1u << CHUNK_SECTION_COUNT) - 1u);
+	constexpr ChunkSectionMask VALID_CHUNK_SECTION_MASK =
+		static_cast<ChunkSectionMask>((uint64_t{1} << CHUNK_SECTION_COUNT) - 1u);
 	// On augmente le niveau de compression Zstd pour le réseau (de 1 à 3).
 	// Le CPU du VPS (serveur) a de la marge, on échange donc un peu de temps CPU
 	// contre une réduction de la taille des paquets pour repousser la limite de bande passante.
 	constexpr int CHUNK_SNAPSHOT_NETWORK_ZSTD_LEVEL = 3;
+	// Niveaux négatifs: vitesse proche de LZ4 pour les liens rapides.
+	constexpr int CHUNK_SNAPSHOT_FAST_ZSTD_LEVEL = -5;
+	// Liens lents: on paie plus de CPU une fois, le payload est partagé par tous.
+	constexpr int CHUNK_SNAPSHOT_DENSE_ZSTD_LEVEL = 9;
+
+	// Position locale sur 14 bits (x:4 | y:6 | z:4), les 2 bits hauts disent ce qui suit.
+	constexpr int BLOCK_UPDATE_KIND_SHIFT = 14;
+	constexpr uint16_t BLOCK_UPDATE_KIND_AIR = 0;
+	constexpr uint16_t BLOCK_UPDATE_KIND_PALETTE = 1;
+	constexpr uint16_t BLOCK_UPDATE_KIND_COLOR = 2;
+	static_assert(CHUNK_SIZE_X == 16 && CHUNK_SIZE_Y == 64 && CHUNK_SIZE_Z == 16,
+				  "BlockUpdateBatch packs chunk-local coordinates on 4/6/4 bits");
 
 	template <typename T>
 	void appendValue(std::vector<uint8_t> &buffer, const T &value)
@@ -63,25 +81,16 @@ namespace
 		return true;
 	}
 
+	// Tampons par thread, un par usage: on ne lit jamais celui dans lequel on écrit.
+	thread_local std::vector<uint8_t> rawScratch;
+	thread_local std::vector<uint8_t> compressedScratch;
+	thread_local std::vector<uint8_t> decompressedScratch;
+
 	bool compressPayloadZstd(const std::vector<uint8_t> &input,
 							 int compressionLevel,
 							 std::vector<uint8_t> &output)
 	{
-		size_t maxCompressedSize = ZSTD_compressBound(input.size());
-		output.resize(maxCompressedSize);
-		size_t compressedSize = ZSTD_compress(
-			output.data(),
-			output.size(),
-			input.data(),
-			input.size(),
-			compressionLevel);
-		if (ZSTD_isError(compressedSize))
-		{
-			output.clear();
-			return false;
-		}
-		output.resize(compressedSize);
-		return true;
+		return compressChunkZstdInto(input.data(), input.size(), compressionLevel, output);
 	}
 
 	bool decompressPayloadZstd(const uint8_t *data,
@@ -93,44 +102,32 @@ namespace
 		{
 			return false;
 		}
+		return decompressChunkZstdInto(data, size, expectedSize, output);
+	}
 
-		output.resize(expectedSize);
-		size_t result = ZSTD_decompress(
-			output.data(),
-			output.size(),
-			data,
-			size);
-		if (ZSTD_isError(result))
-		{
-			output.clear();
-			return false;
-		}
-		if (result != output.size())
+	int chunkCodecZstdLevel(ChunkCodec codec)
+	{
+		switch (codec)
 		{
-			output.clear();
-			return false;
+		case ChunkCodec::ZstdFast:
+			return CHUNK_SNAPSHOT_FAST_ZSTD_LEVEL;
+		case ChunkCodec::ZstdDense:
+			return CHUNK_SNAPSHOT_DENSE_ZSTD_LEVEL;
+		default:
+			return CHUNK_SNAPSHOT_NETWORK_ZSTD_LEVEL;
 		}
-		return true;
 	}
 
 	void appendChunkSectionData(std::vector<uint8_t> &buffer,
 								const VoxelChunkData &chunk,
 								int sectionIndex)
 	{
-		int yBegin = VoxelChunkData::sectionYBegin(sectionIndex);
-		size_t xSliceBytes =
-			static_cast<size_t>(CHUNK_SECTION_HEIGHT) *
-			static_cast<size_t>(CHUNK_SIZE_Z) *
-			sizeof(uint32_t);
+		uint32_t values[CHUNK_SECTION_BLOCK_COUNT];
+		chunk.copySectionBlocks(sectionIndex, values);
 
-		for (int x = 0; x < CHUNK_SIZE_X; x++)
-		{
-			size_t start = buffer.size();
-			buffer.resize(start + xSliceBytes);
-			std::memcpy(buffer.data() + start,
-						&chunk.blocks[x][yBegin][0],
-						xSliceBytes);
-		}
+		size_t start = buffer.size();
+		buffer.resize(start + sizeof(values));
+		std::memcpy(buffer.data() + start, values, sizeof(values));
 	}
 
 	bool readChunkSectionData(const uint8_t *data,
@@ -139,29 +136,43 @@ namespace
 							  VoxelChunkData &chunk,
 							  int sectionIndex)
 	{
-		int yBegin = VoxelChunkData::sectionYBegin(sectionIndex);
-		size_t xSliceBytes =
-			static_cast<size_t>(CHUNK_SECTION_HEIGHT) *
-			static_cast<size_t>(CHUNK_SIZE_Z) *
-			sizeof(uint32_t);
-
-		for (int x = 0; x < CHUNK_SIZE_X; x++)
+		uint32_t values[CHUNK_SECTION_BLOCK_COUNT];
+		if (offset + sizeof(values) > size)
 		{
-			if (offset + xSliceBytes > size)
-			{
-				return false;
-			}
-			std::memcpy(&chunk.blocks[x][yBegin][0], data + offset, xSliceBytes);
-			offset += xSliceBytes;
+			return false;
 		}
-
+		std::memcpy(values, data + offset, sizeof(values));
+		offset += sizeof(values);
+		chunk.loadSectionBlocks(sectionIndex, values);
 		return true;
 	}
 }
 
+const char *chunkCodecName(ChunkCodec codec)
+{
+	switch (codec)
+	{
+	case ChunkCodec::Sections:
+		return "sections";
+	case ChunkCodec::ZstdFast:
+		return "zstd_fast";
+	case ChunkCodec::Zstd:
+		return "zstd";
+	case ChunkCodec::ZstdDense:
+		return "zstd_dense";
+	}
+	return "unknown";
+}
+
 std::vector<uint8_t> encodeHello(const HelloMessage &message)
 {
-	return encodeWithType(PacketType::Hello, message);
+	std::vector<uint8_t> buffer;
+	buffer.reserve(1 + sizeof(message.magic) + sizeof(message.version) + sizeof(message.chunkCodecs));
+	appendValue(buffer, PacketType::Hello);
+	appendValue(buffer, message.magic);
+	appendValue(buffer, message.version);
+	appendValue(buffer, message.chunkCodecs);
+	return buffer;
 }
 
 bool decodeHello(const uint8_t *data, size_t size, HelloMessage &message)
@@ -171,7 +182,18 @@ bool decodeHello(const uint8_t *data, size_t size, HelloMessage &message)
 	{
 		return false;
 	}
-	return readValue(data, size, offset, message);
+	if (!readValue(data, size, offset, message.magic) ||
+		!readValue(data, size, offset, message.version))
+	{
+		return false;
+	}
+	// v1 s'arrêtait à la version (padding de la struct compris).
+	message.chunkCodecs = LEGACY_CHUNK_CODECS;
+	if (message.version >= 2 && !readValue(data, size, offset, message.chunkCodecs))
+	{
+		return false;
+	}
+	return true;
 }
 
 std::vector<uint8_t> encodeLoginRequest(const LoginRequestMessage &message)
@@ -255,9 +277,33 @@ bool decodeWorldFrontier(const uint8_t *data, size_t size, WorldFrontier &fronti
 	return readValue(data, size, offset, frontier);
 }
 
+std::vector<uint8_t> encodeShardFrontierSync(const ShardFrontierSyncMessage &message)
+{
+	return encodeWithType(PacketType::ShardFrontierSync, message);
+}
+
+bool decodeShardFrontierSync(const uint8_t *data, size_t size, ShardFrontierSyncMessage &message)
+{
+	size_t offset = 0;
+	if (!readPacketType(data, size, PacketType::ShardFrontierSync, offset))
+	{
+		return false;
+	}
+	return readValue(data, size, offset, message);
+}
+
 std::vector<uint8_t> encodeChunkRequest(const ChunkRequestMessage &message)
 {
-	return encodeWithType(PacketType::ChunkRequest, message);
+	std::vector<uint8_t> buffer;
+	buffer.reserve(1 + sizeof(int32_t) * 2 + sizeof(uint64_t));
+	appendValue(buffer, PacketType::ChunkRequest);
+	appendValue(buffer, message.chunkX);
+	appendValue(buffer, message.chunkZ);
+	if (message.hasKnownRevision)
+	{
+		appendValue(buffer, message.knownRevision);
+	}
+	return buffer;
 }
 
 bool decodeChunkRequest(const uint8_t *data, size_t size, ChunkRequestMessage &message)
@@ -267,7 +313,27 @@ bool decodeChunkRequest(const uint8_t *data, size_t size, ChunkRequestMessage &m
 	{
 		return false;
 	}
-	return readValue(data, size, offset, message);
+	if (!readValue(data, size, offset, message.chunkX))
+	{
+		return false;
+	}
+	if (!readValue(data, size, offset, message.chunkZ))
+	{
+		return false;
+	}
+	// Révision connue optionnelle: absente pour un premier chargement.
+	message.hasKnownRevision = false;
+	message.knownRevision = 0;
+	if (offset == size)
+	{
+		return true;
+	}
+	if (!readValue(data, size, offset, message.knownRevision) || offset != size)
+	{
+		return false;
+	}
+	message.hasKnownRevision = true;
+	return true;
 }
 
 std::vector<uint8_t> encodeChunkDrop(const ChunkDropMessage &message)
@@ -285,13 +351,13 @@ bool decodeChunkDrop(const uint8_t *data, size_t size, ChunkDropMessage &message
 	return readValue(data, size, offset, message);
 }
 
-std::vector<uint8_t> encodeChunkSnapshot(const VoxelChunkData &chunk)
+void encodeChunkSnapshotInto(const VoxelChunkData &chunk, std::vector<uint8_t> &buffer)
 {
-	std::vector<uint8_t> buffer;
+	buffer.clear();
 	size_t sectionBytes = chunk.nonEmptySectionCount() *
 		CHUNK_SECTION_BLOCK_COUNT *
 		sizeof(uint32_t);
-	buffer.reserve(1 + sizeof(int32_t) * 2 + sizeof(uint64_t) + sizeof(uint8_t) + sectionBytes);
+	buffer.reserve(1 + sizeof(int32_t) * 2 + sizeof(uint64_t) + sizeof(ChunkSectionMask) + sectionBytes);
 	appendValue(buffer, PacketType::ChunkSnapshotSections);
 	appendValue(buffer, chunk.chunkX);
 	appendValue(buffer, chunk.chunkZ);
@@ -300,54 +366,124 @@ std::vector<uint8_t> encodeChunkSnapshot(const VoxelChunkData &chunk)
 
 	for (int sectionIndex = 0; sectionIndex < CHUNK_SECTION_COUNT; sectionIndex++)
 	{
-		if (chunk.isSectionEmpty(sectionIndex))
+		if (chunk.sectionIfPresent(sectionIndex) == nullptr)
 		{
 			continue;
 		}
 		appendChunkSectionData(buffer, chunk, sectionIndex);
 	}
+}
 
+std::vector<uint8_t> encodeChunkSnapshot(const VoxelChunkData &chunk)
+{
+	std::vector<uint8_t> buffer;
+	encodeChunkSnapshotInto(chunk, buffer);
 	return buffer;
 }
 
 std::vector<uint8_t> encodeChunkSnapshotNetwork(const VoxelChunkData &chunk)
 {
-	std::vector<uint8_t> rawPayload = encodeChunkSnapshot(chunk);
-	if (rawPayload.size() > static_cast<size_t>(std::numeric_limits<uint32_t>::max()))
+	return encodeChunkSnapshotNetwork(chunk, ChunkCodec::Zstd);
+}
+
+std::vector<uint8_t> encodeChunkSnapshotNetwork(const VoxelChunkData &chunk, ChunkCodec codec)
+{
+	if (codec == ChunkCodec::Sections)
+	{
+		return encodeChunkSnapshot(chunk);
+	}
+
+	// Seul le paquet final est alloué, à sa taille exacte: il part dans le cache partagé.
+	encodeChunkSnapshotInto(chunk, rawScratch);
+	if (rawScratch.size() > static_cast<size_t>(std::numeric_limits<uint32_t>::max()))
 	{
-		return rawPayload;
+		return rawScratch;
 	}
 
-	std::vector<uint8_t> compressedPayload;
 	if (!compressPayloadZstd(
-			rawPayload,
-			CHUNK_SNAPSHOT_NETWORK_ZSTD_LEVEL,
-			compressedPayload))
+			rawScratch,
+			chunkCodecZstdLevel(codec),
+			compressedScratch))
 	{
-		return rawPayload;
+		return rawScratch;
 	}
 
 	size_t wrappedCompressedSize =
 		sizeof(PacketType) +
 		sizeof(uint32_t) +
-		compressedPayload.size();
-	if (wrappedCompressedSize >= rawPayload.size())
+		compressedScratch.size();
+	if (wrappedCompressedSize >= rawScratch.size())
 	{
-		return rawPayload;
+		return rawScratch;
 	}
 
 	std::vector<uint8_t> networkPayload;
 	networkPayload.reserve(wrappedCompressedSize);
 	appendValue(networkPayload, PacketType::ChunkSnapshotSectionsZstd);
-	uint32_t rawPayloadSize = static_cast<uint32_t>(rawPayload.size());
+	uint32_t rawPayloadSize = static_cast<uint32_t>(rawScratch.size());
 	appendValue(networkPayload, rawPayloadSize);
 	networkPayload.insert(
 		networkPayload.end(),
-		compressedPayload.begin(),
-		compressedPayload.end());
+		compressedScratch.begin(),
+		compressedScratch.end());
 	return networkPayload;
 }
 
+std::vector<uint8_t> encodeChunkSectionData(const VoxelChunkData &chunk, int sectionIndex)
+{
+	std::vector<uint8_t> sectionData;
+	sectionData.reserve(CHUNK_SECTION_BLOCK_COUNT * sizeof(uint32_t));
+	appendChunkSectionData(sectionData, chunk, sectionIndex);
+	return sectionData;
+}
+
+bool compressChunkSectionFrame(const VoxelChunkData &chunk, int sectionIndex, std::vector<uint8_t> &outFrame)
+{
+	rawScratch.clear();
+	appendChunkSectionData(rawScratch, chunk, sectionIndex);
+	if (!compressPayloadZstd(rawScratch, CHUNK_SNAPSHOT_NETWORK_ZSTD_LEVEL, compressedScratch))
+	{
+		outFrame.clear();
+		return false;
+	}
+	// La trame reste en cache tant que la section n'est pas rééditée: copie à la taille exacte.
+	outFrame.assign(compressedScratch.begin(), compressedScratch.end());
+	return true;
+}
+
+std::vector<uint8_t> encodeChunkSnapshotSectionFrames(const VoxelChunkData &chunk,
+													  const std::vector<uint8_t> *const *sectionFrames)
+{
+	ChunkSectionMask sectionMask = chunk.sectionMask();
+	size_t framesBytes = 0;
+	for (int sectionIndex = 0; sectionIndex < CHUNK_SECTION_COUNT; sectionIndex++)
+	{
+		if ((sectionMask & VoxelChunkData::sectionBit(sectionIndex)) != 0)
+		{
+			framesBytes += sizeof(uint32_t) + sectionFrames[sectionIndex]->size();
+		}
+	}
+
+	std::vector<uint8_t> buffer;
+	buffer.reserve(1 + sizeof(int32_t) * 2 + sizeof(uint64_t) + sizeof(ChunkSectionMask) + framesBytes);
+	appendValue(buffer, PacketType::ChunkSnapshotSectionFrames);
+	appendValue(buffer, chunk.chunkX);
+	appendValue(buffer, chunk.chunkZ);
+	appendValue(buffer, chunk.revision);
+	appendValue(buffer, sectionMask);
+	for (int sectionIndex = 0; sectionIndex < CHUNK_SECTION_COUNT; sectionIndex++)
+	{
+		if ((sectionMask & VoxelChunkData::sectionBit(sectionIndex)) == 0)
+		{
+			continue;
+		}
+		const std::vector<uint8_t> &frame = *sectionFrames[sectionIndex];
+		appendValue(buffer, static_cast<uint32_t>(frame.size()));
+		buffer.insert(buffer.end(), frame.begin(), frame.end());
+	}
+	return buffer;
+}
+
 bool decodeChunkSnapshot(const uint8_t *data, size_t size, DecodedChunkSnapshot &message)
 {
 	size_t offset = 0;
@@ -370,11 +506,14 @@ bool decodeChunkSnapshot(const uint8_t *data, size_t size, DecodedChunkSnapshot
 		{
 			return false;
 		}
-		if (offset + sizeof(message.chunk.blocks) > size)
+		size_t blocksBytes = CHUNK_BLOCK_COUNT * sizeof(uint32_t);
+		if (offset + blocksBytes > size)
 		{
 			return false;
 		}
-		std::memcpy(message.chunk.blocks, data + offset, sizeof(message.chunk.blocks));
+		std::vector<uint32_t> values(CHUNK_BLOCK_COUNT);
+		std::memcpy(values.data(), data + offset, blocksBytes);
+		message.chunk.loadBlocks(values.data());
 		message.chunk.rebuildSectionMask();
 		return true;
 	}
@@ -400,7 +539,7 @@ bool decodeChunkSnapshot(const uint8_t *data, size_t size, DecodedChunkSnapshot
 			return false;
 		}
 
-		uint32_t *values = &message.chunk.blocks[0][0][0];
+		std::vector<uint32_t> values(CHUNK_BLOCK_COUNT, VOXEL_AIR);
 		size_t written = 0;
 		for (uint32_t index = 0; index < runCount; index++)
 		{
@@ -423,6 +562,7 @@ bool decodeChunkSnapshot(const uint8_t *data, size_t size, DecodedChunkSnapshot
 			{
 				return false;
 			}
+			message.chunk.loadBlocks(values.data());
 			message.chunk.rebuildSectionMask();
 			return true;
 		}
@@ -443,20 +583,19 @@ bool decodeChunkSnapshot(const uint8_t *data, size_t size, DecodedChunkSnapshot
 			return false;
 		}
 
-		uint8_t sectionMask = 0;
+		ChunkSectionMask sectionMask = 0;
 		if (!readValue(data, size, offset, sectionMask))
 		{
 			return false;
 		}
-		if ((sectionMask & static_cast<uint8_t>(~VALID_CHUNK_SECTION_MASK)) != 0)
+		if ((sectionMask & static_cast<ChunkSectionMask>(~VALID_CHUNK_SECTION_MASK)) != 0)
 		{
 			return false;
 		}
 
 		for (int sectionIndex = 0; sectionIndex < CHUNK_SECTION_COUNT; sectionIndex++)
 		{
-			uint8_t sectionBit = static_cast<uint8_t>(1u << sectionIndex);
-			if ((sectionMask & sectionBit) == 0)
+			if ((sectionMask & VoxelChunkData::sectionBit(sectionIndex)) == 0)
 			{
 				continue;
 			}
@@ -491,25 +630,392 @@ bool decodeChunkSnapshot(const uint8_t *data, size_t size, DecodedChunkSnapshot
 			return false;
 		}
 
-		std::vector<uint8_t> decompressedPayload;
 		if (!decompressPayloadZstd(
 				data + offset,
 				size - offset,
 				rawPayloadSize,
-				decompressedPayload))
+				decompressedScratch))
+		{
+			return false;
+		}
+		// Le contenu doit être un snapshot non compressé: sinon l'appel récursif
+		// décompresserait dans le tampon qu'il est en train de lire.
+		if (static_cast<PacketType>(decompressedScratch[0]) != PacketType::ChunkSnapshotSections)
 		{
 			return false;
 		}
 
 		return decodeChunkSnapshot(
-			decompressedPayload.data(),
-			decompressedPayload.size(),
+			decompressedScratch.data(),
+			decompressedScratch.size(),
 			message);
 	}
 
+	if (packetType == PacketType::ChunkSnapshotSectionFrames)
+	{
+		message.chunk.clearBlocks();
+		ChunkSectionMask sectionMask = 0;
+		if (!readValue(data, size, offset, message.chunk.chunkX) ||
+			!readValue(data, size, offset, message.chunk.chunkZ) ||
+			!readValue(data, size, offset, message.chunk.revision) ||
+			!readValue(data, size, offset, sectionMask))
+		{
+			return false;
+		}
+		if ((sectionMask & static_cast<ChunkSectionMask>(~VALID_CHUNK_SECTION_MASK)) != 0)
+		{
+			return false;
+		}
+
+		std::vector<uint8_t> &sectionData = decompressedScratch;
+		for (int sectionIndex = 0; sectionIndex < CHUNK_SECTION_COUNT; sectionIndex++)
+		{
+			if ((sectionMask & VoxelChunkData::sectionBit(sectionIndex)) == 0)
+			{
+				continue;
+			}
+			uint32_t frameSize = 0;
+			if (!readValue(data, size, offset, frameSize) || offset + frameSize > size)
+			{
+				return false;
+			}
+			if (!decompressPayloadZstd(
+					data + offset,
+					frameSize,
+					CHUNK_SECTION_BLOCK_COUNT * sizeof(uint32_t),
+					sectionData))
+			{
+				return false;
+			}
+			offset += frameSize;
+			size_t sectionOffset = 0;
+			if (!readChunkSectionData(sectionData.data(), sectionData.size(), sectionOffset, message.chunk, sectionIndex))
+			{
+				return false;
+			}
+		}
+
+		if (offset != size)
+		{
+			return false;
+		}
+		return message.chunk.sectionMask() == sectionMask;
+	}
+
 	return false;
 }
 
+std::vector<uint8_t> encodeChunkSectionDelta(const VoxelChunkData &chunk,
+											 uint64_t baseRevision,
+											 ChunkSectionMask changedSections)
+{
+	changedSections &= VALID_CHUNK_SECTION_MASK;
+	ChunkSectionMask presentSections = changedSections & chunk.sectionMask();
+
+	std::vector<uint8_t> &sectionData = rawScratch;
+	sectionData.clear();
+	sectionData.reserve(static_cast<size_t>(std::popcount(static_cast<unsigned int>(presentSections))) *
+		CHUNK_SECTION_BLOCK_COUNT *
+		sizeof(uint32_t));
+	for (int sectionIndex = 0; sectionIndex < CHUNK_SECTION_COUNT; sectionIndex++)
+	{
+		if ((presentSections & VoxelChunkData::sectionBit(sectionIndex)) == 0)
+		{
+			continue;
+		}
+		appendChunkSectionData(sectionData, chunk, sectionIndex);
+	}
+
+	// Même compression que les snapshots, mais seulement si elle fait gagner quelque chose.
+	std::vector<uint8_t> &compressedData = compressedScratch;
+	uint8_t compressed = 0;
+	if (!sectionData.empty() &&
+		compressPayloadZstd(sectionData, CHUNK_SNAPSHOT_NETWORK_ZSTD_LEVEL, compressedData) &&
+		compressedData.size() < sectionData.size())
+	{
+		compressed = 1;
+	}
+	const std::vector<uint8_t> &body = compressed != 0 ? compressedData : sectionData;
+
+	std::vector<uint8_t> buffer;
+	buffer.reserve(1 + sizeof(int32_t) * 2 + sizeof(uint64_t) * 2 + sizeof(ChunkSectionMask) * 2 +
+				   sizeof(uint32_t) + 1 + body.size());
+	appendValue(buffer, PacketType::ChunkSectionDelta);
+	appendValue(buffer, chunk.chunkX);
+	appendValue(buffer, chunk.chunkZ);
+	appendValue(buffer, baseRevision);
+	appendValue(buffer, chunk.revision);
+	appendValue(buffer, changedSections);
+	appendValue(buffer, presentSections);
+	appendValue(buffer, static_cast<uint32_t>(sectionData.size()));
+	appendValue(buffer, compressed);
+	buffer.insert(buffer.end(), body.begin(), body.end());
+	return buffer;
+}
+
+bool decodeChunkSectionDelta(const uint8_t *data, size_t size, ChunkSectionDeltaMessage &message)
+{
+	size_t offset = 0;
+	if (!readPacketType(data, size, PacketType::ChunkSectionDelta, offset))
+	{
+		return false;
+	}
+
+	message.chunk.clearBlocks();
+	ChunkSectionMask presentSections = 0;
+	uint32_t rawSectionBytes = 0;
+	uint8_t compressed = 0;
+	if (!readValue(data, size, offset, message.chunk.chunkX) ||
+		!readValue(data, size, offset, message.chunk.chunkZ) ||
+		!readValue(data, size, offset, message.baseRevision) ||
+		!readValue(data, size, offset, message.chunk.revision) ||
+		!readValue(data, size, offset, message.changedSections) ||
+		!readValue(data, size, offset, presentSections) ||
+		!readValue(data, size, offset, rawSectionBytes) ||
+		!readValue(data, size, offset, compressed))
+	{
+		return false;
+	}
+	if ((message.changedSections & static_cast<ChunkSectionMask>(~VALID_CHUNK_SECTION_MASK)) != 0 ||
+		(presentSections & static_cast<ChunkSectionMask>(~message.changedSections)) != 0)
+	{
+		return false;
+	}
+
+	size_t expectedBytes = static_cast<size_t>(std::popcount(static_cast<unsigned int>(presentSections))) *
+		CHUNK_SECTION_BLOCK_COUNT *
+		sizeof(uint32_t);
+	if (rawSectionBytes != expectedBytes)
+	{
+		return false;
+	}
+
+	std::vector<uint8_t> &decompressedData = decompressedScratch;
+	const uint8_t *sectionData = data + offset;
+	size_t sectionSize = size - offset;
+	if (compressed != 0)
+	{
+		if (!decompressPayloadZstd(sectionData, sectionSize, rawSectionBytes, decompressedData))
+		{
+			return false;
+		}
+		sectionData = decompressedData.data();
+		sectionSize = decompressedData.size();
+	}
+	if (sectionSize != expectedBytes)
+	{
+		return false;
+	}
+
+	size_t sectionOffset = 0;
+	for (int sectionIndex = 0; sectionIndex < CHUNK_SECTION_COUNT; sectionIndex++)
+	{
+		if ((presentSections & VoxelChunkData::sectionBit(sectionIndex)) == 0)
+		{
+			continue;
+		}
+		if (!readChunkSectionData(sectionData, sectionSize, sectionOffset, message.chunk, sectionIndex))
+		{
+			return false;
+		}
+	}
+	return message.chunk.sectionMask() == presentSections;
+}
+
+std::vector<uint8_t> encodeChunkZstdDictionary(const ChunkZstdDictionaryMessage &message)
+{
+	std::vector<uint8_t> buffer;
+	buffer.reserve(1 + sizeof(uint32_t) * 2 + message.content.size());
+	appendValue(buffer, PacketType::ChunkZstdDictionary);
+	appendValue(buffer, message.dictionaryId);
+	appendValue(buffer, static_cast<uint32_t>(message.content.size()));
+	buffer.insert(buffer.end(), message.content.begin(), message.content.end());
+	return buffer;
+}
+
+bool decodeChunkZstdDictionary(const uint8_t *data, size_t size, ChunkZstdDictionaryMessage &message)
+{
+	size_t offset = 0;
+	if (!readPacketType(data, size, PacketType::ChunkZstdDictionary, offset))
+	{
+		return false;
+	}
+
+	uint32_t contentSize = 0;
+	if (!readValue(data, size, offset, message.dictionaryId) ||
+		!readValue(data, size, offset, contentSize))
+	{
+		return false;
+	}
+	if (contentSize == 0 || offset + contentSize != size)
+	{
+		return false;
+	}
+	message.content.assign(data + offset, data + size);
+	return true;
+}
+
+QuantizedPlayerTransform quantizePlayerTransform(float positionX,
+												 float positionY,
+												 float positionZ,
+												 float lookX,
+												 float lookY,
+												 float lookZ)
+{
+	auto quantizePosition = [](float value)
+	{
+		double scaled = std::round(static_cast<double>(value) * REMOTE_PLAYER_POSITION_SCALE);
+		scaled = std::clamp(
+			scaled,
+			static_cast<double>(std::numeric_limits<int32_t>::min()),
+			static_cast<double>(std::numeric_limits<int32_t>::max()));
+		return static_cast<int32_t>(scaled);
+	};
+
+	QuantizedPlayerTransform transform;
+	transform.positionX = quantizePosition(positionX);
+	transform.positionY = quantizePosition(positionY);
+	transform.positionZ = quantizePosition(positionZ);
+
+	float length = std::sqrt(lookX * lookX + lookY * lookY + lookZ * lookZ);
+	if (length > 0.0f)
+	{
+		lookX /= length;
+		lookY /= length;
+		lookZ /= length;
+	}
+	// Lacet sur le tour complet (wrap naturel du uint16), tangage sur [-pi/2, pi/2].
+	double yaw = std::atan2(static_cast<double>(lookX), static_cast<double>(-lookZ));
+	double pitch = std::asin(std::clamp(static_cast<double>(lookY), -1.0, 1.0));
+	transform.yaw = static_cast<uint16_t>(
+		static_cast<int32_t>(std::lround(yaw / (2.0 * std::numbers::pi) * 65536.0)) & 0xFFFF);
+	transform.pitch = static_cast<int16_t>(std::lround(pitch / (std::numbers::pi / 2.0) * 32767.0));
+	return transform;
+}
+
+void dequantizePlayerPosition(const QuantizedPlayerTransform &transform, float &x, float &y, float &z)
+{
+	x = static_cast<float>(transform.positionX) / REMOTE_PLAYER_POSITION_SCALE;
+	y = static_cast<float>(transform.positionY) / REMOTE_PLAYER_POSITION_SCALE;
+	z = static_cast<float>(transform.positionZ) / REMOTE_PLAYER_POSITION_SCALE;
+}
+
+void dequantizePlayerLook(const QuantizedPlayerTransform &transform, float &x, float &y, float &z)
+{
+	double yaw = static_cast<double>(transform.yaw) / 65536.0 * 2.0 * std::numbers::pi;
+	double pitch = static_cast<double>(transform.pitch) / 32767.0 * (std::numbers::pi / 2.0);
+	double horizontal = std::cos(pitch);
+	x = static_cast<float>(std::sin(yaw) * horizontal);
+	y = static_cast<float>(std::sin(pitch));
+	z = static_cast<float>(-std::cos(yaw) * horizontal);
+}
+
+std::vector<uint8_t> encodeRemotePlayerBatch(const RemotePlayerBatchMessage &message)
+{
+	std::vector<uint8_t> buffer;
+	buffer.reserve(1 + sizeof(uint16_t) + message.updates.size() * 16);
+	appendValue(buffer, PacketType::RemotePlayerBatch);
+	appendValue(buffer, static_cast<uint16_t>(message.updates.size()));
+	for (const RemotePlayerUpdate &update : message.updates)
+	{
+		appendValue(buffer, update.replicationId);
+		appendValue(buffer, update.flags);
+		if ((update.flags & REMOTE_PLAYER_SPAWN) != 0)
+		{
+			size_t usernameLength = std::min(update.username.size(), PLAYER_USERNAME_MAX_LENGTH);
+			appendValue(buffer, update.playerId);
+			appendValue(buffer, update.skinId);
+			appendValue(buffer, static_cast<uint8_t>(usernameLength));
+			buffer.insert(buffer.end(), update.username.begin(), update.username.begin() + usernameLength);
+		}
+		if ((update.flags & REMOTE_PLAYER_POSITION) != 0)
+		{
+			appendValue(buffer, update.transform.positionX);
+			appendValue(buffer, update.transform.positionY);
+			appendValue(buffer, update.transform.positionZ);
+		}
+		else if ((update.flags & REMOTE_PLAYER_POSITION_DELTA) != 0)
+		{
+			appendValue(buffer, update.deltaX);
+			appendValue(buffer, update.deltaY);
+			appendValue(buffer, update.deltaZ);
+		}
+		if ((update.flags & REMOTE_PLAYER_LOOK) != 0)
+		{
+			appendValue(buffer, update.transform.yaw);
+			appendValue(buffer, update.transform.pitch);
+		}
+	}
+	return buffer;
+}
+
+bool decodeRemotePlayerBatch(const uint8_t *data, size_t size, RemotePlayerBatchMessage &message)
+{
+	size_t offset = 0;
+	if (!readPacketType(data, size, PacketType::RemotePlayerBatch, offset))
+	{
+		return false;
+	}
+
+	uint16_t updateCount = 0;
+	if (!readValue(data, size, offset, updateCount))
+	{
+		return false;
+	}
+	message.updates.clear();
+	message.updates.reserve(updateCount);
+	for (uint16_t updateIndex = 0; updateIndex < updateCount; updateIndex++)
+	{
+		RemotePlayerUpdate &update = message.updates.emplace_back();
+		if (!readValue(data, size, offset, update.replicationId) ||
+			!readValue(data, size, offset, update.flags))
+		{
+			return false;
+		}
+		if ((update.flags & REMOTE_PLAYER_SPAWN) != 0)
+		{
+			uint8_t usernameLength = 0;
+			if (!readValue(data, size, offset, update.playerId) ||
+				!readValue(data, size, offset, update.skinId) ||
+				!readValue(data, size, offset, usernameLength) ||
+				usernameLength > PLAYER_USERNAME_MAX_LENGTH ||
+				offset + usernameLength > size)
+			{
+				return false;
+			}
+			update.username.assign(reinterpret_cast<const char *>(data + offset), usernameLength);
+			offset += usernameLength;
+		}
+		if ((update.flags & REMOTE_PLAYER_POSITION) != 0)
+		{
+			if (!readValue(data, size, offset, update.transform.positionX) ||
+				!readValue(data, size, offset, update.transform.positionY) ||
+				!readValue(data, size, offset, update.transform.positionZ))
+			{
+				return false;
+			}
+		}
+		else if ((update.flags & REMOTE_PLAYER_POSITION_DELTA) != 0)
+		{
+			if (!readValue(data, size, offset, update.deltaX) ||
+				!readValue(data, size, offset, update.deltaY) ||
+				!readValue(data, size, offset, update.deltaZ))
+			{
+				return false;
+			}
+		}
+		if ((update.flags & REMOTE_PLAYER_LOOK) != 0)
+		{
+			if (!readValue(data, size, offset, update.transform.yaw) ||
+				!readValue(data, size, offset, update.transform.pitch))
+			{
+				return false;
+			}
+		}
+	}
+	return offset == size;
+}
+
 std::vector<uint8_t> encodeBlockActionRequest(const BlockActionRequestMessage &message)
 {
 	return encodeWithType(PacketType::BlockActionRequest, message);
@@ -540,6 +1046,139 @@ bool decodeBlockUpdateBroadcast(const uint8_t *data, size_t size, BlockUpdateBro
 	return readValue(data, size, offset, message);
 }
 
+std::vector<uint8_t> encodeBlockUpdateBatch(const BlockUpdateBatchMessage &message)
+{
+	std::vector<uint8_t> buffer;
+	size_t chunkCount = message.chunks.size();
+	if (chunkCount > std::numeric_limits<uint16_t>::max())
+	{
+		chunkCount = std::numeric_limits<uint16_t>::max();
+	}
+
+	size_t reserveBytes = 1 + sizeof(uint16_t);
+	for (size_t chunkIndex = 0; chunkIndex < chunkCount; chunkIndex++)
+	{
+		reserveBytes += sizeof(int32_t) * 2 + sizeof(uint64_t) + sizeof(uint16_t) +
+						message.chunks[chunkIndex].updates.size() * (sizeof(uint16_t) + sizeof(uint32_t));
+	}
+	buffer.reserve(reserveBytes);
+
+	appendValue(buffer, PacketType::BlockUpdateBatch);
+	appendValue(buffer, static_cast<uint16_t>(chunkCount));
+	for (size_t chunkIndex = 0; chunkIndex < chunkCount; chunkIndex++)
+	{
+		const BlockUpdateBatchChunk &chunk = message.chunks[chunkIndex];
+		size_t updateCount = chunk.updates.size();
+		if (updateCount > std::numeric_limits<uint16_t>::max())
+		{
+			updateCount = std::numeric_limits<uint16_t>::max();
+		}
+		appendValue(buffer, chunk.chunkX);
+		appendValue(buffer, chunk.chunkZ);
+		appendValue(buffer, chunk.revision);
+		appendValue(buffer, static_cast<uint16_t>(updateCount));
+		for (size_t updateIndex = 0; updateIndex < updateCount; updateIndex++)
+		{
+			const BlockUpdateBatchEntry &update = chunk.updates[updateIndex];
+			uint16_t packed = static_cast<uint16_t>(
+				((update.localX & 0xFu) << 10) |
+				((update.localY & 0x3Fu) << 4) |
+				(update.localZ & 0xFu));
+			uint8_t paletteIndex = 0;
+			if (update.finalColor == VOXEL_AIR)
+			{
+				appendValue(buffer, static_cast<uint16_t>(packed | (BLOCK_UPDATE_KIND_AIR << BLOCK_UPDATE_KIND_SHIFT)));
+			}
+			else if (findPlayerPaletteIndex(update.finalColor, paletteIndex))
+			{
+				appendValue(buffer, static_cast<uint16_t>(packed | (BLOCK_UPDATE_KIND_PALETTE << BLOCK_UPDATE_KIND_SHIFT)));
+				appendValue(buffer, paletteIndex);
+			}
+			else
+			{
+				appendValue(buffer, static_cast<uint16_t>(packed | (BLOCK_UPDATE_KIND_COLOR << BLOCK_UPDATE_KIND_SHIFT)));
+				appendValue(buffer, update.finalColor);
+			}
+		}
+	}
+	return buffer;
+}
+
+bool decodeBlockUpdateBatch(const uint8_t *data, size_t size, BlockUpdateBatchMessage &message)
+{
+	size_t offset = 0;
+	if (!readPacketType(data, size, PacketType::BlockUpdateBatch, offset))
+	{
+		return false;
+	}
+
+	uint16_t chunkCount = 0;
+	if (!readValue(data, size, offset, chunkCount))
+	{
+		return false;
+	}
+
+	message.chunks.clear();
+	message.chunks.resize(chunkCount);
+	for (BlockUpdateBatchChunk &chunk : message.chunks)
+	{
+		uint16_t updateCount = 0;
+		if (!readValue(data, size, offset, chunk.chunkX) ||
+			!readValue(data, size, offset, chunk.chunkZ) ||
+			!readValue(data, size, offset, chunk.revision) ||
+			!readValue(data, size, offset, updateCount))
+		{
+			return false;
+		}
+		// Au moins 2 octets par entrée: on refuse un compteur impossible avant d'allouer.
+		if (offset + static_cast<size_t>(updateCount) * sizeof(uint16_t) > size)
+		{
+			return false;
+		}
+
+		chunk.updates.resize(updateCount);
+		for (BlockUpdateBatchEntry &update : chunk.updates)
+		{
+			uint16_t packed = 0;
+			if (!readValue(data, size, offset, packed))
+			{
+				return false;
+			}
+			update.localX = static_cast<uint8_t>((packed >> 10) & 0xFu);
+			update.localY = static_cast<uint8_t>((packed >> 4) & 0x3Fu);
+			update.localZ = static_cast<uint8_t>(packed & 0xFu);
+
+			uint16_t kind = static_cast<uint16_t>(packed >> BLOCK_UPDATE_KIND_SHIFT);
+			if (kind == BLOCK_UPDATE_KIND_AIR)
+			{
+				update.finalColor = VOXEL_AIR;
+			}
+			else if (kind == BLOCK_UPDATE_KIND_PALETTE)
+			{
+				uint8_t paletteIndex = 0;
+				if (!readValue(data, size, offset, paletteIndex) ||
+					paletteIndex >= PLAYER_COLOR_PALETTE_SIZE)
+				{
+					return false;
+				}
+				update.finalColor = playerPaletteColor(paletteIndex);
+			}
+			else if (kind == BLOCK_UPDATE_KIND_COLOR)
+			{
+				if (!readValue(data, size, offset, update.finalColor))
+				{
+					return false;
+				}
+			}
+			else
+			{
+				return false;
+			}
+		}
+	}
+	return offset == size;
+}
+
 std::vector<uint8_t> encodePlayerState(const PlayerStateMessage &message)
 {
 	return encodeWithType(PacketType::PlayerState, message);
@@ -691,6 +1330,18 @@ const char *packetTypeName(PacketType type)
 		return "AccountDeleteRequest";
 	case PacketType::AccountDeleteResponse:
 		return "AccountDeleteResponse";
+	case PacketType::BlockUpdateBatch:
+		return "BlockUpdateBatch";
+	case PacketType::ChunkSectionDelta:
+		return "ChunkSectionDelta";
+	case PacketType::ChunkSnapshotSectionFrames:
+		return "ChunkSnapshotSectionFrames";
+	case PacketType::ChunkZstdDictionary:
+		return "ChunkZstdDictionary";
+	case PacketType::RemotePlayerBatch:
+		return "RemotePlayerBatch";
+	case PacketType::ShardFrontierSync:
+		return "ShardFrontierSync";
 	}
 	return "Unknown";
 }
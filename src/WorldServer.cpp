@@ -9,15 +9,32 @@
 #endif
 
 #include <ChunkPalette.h>
+#include <ChunkPool.h>
+#include <ChunkZstdDictionary.h>
+#include <PacketTrace.h>
 #include <PasswordHasher.h>
 #include <Player.h>
 #include <PlayerSessionData.h>
 #include <PlayerTable.h>
 #include <PlayerUsername.h>
 #include <WorldTable.h>
+#include <server/core/AuthWorkerPool.h>
+#include <server/core/ChunkCodecPolicy.h>
+#include <server/core/ChunkSendController.h>
+#include <server/core/ChunkSendQueue.h>
+#include <server/core/ChunkSendScheduler.h>
+#include <server/core/ChunkViewPriority.h>
+#include <server/core/JobSystem.h>
+#include <server/core/MetricsExporter.h>
+#include <server/core/MetricsRegistry.h>
+#include <server/core/PlayerSaveQueue.h>
+#include <server/core/PlayerSpatialHash.h>
+#include <server/core/SpscRing.h>
 
 #include <enet/enet.h>
+#include <sodium.h>
 
+#include <array>
 #include <atomic>
 #include <cctype>
 #include <chrono>
@@ -25,6 +42,7 @@
 #include <condition_variable>
 #include <cstdint>
 #include <csignal>
+#include <cstring>
 #include <cstdlib>
 #include <ctime>
 #include <deque>
@@ -32,6 +50,7 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <queue>
@@ -51,7 +70,12 @@ namespace
 	constexpr uint32_t DEFAULT_STREAM_TICK_MS = 8;
 	constexpr size_t DEFAULT_MAX_INTEGRATED_CHUNKS_PER_TICK = 4;
 	constexpr size_t DEFAULT_MAX_CHUNK_SENDS_PER_CLIENT_PER_TICK = 100;
+	// Plafond de sécurité: la vraie limite est la fenêtre en octets de ChunkSendController.
 	constexpr size_t MAX_PENDING_CHUNK_SNAPSHOTS_PER_CLIENT = 512;
+	// Éditions mémorisées par chunk pour répondre par delta à un client qui revient.
+	constexpr size_t CHUNK_SECTION_HISTORY_LIMIT = 64;
+	// Une rafale d'éditions ne déclenche qu'un ré-encodage, lancé après cette fenêtre.
+	constexpr uint32_t SNAPSHOT_REENCODE_DEBOUNCE_MS = 50;
 	constexpr size_t DEFAULT_MAX_CHUNK_SAVES_PER_TICK = 8;
 	constexpr size_t DEFAULT_MAX_CHUNK_UNLOADS_PER_TICK = 8;
 	constexpr size_t CLASSIC_MIN_INTEGRATED_CHUNKS_PER_TICK = 8;
@@ -67,6 +91,35 @@ namespace
 	constexpr uint64_t EXPANSION_BASE_COOLDOWN_MS = 30000;
 	constexpr uint64_t EXPANSION_MAX_COOLDOWN_MS = 15ull * 60ull * 1000ull;
 	constexpr int SPAWN_CLEARANCE_BLOCKS = 3;
+	constexpr size_t MAX_CLIENT_PEERS = 256;
+	// Logins / suppressions admis en attente d'un thread d'authentification (au-delà: ServerBusy).
+	constexpr size_t AUTH_ADMISSION_QUEUE_CAPACITY = 256;
+	constexpr size_t MAX_DEFAULT_AUTH_WORKERS = 4;
+	constexpr size_t NETWORK_INBOUND_RING_CAPACITY = 8192;
+	constexpr size_t NETWORK_OUTBOUND_RING_CAPACITY = 16384;
+	constexpr uint32_t NETWORK_THREAD_SERVICE_TIMEOUT_MS = 1;
+	// Le thread réseau publie RTT / données en vol de chaque peer à ce rythme.
+	constexpr uint32_t NETWORK_LINK_STATS_INTERVAL_MS = 250;
+	constexpr uint32_t CHUNK_CODEC_EVALUATION_INTERVAL_MS = 1000;
+	// Débit acquitté: moyenne glissante, une évaluation sur deux compte pour moitié.
+	constexpr double ACKED_THROUGHPUT_SMOOTHING = 0.5;
+	// Au-delà, encoder une variante de plus ralentirait la génération et les envois.
+	constexpr size_t CHUNK_CODEC_CPU_BACKLOG_JOBS_PER_WORKER = 8;
+	// Un joueur visible ne disparaît qu'au-delà de rayon * facteur: pas de clignotement au bord.
+	constexpr float PLAYER_VIEW_KEEP_RADIUS_FACTOR = 1.25f;
+	constexpr int PLAYER_SPATIAL_HASH_CELL_CHUNKS = 2;
+	constexpr size_t MAX_REMOTE_PLAYER_UPDATES_PER_PACKET = 256;
+	// Premier remplissage: les chunks devant un joueur qui vient d'arriver passent avant les fonds de carte.
+	constexpr uint32_t NEW_PLAYER_FRUSTUM_SEND_WEIGHT = 4;
+	constexpr uint32_t NEW_PLAYER_SEND_BOOST_MS = 15000;
+	// Demi-angle horizontal du champ de vue, un peu large pour couvrir les rotations rapides.
+	constexpr float SEND_FRUSTUM_MIN_ALIGNMENT = 0.34f;
+	constexpr int SEND_FRUSTUM_NEAR_CHUNKS = 2;
+	constexpr size_t SEND_QUEUE_STALE_SLACK = 64;
+	constexpr size_t GENERATION_HEAP_STALE_SLACK = 256;
+	// Sauvegarde périodique des joueurs connectés (écrite en différé, par lots).
+	constexpr uint64_t PLAYER_AUTOSAVE_INTERVAL_MS = 30000;
+	constexpr float GENERATION_UNWATCHED_PRIORITY = 1.0e9f;
 	constexpr const char *SERVER_CONNECTION_LOG_PATH = "logs/server_connections.log";
 	constexpr const char *ACTIVITY_FRONTIER_META_KEY = "activity_frontier_state_v1";
 	constexpr const char *ADMIN_USERS_ENV = "VOXPLACE_ADMIN_USERS";
@@ -98,17 +151,15 @@ namespace
 
 			// Politique serveur dédiée:
 			// - 1 thread logique réservé au main thread (réseau + tick + intégration)
-			// - 1 thread logique réservé au save worker SQLite
-			// - tout le reste est alloué au pool de génération
+			// - tout le reste va au JobSystem (chargement, génération, encodage, sauvegarde)
 			//
-			// Cela pousse beaucoup plus fort qu'une heuristique desktop partagée
-			// client+serveur, tout en gardant explicitement la place pour le thread
-			// autoritaire et la persistance asynchrone.
+			// Un seul pool: un coeur libre prend l'étape en retard au lieu d'attendre
+			// sur une file spécialisée.
 			if (reported <= 2)
 			{
 				return 1;
 			}
-			return static_cast<size_t>(reported - 2);
+			return static_cast<size_t>(reported - 1);
 		}
 
 		void addAdminUsername(std::unordered_set<std::string> &admins, const std::string &rawUsername)
@@ -226,14 +277,6 @@ namespace
 			return isValidActivityFrontierState(state);
 		}
 
-		ChunkCoord chunkCoordFromKey(int64_t key)
-		{
-			ChunkCoord coord;
-		coord.x = static_cast<int>(key >> 32);
-		coord.z = static_cast<int>(key & 0xFFFFFFFF);
-		return coord;
-	}
-
 	uint64_t systemNowMs()
 	{
 		auto now = std::chrono::system_clock::now().time_since_epoch();
@@ -327,7 +370,7 @@ namespace
 		rawBytes += sizeof(chunk.chunkX);
 		rawBytes += sizeof(chunk.chunkZ);
 		rawBytes += sizeof(chunk.revision);
-		rawBytes += sizeof(uint8_t);
+		rawBytes += sizeof(ChunkSectionMask);
 		rawBytes +=
 			chunk.nonEmptySectionCount() *
 			CHUNK_SECTION_BLOCK_COUNT *
@@ -338,6 +381,16 @@ namespace
 
 struct WorldServer::Impl
 {
+	// Copie des compteurs de l'ENetPeer: le thread de simulation n'y touche pas directement.
+	struct PeerLinkStats
+	{
+		uint32_t roundTripTimeMs = 0;
+		uint32_t roundTripTimeVarianceMs = 0;
+		uint32_t packetLoss = 0;
+		uint32_t packetThrottle = 0;
+		uint32_t reliableDataInTransit = 0;
+	};
+
 	struct ClientSession
 	{
 		struct ClientChunkStreamState
@@ -346,7 +399,15 @@ struct WorldServer::Impl
 			std::unordered_set<int64_t> loadedChunks;
 			std::unordered_set<int64_t> queuedChunks;
 			std::unordered_set<uint64_t> pendingPacketIds;
-			std::deque<int64_t> sendQueue;
+			// Octets de snapshots envoyés et pas encore libérés par ENet.
+			size_t pendingChunkBytes = 0;
+			size_t peakPendingChunkBytes = 0;
+			// Ordre de vue du joueur; queuedChunks fait foi (doublons et chunks abandonnés y sont sautés).
+			ChunkSendQueue sendQueue;
+			// Révision que le client a gardée en quittant le chunk (ChunkRequest.knownRevision).
+			std::unordered_map<int64_t, uint64_t> knownRevisions;
+			// Vue du joueur lors de la dernière priorisation de la génération.
+			ChunkView generationView;
 		};
 
 			struct ClientPlayerContext
@@ -355,31 +416,193 @@ struct WorldServer::Impl
 				PlayerSessionData playerSession;
 				std::string usernameKey;
 				bool admin = false;
+				// Login admis dans le pool d'authentification, réponse pas encore envoyée.
+				bool authPending = false;
+				// Levé à la déconnexion: un job pas encore commencé ne calcule pas le hash pour rien.
+				std::shared_ptr<std::atomic<bool>> authCancelled = std::make_shared<std::atomic<bool>>(false);
+				std::chrono::steady_clock::time_point authenticatedAt;
+			};
+
+		struct ClientLinkState
+		{
+			PeerLinkStats stats;
+			bool statsReceived = false;
+			// Octets de snapshots acquittés depuis la dernière évaluation du codec.
+			size_t ackedChunkBytes = 0;
+			double ackedBytesPerSecond = 0.0;
+			uint32_t supportedChunkCodecs = LEGACY_CHUNK_CODECS;
+			ChunkCodec chunkCodec = ChunkCodec::Zstd;
+			bool chunkCodecChosen = false;
+			ChunkSendController sendController;
+			ChunkSendFlow sendFlow;
+			size_t sendWindowAckedBytes = 0;
+			std::chrono::steady_clock::time_point lastLinkSample = std::chrono::steady_clock::now();
+			std::chrono::steady_clock::time_point lastCodecEvaluation = std::chrono::steady_clock::now();
+		};
+
+		struct ClientReplicationState
+		{
+			// Dernier état envoyé à ce client pour chaque joueur visible: base des deltas.
+			struct VisiblePlayer
+			{
+				uint64_t playerId = 0;
+				QuantizedPlayerTransform sent;
+				uint64_t seenPass = 0;
 			};
 
+			// Slot ENet du peer: stable le temps de la connexion, réutilisé ensuite
+			// (d'où playerId dans VisiblePlayer pour détecter un remplacement).
+			uint16_t replicationId = 0;
+			QuantizedPlayerTransform transform;
+			std::unordered_map<uint16_t, VisiblePlayer> visiblePlayers;
+		};
+
 		ENetPeer *peer = nullptr;
+		// connectID ENet de cette connexion: le thread réseau ignore les envois vers un slot réutilisé.
+		uint32_t connectId = 0;
+		// Session dans la trace de paquets (0 = pas tracée).
+		uint32_t traceSessionId = 0;
+		ENetAddress address{};
 		ClientChunkStreamState chunkStream;
 		ClientPlayerContext playerContext;
+		ClientLinkState link;
+		ClientReplicationState replication;
+	};
+
+	enum class AuthRequestKind : uint8_t
+	{
+		Login,
+		AccountDelete
+	};
+
+	// Produit par un thread d'authentification, appliqué par le thread de simulation.
+	struct AuthResult
+	{
+		AuthRequestKind kind = AuthRequestKind::Login;
+		ENetPeer *peer = nullptr;
+		uint32_t connectId = 0;
+		std::string username;
+		LoginStatus loginStatus = LoginStatus::InvalidCredentials;
+		AccountDeleteStatus deleteStatus = AccountDeleteStatus::InvalidCredentials;
+		Player player;
+		bool createdPlayer = false;
+		std::shared_ptr<std::atomic<bool>> cancelled;
+		std::chrono::steady_clock::time_point admittedAt;
+	};
+
+	// Limites d'une session pendant le stream tick en cours (voir sendQueuedChunks).
+	struct ClientSendTick
+	{
+		ClientSession *session = nullptr;
+		size_t sendBudget = 0;
+		size_t sentCount = 0;
+		size_t tickBytes = 0;
+		size_t tickByteBudget = 0;
+	};
+
+	// type NONE: échantillon PeerLinkStats périodique (droppable).
+	struct InboundNetworkEvent
+	{
+		ENetEventType type = ENET_EVENT_TYPE_NONE;
+		ENetPeer *peer = nullptr;
+		uint32_t connectId = 0;
+		ENetAddress address{};
+		ENetPacket *packet = nullptr;
+		uint8_t channel = 0;
+		PeerLinkStats linkStats;
 	};
 
+	struct OutboundNetworkPacket
+	{
+		ENetPeer *peer = nullptr;
+		uint32_t connectId = 0;
+		uint8_t channel = 0;
+		ENetPacket *packet = nullptr;
+	};
+
+	// Octets immuables partagés entre le cache et tous les paquets ENet en vol.
+	using SharedSnapshotPayload = std::shared_ptr<const std::vector<uint8_t>>;
+
 	struct ReadyChunk
 	{
-		VoxelChunkData chunk;
+		ChunkHandle chunk;
 		bool loadedFromStorage = false;
 		uint8_t snapshotSectionCount = 0;
 		size_t snapshotRawBytes = 0;
 		std::vector<uint8_t> snapshotPayload;
+		// Variantes des codecs utilisés par au moins une session à l'encodage.
+		SharedSnapshotPayload codecPayloads[CHUNK_CODEC_COUNT];
 	};
 
 	struct SaveBatchJob
 	{
-		std::vector<VoxelChunkData> chunks;
+		uint64_t sequence = 0;
+		std::vector<ChunkHandle> chunks;
+		std::vector<WorldTablePreparedChunk> prepared;
+		bool preparedOk = false;
+	};
+
+	struct WorldChunkEntry
+	{
+		ChunkHandle chunk;
+		int64_t key = 0;
+		// Liste LRU intrusive des chunks froids: aucun client intéressé, rien à sauver.
+		WorldChunkEntry *coldPrev = nullptr;
+		WorldChunkEntry *coldNext = nullptr;
+		bool cold = false;
 	};
 
-	struct PendingChunkPacket
+	struct FreedChunkPacket
 	{
 		ENetPeer *peer = nullptr;
 		uint64_t packetId = 0;
+		uint32_t bytes = 0;
+	};
+
+	// Porté par packet->userData: le freeCallback peut tourner sur le thread réseau.
+	// Le paquet pointe sur payload (NO_ALLOCATE), la référence tient jusqu'à sa libération.
+	struct ChunkPacketTag
+	{
+		Impl *server = nullptr;
+		FreedChunkPacket freed;
+		SharedSnapshotPayload payload;
+	};
+
+	// Sert à la fois au calcul des deltas et au rejeu des éditions derrière un snapshot périmé.
+	struct ChunkSectionEdit
+	{
+		uint64_t revision = 0;
+		ChunkSectionMask sections = 0;
+		BlockUpdateBatchEntry update;
+	};
+
+	struct ChunkSnapshotReencode
+	{
+		// Trame Zstd par section présente, réutilisée tant que la section n'est pas éditée.
+		SharedSnapshotPayload sectionFrames[CHUNK_SECTION_COUNT];
+		ChunkSectionMask staleSections = 0;
+		bool queued = false;
+		bool inFlight = false;
+		uint64_t sequence = 0;
+		std::chrono::steady_clock::time_point dueAt;
+	};
+
+	struct CompletedSnapshotReencode
+	{
+		int64_t key = 0;
+		uint64_t sequence = 0;
+		uint64_t revision = 0;
+		uint8_t sectionCount = 0;
+		size_t rawBytes = 0;
+		SharedSnapshotPayload sectionFrames[CHUNK_SECTION_COUNT];
+		SharedSnapshotPayload payload;
+	};
+
+	struct CachedChunkSectionDelta
+	{
+		uint64_t baseRevision = 0;
+		uint64_t revision = 0;
+		SharedSnapshotPayload payload;
 	};
 
 	struct CachedChunkSnapshotPayload
@@ -387,7 +610,52 @@ struct WorldServer::Impl
 		uint64_t revision = 0;
 		uint8_t sectionCount = 0;
 		size_t rawBytes = 0;
-		std::vector<uint8_t> payload;
+		SharedSnapshotPayload payload;
+	};
+
+	// Variante d'un autre codec que Zstd: jamais périmée, ré-encodée à la demande.
+	struct ChunkSnapshotCodecVariant
+	{
+		uint64_t revision = 0;
+		SharedSnapshotPayload payload;
+		bool encoding = false;
+	};
+
+	struct CompletedSnapshotCodecVariant
+	{
+		int64_t key = 0;
+		ChunkCodec codec = ChunkCodec::Zstd;
+		uint64_t revision = 0;
+		SharedSnapshotPayload payload;
+	};
+
+	struct GenerationTask
+	{
+		ChunkCoord coord;
+		float priority = 0.0f;
+		uint64_t sequence = 0;
+	};
+
+	struct GenerationTaskLater
+	{
+		bool operator()(const GenerationTask &left, const GenerationTask &right) const
+		{
+			if (left.priority != right.priority)
+			{
+				return left.priority > right.priority;
+			}
+			return left.sequence > right.sequence;
+		}
+	};
+
+	struct PendingGenerationTask
+	{
+		ChunkCoord coord;
+		uint64_t sequence = 0;
+		// Frontière / bootstrap: le chunk doit exister même si aucun client ne l'a demandé.
+		bool pinned = false;
+		// Chunk attendu en base: file Load plutôt que Generate.
+		bool fromStorage = false;
 	};
 
 	struct ExpansionVoteState
@@ -399,28 +667,176 @@ struct WorldServer::Impl
 		std::unordered_set<uint64_t> noVoterIds;
 	};
 
+	// Poignées vers le registre, résolues une fois: une mise à jour ne coûte qu'un atomique.
+	// Durées en microsecondes; les *_now sont des gauges rafraîchies à chaque tick.
+	struct ServerMetrics
+	{
+		explicit ServerMetrics(MetricsRegistry &registry)
+			: loopWork(registry.histogram("voxplace_loop_work_microseconds", "Work time of one simulation loop iteration, excluding the network wait")),
+			  streamTick(registry.histogram("voxplace_tick_phase_microseconds", "Time spent in a server tick phase", "phase=\"stream_tick\"")),
+			  replicatePlayers(registry.histogram("voxplace_tick_phase_microseconds", "", "phase=\"replicate_players\"")),
+			  integrateChunks(registry.histogram("voxplace_tick_phase_microseconds", "", "phase=\"integrate_chunks\"")),
+			  sendChunks(registry.histogram("voxplace_tick_phase_microseconds", "", "phase=\"send_chunks\"")),
+			  tick(registry.histogram("voxplace_tick_phase_microseconds", "", "phase=\"tick\"")),
+			  flushDirtyChunks(registry.histogram("voxplace_tick_phase_microseconds", "", "phase=\"flush_dirty_chunks\"")),
+			  unloadChunks(registry.histogram("voxplace_tick_phase_microseconds", "", "phase=\"unload_chunks\"")),
+			  sqliteLoad(registry.histogram("voxplace_worker_stage_microseconds", "Time spent in a worker job stage", "stage=\"sqlite_load\"")),
+			  generate(registry.histogram("voxplace_worker_stage_microseconds", "", "stage=\"generate\"")),
+			  encode(registry.histogram("voxplace_worker_stage_microseconds", "", "stage=\"encode\"")),
+			  saveCompress(registry.histogram("voxplace_worker_stage_microseconds", "", "stage=\"save_compress\"")),
+			  sqliteSave(registry.histogram("voxplace_worker_stage_microseconds", "", "stage=\"sqlite_save\"")),
+			  playerSaveCommit(registry.histogram("voxplace_player_save_commit_microseconds", "Time to commit one batch of player states")),
+			  login(registry.histogram("voxplace_auth_microseconds", "Time from admission to result of an authentication request", "kind=\"login\"")),
+			  accountDelete(registry.histogram("voxplace_auth_microseconds", "", "kind=\"account_delete\"")),
+			  clientSendQueue(registry.histogram("voxplace_client_send_queue_chunks", "Chunks queued for one client, sampled every tick")),
+			  clientInFlightBytes(registry.histogram("voxplace_client_in_flight_bytes", "Unacknowledged snapshot bytes for one client, sampled every tick")),
+			  clientRoundTripMs(registry.histogram("voxplace_client_rtt_milliseconds", "ENet round trip time of one client, sampled every tick")),
+			  chunksSent(registry.counter("voxplace_chunks_sent_total", "Chunk snapshots and section deltas sent")),
+			  chunkBytesSent(registry.counter("voxplace_chunk_bytes_sent_total", "Bytes of chunk snapshots and section deltas sent")),
+			  chunksLoaded(registry.counter("voxplace_chunks_loaded_total", "Chunks read back from the world database")),
+			  chunksGenerated(registry.counter("voxplace_chunks_generated_total", "Chunks produced by the terrain generator")),
+			  chunkLoadErrors(registry.counter("voxplace_chunk_load_errors_total", "Chunk reads from the world database that failed")),
+			  chunksSaved(registry.counter("voxplace_chunks_saved_total", "Chunks written to the world database")),
+			  authAccepted(registry.counter("voxplace_auth_results_total", "Completed authentication requests by outcome", "result=\"accepted\"")),
+			  authRejected(registry.counter("voxplace_auth_results_total", "", "result=\"rejected\"")),
+			  authBusyRejects(registry.counter("voxplace_auth_results_total", "", "result=\"busy\"")),
+			  clients(registry.gauge("voxplace_clients_now", "Connected peers")),
+			  worldChunks(registry.gauge("voxplace_world_chunks_now", "Chunks resident in memory")),
+			  generationTasks(registry.gauge("voxplace_generation_tasks_now", "Chunks waiting for load or generation")),
+			  dirtyChunks(registry.gauge("voxplace_dirty_chunks_now", "Modified chunks not yet written")),
+			  jobsEncode(registry.gauge("voxplace_jobs_pending_now", "Jobs waiting in the job system", "priority=\"encode\"")),
+			  jobsLoad(registry.gauge("voxplace_jobs_pending_now", "", "priority=\"load\"")),
+			  jobsGenerate(registry.gauge("voxplace_jobs_pending_now", "", "priority=\"generate\"")),
+			  jobsSaveCompress(registry.gauge("voxplace_jobs_pending_now", "", "priority=\"save_compress\"")),
+			  authQueued(registry.gauge("voxplace_auth_queued_now", "Authentication requests waiting for a worker")),
+			  playerSavesPending(registry.gauge("voxplace_player_saves_pending_now", "Player states not yet committed"))
+		{
+		}
+
+		MetricsHistogram &loopWork;
+		MetricsHistogram &streamTick;
+		MetricsHistogram &replicatePlayers;
+		MetricsHistogram &integrateChunks;
+		MetricsHistogram &sendChunks;
+		MetricsHistogram &tick;
+		MetricsHistogram &flushDirtyChunks;
+		MetricsHistogram &unloadChunks;
+		MetricsHistogram &sqliteLoad;
+		MetricsHistogram &generate;
+		MetricsHistogram &encode;
+		MetricsHistogram &saveCompress;
+		MetricsHistogram &sqliteSave;
+		MetricsHistogram &playerSaveCommit;
+		MetricsHistogram &login;
+		MetricsHistogram &accountDelete;
+		MetricsHistogram &clientSendQueue;
+		MetricsHistogram &clientInFlightBytes;
+		MetricsHistogram &clientRoundTripMs;
+		MetricsCounter &chunksSent;
+		MetricsCounter &chunkBytesSent;
+		MetricsCounter &chunksLoaded;
+		MetricsCounter &chunksGenerated;
+		MetricsCounter &chunkLoadErrors;
+		MetricsCounter &chunksSaved;
+		MetricsCounter &authAccepted;
+		MetricsCounter &authRejected;
+		MetricsCounter &authBusyRejects;
+		MetricsGauge &clients;
+		MetricsGauge &worldChunks;
+		MetricsGauge &generationTasks;
+		MetricsGauge &dirtyChunks;
+		MetricsGauge &jobsEncode;
+		MetricsGauge &jobsLoad;
+		MetricsGauge &jobsGenerate;
+		MetricsGauge &jobsSaveCompress;
+		MetricsGauge &authQueued;
+		MetricsGauge &playerSavesPending;
+	};
+
 		uint16_t port = 0;
 			std::string playerDatabasePath;
 			std::string worldDatabasePath;
 			bool persistGeneratedChunks = false;
 		ServerEnvironmentOptions environmentOptions;
+	ShardLayout shard;
+	// Comparé en entier (zéros compris) à celui de chaque ShardFrontierSync.
+	char shardToken[SHARD_TOKEN_MAX_LENGTH + 1] = {};
+	MetricsRegistry metricsRegistry;
+	ServerMetrics metrics{metricsRegistry};
+	MetricsExporter metricsExporter;
+	PacketTraceWriter packetTrace;
 	bool enetInitialized = false;
 	ENetHost *host = nullptr;
 	std::unique_ptr<IChunkGenerator> generator;
+	// Dictionnaire actif de world_meta, envoyé tel quel à chaque login.
+	std::vector<uint8_t> chunkDictionaryPacket;
 		WorldGenerationMode generationMode = WorldGenerationMode::ActivityFrontier;
-		PlayerTable playerTable;
+		// Les sauvegardes de joueurs ne passent plus par le thread de simulation.
+		PlayerSaveQueue playerSaveQueue;
+		uint64_t nextPlayerAutosaveAtMs = 0;
 			WorldTable worldTable;
-		PasswordHasher passwordHasher;
+		// Connexion à part pour le pool d'authentification (lectures, créations, suppressions).
+		PlayerTable authPlayerTable;
+		std::mutex authPlayerTableMutex;
+		AuthWorkerPool authWorkers;
+		std::mutex completedAuthResultsMutex;
+		std::vector<AuthResult> completedAuthResults;
+		std::unordered_set<std::string> pendingAuthUsernames;
+		// Lu par les threads d'authentification: ne plus le modifier après le constructeur.
 		std::unordered_set<std::string> adminUsernames;
 		bool blockCooldownDisabled = false;
 
 		WorldFrontier frontier;
 	ExpansionVoteState expansionVote;
-	std::unordered_map<int64_t, VoxelChunkData> worldChunks;
+	std::unordered_map<int64_t, WorldChunkEntry> worldChunks;
+	// Nombre de sessions dont wantedChunks contient la clé (chunks chargés ou non).
+	std::unordered_map<int64_t, uint32_t> chunkInterestCounts;
+	// Sessions à qui router les BlockUpdate d'un chunk (loadedChunks ou sendQueue).
+	std::unordered_map<int64_t, std::unordered_set<ENetPeer *>> chunkSubscribers;
+	// Modifications du stream tick en cours, envoyées groupées par flushBlockUpdateBatches.
+	std::unordered_map<int64_t, BlockUpdateBatchChunk> pendingBlockUpdates;
+	WorldChunkEntry *coldChunksHead = nullptr;
+	WorldChunkEntry *coldChunksTail = nullptr;
+	size_t coldChunkCount = 0;
 	std::unordered_map<int64_t, CachedChunkSnapshotPayload> chunkSnapshotPayloadCache;
+	// Une révision par entrée, sans trou: sinon on ne peut plus prouver ce qui a changé.
+	std::unordered_map<int64_t, std::deque<ChunkSectionEdit>> chunkSectionHistory;
+	// Dernier delta encodé par chunk: les joueurs qui reviennent au spawn partagent souvent la même base.
+	std::unordered_map<int64_t, CachedChunkSectionDelta> chunkSectionDeltaCache;
+	std::unordered_map<int64_t, ChunkSnapshotReencode> chunkSnapshotReencodes;
+	std::vector<int64_t> queuedSnapshotReencodes;
+	uint64_t nextSnapshotReencodeSequence = 1;
+	std::mutex completedSnapshotReencodesMutex;
+	std::vector<CompletedSnapshotReencode> completedSnapshotReencodes;
+	// Le cache principal tient la variante Zstd (ré-encodage par sections, rejeu des périmés).
+	std::unordered_map<int64_t, std::array<ChunkSnapshotCodecVariant, CHUNK_CODEC_COUNT>> chunkSnapshotCodecVariants;
+	std::vector<CompletedSnapshotCodecVariant> completedSnapshotCodecVariants;
+	// Codecs à encoder en plus de Zstd dès la génération (chunkCodecBit), lu par les jobs Encode.
+	std::atomic<uint32_t> extraChunkCodecs = 0;
 	uint64_t totalBlockActions = 0;
 	std::unordered_map<ENetPeer *, ClientSession> clients;
-	std::unordered_map<ENetPacket *, PendingChunkPacket> pendingChunkPackets;
+	// Sessions authentifiées indexées pour la réplication des joueurs (pointeurs stables dans clients).
+	PlayerSpatialHash playerSpatialHash{PLAYER_SPATIAL_HASH_CELL_CHUNKS};
+	std::unordered_map<uint16_t, ClientSession *> replicatedSessions;
+	std::vector<uint16_t> replicationCandidates;
+	bool playerReplicationDirty = false;
+	ChunkSendScheduler chunkSendScheduler;
+	std::vector<ClientSendTick> clientSendTicks;
+	std::vector<ChunkSendCandidate> chunkSendCandidates;
+	uint64_t playerReplicationPass = 0;
+	// Snapshots libérés par ENet (acquittés ou abandonnés), repris par le thread de simulation.
+	std::mutex freedChunkPacketsMutex;
+	std::vector<FreedChunkPacket> freedChunkPackets;
+	SpscRing<InboundNetworkEvent, NETWORK_INBOUND_RING_CAPACITY> inboundNetworkEvents;
+	SpscRing<OutboundNetworkPacket, NETWORK_OUTBOUND_RING_CAPACITY> outboundNetworkPackets;
+	// Paquets fiables qui n'ont pas trouvé place dans l'anneau: la simulation ne se bloque
+	// jamais dessus (le thread réseau peut lui-même attendre de la place côté entrant).
+	std::deque<OutboundNetworkPacket> outboundOverflow;
+	size_t profileOutboundOverflowPeak = 0;
+	std::thread networkThread;
+	std::atomic<bool> networkThreadRunning = false;
+	std::mutex networkWakeMutex;
+	std::condition_variable networkWakeCv;
 	std::unordered_map<std::string, uint64_t> activeUsernames;
 		std::unordered_set<int64_t> dirtyChunkKeys;
 		std::unordered_set<int64_t> queuedDirtyChunkKeys;
@@ -428,20 +844,31 @@ struct WorldServer::Impl
 			mutable std::mutex persistedChunkKeysMutex;
 			std::unordered_set<int64_t> persistedChunkKeys;
 			mutable std::mutex saveMutex;
-		std::condition_variable saveCv;
-		std::deque<SaveBatchJob> saveJobs;
+		// Lots compressés en parallèle, écrits dans l'ordre de leur séquence.
+		std::map<uint64_t, SaveBatchJob> preparedSaveBatches;
 		std::unordered_map<int64_t, size_t> pendingSaveChunkCounts;
-		std::thread saveWorker;
-		bool saveStopRequested = false;
+		uint64_t nextSaveBatchSequence = 0;
+		uint64_t nextSaveBatchToWrite = 0;
+		size_t pendingSaveBatchCount = 0;
+		// Chunks dont la dernière sauvegarde en vol vient d'aboutir, repris par le tick.
+		std::vector<int64_t> savedChunkKeys;
+		bool saveWriterActive = false;
+		bool saveRetryRequested = false;
 
 	std::atomic<bool> running = false;
 	std::mutex taskMutex;
-	std::condition_variable taskCv;
-	std::deque<ChunkCoord> generationTasks;
+	// Tas de priorité (distance/vue du joueur intéressé le plus proche), entrées périmées ignorées au pop.
+	std::vector<GenerationTask> loadTaskHeap;
+	std::vector<GenerationTask> generationTaskHeap;
+	std::unordered_map<int64_t, PendingGenerationTask> pendingGenerationTasks;
 	std::unordered_set<int64_t> scheduledChunkKeys;
+	uint64_t nextGenerationTaskSequence = 1;
+	// Thread de simulation seulement: un joueur a assez bougé, ou les tas sont pleins d'entrées annulées.
+	bool generationPrioritiesStale = false;
+	size_t profileCancelledGenerationTasks = 0;
 	std::mutex readyMutex;
 	std::deque<ReadyChunk> readyChunks;
-	std::vector<std::thread> workers;
+	JobSystem jobSystem;
 	size_t workerCount = 0;
 	bool profileWorkers = false;
 	std::filesystem::path connectionLogPath = SERVER_CONNECTION_LOG_PATH;
@@ -469,6 +896,26 @@ struct WorldServer::Impl
 	size_t profileSnapshotPayloadBytes = 0;
 	size_t profileSnapshotRawBytes = 0;
 	size_t profileSnapshotSectionCount = 0;
+	size_t profileSectionDeltaCount = 0;
+	size_t profileSectionDeltaBytes = 0;
+	size_t profileSnapshotReencodes = 0;
+	size_t profileStaleSnapshotReplays = 0;
+	size_t profileCodecSnapshots[CHUNK_CODEC_COUNT] = {};
+	size_t profileCodecVariantEncodes = 0;
+	size_t profileReplicationPasses = 0;
+	uint64_t profileReplicationMicros = 0;
+	uint64_t profileReplicationMicrosMax = 0;
+	size_t profileReplicationExamined = 0;
+	size_t profileReplicationUpdates = 0;
+	size_t profileReplicationBytes = 0;
+	// Temps de travail d'une itération de la boucle de simulation (hors attente réseau).
+	uint64_t profileLoopIterations = 0;
+	uint64_t profileLoopMicros = 0;
+	uint64_t profileLoopMicrosMax = 0;
+	size_t profileAuthCompleted = 0;
+	size_t profileAuthRejectedBusy = 0;
+	uint64_t profileAuthMicros = 0;
+	uint64_t profileAuthMicrosMax = 0;
 	uint64_t nextChunkSnapshotPacketId = 1;
 	std::atomic<size_t> profileSaveBatchCount = 0;
 	std::atomic<size_t> profileSavedChunkCount = 0;
@@ -480,20 +927,25 @@ struct WorldServer::Impl
 				 std::string selectedPlayerDatabasePath,
 				 std::string selectedWorldDatabasePath,
 				 bool shouldPersistGeneratedChunks,
-				 ServerEnvironmentOptions selectedEnvironmentOptions)
+				 ServerEnvironmentOptions selectedEnvironmentOptions,
+				 ShardLayout selectedShard,
+				 const std::string &selectedShardToken)
 				: port(listenPort),
 				  playerDatabasePath(std::move(selectedPlayerDatabasePath)),
 				  worldDatabasePath(std::move(selectedWorldDatabasePath)),
 				  persistGeneratedChunks(shouldPersistGeneratedChunks),
 			  environmentOptions(selectedEnvironmentOptions),
+			  shard(selectedShard),
 			  generator(std::move(worldGenerator)),
 		  generationMode(selectedGenerationMode),
 		  profileWorkers(environmentOptions.profileWorkersEnabled)
 	{
+		std::memcpy(shardToken, selectedShardToken.data(), std::min(selectedShardToken.size(), SHARD_TOKEN_MAX_LENGTH));
 		if (environmentOptions.streamTickMs == 0)
 		{
 			environmentOptions.streamTickMs = DEFAULT_STREAM_TICK_MS;
 		}
+		chunkSendScheduler.setHostBytesPerSecond(environmentOptions.hostEgressBytesPerSecond);
 		frontier.playableBounds = makeSquareBounds(INITIAL_PLAYABLE_RADIUS);
 			frontier.paddingChunks = INITIAL_PADDING_CHUNKS;
 			frontier.generatedBounds = frontier.playableBounds.expanded(frontier.paddingChunks);
@@ -509,19 +961,37 @@ struct WorldServer::Impl
 
 		bool start()
 		{
-				if (!playerTable.open(playerDatabasePath))
+				playerSaveQueue.setCommitHistogram(&metrics.playerSaveCommit);
+				if (!playerSaveQueue.open(playerDatabasePath))
 				{
 				std::cerr << "Failed to open player database: "
-						  << playerTable.lastError() << std::endl;
+						  << playerSaveQueue.lastError() << std::endl;
 				return false;
 			}
+				if (!authPlayerTable.open(playerDatabasePath))
+				{
+					std::cerr << "Failed to open player database for authentication: "
+							  << authPlayerTable.lastError() << std::endl;
+					playerSaveQueue.close();
+					return false;
+				}
 				if (!worldTable.open(worldDatabasePath, worldGenerationModeName(generationMode)))
 				{
 					std::cerr << "Failed to open world database: "
 							  << worldTable.lastErrorCopy() << std::endl;
-					playerTable.close();
+					authPlayerTable.close();
+					playerSaveQueue.close();
 					return false;
 				}
+					if (std::shared_ptr<const ChunkZstdDictionary> dictionary = activeChunkZstdDictionary())
+					{
+						ChunkZstdDictionaryMessage dictionaryMessage;
+						dictionaryMessage.dictionaryId = dictionary->id();
+						dictionaryMessage.content = dictionary->content();
+						chunkDictionaryPacket = encodeChunkZstdDictionary(dictionaryMessage);
+						std::cout << "Chunk zstd dictionary " << dictionary->id()
+								  << " (" << dictionary->content().size() << " bytes)" << std::endl;
+					}
 					if (!persistGeneratedChunks)
 					{
 						if (!loadPersistedChunkKeys())
@@ -529,14 +999,16 @@ struct WorldServer::Impl
 							std::cerr << "Failed to preload modified chunk keys: "
 									  << worldTable.lastErrorCopy() << std::endl;
 							worldTable.close();
-					playerTable.close();
+					authPlayerTable.close();
+					playerSaveQueue.close();
 					return false;
 				}
 			}
 			if (!loadActivityFrontierState())
 			{
 				worldTable.close();
-				playerTable.close();
+				authPlayerTable.close();
+				playerSaveQueue.close();
 				return false;
 			}
 			initializeConnectionLog();
@@ -549,8 +1021,13 @@ struct WorldServer::Impl
 
 		ENetAddress address{};
 		address.host = ENET_HOST_ANY;
+		if (shard.isSharded())
+		{
+			// Seule la passerelle parle aux shards: boucle locale seulement.
+			enet_address_set_host(&address, "127.0.0.1");
+		}
 		address.port = port;
-		host = enet_host_create(&address, 32, 2, 0, 0);
+		host = enet_host_create(&address, MAX_CLIENT_PEERS, 2, 0, 0);
 		if (host == nullptr)
 		{
 			return false;
@@ -558,18 +1035,48 @@ struct WorldServer::Impl
 
 		running = true;
 		workerCount = computeWorkerCount(environmentOptions.requestedWorkerCount);
-		for (size_t i = 0; i < workerCount; i++)
+		jobSystem.start(workerCount);
+		size_t authWorkerCount = environmentOptions.authWorkerCount;
+		if (authWorkerCount == 0)
+		{
+			authWorkerCount = std::clamp<size_t>(std::thread::hardware_concurrency() / 2, 1, MAX_DEFAULT_AUTH_WORKERS);
+		}
+		authWorkers.start(authWorkerCount, AUTH_ADMISSION_QUEUE_CAPACITY);
+		if (!metricsExporter.start(metricsRegistry,
+								   environmentOptions.metricsPort,
+								   environmentOptions.metricsJsonlPath,
+								   environmentOptions.metricsJsonlIntervalMs))
+		{
+			// Les métriques ne sont pas vitales: on sert les joueurs sans elles.
+			std::cerr << "Metrics export disabled: " << metricsExporter.lastError() << std::endl;
+		}
+		else if (environmentOptions.metricsPort != 0)
+		{
+			std::cout << "Metrics on http://127.0.0.1:" << environmentOptions.metricsPort << "/metrics" << std::endl;
+		}
+		if (!environmentOptions.packetTracePath.empty())
 		{
-			workers.emplace_back(&Impl::workerLoop, this);
+			if (packetTrace.open(environmentOptions.packetTracePath))
+			{
+				std::cout << "Recording inbound packets to " << environmentOptions.packetTracePath << std::endl;
+			}
+			else
+			{
+				std::cerr << "Packet trace disabled: " << packetTrace.lastError() << std::endl;
+			}
 		}
-		saveStopRequested = false;
-		saveWorker = std::thread(&Impl::saveWorkerLoop, this);
 		profileWindowStart = std::chrono::steady_clock::now();
 
 			std::cout << "WorldServer listening on port " << port
-					  << " with " << workerCount << " generation worker(s)"
+					  << " with " << workerCount << " job worker(s)"
 					  << " in " << worldGenerationModeName(generationMode)
 					  << " mode" << std::endl;
+			if (shard.isSharded())
+			{
+				std::cout << "Serving shard " << shard.index << "/" << shard.count
+						  << " (" << SHARD_REGION_SIZE_CHUNKS << "x" << SHARD_REGION_SIZE_CHUNKS
+						  << " chunk regions)" << std::endl;
+			}
 			std::cout << "Chunk stream tick: " << environmentOptions.streamTickMs << " ms" << std::endl;
 				std::cout << "World DB path: " << worldDatabasePath << std::endl;
 			if (!persistGeneratedChunks)
@@ -584,6 +1091,8 @@ struct WorldServer::Impl
 		}
 
 		bootstrapInitialWorld();
+		networkThreadRunning = true;
+		networkThread = std::thread(&Impl::networkThreadLoop, this);
 		return true;
 	}
 
@@ -593,7 +1102,8 @@ struct WorldServer::Impl
 		{
 			integrateReadyChunks((std::numeric_limits<size_t>::max)());
 				flushDirtyChunks((std::numeric_limits<size_t>::max)());
-				stopSaveWorker();
+				stopJobSystem();
+				authWorkers.stop();
 				saveAllAuthenticatedPlayers();
 				saveActivityFrontierState();
 				cleanupNetwork();
@@ -601,18 +1111,12 @@ struct WorldServer::Impl
 			}
 
 		running = false;
-		taskCv.notify_all();
-		for (std::thread &worker : workers)
-		{
-			if (worker.joinable())
-			{
-				worker.join();
-			}
-		}
-		workers.clear();
+		// Les jobs Load/Generate encore en file sortent tout de suite, les encodages finissent.
+		jobSystem.waitIdle();
 		integrateReadyChunks((std::numeric_limits<size_t>::max)());
 			flushDirtyChunks((std::numeric_limits<size_t>::max)());
-			stopSaveWorker();
+			stopJobSystem();
+			authWorkers.stop();
 			saveAllAuthenticatedPlayers();
 			saveActivityFrontierState();
 			cleanupNetwork();
@@ -620,12 +1124,19 @@ struct WorldServer::Impl
 
 	void cleanupNetwork()
 	{
+		metricsExporter.stop();
+		stopNetworkThread();
+		if (packetTrace.isOpen())
+		{
+			std::cout << "Packet trace closed after " << packetTrace.recordCount() << " record(s)" << std::endl;
+			packetTrace.close();
+		}
 		if (host != nullptr)
 		{
 			enet_host_destroy(host);
 			host = nullptr;
 		}
-		pendingChunkPackets.clear();
+		drainFreedChunkPackets();
 		if (enetInitialized)
 		{
 			enet_deinitialize();
@@ -636,7 +1147,11 @@ struct WorldServer::Impl
 			connectionLogFile.close();
 		}
 		worldTable.close();
-		playerTable.close();
+		authPlayerTable.close();
+		if (!playerSaveQueue.close())
+		{
+			std::cerr << playerSaveQueue.lastError() << std::endl;
+		}
 	}
 
 	int run()
@@ -654,26 +1169,24 @@ struct WorldServer::Impl
 				break;
 			}
 
-			auto now = clock::now();
 			auto nextNetworkDeadline = nextTick;
 			if (nextStreamTick < nextNetworkDeadline)
 			{
 				nextNetworkDeadline = nextStreamTick;
 			}
-
-			uint32_t networkWaitMs = 0;
-			if (nextNetworkDeadline > now)
 			{
-				auto waitMicros = std::chrono::duration_cast<std::chrono::microseconds>(
-					nextNetworkDeadline - now);
-				if (waitMicros.count() > 0)
-				{
-					networkWaitMs = static_cast<uint32_t>((waitMicros.count() + 999) / 1000);
-				}
+				// Le thread réseau nous réveille dès qu'il a poussé des évènements.
+				std::unique_lock<std::mutex> lock(networkWakeMutex);
+				networkWakeCv.wait_until(lock, nextNetworkDeadline, [&]()
+										 { return !inboundNetworkEvents.empty(); });
 			}
 
-			serviceNetwork(networkWaitMs);
-			now = clock::now();
+			auto loopStart = clock::now();
+			flushOutboundOverflow();
+			processInboundNetworkEvents();
+			drainFreedChunkPackets();
+			applyCompletedAuthResults();
+			auto now = clock::now();
 			if (now >= nextStreamTick)
 			{
 				streamTick();
@@ -684,6 +1197,12 @@ struct WorldServer::Impl
 				tick();
 				nextTick = now + std::chrono::milliseconds(SERVER_TICK_MS);
 			}
+			uint64_t loopMicros = static_cast<uint64_t>(
+				std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - loopStart).count());
+			profileLoopIterations++;
+			profileLoopMicros += loopMicros;
+			profileLoopMicrosMax = std::max(profileLoopMicrosMax, loopMicros);
+			metrics.loopWork.record(loopMicros);
 
 			FrameMark;
 		}
@@ -694,9 +1213,7 @@ struct WorldServer::Impl
 	void bootstrapInitialWorld()
 	{
 		const ChunkBounds &initialBounds = frontier.generatedBounds;
-		size_t expectedChunkCount =
-			static_cast<size_t>(initialBounds.widthChunks()) *
-			static_cast<size_t>(initialBounds.depthChunks());
+		size_t expectedChunkCount = ownedChunkCount(initialBounds);
 
 		scheduleBounds(initialBounds);
 
@@ -710,6 +1227,22 @@ struct WorldServer::Impl
 				  << " generated chunk(s)" << std::endl;
 	}
 
+	size_t ownedChunkCount(const ChunkBounds &bounds) const
+	{
+		size_t count = 0;
+		for (int cx = bounds.minChunkX; cx < bounds.maxChunkXExclusive; cx++)
+		{
+			for (int cz = bounds.minChunkZ; cz < bounds.maxChunkZExclusive; cz++)
+			{
+				if (shard.owns(cx, cz))
+				{
+					count++;
+				}
+			}
+		}
+		return count;
+	}
+
 	void updateExpansionProgress()
 	{
 		if (generationMode == WorldGenerationMode::ClassicStreaming)
@@ -757,6 +1290,10 @@ struct WorldServer::Impl
 
 		bool canStreamChunkRequest(int chunkX, int chunkZ) const
 		{
+			if (!shard.owns(chunkX, chunkZ))
+			{
+				return false;
+			}
 			if (usesClassicStreaming())
 			{
 			return true;
@@ -810,26 +1347,28 @@ struct WorldServer::Impl
 			return false;
 		}
 
-			void workerLoop()
-			{
-			while (running)
+			void runChunkJob(JobPriority priority)
 			{
-				ChunkCoord coord;
-			{
-				std::unique_lock<std::mutex> lock(taskMutex);
-				taskCv.wait(lock, [&]()
-							{ return !running || !generationTasks.empty(); });
-				if (!running && generationTasks.empty())
+				if (!running)
 				{
 					return;
 				}
-				coord = generationTasks.front();
-				generationTasks.pop_front();
+
+				ChunkCoord coord;
+				{
+					std::lock_guard<std::mutex> lock(taskMutex);
+					std::vector<GenerationTask> &heap =
+						priority == JobPriority::Load ? loadTaskHeap : generationTaskHeap;
+					if (!popNextGenerationTaskNoLock(heap, coord))
+					{
+						// Tâche annulée entre-temps: le job n'a plus rien à faire.
+						return;
+					}
 				}
 
-					ZoneScopedN("Worker Generate Chunk");
+					ZoneScopedN("Job Load/Generate Chunk");
 					ReadyChunk readyChunk;
-					readyChunk.chunk = VoxelChunkData(coord.x, coord.z);
+					readyChunk.chunk = ChunkPool::instance().acquire(coord.x, coord.z);
 					int64_t key = chunkKey(coord.x, coord.z);
 					bool loadedFromStorage = false;
 					bool shouldTryStorageLoad = true;
@@ -848,7 +1387,7 @@ struct WorldServer::Impl
 							loadResult = worldTable.loadChunkResult(
 								coord.x,
 								coord.z,
-								readyChunk.chunk,
+								*readyChunk.chunk,
 								&loadError);
 						}
 						auto loadEnd = std::chrono::steady_clock::now();
@@ -857,6 +1396,7 @@ struct WorldServer::Impl
 								loadEnd - loadStart)
 								.count());
 
+						metrics.sqliteLoad.record(loadMicros);
 						if (loadResult == WorldTableLoadChunkResult::Loaded)
 						{
 							loadedFromStorage = true;
@@ -869,6 +1409,7 @@ struct WorldServer::Impl
 									  << coord.z << " from storage: "
 									  << loadError << std::endl;
 							profileLoadErrorChunks.fetch_add(1, std::memory_order_relaxed);
+							metrics.chunkLoadErrors.add();
 						}
 					}
 					readyChunk.loadedFromStorage = loadedFromStorage;
@@ -876,13 +1417,14 @@ struct WorldServer::Impl
 					if (loadedFromStorage)
 					{
 						profileLoadedChunks.fetch_add(1, std::memory_order_relaxed);
+						metrics.chunksLoaded.add();
 					}
 					else
 					{
 						auto generationStart = std::chrono::steady_clock::now();
 						{
 							ZoneScopedN("CPU: FastNoise Gen Terrain");
-							generator->fillChunk(readyChunk.chunk);
+							generator->fillChunk(*readyChunk.chunk);
 						}
 						auto generationEnd = std::chrono::steady_clock::now();
 						uint64_t generationMicros = static_cast<uint64_t>(
@@ -892,152 +1434,579 @@ struct WorldServer::Impl
 					profileGeneratedChunkMicros.fetch_add(generationMicros, std::memory_order_relaxed);
 					updateAtomicMax(profileGeneratedChunkMicrosMax, generationMicros);
 					profileGeneratedFreshChunks.fetch_add(1, std::memory_order_relaxed);
+					metrics.generate.record(generationMicros);
+					metrics.chunksGenerated.add();
 				}
 
-				if (workerCount > 1)
+				submitEncodeJob(std::move(readyChunk));
+			}
+
+		void submitEncodeJob(ReadyChunk &&readyChunk)
+		{
+			// L'encodage Zstd sort de la boucle d'envoi ENet, sur n'importe quel coeur libre.
+			jobSystem.submit(JobPriority::Encode, [this, readyChunk = std::move(readyChunk)]() mutable
+							 {
+				ZoneScopedN("Job Encode Chunk Snapshot");
 				{
-					// Sur les machines plus larges, on fait l'encodage dans les workers déjà
-					// existants pour sortir Zstd de la boucle d'envoi ENet sans ajouter de thread.
-					readyChunk.snapshotSectionCount = static_cast<uint8_t>(readyChunk.chunk.nonEmptySectionCount());
-					readyChunk.snapshotRawBytes = chunkSnapshotRawPayloadBytes(readyChunk.chunk);
-					readyChunk.snapshotPayload = encodeChunkSnapshotNetwork(readyChunk.chunk);
+					MetricsScopeTimer encodeTimer(metrics.encode);
+					readyChunk.snapshotSectionCount = static_cast<uint8_t>(readyChunk.chunk->nonEmptySectionCount());
+					readyChunk.snapshotRawBytes = chunkSnapshotRawPayloadBytes(*readyChunk.chunk);
+					readyChunk.snapshotPayload = encodeChunkSnapshotNetwork(*readyChunk.chunk);
+					uint32_t codecs = extraChunkCodecs.load(std::memory_order_relaxed);
+					for (size_t codecIndex = 0; codecIndex < CHUNK_CODEC_COUNT; codecIndex++)
+					{
+						ChunkCodec codec = static_cast<ChunkCodec>(codecIndex);
+						if ((codecs & chunkCodecBit(codec)) != 0)
+						{
+							readyChunk.codecPayloads[codecIndex] = std::make_shared<const std::vector<uint8_t>>(
+								encodeChunkSnapshotNetwork(*readyChunk.chunk, codec));
+						}
+					}
 				}
 
 				std::lock_guard<std::mutex> readyLock(readyMutex);
 				readyChunks.push_back(std::move(readyChunk));
-				profileReadyChunks.fetch_add(1, std::memory_order_relaxed);
-			}
+				profileReadyChunks.fetch_add(1, std::memory_order_relaxed); });
 		}
 
-	void serviceNetwork(uint32_t timeoutMs)
+	void processInboundNetworkEvents()
 	{
-		if (host == nullptr)
-		{
-			return;
-		}
-
-		ENetEvent event{};
-		while (enet_host_service(host, &event, timeoutMs) > 0)
+		InboundNetworkEvent event;
+		while (inboundNetworkEvents.tryPop(event))
 		{
-			timeoutMs = 0;
 			if (event.type == ENET_EVENT_TYPE_CONNECT)
 			{
-				handleConnect(event.peer);
+				handleConnect(event.peer, event.connectId, event.address);
+				traceConnect(event.peer);
 				continue;
 			}
 			if (event.type == ENET_EVENT_TYPE_DISCONNECT)
 			{
+				traceDisconnect(event.peer);
 				handleDisconnect(event.peer);
 				continue;
 			}
 			if (event.type == ENET_EVENT_TYPE_RECEIVE)
 			{
+				tracePacket(event.peer, event.channel, event.packet->data, event.packet->dataLength);
 				handlePacket(event.peer, event.packet->data, event.packet->dataLength);
 				enet_packet_destroy(event.packet);
+				continue;
+			}
+			auto sessionIt = clients.find(event.peer);
+			if (sessionIt != clients.end() && sessionIt->second.connectId == event.connectId)
+			{
+				applyPeerLinkStats(sessionIt->second, event.linkStats);
 			}
 		}
 	}
 
-	void tick()
+	void traceConnect(ENetPeer *peer)
 	{
-		ZoneScopedN("Server Tick");
-		if (expansionVote.active && systemNowMs() >= expansionVote.voteEndsAtMs)
+		if (!packetTrace.isOpen())
 		{
-			failExpansionVote("Expansion failed.");
+			return;
+		}
+		auto sessionIt = clients.find(peer);
+		if (sessionIt == clients.end())
+		{
+			return;
+		}
+		sessionIt->second.traceSessionId = packetTrace.recordConnect();
+		if (sessionIt->second.traceSessionId == 0)
+		{
+			stopPacketTrace();
 		}
-		flushDirtyChunks(DEFAULT_MAX_CHUNK_SAVES_PER_TICK);
-		unloadColdChunks(unloadChunksBudgetForTick());
-		logWorkerProfileWindowIfNeeded();
 	}
 
-	void streamTick()
+	void traceDisconnect(ENetPeer *peer)
 	{
-		integrateReadyChunks(integratedChunksBudgetForStreamTick());
-		for (auto &entry : clients)
+		if (!packetTrace.isOpen())
+		{
+			return;
+		}
+		auto sessionIt = clients.find(peer);
+		if (sessionIt == clients.end() || sessionIt->second.traceSessionId == 0)
+		{
+			return;
+		}
+		if (!packetTrace.recordDisconnect(sessionIt->second.traceSessionId))
 		{
-			sendQueuedChunks(entry.second, chunkSendBudgetForClientStreamTick(entry.second.chunkStream));
+			stopPacketTrace();
 		}
-		// On pousse les snapshots plus souvent que le tick gameplay pour réduire
-		// le temps passé en file d'attente avant l'émission réseau.
-		enet_host_flush(host);
 	}
 
-	bool isChunkWantedByAnyClient(int64_t key) const
+	void tracePacket(ENetPeer *peer, uint8_t channel, const uint8_t *data, size_t size)
 	{
-		for (const auto &entry : clients)
+		if (!packetTrace.isOpen())
 		{
-			const ClientSession &session = entry.second;
-			if (session.chunkStream.wantedChunks.find(key) != session.chunkStream.wantedChunks.end())
-			{
-				return true;
-			}
+			return;
 		}
-		return false;
-	}
-
-		bool canUnloadChunkNow(int64_t key) const
+		auto sessionIt = clients.find(peer);
+		if (sessionIt == clients.end() || sessionIt->second.traceSessionId == 0)
 		{
-		if (dirtyChunkKeys.find(key) != dirtyChunkKeys.end())
+			return;
+		}
+		if (!packetTrace.recordPacket(sessionIt->second.traceSessionId, channel, data, size))
 		{
-			return false;
+			stopPacketTrace();
 		}
-			if (queuedDirtyChunkKeys.find(key) != queuedDirtyChunkKeys.end())
+	}
+
+	// Une trace qui n'écrit plus (disque plein...) s'arrête; le serveur continue.
+	void stopPacketTrace()
+	{
+		std::cerr << "Packet trace stopped: " << packetTrace.lastError() << std::endl;
+		packetTrace.close();
+	}
+
+	void applyPeerLinkStats(ClientSession &session, const PeerLinkStats &stats)
+	{
+		ClientSession::ClientLinkState &link = session.link;
+		link.stats = stats;
+		link.statsReceived = true;
+
+		auto now = std::chrono::steady_clock::now();
+		ChunkSendLinkSample sample;
+		sample.roundTripTimeMs = stats.roundTripTimeMs;
+		sample.throttle = static_cast<float>(stats.packetThrottle) / static_cast<float>(ENET_PEER_PACKET_THROTTLE_SCALE);
+		sample.lossRate = static_cast<float>(stats.packetLoss) / static_cast<float>(ENET_PEER_PACKET_LOSS_SCALE);
+		sample.ackedBytes = link.sendWindowAckedBytes;
+		sample.peakInFlightBytes = session.chunkStream.peakPendingChunkBytes;
+		sample.elapsedSeconds = std::chrono::duration<double>(now - link.lastLinkSample).count();
+		link.sendController.onLinkSample(sample);
+		link.sendWindowAckedBytes = 0;
+		link.lastLinkSample = now;
+		session.chunkStream.peakPendingChunkBytes = session.chunkStream.pendingChunkBytes;
+	}
+
+	// Seul ce thread touche à l'hôte ENet: acks et lectures ne dépendent plus de la durée du tick.
+	void networkThreadLoop()
+	{
+		auto nextLinkStats = std::chrono::steady_clock::now();
+		while (networkThreadRunning.load(std::memory_order_acquire))
+		{
+			size_t sentCount = sendOutboundNetworkPackets();
+
+			bool pushedEvents = false;
+			auto now = std::chrono::steady_clock::now();
+			if (now >= nextLinkStats)
 			{
-				return false;
+				pushedEvents = pushPeerLinkStats();
+				nextLinkStats = now + std::chrono::milliseconds(NETWORK_LINK_STATS_INTERVAL_MS);
 			}
-			if (isChunkPendingSave(key))
+			uint32_t timeoutMs = sentCount > 0 ? 0 : NETWORK_THREAD_SERVICE_TIMEOUT_MS;
+			ENetEvent event{};
+			while (enet_host_service(host, &event, timeoutMs) > 0)
 			{
-				return false;
+				timeoutMs = 0;
+				InboundNetworkEvent inbound;
+				inbound.type = event.type;
+				inbound.peer = event.peer;
+				if (event.type == ENET_EVENT_TYPE_CONNECT)
+				{
+					// Ce réglage agit surtout sur les envois non fiables d'ENet.
+					// On le garde aligné avec le client pour les essais de streaming agressif.
+					enet_peer_throttle_configure(event.peer, 5000, 6, 3);
+					inbound.connectId = event.peer->connectID;
+					inbound.address = event.peer->address;
+				}
+				else if (event.type == ENET_EVENT_TYPE_RECEIVE)
+				{
+					inbound.packet = event.packet;
+					inbound.channel = event.channelID;
+				}
+				else if (event.type != ENET_EVENT_TYPE_DISCONNECT)
+				{
+					continue;
+				}
+
+				// File pleine: on attend la simulation plutôt que de perdre un paquet fiable,
+				// en vidant l'anneau sortant pour qu'elle ne reste pas bloquée de son côté.
+				while (!inboundNetworkEvents.tryPush(std::move(inbound)))
+				{
+					wakeSimulationThread();
+					sendOutboundNetworkPackets();
+					std::this_thread::yield();
+				}
+				pushedEvents = true;
 			}
-			if (isChunkWantedByAnyClient(key))
+
+			enet_host_flush(host);
+			if (pushedEvents)
 			{
-				return false;
+				wakeSimulationThread();
+			}
 		}
-		return true;
 	}
 
-		size_t unloadChunksBudgetForTick() const
+	bool pushPeerLinkStats()
+	{
+		bool pushed = false;
+		for (size_t peerIndex = 0; peerIndex < host->peerCount; peerIndex++)
 		{
-			if (!usesOptimizedStreamingBudgets())
+			ENetPeer *peer = &host->peers[peerIndex];
+			if (peer->state != ENET_PEER_STATE_CONNECTED)
 			{
-				return DEFAULT_MAX_CHUNK_UNLOADS_PER_TICK;
+				continue;
 			}
-			return CLASSIC_MAX_CHUNK_UNLOADS_PER_TICK;
+			InboundNetworkEvent inbound;
+			inbound.peer = peer;
+			inbound.connectId = peer->connectID;
+			inbound.linkStats.roundTripTimeMs = peer->roundTripTime;
+			inbound.linkStats.roundTripTimeVarianceMs = peer->roundTripTimeVariance;
+			inbound.linkStats.packetLoss = peer->packetLoss;
+			inbound.linkStats.packetThrottle = peer->packetThrottle;
+			inbound.linkStats.reliableDataInTransit = peer->reliableDataInTransit;
+			// Un échantillon perdu sera remplacé au suivant: on ne bloque pas pour lui.
+			if (!inboundNetworkEvents.tryPush(std::move(inbound)))
+			{
+				break;
+			}
+			pushed = true;
+		}
+		return pushed;
 	}
 
-	void unloadColdChunks(size_t maxCount)
+	void wakeSimulationThread()
 	{
-		if (maxCount == 0 || worldChunks.empty())
 		{
-			return;
+			std::lock_guard<std::mutex> lock(networkWakeMutex);
 		}
+		networkWakeCv.notify_one();
+	}
 
-		size_t unloadedCount = 0;
-		for (auto it = worldChunks.begin();
-			 it != worldChunks.end() && unloadedCount < maxCount;)
-		{
-			int64_t key = it->first;
-			if (!canUnloadChunkNow(key))
+	size_t sendOutboundNetworkPackets()
+	{
+		size_t sentCount = 0;
+		OutboundNetworkPacket outbound;
+		while (outboundNetworkPackets.tryPop(outbound))
+		{
+			bool sameConnection =
+				outbound.peer->state == ENET_PEER_STATE_CONNECTED &&
+				outbound.peer->connectID == outbound.connectId;
+			if (!sameConnection ||
+				enet_peer_send(outbound.peer, outbound.channel, outbound.packet) != 0)
 			{
-				++it;
+				enet_packet_destroy(outbound.packet);
 				continue;
 			}
-
-			invalidateChunkSnapshotCache(key);
-			it = worldChunks.erase(it);
-			unloadedCount++;
+			sentCount++;
 		}
-
-		profileUnloadedChunks += unloadedCount;
+		return sentCount;
 	}
 
-	void integrateReadyChunks(size_t maxCount)
+	void stopNetworkThread()
 	{
-		size_t integratedCount = 0;
-
-		while (integratedCount < maxCount)
+		if (networkThread.joinable())
 		{
-				ReadyChunk readyChunk;
+			networkThreadRunning = false;
+			networkThread.join();
+		}
+		// Plus de concurrence: on pousse ce qui reste puis on jette les entrées non lues.
+		if (host != nullptr)
+		{
+			sendOutboundNetworkPackets();
+			while (!outboundOverflow.empty())
+			{
+				flushOutboundOverflow();
+				sendOutboundNetworkPackets();
+			}
+			enet_host_flush(host);
+		}
+		OutboundNetworkPacket outbound;
+		while (outboundNetworkPackets.tryPop(outbound))
+		{
+			enet_packet_destroy(outbound.packet);
+		}
+		for (OutboundNetworkPacket &overflowed : outboundOverflow)
+		{
+			enet_packet_destroy(overflowed.packet);
+		}
+		outboundOverflow.clear();
+		InboundNetworkEvent inbound;
+		while (inboundNetworkEvents.tryPop(inbound))
+		{
+			if (inbound.packet != nullptr)
+			{
+				enet_packet_destroy(inbound.packet);
+			}
+		}
+	}
+
+	// keepIfFull: un paquet fiable part plus tard via outboundOverflow plutôt que d'être refusé.
+	bool queueOutboundPacket(ENetPeer *peer, uint32_t connectId, uint8_t channel, ENetPacket *packet, bool keepIfFull)
+	{
+		OutboundNetworkPacket outbound;
+		outbound.peer = peer;
+		outbound.connectId = connectId;
+		outbound.channel = channel;
+		outbound.packet = packet;
+		// Tant que le débordement n'est pas vidé, rien ne le double: l'ordre fiable est préservé.
+		if (outboundOverflow.empty() && outboundNetworkPackets.tryPush(std::move(outbound)))
+		{
+			return true;
+		}
+		if (!keepIfFull)
+		{
+			return false;
+		}
+		outboundOverflow.push_back(outbound);
+		profileOutboundOverflowPeak = std::max(profileOutboundOverflowPeak, outboundOverflow.size());
+		return true;
+	}
+
+	void flushOutboundOverflow()
+	{
+		while (!outboundOverflow.empty())
+		{
+			OutboundNetworkPacket outbound = outboundOverflow.front();
+			if (!outboundNetworkPackets.tryPush(std::move(outbound)))
+			{
+				return;
+			}
+			outboundOverflow.pop_front();
+		}
+	}
+
+	void tick()
+	{
+		ZoneScopedN("Server Tick");
+		MetricsScopeTimer tickTimer(metrics.tick);
+		if (expansionVote.active && systemNowMs() >= expansionVote.voteEndsAtMs)
+		{
+			failExpansionVote("Expansion failed.");
+		}
+		refreshGenerationPrioritiesIfStale();
+		retryFailedSaveBatchesIfNeeded();
+		collectSavedChunks();
+		{
+			MetricsScopeTimer phaseTimer(metrics.flushDirtyChunks);
+			flushDirtyChunks(DEFAULT_MAX_CHUNK_SAVES_PER_TICK);
+		}
+		{
+			MetricsScopeTimer phaseTimer(metrics.unloadChunks);
+			unloadColdChunks(unloadChunksBudgetForTick());
+		}
+		updateChunkCodecs();
+		autosavePlayersIfDue();
+		updateMetricGauges();
+		logWorkerProfileWindowIfNeeded();
+	}
+
+	void streamTick()
+	{
+		MetricsScopeTimer streamTickTimer(metrics.streamTick);
+		flushBlockUpdateBatches();
+		{
+			MetricsScopeTimer phaseTimer(metrics.replicatePlayers);
+			replicatePlayers();
+		}
+		drainCompletedSnapshotReencodes();
+		drainCompletedSnapshotCodecVariants();
+		submitDueSnapshotReencodes();
+		{
+			MetricsScopeTimer phaseTimer(metrics.integrateChunks);
+			integrateReadyChunks(integratedChunksBudgetForStreamTick());
+		}
+		{
+			MetricsScopeTimer phaseTimer(metrics.sendChunks);
+			sendQueuedChunks();
+		}
+		// Les snapshots partent vers le thread réseau à chaque stream tick, qui les émet aussitôt.
+	}
+
+	bool isChunkWantedByAnyClient(int64_t key) const
+	{
+		return chunkInterestCounts.find(key) != chunkInterestCounts.end();
+	}
+
+	void addChunkInterest(ClientSession &session, int64_t key)
+	{
+		if (!session.chunkStream.wantedChunks.insert(key).second)
+		{
+			return;
+		}
+		uint32_t &interestCount = chunkInterestCounts[key];
+		interestCount++;
+		if (interestCount == 1)
+		{
+			unlinkColdChunk(key);
+		}
+	}
+
+	// Retourne true quand plus aucun client ne veut le chunk.
+	bool releaseChunkInterest(int64_t key)
+	{
+		auto interestIt = chunkInterestCounts.find(key);
+		if (interestIt == chunkInterestCounts.end())
+		{
+			return true;
+		}
+		if (interestIt->second > 1)
+		{
+			interestIt->second--;
+			return false;
+		}
+		chunkInterestCounts.erase(interestIt);
+		refreshColdChunkState(key);
+		return true;
+	}
+
+	void linkColdChunk(WorldChunkEntry &entry)
+	{
+		if (entry.cold)
+		{
+			return;
+		}
+		entry.coldPrev = coldChunksTail;
+		entry.coldNext = nullptr;
+		if (coldChunksTail != nullptr)
+		{
+			coldChunksTail->coldNext = &entry;
+		}
+		else
+		{
+			coldChunksHead = &entry;
+		}
+		coldChunksTail = &entry;
+		entry.cold = true;
+		coldChunkCount++;
+	}
+
+	void unlinkColdChunk(WorldChunkEntry &entry)
+	{
+		if (!entry.cold)
+		{
+			return;
+		}
+		if (entry.coldPrev != nullptr)
+		{
+			entry.coldPrev->coldNext = entry.coldNext;
+		}
+		else
+		{
+			coldChunksHead = entry.coldNext;
+		}
+		if (entry.coldNext != nullptr)
+		{
+			entry.coldNext->coldPrev = entry.coldPrev;
+		}
+		else
+		{
+			coldChunksTail = entry.coldPrev;
+		}
+		entry.coldPrev = nullptr;
+		entry.coldNext = nullptr;
+		entry.cold = false;
+		coldChunkCount--;
+	}
+
+	void unlinkColdChunk(int64_t key)
+	{
+		auto worldIt = worldChunks.find(key);
+		if (worldIt != worldChunks.end())
+		{
+			unlinkColdChunk(worldIt->second);
+		}
+	}
+
+	// À rappeler dès qu'une condition de canUnloadChunkNow peut avoir changé.
+	void refreshColdChunkState(int64_t key)
+	{
+		auto worldIt = worldChunks.find(key);
+		if (worldIt == worldChunks.end())
+		{
+			return;
+		}
+		if (canUnloadChunkNow(key))
+		{
+			linkColdChunk(worldIt->second);
+		}
+		else
+		{
+			unlinkColdChunk(worldIt->second);
+		}
+	}
+
+	void collectSavedChunks()
+	{
+		std::vector<int64_t> keys;
+		{
+			std::lock_guard<std::mutex> lock(saveMutex);
+			keys.swap(savedChunkKeys);
+		}
+		for (int64_t key : keys)
+		{
+			refreshColdChunkState(key);
+		}
+	}
+
+		bool canUnloadChunkNow(int64_t key) const
+		{
+		if (dirtyChunkKeys.find(key) != dirtyChunkKeys.end())
+		{
+			return false;
+		}
+			if (queuedDirtyChunkKeys.find(key) != queuedDirtyChunkKeys.end())
+			{
+				return false;
+			}
+			if (isChunkPendingSave(key))
+			{
+				return false;
+			}
+			if (isChunkWantedByAnyClient(key))
+			{
+				return false;
+		}
+		return true;
+	}
+
+		size_t unloadChunksBudgetForTick() const
+		{
+			if (!usesOptimizedStreamingBudgets())
+			{
+				return DEFAULT_MAX_CHUNK_UNLOADS_PER_TICK;
+			}
+			return CLASSIC_MAX_CHUNK_UNLOADS_PER_TICK;
+	}
+
+	void unloadColdChunks(size_t maxCount)
+	{
+		if (maxCount == 0 || worldChunks.empty())
+		{
+			return;
+		}
+
+		// Les plus anciens chunks froids partent d'abord: coût proportionnel aux évictions.
+		size_t unloadedCount = 0;
+		while (unloadedCount < maxCount && coldChunksHead != nullptr)
+		{
+			WorldChunkEntry &entry = *coldChunksHead;
+			int64_t key = entry.key;
+			unlinkColdChunk(entry);
+			if (!canUnloadChunkNow(key))
+			{
+				continue;
+			}
+
+			invalidateChunkSnapshotCache(key);
+			chunkSectionHistory.erase(key);
+			worldChunks.erase(key);
+			unloadedCount++;
+		}
+
+		profileUnloadedChunks += unloadedCount;
+	}
+
+	void integrateReadyChunks(size_t maxCount)
+	{
+		size_t integratedCount = 0;
+
+		while (integratedCount < maxCount)
+		{
+				ReadyChunk readyChunk;
 				{
 					std::lock_guard<std::mutex> readyLock(readyMutex);
 					if (readyChunks.empty())
@@ -1047,26 +2016,35 @@ struct WorldServer::Impl
 					readyChunk = std::move(readyChunks.front());
 					readyChunks.pop_front();
 				}
-				VoxelChunkData chunk = std::move(readyChunk.chunk);
-
-				int64_t key = chunkKey(chunk.chunkX, chunk.chunkZ);
-				worldChunks[key] = std::move(chunk);
-				VoxelChunkData &storedChunk = worldChunks[key];
+				int64_t key = chunkKey(readyChunk.chunk->chunkX, readyChunk.chunk->chunkZ);
+				WorldChunkEntry &storedEntry = worldChunks[key];
+				storedEntry.key = key;
+				storedEntry.chunk = std::move(readyChunk.chunk);
+				const VoxelChunkData &storedChunk = *storedEntry.chunk;
 				CachedChunkSnapshotPayload &cachedPayload = chunkSnapshotPayloadCache[key];
 				cachedPayload.revision = storedChunk.revision;
 				if (readyChunk.snapshotPayload.empty())
 				{
-					// Sur les petites machines, on laisse le worker se concentrer sur la
-					// production du chunk, puis on pré-encode ici avant la boucle d'envoi.
+					// Normalement encodé par le job Encode; filet si le payload est vide.
 					cachedPayload.sectionCount = static_cast<uint8_t>(storedChunk.nonEmptySectionCount());
 					cachedPayload.rawBytes = chunkSnapshotRawPayloadBytes(storedChunk);
-					cachedPayload.payload = encodeChunkSnapshotNetwork(storedChunk);
+					cachedPayload.payload = std::make_shared<const std::vector<uint8_t>>(encodeChunkSnapshotNetwork(storedChunk));
 				}
 				else
 				{
 					cachedPayload.sectionCount = readyChunk.snapshotSectionCount;
 					cachedPayload.rawBytes = readyChunk.snapshotRawBytes;
-					cachedPayload.payload = std::move(readyChunk.snapshotPayload);
+					cachedPayload.payload = std::make_shared<const std::vector<uint8_t>>(std::move(readyChunk.snapshotPayload));
+				}
+				for (size_t codecIndex = 0; codecIndex < CHUNK_CODEC_COUNT; codecIndex++)
+				{
+					if (readyChunk.codecPayloads[codecIndex] == nullptr)
+					{
+						continue;
+					}
+					ChunkSnapshotCodecVariant &variant = chunkSnapshotCodecVariants[key][codecIndex];
+					variant.revision = storedChunk.revision;
+					variant.payload = std::move(readyChunk.codecPayloads[codecIndex]);
 				}
 				if (readyChunk.loadedFromStorage)
 				{
@@ -1085,12 +2063,13 @@ struct WorldServer::Impl
 					std::lock_guard<std::mutex> taskLock(taskMutex);
 					scheduledChunkKeys.erase(key);
 			}
+			refreshColdChunkState(key);
 			for (auto &entry : clients)
 			{
 				ClientSession &session = entry.second;
 				if (session.chunkStream.wantedChunks.find(key) != session.chunkStream.wantedChunks.end())
 				{
-					queueChunkForClient(session.chunkStream, key);
+					queueChunkForClient(session, key);
 				}
 			}
 			integratedCount++;
@@ -1098,12 +2077,47 @@ struct WorldServer::Impl
 		profileIntegratedChunks += integratedCount;
 	}
 
+	void updateMetricGauges()
+	{
+		{
+			std::lock_guard<std::mutex> taskLock(taskMutex);
+			metrics.generationTasks.set(static_cast<int64_t>(pendingGenerationTasks.size()));
+		}
+		metrics.clients.set(static_cast<int64_t>(clients.size()));
+		metrics.worldChunks.set(static_cast<int64_t>(worldChunks.size()));
+		metrics.dirtyChunks.set(static_cast<int64_t>(dirtyChunkKeys.size()));
+		metrics.jobsEncode.set(static_cast<int64_t>(jobSystem.pendingCount(JobPriority::Encode)));
+		metrics.jobsLoad.set(static_cast<int64_t>(jobSystem.pendingCount(JobPriority::Load)));
+		metrics.jobsGenerate.set(static_cast<int64_t>(jobSystem.pendingCount(JobPriority::Generate)));
+		metrics.jobsSaveCompress.set(static_cast<int64_t>(jobSystem.pendingCount(JobPriority::SaveCompress)));
+		metrics.authQueued.set(static_cast<int64_t>(authWorkers.queuedCount()));
+		metrics.playerSavesPending.set(static_cast<int64_t>(playerSaveQueue.pendingCount()));
+		// Une valeur par session et par tick: les quantiles disent combien de clients attendent, et combien.
+		for (const auto &entry : clients)
+		{
+			const ClientSession &session = entry.second;
+			if (!session.playerContext.playerSession.authenticated)
+			{
+				continue;
+			}
+			metrics.clientSendQueue.record(session.chunkStream.queuedChunks.size());
+			metrics.clientInFlightBytes.record(session.chunkStream.pendingChunkBytes);
+			// Le peer appartient au thread réseau: on lit l'instantané poussé par pushPeerLinkStats.
+			if (session.link.statsReceived)
+			{
+				metrics.clientRoundTripMs.record(session.link.stats.roundTripTimeMs);
+			}
+		}
+	}
+
 	void logWorkerProfileWindowIfNeeded()
 	{
 		size_t generationTaskCount = 0;
+		size_t cancelledTasksWindow = 0;
 		{
 			std::lock_guard<std::mutex> taskLock(taskMutex);
-			generationTaskCount = generationTasks.size();
+			generationTaskCount = pendingGenerationTasks.size();
+			cancelledTasksWindow = profileCancelledGenerationTasks;
 		}
 
 		size_t readyChunkCount = 0;
@@ -1151,6 +2165,7 @@ struct WorldServer::Impl
 		uint64_t generatedMicrosMaxWindow = profileGeneratedChunkMicrosMax.exchange(0, std::memory_order_relaxed);
 		size_t saveBatchWindow = profileSaveBatchCount.exchange(0, std::memory_order_relaxed);
 		size_t savedChunksWindow = profileSavedChunkCount.exchange(0, std::memory_order_relaxed);
+		PlayerSaveQueueStats playerSaveStats = playerSaveQueue.takeWindowStats();
 
 		size_t queuedSendCount = 0;
 		for (const auto &entry : clients)
@@ -1161,7 +2176,7 @@ struct WorldServer::Impl
 		size_t saveQueueJobsNow = 0;
 		{
 			std::lock_guard<std::mutex> lock(saveMutex);
-			saveQueueJobsNow = saveJobs.size();
+			saveQueueJobsNow = pendingSaveBatchCount;
 		}
 
 		ServerProfileMessage message;
@@ -1260,6 +2275,7 @@ struct WorldServer::Impl
 					  << " mode=" << worldGenerationModeName(generationMode)
 					  << " clients=" << clients.size()
 					  << " world_chunks=" << worldChunks.size()
+					  << " cold_chunks=" << coldChunkCount
 					  << " ready_window=" << readyWindow
 					  << " loaded_window=" << loadedWindow
 					  << " generated_fresh_window=" << generatedFreshWindow
@@ -1276,6 +2292,13 @@ struct WorldServer::Impl
 					  << " tasks_now=" << generationTaskCount
 					  << " tasks_avg=" << avgTasks
 					  << " tasks_max=" << profileMaxGenerationTasks
+					  << " tasks_cancelled_window=" << cancelledTasksWindow
+					  << " jobs_encode_now=" << jobSystem.pendingCount(JobPriority::Encode)
+					  << " jobs_load_now=" << jobSystem.pendingCount(JobPriority::Load)
+					  << " jobs_generate_now=" << jobSystem.pendingCount(JobPriority::Generate)
+					  << " jobs_save_now=" << jobSystem.pendingCount(JobPriority::SaveCompress)
+					  << " job_steals_window=" << jobSystem.takeStealCount()
+					  << " outbound_overflow_max=" << profileOutboundOverflowPeak
 					  << " ready_now=" << readyChunkCount
 					  << " ready_avg=" << avgReady
 					  << " ready_max=" << profileMaxReadyChunks
@@ -1293,6 +2316,126 @@ struct WorldServer::Impl
 						  << " snapshot_ratio=" << snapshotRatio;
 			}
 
+			if (profileSectionDeltaCount > 0)
+			{
+				std::cout << " section_deltas_window=" << profileSectionDeltaCount
+						  << " section_delta_avg_bytes="
+						  << static_cast<double>(profileSectionDeltaBytes) / static_cast<double>(profileSectionDeltaCount);
+			}
+
+			std::cout << " reencodes_window=" << profileSnapshotReencodes
+					  << " stale_replays_window=" << profileStaleSnapshotReplays;
+
+			size_t codecSessions[CHUNK_CODEC_COUNT] = {};
+			for (const auto &entry : clients)
+			{
+				codecSessions[static_cast<size_t>(entry.second.link.chunkCodec)]++;
+			}
+			// Format codec:sessions/snapshots, ex. codecs=sections:1/62,zstd_fast:0/0,...
+			std::cout << " codecs=";
+			for (size_t codecIndex = 0; codecIndex < CHUNK_CODEC_COUNT; codecIndex++)
+			{
+				std::cout << (codecIndex == 0 ? "" : ",")
+						  << chunkCodecName(static_cast<ChunkCodec>(codecIndex)) << ':'
+						  << codecSessions[codecIndex] << '/' << profileCodecSnapshots[codecIndex];
+			}
+			std::cout << " codec_variant_encodes_window=" << profileCodecVariantEncodes;
+
+			size_t linkSessions = 0;
+			size_t windowBytesSum = 0;
+			size_t windowBytesMin = std::numeric_limits<size_t>::max();
+			size_t inFlightBytes = 0;
+			uint32_t roundTripTimeMaxMs = 0;
+			uint64_t windowDecreases = 0;
+			uint64_t sendQueueRekeys = 0;
+			for (const auto &entry : clients)
+			{
+				sendQueueRekeys += entry.second.chunkStream.sendQueue.rekeyCount();
+				const ClientSession::ClientLinkState &link = entry.second.link;
+				if (!link.statsReceived)
+				{
+					continue;
+				}
+				linkSessions++;
+				windowBytesSum += link.sendController.windowBytes();
+				windowBytesMin = std::min(windowBytesMin, link.sendController.windowBytes());
+				inFlightBytes += entry.second.chunkStream.pendingChunkBytes;
+				roundTripTimeMaxMs = std::max(roundTripTimeMaxMs, link.stats.roundTripTimeMs);
+				windowDecreases += link.sendController.decreaseCount();
+			}
+			if (linkSessions > 0)
+			{
+				std::cout << " send_window_kib_avg=" << static_cast<double>(windowBytesSum) / 1024.0 / static_cast<double>(linkSessions)
+						  << " send_window_kib_min=" << windowBytesMin / 1024
+						  << " send_in_flight_kib_now=" << inFlightBytes / 1024
+						  << " link_rtt_ms_max=" << roundTripTimeMaxMs
+						  << " send_window_decreases_total=" << windowDecreases;
+			}
+			std::cout << " send_queue_rekeys_total=" << sendQueueRekeys;
+
+			// Octets servis par session (slot:servis/dont boostés, en KiB) et indice de Jain sur la fenêtre.
+			double servedSum = 0.0;
+			double servedSquares = 0.0;
+			size_t servedSessions = 0;
+			std::ostringstream servedList;
+			for (const auto &entry : clients)
+			{
+				const ChunkSendFlow &flow = entry.second.link.sendFlow;
+				if (flow.servedBytesWindow == 0 && entry.second.chunkStream.sendQueue.empty())
+				{
+					continue;
+				}
+				double served = static_cast<double>(flow.servedBytesWindow);
+				servedSum += served;
+				servedSquares += served * served;
+				servedList << (servedSessions == 0 ? "" : ",")
+						   << entry.second.replication.replicationId << ':'
+						   << flow.servedBytesWindow / 1024 << '/' << flow.boostedBytesWindow / 1024;
+				servedSessions++;
+			}
+			if (servedSessions > 0)
+			{
+				std::cout << " host_egress_kib_s=" << chunkSendScheduler.hostBytesPerSecond() / 1024
+						  << " host_limited_ticks_total=" << chunkSendScheduler.hostLimitedTicks()
+						  << " served_kib=" << servedList.str()
+						  << " served_jain="
+						  << (servedSquares > 0.0 ? servedSum * servedSum / (static_cast<double>(servedSessions) * servedSquares) : 1.0);
+			}
+
+			if (profileReplicationPasses > 0)
+			{
+				std::cout << " replicated_players_now=" << replicatedSessions.size()
+						  << " replication_passes_window=" << profileReplicationPasses
+						  << " replication_us_avg="
+						  << static_cast<double>(profileReplicationMicros) / static_cast<double>(profileReplicationPasses)
+						  << " replication_us_max=" << profileReplicationMicrosMax
+						  << " replication_examined_window=" << profileReplicationExamined
+						  << " replication_updates_window=" << profileReplicationUpdates
+						  << " replication_bytes_window=" << profileReplicationBytes;
+			}
+
+			if (profileLoopIterations > 0)
+			{
+				std::cout << " loop_us_avg=" << profileLoopMicros / profileLoopIterations
+						  << " loop_us_max=" << profileLoopMicrosMax;
+			}
+			std::cout << " auth_queued_now=" << authWorkers.queuedCount()
+					  << " auth_active_now=" << authWorkers.activeCount()
+					  << " auth_completed_window=" << profileAuthCompleted
+					  << " auth_busy_rejects_window=" << profileAuthRejectedBusy;
+			if (profileAuthCompleted > 0)
+			{
+				std::cout << " auth_ms_avg=" << profileAuthMicros / profileAuthCompleted / 1000
+						  << " auth_ms_max=" << profileAuthMicrosMax / 1000;
+			}
+			std::cout << " player_saves_pending_now=" << playerSaveQueue.pendingCount()
+					  << " player_saves_enqueued_window=" << playerSaveStats.enqueued
+					  << " player_saves_coalesced_window=" << playerSaveStats.coalesced
+					  << " player_saves_written_window=" << playerSaveStats.written
+					  << " player_save_batches_window=" << playerSaveStats.batches
+					  << " player_save_failed_batches_window=" << playerSaveStats.failedBatches
+					  << " player_save_commit_us_max=" << playerSaveStats.commitMicrosMax;
+
 			std::cout << " saved_chunks_window=" << savedChunksWindow
 					  << " save_batches_window=" << saveBatchWindow
 					  << " save_avg_chunks=" << saveAvgChunks
@@ -1300,6 +2443,10 @@ struct WorldServer::Impl
 		}
 
 		profileWindowStart = now;
+		{
+			std::lock_guard<std::mutex> taskLock(taskMutex);
+			profileCancelledGenerationTasks -= cancelledTasksWindow;
+		}
 		profileIntegratedChunks = 0;
 		profileIntegratedLoadedChunks = 0;
 		profileIntegratedGeneratedChunks = 0;
@@ -1315,6 +2462,34 @@ struct WorldServer::Impl
 		profileSnapshotPayloadBytes = 0;
 		profileSnapshotRawBytes = 0;
 		profileSnapshotSectionCount = 0;
+		profileSectionDeltaCount = 0;
+		profileSectionDeltaBytes = 0;
+		profileSnapshotReencodes = 0;
+		profileStaleSnapshotReplays = 0;
+		for (size_t &codecSnapshots : profileCodecSnapshots)
+		{
+			codecSnapshots = 0;
+		}
+		profileCodecVariantEncodes = 0;
+		profileReplicationPasses = 0;
+		profileReplicationMicros = 0;
+		profileReplicationMicrosMax = 0;
+		profileReplicationExamined = 0;
+		profileReplicationUpdates = 0;
+		profileReplicationBytes = 0;
+		profileLoopIterations = 0;
+		profileLoopMicros = 0;
+		profileLoopMicrosMax = 0;
+		profileOutboundOverflowPeak = outboundOverflow.size();
+		profileAuthCompleted = 0;
+		profileAuthRejectedBusy = 0;
+		profileAuthMicros = 0;
+		profileAuthMicrosMax = 0;
+		for (auto &entry : clients)
+		{
+			entry.second.link.sendFlow.servedBytesWindow = 0;
+			entry.second.link.sendFlow.boostedBytesWindow = 0;
+		}
 	}
 
 		size_t integratedChunksBudgetForTick()
@@ -1333,7 +2508,7 @@ struct WorldServer::Impl
 		size_t scheduledCount = 0;
 		{
 			std::lock_guard<std::mutex> taskLock(taskMutex);
-			scheduledCount = generationTasks.size();
+			scheduledCount = pendingGenerationTasks.size();
 		}
 
 		size_t budget = CLASSIC_MIN_INTEGRATED_CHUNKS_PER_TICK;
@@ -1353,14 +2528,13 @@ struct WorldServer::Impl
 		return scaleBudgetForStreamTick(integratedChunksBudgetForTick(), environmentOptions.streamTickMs);
 	}
 
-	void handleConnect(ENetPeer *peer)
+	void handleConnect(ENetPeer *peer, uint32_t connectId, const ENetAddress &address)
 	{
-		// Ce réglage agit surtout sur les envois non fiables d'ENet.
-		// On le garde aligné avec le client pour les essais de streaming agressif.
-		enet_peer_throttle_configure(peer, 5000, 6, 3);
-
 		ClientSession session;
 		session.peer = peer;
+		session.connectId = connectId;
+		session.address = address;
+		session.replication.replicationId = static_cast<uint16_t>(peer - host->peers);
 		session.playerContext.playerSession.lastSeenAtMs = systemNowMs();
 		clients[peer] = std::move(session);
 		std::cout << "Client connected" << std::endl;
@@ -1372,6 +2546,7 @@ struct WorldServer::Impl
 		if (sessionIt != clients.end())
 		{
 			ClientSession &session = sessionIt->second;
+			session.playerContext.authCancelled->store(true, std::memory_order_relaxed);
 			uint64_t playerId = session.playerContext.player.profile.playerId;
 			bool wasAuthenticated = session.playerContext.playerSession.authenticated;
 			std::string username = session.playerContext.player.profile.username;
@@ -1380,7 +2555,32 @@ struct WorldServer::Impl
 			{
 				activeUsernames.erase(session.playerContext.usernameKey);
 			}
-			clients.erase(sessionIt);
+			std::unordered_set<int64_t> droppedWantedChunks = std::move(session.chunkStream.wantedChunks);
+			session.chunkStream.loadedChunks.merge(session.chunkStream.queuedChunks);
+			for (int64_t key : session.chunkStream.loadedChunks)
+			{
+				auto subscribersIt = chunkSubscribers.find(key);
+				if (subscribersIt == chunkSubscribers.end())
+				{
+					continue;
+				}
+				subscribersIt->second.erase(peer);
+				if (subscribersIt->second.empty())
+				{
+					chunkSubscribers.erase(subscribersIt);
+				}
+			}
+			removeReplicatedPlayer(session);
+			clients.erase(sessionIt);
+			for (int64_t key : droppedWantedChunks)
+			{
+				if (releaseChunkInterest(key))
+				{
+					cancelChunkGeneration(key);
+				}
+			}
+			// Les tâches encore voulues par d'autres étaient peut-être classées sur ce joueur.
+			generationPrioritiesStale = generationPrioritiesStale || !droppedWantedChunks.empty();
 			if (wasAuthenticated)
 			{
 				broadcastServerMessage(username + " left the server.");
@@ -1511,18 +2711,14 @@ struct WorldServer::Impl
 		}
 	}
 
-	std::string peerAddressString(ENetPeer *peer) const
+	std::string peerAddressString(const ENetAddress &address) const
 	{
-		if (peer == nullptr)
-		{
-			return "unknown";
-		}
 		char hostBuffer[64] = {};
-		if (enet_address_get_host_ip(&peer->address, hostBuffer, sizeof(hostBuffer)) != 0)
+		if (enet_address_get_host_ip(&address, hostBuffer, sizeof(hostBuffer)) != 0)
 		{
-			return "unknown:" + std::to_string(peer->address.port);
+			return "unknown:" + std::to_string(address.port);
 		}
-		return std::string(hostBuffer) + ":" + std::to_string(peer->address.port);
+		return std::string(hostBuffer) + ":" + std::to_string(address.port);
 	}
 
 	void logSuccessfulLogin(const ClientSession &session, bool createdPlayer)
@@ -1538,7 +2734,7 @@ struct WorldServer::Impl
 		connectionLogFile << '[' << std::put_time(&timeInfo, "%Y-%m-%d %H:%M:%S") << "] "
 					  << session.playerContext.player.profile.username
 					  << " id=" << session.playerContext.player.profile.playerId
-					  << " addr=" << peerAddressString(session.peer)
+					  << " addr=" << peerAddressString(session.address)
 					  << " status=";
 		if (createdPlayer)
 		{
@@ -1581,7 +2777,7 @@ struct WorldServer::Impl
 		int localZ = floorMod(worldZ, CHUNK_SIZE_Z);
 		for (int worldY = CHUNK_SIZE_Y - 1; worldY >= 0; worldY--)
 		{
-			if (worldIt->second.getBlock(localX, worldY, localZ) == VOXEL_AIR)
+			if (worldIt->second.chunk->getBlock(localX, worldY, localZ) == VOXEL_AIR)
 			{
 				continue;
 			}
@@ -1921,18 +3117,23 @@ struct WorldServer::Impl
 		{
 			return true;
 		}
-		if (!playerTable.isOpen())
+		if (!playerSaveQueue.isOpen())
 		{
 			return false;
 		}
-		if (!playerTable.savePlayer(session.playerContext.player))
+		playerSaveQueue.enqueue(session.playerContext.player);
+		return true;
+	}
+
+	void autosavePlayersIfDue()
+	{
+		uint64_t nowMs = systemNowMs();
+		if (nowMs < nextPlayerAutosaveAtMs)
 		{
-			std::cerr << "Failed to save player "
-					  << session.playerContext.player.profile.username
-					  << ": " << playerTable.lastError() << std::endl;
-			return false;
+			return;
 		}
-		return true;
+		nextPlayerAutosaveAtMs = nowMs + PLAYER_AUTOSAVE_INTERVAL_MS;
+		saveAllAuthenticatedPlayers();
 	}
 
 	void saveAllAuthenticatedPlayers()
@@ -1946,120 +3147,178 @@ struct WorldServer::Impl
 	void markChunkDirty(int64_t key)
 	{
 		dirtyChunkKeys.insert(key);
+		unlinkColdChunk(key);
 		if (queuedDirtyChunkKeys.insert(key).second)
 		{
 			dirtyChunkQueue.push_back(key);
 		}
 	}
 
-		void enqueueSaveBatch(std::vector<VoxelChunkData> &&chunks)
+		void enqueueSaveBatch(std::vector<ChunkHandle> &&chunks)
 		{
 			if (chunks.empty())
 			{
 			return;
 		}
 
+			SaveBatchJob job;
+			job.chunks = std::move(chunks);
 			{
 				std::lock_guard<std::mutex> lock(saveMutex);
-				for (const VoxelChunkData &chunk : chunks)
+				for (const ChunkHandle &chunk : job.chunks)
 				{
-					int64_t key = chunkKey(chunk.chunkX, chunk.chunkZ);
+					int64_t key = chunkKey(chunk->chunkX, chunk->chunkZ);
 					pendingSaveChunkCounts[key]++;
 				}
-				saveJobs.push_back(SaveBatchJob{std::move(chunks)});
+				job.sequence = nextSaveBatchSequence++;
+				pendingSaveBatchCount++;
 			}
-			saveCv.notify_one();
+			jobSystem.submit(JobPriority::SaveCompress, [this, job = std::move(job)]() mutable
+							 {
+				compressSaveBatch(job);
+				{
+					std::lock_guard<std::mutex> lock(saveMutex);
+					uint64_t sequence = job.sequence;
+					preparedSaveBatches.emplace(sequence, std::move(job));
+				}
+				writePreparedSaveBatches(); });
+		}
+
+	void compressSaveBatch(SaveBatchJob &job)
+	{
+		ZoneScopedN("Job Compress Save Batch");
+		MetricsScopeTimer compressTimer(metrics.saveCompress);
+		std::vector<const VoxelChunkData *> chunksToWrite;
+		chunksToWrite.reserve(job.chunks.size());
+		for (const ChunkHandle &chunk : job.chunks)
+		{
+			chunksToWrite.push_back(chunk.get());
+		}
+		job.preparedOk = worldTable.prepareChunksBatch(chunksToWrite, job.prepared);
+		if (!job.preparedOk)
+		{
+			std::cerr << "Failed to compress world chunk batch: "
+					  << worldTable.lastErrorCopy() << std::endl;
 		}
+	}
 
-	void saveWorkerLoop()
+	// La compression tourne en parallèle, mais l'écriture suit l'ordre de soumission:
+	// un vieux lot ne doit jamais écraser une révision plus récente du même chunk.
+	bool writePreparedSaveBatches()
 	{
 		while (true)
 		{
 			SaveBatchJob job;
 			{
-				std::unique_lock<std::mutex> lock(saveMutex);
-				saveCv.wait(lock, [&]()
-							{ return saveStopRequested || !saveJobs.empty(); });
-				if (saveJobs.empty())
+				std::lock_guard<std::mutex> lock(saveMutex);
+				if (saveWriterActive || preparedSaveBatches.empty())
 				{
-					if (saveStopRequested)
-					{
-						return;
-					}
-					continue;
+					return true;
+				}
+				auto batchIt = preparedSaveBatches.begin();
+				if (batchIt->first != nextSaveBatchToWrite)
+				{
+					return true;
 				}
+				job = std::move(batchIt->second);
+				preparedSaveBatches.erase(batchIt);
+				saveWriterActive = true;
+			}
 
-				job = std::move(saveJobs.front());
-				saveJobs.pop_front();
+			ZoneScopedN("SQLite: Save Chunk Batch");
+			if (!job.preparedOk)
+			{
+				compressSaveBatch(job);
+			}
+			bool saved = false;
+			if (job.preparedOk)
+			{
+				MetricsScopeTimer saveTimer(metrics.sqliteSave);
+				saved = worldTable.savePreparedChunksBatch(job.prepared);
+			}
+			if (!saved)
+			{
+				if (job.preparedOk)
+				{
+					std::cerr << "Failed to save world chunk batch: "
+							  << worldTable.lastErrorCopy() << std::endl;
+				}
+				// On garde le lot en tête, le prochain tick relancera l'écriture.
+				std::lock_guard<std::mutex> lock(saveMutex);
+				uint64_t sequence = job.sequence;
+				preparedSaveBatches.emplace(sequence, std::move(job));
+				saveWriterActive = false;
+				saveRetryRequested = true;
+				return false;
 			}
 
-			ZoneScopedN("SQLite Save Worker");
+			{
+				std::lock_guard<std::mutex> lock(saveMutex);
+				for (const ChunkHandle &chunk : job.chunks)
 				{
-					ZoneScopedN("SQLite: Save Chunk Batch");
-					if (!worldTable.saveChunksBatch(job.chunks))
+					int64_t key = chunkKey(chunk->chunkX, chunk->chunkZ);
+					auto pendingIt = pendingSaveChunkCounts.find(key);
+					if (pendingIt == pendingSaveChunkCounts.end())
 					{
-						std::string saveError = worldTable.lastErrorCopy();
-						std::cerr << "Failed to save world chunk batch: "
-								  << saveError << std::endl;
-						{
-							std::lock_guard<std::mutex> lock(saveMutex);
-							saveJobs.push_front(std::move(job));
-					}
-					saveCv.notify_one();
-					std::this_thread::sleep_for(std::chrono::milliseconds(10));
 						continue;
 					}
+					if (pendingIt->second <= 1)
 					{
-						std::lock_guard<std::mutex> lock(saveMutex);
-						for (const VoxelChunkData &chunk : job.chunks)
-						{
-							int64_t key = chunkKey(chunk.chunkX, chunk.chunkZ);
-							auto pendingIt = pendingSaveChunkCounts.find(key);
-							if (pendingIt == pendingSaveChunkCounts.end())
-							{
-								continue;
-							}
-							if (pendingIt->second <= 1)
-							{
-								pendingSaveChunkCounts.erase(pendingIt);
-							}
-							else
-							{
-								pendingIt->second--;
-							}
-						}
+						pendingSaveChunkCounts.erase(pendingIt);
+						savedChunkKeys.push_back(key);
 					}
-					if (!persistGeneratedChunks)
+					else
 					{
-						for (const VoxelChunkData &chunk : job.chunks)
-						{
-							rememberPersistedChunkKey(chunkKey(chunk.chunkX, chunk.chunkZ));
-						}
+						pendingIt->second--;
 					}
-					profileSaveBatchCount.fetch_add(1, std::memory_order_relaxed);
-					profileSavedChunkCount.fetch_add(job.chunks.size(), std::memory_order_relaxed);
 				}
+				nextSaveBatchToWrite++;
+				pendingSaveBatchCount--;
+				saveWriterActive = false;
+			}
+			if (!persistGeneratedChunks)
+			{
+				for (const ChunkHandle &chunk : job.chunks)
+				{
+					rememberPersistedChunkKey(chunkKey(chunk->chunkX, chunk->chunkZ));
+				}
+			}
+			profileSaveBatchCount.fetch_add(1, std::memory_order_relaxed);
+			profileSavedChunkCount.fetch_add(job.chunks.size(), std::memory_order_relaxed);
+			metrics.chunksSaved.add(job.chunks.size());
 		}
 	}
 
-	void stopSaveWorker()
+	void retryFailedSaveBatchesIfNeeded()
 	{
 		{
 			std::lock_guard<std::mutex> lock(saveMutex);
-			saveStopRequested = true;
+			if (!saveRetryRequested)
+			{
+				return;
+			}
+			saveRetryRequested = false;
 		}
-		saveCv.notify_all();
-		if (saveWorker.joinable())
+		jobSystem.submit(JobPriority::SaveCompress, [this]()
+						 { writePreparedSaveBatches(); });
+	}
+
+	void stopJobSystem()
+	{
+		jobSystem.waitIdle();
+		// Un lot en échec est réessayé jusqu'à ce que SQLite l'accepte, comme avant l'arrêt.
+		while (!writePreparedSaveBatches())
 		{
-			saveWorker.join();
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
 		}
+		jobSystem.stop();
 	}
 
 		void flushDirtyChunks(size_t maxCount)
 		{
 		ZoneScopedN("SQLite: Flush Dirty Chunks");
 		std::vector<int64_t> attemptedKeys;
-		std::vector<VoxelChunkData> chunksToSave;
+		std::vector<ChunkHandle> chunksToSave;
 		size_t reserveCount = dirtyChunkQueue.size();
 		if (maxCount < reserveCount)
 		{
@@ -2078,6 +3337,7 @@ struct WorldServer::Impl
 
 				if (dirtyChunkKeys.find(key) == dirtyChunkKeys.end())
 				{
+					refreshColdChunkState(key);
 					continue;
 				}
 
@@ -2089,7 +3349,8 @@ struct WorldServer::Impl
 				}
 
 				attemptedKeys.push_back(key);
-				chunksToSave.push_back(worldIt->second);
+				// Snapshot copy-on-write: seules les références de sections sont copiées.
+				chunksToSave.push_back(ChunkPool::instance().acquireCopy(*worldIt->second.chunk));
 			}
 		}
 
@@ -2178,7 +3439,8 @@ struct WorldServer::Impl
 				sendReliable(peer, encodeAccountDeleteResponse(response));
 				return;
 			}
-			if (activeUsernames.find(trimmedUsername) != activeUsernames.end())
+			if (activeUsernames.find(trimmedUsername) != activeUsernames.end() ||
+				pendingAuthUsernames.find(trimmedUsername) != pendingAuthUsernames.end())
 			{
 				response.status = AccountDeleteStatus::UsernameAlreadyInUse;
 				sendReliable(peer, encodeAccountDeleteResponse(response));
@@ -2186,34 +3448,31 @@ struct WorldServer::Impl
 			}
 
 			std::string password = std::string(request.password);
-			Player player;
-			std::string storedPasswordHash;
-			if (password.empty() ||
-				!playerTable.loadPlayerAuthByUsername(trimmedUsername, player, storedPasswordHash))
+			if (password.empty())
 			{
 				response.status = AccountDeleteStatus::InvalidCredentials;
 				sendReliable(peer, encodeAccountDeleteResponse(response));
 				return;
 			}
-			if (storedPasswordHash.empty() ||
-				!passwordHasher.verifyPassword(password, storedPasswordHash))
+
+			AuthResult result;
+			result.kind = AuthRequestKind::AccountDelete;
+			result.peer = peer;
+			auto sessionIt = clients.find(peer);
+			if (sessionIt != clients.end())
 			{
-				response.status = AccountDeleteStatus::InvalidCredentials;
-				sendReliable(peer, encodeAccountDeleteResponse(response));
-				return;
+				result.connectId = sessionIt->second.connectId;
+				result.cancelled = sessionIt->second.playerContext.authCancelled;
 			}
-			if (!playerTable.deletePlayer(player.profile.playerId))
+			result.username = trimmedUsername;
+			result.admittedAt = std::chrono::steady_clock::now();
+			if (!submitAuthJob(std::move(result), std::move(password)))
 			{
-				std::cerr << "Failed to delete player "
-						  << trimmedUsername
-						  << ": " << playerTable.lastError() << std::endl;
-				response.status = AccountDeleteStatus::StorageError;
+				response.status = AccountDeleteStatus::ServerBusy;
 				sendReliable(peer, encodeAccountDeleteResponse(response));
 				return;
 			}
-			response.status = AccountDeleteStatus::Deleted;
-			sendReliable(peer, encodeAccountDeleteResponse(response));
-			std::cout << "Deleted player account: " << trimmedUsername << std::endl;
+			pendingAuthUsernames.insert(trimmedUsername);
 		}
 
 		void handleLoginRequest(ENetPeer *peer, const LoginRequestMessage &request)
@@ -2226,7 +3485,7 @@ struct WorldServer::Impl
 
 		ClientSession &session = sessionIt->second;
 		session.playerContext.playerSession.lastSeenAtMs = systemNowMs();
-		if (session.playerContext.playerSession.authenticated)
+		if (session.playerContext.playerSession.authenticated || session.playerContext.authPending)
 		{
 			return;
 		}
@@ -2243,7 +3502,9 @@ struct WorldServer::Impl
 			return;
 		}
 
-		if (activeUsernames.find(trimmedUsername) != activeUsernames.end())
+		// Un login ou une suppression en cours réserve déjà le nom.
+		if (activeUsernames.find(trimmedUsername) != activeUsernames.end() ||
+			pendingAuthUsernames.find(trimmedUsername) != pendingAuthUsernames.end())
 		{
 			response.status = LoginStatus::UsernameAlreadyInUse;
 			copyPlayerUsernameToBuffer(trimmedUsername, response.username);
@@ -2258,96 +3519,250 @@ struct WorldServer::Impl
 			sendReliable(peer, encodeLoginResponse(response));
 			return;
 		}
-		std::string passwordHashForNewPlayer;
-		if (!passwordHasher.hashPassword(password, passwordHashForNewPlayer))
+
+		AuthResult result;
+		result.kind = AuthRequestKind::Login;
+		result.peer = peer;
+		result.connectId = session.connectId;
+		result.cancelled = session.playerContext.authCancelled;
+		result.username = trimmedUsername;
+		result.admittedAt = std::chrono::steady_clock::now();
+		if (!submitAuthJob(std::move(result), std::move(password)))
 		{
-			std::cerr << "Failed to hash password for "
-					  << trimmedUsername
-					  << ": " << passwordHasher.lastError() << std::endl;
-			response.status = LoginStatus::InvalidCredentials;
+			response.status = LoginStatus::ServerBusy;
 			sendReliable(peer, encodeLoginResponse(response));
 			return;
 		}
+		pendingAuthUsernames.insert(trimmedUsername);
+		session.playerContext.authPending = true;
+	}
 
-		bool createdPlayer = false;
-		Player loadedPlayer;
+	bool submitAuthJob(AuthResult result, std::string password)
+	{
+		bool admitted = authWorkers.trySubmit([this, result = std::move(result), password = std::move(password)]() mutable
+											  {
+			if (result.cancelled != nullptr && result.cancelled->load(std::memory_order_relaxed))
+			{
+				// Client parti pendant l'attente: rien à hasher, le nom est juste libéré.
+			}
+			else if (result.kind == AuthRequestKind::Login)
+			{
+				runLoginAuthentication(result, password);
+			}
+			else
+			{
+				runAccountDeletion(result, password);
+			}
+			std::lock_guard<std::mutex> lock(completedAuthResultsMutex);
+			completedAuthResults.push_back(std::move(result)); });
+		if (!admitted)
+		{
+			profileAuthRejectedBusy++;
+			metrics.authBusyRejects.add();
+		}
+		return admitted;
+	}
+
+	// Thread d'authentification: ne touche qu'à authPlayerTable (sous verrou) et à des données immuables.
+	void runLoginAuthentication(AuthResult &result, const std::string &password)
+	{
+		PasswordHasher hasher;
 		std::string storedPasswordHash;
-		if (!playerTable.loadOrCreatePlayer(
-				trimmedUsername,
-				passwordHashForNewPlayer,
-				loadedPlayer,
-				storedPasswordHash,
-				createdPlayer))
-		{
-			std::cerr << "Failed to load/create player "
-					  << trimmedUsername
-					  << ": " << playerTable.lastError() << std::endl;
-			response.status = LoginStatus::InvalidUsername;
-			sendReliable(peer, encodeLoginResponse(response));
-			return;
+		// Relu avant la base: une déconnexion récente peut ne pas y être encore écrite.
+		Player unsavedPlayer;
+		bool hasUnsavedState = playerSaveQueue.pendingPlayer(result.username, unsavedPlayer);
+		bool found = false;
+		{
+			std::lock_guard<std::mutex> lock(authPlayerTableMutex);
+			found = authPlayerTable.loadPlayerAuthByUsername(result.username, result.player, storedPasswordHash);
+		}
+		if (found && hasUnsavedState && unsavedPlayer.profile.playerId == result.player.profile.playerId)
+		{
+			result.player.profile.skinId = unsavedPlayer.profile.skinId;
+			result.player.state = unsavedPlayer.state;
 		}
 
-		session.playerContext.player = loadedPlayer;
-		if (createdPlayer)
+		bool mustVerify = found && !storedPasswordHash.empty();
+		if (!mustVerify)
 		{
-			placePlayerAtSpawn(session.playerContext.player);
-			if (!playerTable.savePlayer(session.playerContext.player))
+			// Compte nouveau ou sans mot de passe: le hash se calcule hors verrou.
+			std::string passwordHash;
+			if (!hasher.hashPassword(password, passwordHash))
 			{
-				std::cerr << "Failed to persist spawn for new player "
-						  << trimmedUsername
-						  << ": " << playerTable.lastError() << std::endl;
+				std::cerr << "Failed to hash password for "
+						  << result.username
+						  << ": " << hasher.lastError() << std::endl;
+				result.loginStatus = LoginStatus::InvalidCredentials;
+				return;
 			}
-		}
-		if (!createdPlayer)
-		{
-			if (!storedPasswordHash.empty())
+
+			std::lock_guard<std::mutex> lock(authPlayerTableMutex);
+			if (!found &&
+				!authPlayerTable.loadOrCreatePlayer(
+					result.username,
+					passwordHash,
+					result.player,
+					storedPasswordHash,
+					result.createdPlayer))
 			{
-				if (password.empty() ||
-					!passwordHasher.verifyPassword(password, storedPasswordHash))
-				{
-					response.status = LoginStatus::InvalidCredentials;
-					sendReliable(peer, encodeLoginResponse(response));
-					return;
-				}
+				std::cerr << "Failed to load/create player "
+						  << result.username
+						  << ": " << authPlayerTable.lastError() << std::endl;
+				result.loginStatus = LoginStatus::InvalidUsername;
+				return;
 			}
-			else
+			if (!result.createdPlayer)
 			{
-				if (!playerTable.updatePasswordHash(
-						session.playerContext.player.profile.playerId,
-						passwordHashForNewPlayer))
+				mustVerify = !storedPasswordHash.empty();
+				if (!mustVerify &&
+					!authPlayerTable.updatePasswordHash(result.player.profile.playerId, passwordHash))
 				{
 					std::cerr << "Failed to set password hash for "
-							  << trimmedUsername
-							  << ": " << playerTable.lastError() << std::endl;
-					response.status = LoginStatus::InvalidCredentials;
-					sendReliable(peer, encodeLoginResponse(response));
+							  << result.username
+							  << ": " << authPlayerTable.lastError() << std::endl;
+					result.loginStatus = LoginStatus::InvalidCredentials;
 					return;
 				}
 			}
 		}
+		if (mustVerify && !hasher.verifyPassword(password, storedPasswordHash))
+		{
+			result.loginStatus = LoginStatus::InvalidCredentials;
+			return;
+		}
 
-		bool adminFromEnvironment = isAdminUsername(trimmedUsername);
-		bool adminFromDefaultCredential = isDefaultAdminCredential(trimmedUsername, password);
+		bool adminFromEnvironment = isAdminUsername(result.username);
+		bool adminFromDefaultCredential = isDefaultAdminCredential(result.username, password);
 		if ((adminFromEnvironment || adminFromDefaultCredential) &&
-			!session.playerContext.player.profile.admin)
+			!result.player.profile.admin)
 		{
-			session.playerContext.player.profile.admin = true;
-			if (!playerTable.updateAdminFlag(
-					session.playerContext.player.profile.playerId,
-					true))
+			result.player.profile.admin = true;
+			std::lock_guard<std::mutex> lock(authPlayerTableMutex);
+			if (!authPlayerTable.updateAdminFlag(result.player.profile.playerId, true))
 			{
 				std::cerr << "Failed to persist admin flag for "
-						  << trimmedUsername
-						  << ": " << playerTable.lastError() << std::endl;
+						  << result.username
+						  << ": " << authPlayerTable.lastError() << std::endl;
+			}
+		}
+		result.loginStatus = LoginStatus::Accepted;
+	}
+
+	void runAccountDeletion(AuthResult &result, const std::string &password)
+	{
+		PasswordHasher hasher;
+		std::string storedPasswordHash;
+		bool found = false;
+		{
+			std::lock_guard<std::mutex> lock(authPlayerTableMutex);
+			found = authPlayerTable.loadPlayerAuthByUsername(result.username, result.player, storedPasswordHash);
+		}
+		if (!found ||
+			storedPasswordHash.empty() ||
+			!hasher.verifyPassword(password, storedPasswordHash))
+		{
+			result.deleteStatus = AccountDeleteStatus::InvalidCredentials;
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(authPlayerTableMutex);
+		if (!authPlayerTable.deletePlayer(result.player.profile.playerId))
+		{
+			std::cerr << "Failed to delete player "
+					  << result.username
+					  << ": " << authPlayerTable.lastError() << std::endl;
+			result.deleteStatus = AccountDeleteStatus::StorageError;
+			return;
+		}
+		result.deleteStatus = AccountDeleteStatus::Deleted;
+	}
+
+	void applyCompletedAuthResults()
+	{
+		std::vector<AuthResult> results;
+		{
+			std::lock_guard<std::mutex> lock(completedAuthResultsMutex);
+			if (completedAuthResults.empty())
+			{
+				return;
+			}
+			results.swap(completedAuthResults);
+		}
+
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		for (AuthResult &result : results)
+		{
+			pendingAuthUsernames.erase(result.username);
+			uint64_t authMicros = static_cast<uint64_t>(
+				std::chrono::duration_cast<std::chrono::microseconds>(now - result.admittedAt).count());
+			profileAuthCompleted++;
+			profileAuthMicros += authMicros;
+			profileAuthMicrosMax = std::max(profileAuthMicrosMax, authMicros);
+			bool accepted = result.kind == AuthRequestKind::Login
+				? result.loginStatus == LoginStatus::Accepted
+				: result.deleteStatus == AccountDeleteStatus::Deleted;
+			(accepted ? metrics.authAccepted : metrics.authRejected).add();
+			(result.kind == AuthRequestKind::Login ? metrics.login : metrics.accountDelete).record(authMicros);
+
+			// Le peer a pu partir (et son slot être repris) pendant le hash.
+			auto sessionIt = clients.find(result.peer);
+			bool sameConnection = sessionIt != clients.end() && sessionIt->second.connectId == result.connectId;
+			if (result.kind == AuthRequestKind::AccountDelete)
+			{
+				if (result.deleteStatus == AccountDeleteStatus::Deleted)
+				{
+					std::cout << "Deleted player account: " << result.username << std::endl;
+				}
+				if (sameConnection)
+				{
+					AccountDeleteResponseMessage response;
+					response.status = result.deleteStatus;
+					sendReliable(result.peer, encodeAccountDeleteResponse(response));
+				}
+				continue;
+			}
+
+			if (!sameConnection)
+			{
+				continue;
+			}
+			ClientSession &session = sessionIt->second;
+			session.playerContext.authPending = false;
+			if (result.loginStatus != LoginStatus::Accepted)
+			{
+				LoginResponseMessage response;
+				response.serverNowMs = systemNowMs();
+				response.status = result.loginStatus;
+				sendReliable(result.peer, encodeLoginResponse(response));
+				continue;
 			}
+			completeLogin(session, result);
+		}
+	}
+
+	void completeLogin(ClientSession &session, const AuthResult &result)
+	{
+		ENetPeer *peer = session.peer;
+		const std::string &trimmedUsername = result.username;
+		bool createdPlayer = result.createdPlayer;
+		session.playerContext.player = result.player;
+		if (createdPlayer)
+		{
+			placePlayerAtSpawn(session.playerContext.player);
+			playerSaveQueue.enqueue(session.playerContext.player);
 		}
 
 		session.playerContext.playerSession.playerId = session.playerContext.player.profile.playerId;
 		session.playerContext.playerSession.authenticated = true;
+		session.playerContext.authenticatedAt = std::chrono::steady_clock::now();
 		session.playerContext.usernameKey = trimmedUsername;
 		session.playerContext.admin = session.playerContext.player.profile.admin;
 		activeUsernames[trimmedUsername] = session.playerContext.player.profile.playerId;
+		indexReplicatedPlayer(session);
+		updateSendQueueView(session);
 
+		LoginResponseMessage response;
+		response.serverNowMs = systemNowMs();
 		response.status = LoginStatus::Accepted;
 		response.playerId = session.playerContext.player.profile.playerId;
 		copyPlayerUsernameToBuffer(trimmedUsername, response.username);
@@ -2364,6 +3779,10 @@ struct WorldServer::Impl
 			{
 				response.blockCooldownDisabled = 1;
 			}
+			if (!chunkDictionaryPacket.empty())
+			{
+				sendReliable(peer, chunkDictionaryPacket);
+			}
 			sendReliable(peer, encodeLoginResponse(response));
 		sendReliable(peer, encodeWorldFrontier(frontier));
 		sendExpansionStatus(session);
@@ -2403,10 +3822,21 @@ struct WorldServer::Impl
 			{
 				return;
 			}
+			auto sessionIt = clients.find(peer);
+			if (sessionIt != clients.end())
+			{
+				sessionIt->second.link.supportedChunkCodecs = hello.chunkCodecs;
+			}
 			sendReliable(peer, encodeHello(hello));
 			return;
 		}
 
+		if (type == PacketType::ShardFrontierSync && shard.isSharded())
+		{
+			handleShardFrontier(peer, data, size);
+			return;
+		}
+
 			if (type == PacketType::LoginRequest)
 			{
 				LoginRequestMessage loginRequest;
@@ -2521,12 +3951,20 @@ struct WorldServer::Impl
 
 		int64_t key = chunkKey(request.chunkX, request.chunkZ);
 		ClientSession &session = sessionIt->second;
-		session.chunkStream.wantedChunks.insert(key);
+		if (request.hasKnownRevision)
+		{
+			session.chunkStream.knownRevisions[key] = request.knownRevision;
+		}
+		else
+		{
+			session.chunkStream.knownRevisions.erase(key);
+		}
+		addChunkInterest(session, key);
 
 		auto worldIt = worldChunks.find(key);
 		if (worldIt != worldChunks.end())
 		{
-			queueChunkForClient(session.chunkStream, key);
+			queueChunkForClient(session, key);
 			return;
 		}
 
@@ -2543,9 +3981,20 @@ struct WorldServer::Impl
 
 		int64_t key = chunkKey(drop.chunkX, drop.chunkZ);
 		ClientSession &session = sessionIt->second;
-		session.chunkStream.wantedChunks.erase(key);
+		bool wasWanted = session.chunkStream.wantedChunks.erase(key) > 0;
 		session.chunkStream.loadedChunks.erase(key);
 		session.chunkStream.queuedChunks.erase(key);
+		session.chunkStream.knownRevisions.erase(key);
+		// Un joueur qui file laisse derrière lui des entrées abandonnées en bas du tas.
+		if (session.chunkStream.sendQueue.size() > session.chunkStream.queuedChunks.size() * 2 + SEND_QUEUE_STALE_SLACK)
+		{
+			session.chunkStream.sendQueue.retainOnly(session.chunkStream.queuedChunks);
+		}
+		unsubscribeFromChunkUpdatesIfUnused(session, key);
+		if (wasWanted && releaseChunkInterest(key))
+		{
+			cancelChunkGeneration(key);
+		}
 	}
 
 	void handleBlockAction(ENetPeer *peer, const BlockActionRequestMessage &request)
@@ -2600,13 +4049,19 @@ struct WorldServer::Impl
 			finalColor = playerPaletteColor(request.paletteIndex);
 		}
 
-		if (!worldIt->second.setBlockRaw(lx, request.worldY, lz, finalColor))
+		if (!worldIt->second.chunk->setBlockRaw(lx, request.worldY, lz, finalColor))
 		{
 			rejectActionAndSync();
 			return;
 		}
 
-			invalidateChunkSnapshotCache(key);
+			BlockUpdateBatchEntry update;
+			update.localX = static_cast<uint8_t>(lx);
+			update.localY = static_cast<uint8_t>(request.worldY);
+			update.localZ = static_cast<uint8_t>(lz);
+			update.finalColor = finalColor;
+			recordChunkSectionEdit(key, update, worldIt->second.chunk->revision);
+			scheduleSnapshotReencode(key, VoxelChunkData::sectionIndexFromY(request.worldY));
 			markChunkDirty(key);
 			if (blockCooldownDisabled)
 			{
@@ -2618,13 +4073,11 @@ struct WorldServer::Impl
 					nowMs + PLAYER_DEFAULT_BLOCK_ACTION_COOLDOWN_MS;
 			}
 
-		BlockUpdateBroadcastMessage update;
-		update.worldX = request.worldX;
-		update.worldY = request.worldY;
-		update.worldZ = request.worldZ;
-		update.finalColor = finalColor;
-		update.revision = worldIt->second.revision;
-		broadcastReliable(encodeBlockUpdateBroadcast(update));
+		BlockUpdateBatchChunk &pendingChunk = pendingBlockUpdates[key];
+		pendingChunk.chunkX = cx;
+		pendingChunk.chunkZ = cz;
+		pendingChunk.revision = worldIt->second.chunk->revision;
+		pendingChunk.updates.push_back(update);
 		sendPlayerState(session);
 	}
 
@@ -2655,95 +4108,509 @@ struct WorldServer::Impl
 			movement.lookX,
 			movement.lookY,
 			movement.lookZ);
+		updateSendQueueView(session);
+		markGenerationViewIfMoved(session);
+		if (session.playerContext.playerSession.authenticated)
+		{
+			indexReplicatedPlayer(session);
+		}
 	}
 
-	bool shouldExpandPlayableBounds() const
+	void updateSendQueueView(ClientSession &session)
 	{
-		if (usesClassicStreaming())
-		{
-			return false;
-		}
+		const PlayerState &state = session.playerContext.player.state;
+		session.chunkStream.sendQueue.updateView(
+			state.position.x,
+			state.position.z,
+			state.lookDirection.x,
+			state.lookDirection.z);
+	}
 
-		size_t activePlayableChunkCount = static_cast<size_t>(frontier.activePlayableChunkCount);
-		size_t requiredChunkCount = static_cast<size_t>(frontier.requiredActiveChunkCount);
-		if (requiredChunkCount == 0)
+	void indexReplicatedPlayer(ClientSession &session)
+	{
+		const PlayerState &state = session.playerContext.player.state;
+		uint16_t replicationId = session.replication.replicationId;
+		QuantizedPlayerTransform transform = quantizePlayerTransform(
+			state.position.x,
+			state.position.y,
+			state.position.z,
+			state.lookDirection.x,
+			state.lookDirection.y,
+			state.lookDirection.z);
+		if (transform == session.replication.transform && playerSpatialHash.contains(replicationId))
 		{
-			return false;
+			return;
 		}
-		if (activePlayableChunkCount < requiredChunkCount)
+		session.replication.transform = transform;
+		playerSpatialHash.update(replicationId, state.position.x, state.position.z);
+		replicatedSessions[replicationId] = &session;
+		playerReplicationDirty = true;
+	}
+
+	void removeReplicatedPlayer(ClientSession &session)
+	{
+		uint16_t replicationId = session.replication.replicationId;
+		if (!playerSpatialHash.contains(replicationId))
 		{
-			return false;
+			return;
 		}
-		return true;
+		playerSpatialHash.remove(replicationId);
+		replicatedSessions.erase(replicationId);
+		playerReplicationDirty = true;
 	}
 
-	void expandWorldOneRing()
+	// Rien n'a bougé depuis la dernière passe: aucun coût, même avec beaucoup de joueurs.
+	void replicatePlayers()
 	{
-		if (usesClassicStreaming())
+		if (!playerReplicationDirty)
 		{
 			return;
 		}
-
-		ChunkBounds previousGenerated = frontier.generatedBounds;
-		frontier.playableBounds = frontier.playableBounds.expanded(1);
-		frontier.generatedBounds = frontier.playableBounds.expanded(frontier.paddingChunks);
-		clearExpansionVote();
-			expansionVote.cooldownReadyAtMs = systemNowMs() + expansionCooldownMs();
-			totalBlockActions = 0;
-			updateExpansionProgress();
-			saveActivityFrontierState();
-
-			for (int cx = frontier.generatedBounds.minChunkX; cx < frontier.generatedBounds.maxChunkXExclusive; cx++)
+		playerReplicationDirty = false;
+
+		auto startTime = std::chrono::steady_clock::now();
+		float radius = static_cast<float>(environmentOptions.playerViewRadiusBlocks);
+		float keepRadius = radius * PLAYER_VIEW_KEEP_RADIUS_FACTOR;
+		playerReplicationPass++;
+		for (auto &[observerId, observer] : replicatedSessions)
+		{
+			const glm::vec3 &observerPosition = observer->playerContext.player.state.position;
+			profileReplicationExamined += playerSpatialHash.queryRadius(
+				observerPosition.x,
+				observerPosition.z,
+				keepRadius,
+				replicationCandidates);
+
+			RemotePlayerBatchMessage batch;
+			std::unordered_map<uint16_t, ClientSession::ClientReplicationState::VisiblePlayer> &visiblePlayers =
+				observer->replication.visiblePlayers;
+			for (uint16_t candidateId : replicationCandidates)
 			{
-			for (int cz = frontier.generatedBounds.minChunkZ; cz < frontier.generatedBounds.maxChunkZExclusive; cz++)
+				if (candidateId == observerId)
+				{
+					continue;
+				}
+				const ClientSession &target = *replicatedSessions.find(candidateId)->second;
+				const QuantizedPlayerTransform &transform = target.replication.transform;
+				uint64_t targetPlayerId = target.playerContext.player.profile.playerId;
+				auto visibleIt = visiblePlayers.find(candidateId);
+				if (visibleIt == visiblePlayers.end() || visibleIt->second.playerId != targetPlayerId)
+				{
+					glm::vec3 offset = target.playerContext.player.state.position - observerPosition;
+					if (offset.x * offset.x + offset.z * offset.z > radius * radius)
+					{
+						continue;
+					}
+					ClientSession::ClientReplicationState::VisiblePlayer &visible = visiblePlayers[candidateId];
+					visible.playerId = targetPlayerId;
+					visible.sent = transform;
+					visible.seenPass = playerReplicationPass;
+
+					RemotePlayerUpdate &update = batch.updates.emplace_back();
+					update.replicationId = candidateId;
+					update.flags = REMOTE_PLAYER_SPAWN | REMOTE_PLAYER_POSITION | REMOTE_PLAYER_LOOK;
+					update.playerId = targetPlayerId;
+					update.skinId = target.playerContext.player.profile.skinId;
+					update.username = target.playerContext.player.profile.username;
+					update.transform = transform;
+				}
+				else
+				{
+					ClientSession::ClientReplicationState::VisiblePlayer &visible = visibleIt->second;
+					visible.seenPass = playerReplicationPass;
+					if (visible.sent == transform)
+					{
+						continue;
+					}
+					RemotePlayerUpdate &update = batch.updates.emplace_back();
+					update.replicationId = candidateId;
+					appendRemotePlayerTransformChange(update, visible.sent, transform);
+					visible.sent = transform;
+				}
+				flushRemotePlayerBatchIfFull(*observer, batch);
+			}
+
+			for (auto visibleIt = visiblePlayers.begin(); visibleIt != visiblePlayers.end();)
 			{
-				if (previousGenerated.containsChunk(cx, cz))
+				if (visibleIt->second.seenPass == playerReplicationPass)
 				{
+					++visibleIt;
 					continue;
 				}
-				scheduleChunkGeneration(cx, cz);
+				RemotePlayerUpdate &update = batch.updates.emplace_back();
+				update.replicationId = visibleIt->first;
+				update.flags = REMOTE_PLAYER_DESPAWN;
+				visibleIt = visiblePlayers.erase(visibleIt);
+				flushRemotePlayerBatchIfFull(*observer, batch);
 			}
+			sendRemotePlayerBatch(*observer, batch);
 		}
 
-		broadcastReliable(encodeWorldFrontier(frontier));
-		broadcastExpansionStatus();
-		std::cout << "Expanded playable bounds to "
-				  << frontier.playableBounds.widthChunks() << "x"
-				  << frontier.playableBounds.depthChunks() << " chunks" << std::endl;
+		uint64_t elapsedMicros = static_cast<uint64_t>(
+			std::chrono::duration_cast<std::chrono::microseconds>(
+				std::chrono::steady_clock::now() - startTime)
+				.count());
+		profileReplicationPasses++;
+		profileReplicationMicros += elapsedMicros;
+		profileReplicationMicrosMax = std::max(profileReplicationMicrosMax, elapsedMicros);
 	}
 
-	void scheduleBounds(const ChunkBounds &bounds)
+	static void appendRemotePlayerTransformChange(RemotePlayerUpdate &update,
+												  const QuantizedPlayerTransform &previous,
+												  const QuantizedPlayerTransform &current)
 	{
-		for (int cx = bounds.minChunkX; cx < bounds.maxChunkXExclusive; cx++)
+		int64_t deltaX = static_cast<int64_t>(current.positionX) - previous.positionX;
+		int64_t deltaY = static_cast<int64_t>(current.positionY) - previous.positionY;
+		int64_t deltaZ = static_cast<int64_t>(current.positionZ) - previous.positionZ;
+		auto fitsDelta = [](int64_t value)
 		{
-			for (int cz = bounds.minChunkZ; cz < bounds.maxChunkZExclusive; cz++)
+			return value >= std::numeric_limits<int16_t>::min() && value <= std::numeric_limits<int16_t>::max();
+		};
+		if (deltaX != 0 || deltaY != 0 || deltaZ != 0)
+		{
+			if (fitsDelta(deltaX) && fitsDelta(deltaY) && fitsDelta(deltaZ))
+			{
+				update.flags |= REMOTE_PLAYER_POSITION_DELTA;
+				update.deltaX = static_cast<int16_t>(deltaX);
+				update.deltaY = static_cast<int16_t>(deltaY);
+				update.deltaZ = static_cast<int16_t>(deltaZ);
+			}
+			else
 			{
-				scheduleChunkGeneration(cx, cz);
+				update.flags |= REMOTE_PLAYER_POSITION;
 			}
 		}
+		if (current.yaw != previous.yaw || current.pitch != previous.pitch)
+		{
+			update.flags |= REMOTE_PLAYER_LOOK;
+		}
+		update.transform = current;
 	}
 
-	void scheduleChunkGeneration(int cx, int cz)
+	void flushRemotePlayerBatchIfFull(ClientSession &observer, RemotePlayerBatchMessage &batch)
 	{
-		int64_t key = chunkKey(cx, cz);
-		if (worldChunks.find(key) != worldChunks.end())
+		if (batch.updates.size() >= MAX_REMOTE_PLAYER_UPDATES_PER_PACKET)
 		{
-			return;
+			sendRemotePlayerBatch(observer, batch);
 		}
+	}
 
-		std::lock_guard<std::mutex> lock(taskMutex);
-		if (scheduledChunkKeys.find(key) != scheduledChunkKeys.end())
+	void sendRemotePlayerBatch(ClientSession &observer, RemotePlayerBatchMessage &batch)
+	{
+		if (batch.updates.empty())
 		{
 			return;
 		}
-		scheduledChunkKeys.insert(key);
-		generationTasks.push_back(ChunkCoord{cx, cz});
-		taskCv.notify_one();
+		std::vector<uint8_t> payload = encodeRemotePlayerBatch(batch);
+		profileReplicationUpdates += batch.updates.size();
+		profileReplicationBytes += payload.size();
+		sendReliable(observer.peer, payload);
+		batch.updates.clear();
 	}
 
-	void queueChunkForClient(ClientSession::ClientChunkStreamState &chunkStream, int64_t key)
+	bool shouldExpandPlayableBounds() const
 	{
-		if (chunkStream.wantedChunks.find(key) == chunkStream.wantedChunks.end())
+		if (usesClassicStreaming())
+		{
+			return false;
+		}
+
+		size_t activePlayableChunkCount = static_cast<size_t>(frontier.activePlayableChunkCount);
+		size_t requiredChunkCount = static_cast<size_t>(frontier.requiredActiveChunkCount);
+		if (requiredChunkCount == 0)
+		{
+			return false;
+		}
+		if (activePlayableChunkCount < requiredChunkCount)
+		{
+			return false;
+		}
+		return true;
+	}
+
+	void expandWorldOneRing()
+	{
+		if (usesClassicStreaming())
+		{
+			return;
+		}
+
+		ChunkBounds previousGenerated = frontier.generatedBounds;
+		frontier.playableBounds = frontier.playableBounds.expanded(1);
+		frontier.generatedBounds = frontier.playableBounds.expanded(frontier.paddingChunks);
+		clearExpansionVote();
+			expansionVote.cooldownReadyAtMs = systemNowMs() + expansionCooldownMs();
+			totalBlockActions = 0;
+			updateExpansionProgress();
+			saveActivityFrontierState();
+			scheduleGeneratedRing(previousGenerated);
+
+		broadcastReliable(encodeWorldFrontier(frontier));
+		broadcastExpansionStatus();
+		std::cout << "Expanded playable bounds to "
+				  << frontier.playableBounds.widthChunks() << "x"
+				  << frontier.playableBounds.depthChunks() << " chunks" << std::endl;
+	}
+
+	void scheduleGeneratedRing(const ChunkBounds &previousGenerated)
+	{
+		for (int cx = frontier.generatedBounds.minChunkX; cx < frontier.generatedBounds.maxChunkXExclusive; cx++)
+		{
+			for (int cz = frontier.generatedBounds.minChunkZ; cz < frontier.generatedBounds.maxChunkZExclusive; cz++)
+			{
+				if (previousGenerated.containsChunk(cx, cz))
+				{
+					continue;
+				}
+				scheduleChunkGeneration(cx, cz, true);
+			}
+		}
+	}
+
+	// Le primaire décide des expansions; la passerelle relaie sa frontière aux autres shards.
+	void handleShardFrontier(ENetPeer *peer, const uint8_t *data, size_t size)
+	{
+		ShardFrontierSyncMessage sync;
+		if (!decodeShardFrontierSync(data, size, sync))
+		{
+			return;
+		}
+		if (sodium_memcmp(sync.token, shardToken, sizeof(shardToken)) != 0)
+		{
+			// Adresse copiée à la connexion: le peer appartient au thread réseau.
+			auto sessionIt = clients.find(peer);
+			std::cerr << "Rejected shard frontier sync with a bad token from "
+					  << (sessionIt != clients.end() ? peerAddressString(sessionIt->second.address) : std::string("unknown peer"))
+					  << std::endl;
+			return;
+		}
+		if (shard.isPrimary())
+		{
+			sendReliable(peer, encodeWorldFrontier(frontier));
+			return;
+		}
+		if (usesClassicStreaming())
+		{
+			return;
+		}
+
+		// Un anneau par synchro au plus, et seulement autour des bornes actuelles: un shard en
+		// retard de plusieurs expansions rattrape au rythme des renvois de la passerelle.
+		const ChunkBounds &current = frontier.playableBounds;
+		const ChunkBounds &target = sync.frontier.playableBounds;
+		int ringWidth = current.minChunkX - target.minChunkX;
+		if (ringWidth <= 0 || target != current.expanded(ringWidth))
+		{
+			return;
+		}
+
+		ChunkBounds previousGenerated = frontier.generatedBounds;
+		frontier.playableBounds = current.expanded(1);
+		frontier.generatedBounds = frontier.playableBounds.expanded(frontier.paddingChunks);
+		totalBlockActions = 0;
+		updateExpansionProgress();
+		saveActivityFrontierState();
+		scheduleGeneratedRing(previousGenerated);
+		std::cout << "Shard frontier synced to "
+				  << frontier.playableBounds.widthChunks() << "x"
+				  << frontier.playableBounds.depthChunks() << " chunks" << std::endl;
+	}
+
+	void scheduleBounds(const ChunkBounds &bounds)
+	{
+		for (int cx = bounds.minChunkX; cx < bounds.maxChunkXExclusive; cx++)
+		{
+			for (int cz = bounds.minChunkZ; cz < bounds.maxChunkZExclusive; cz++)
+			{
+				scheduleChunkGeneration(cx, cz, true);
+			}
+		}
+	}
+
+	void scheduleChunkGeneration(int cx, int cz, bool pinned = false)
+	{
+		if (!shard.owns(cx, cz))
+		{
+			return;
+		}
+		int64_t key = chunkKey(cx, cz);
+		if (worldChunks.find(key) != worldChunks.end())
+		{
+			return;
+		}
+
+		float priority = chunkGenerationPriority(cx, cz, key, !pinned);
+		bool fromStorage = persistGeneratedChunks || isChunkPersistedOnDisk(key);
+		{
+			std::lock_guard<std::mutex> lock(taskMutex);
+			auto pendingIt = pendingGenerationTasks.find(key);
+			if (pendingIt != pendingGenerationTasks.end())
+			{
+				pendingIt->second.pinned = pendingIt->second.pinned || pinned;
+				return;
+			}
+			if (scheduledChunkKeys.find(key) != scheduledChunkKeys.end())
+			{
+				return;
+			}
+			scheduledChunkKeys.insert(key);
+
+			PendingGenerationTask pending;
+			pending.coord = ChunkCoord{cx, cz};
+			pending.sequence = nextGenerationTaskSequence++;
+			pending.pinned = pinned;
+			pending.fromStorage = fromStorage;
+			pendingGenerationTasks[key] = pending;
+			pushGenerationTaskNoLock(pending, priority);
+		}
+
+		// Le job ne porte pas de coordonnée: il prend la meilleure tâche au moment où il tourne.
+		JobPriority jobPriority = fromStorage ? JobPriority::Load : JobPriority::Generate;
+		jobSystem.submit(jobPriority, [this, jobPriority]()
+						 { runChunkJob(jobPriority); });
+	}
+
+	void cancelChunkGeneration(int64_t key)
+	{
+		std::lock_guard<std::mutex> lock(taskMutex);
+		auto pendingIt = pendingGenerationTasks.find(key);
+		if (pendingIt == pendingGenerationTasks.end() || pendingIt->second.pinned)
+		{
+			return;
+		}
+		// L'entrée du tas devient périmée, le worker la sautera.
+		pendingGenerationTasks.erase(pendingIt);
+		scheduledChunkKeys.erase(key);
+		profileCancelledGenerationTasks++;
+		if (loadTaskHeap.size() + generationTaskHeap.size() >
+			pendingGenerationTasks.size() * 2 + GENERATION_HEAP_STALE_SLACK)
+		{
+			generationPrioritiesStale = true;
+		}
+	}
+
+	void pushGenerationTaskNoLock(const PendingGenerationTask &pending, float priority)
+	{
+		GenerationTask task;
+		task.coord = pending.coord;
+		task.priority = priority;
+		task.sequence = pending.sequence;
+		std::vector<GenerationTask> &heap = pending.fromStorage ? loadTaskHeap : generationTaskHeap;
+		heap.push_back(task);
+		std::push_heap(heap.begin(), heap.end(), GenerationTaskLater{});
+	}
+
+	bool popNextGenerationTaskNoLock(std::vector<GenerationTask> &heap, ChunkCoord &coord)
+	{
+		while (!heap.empty())
+		{
+			std::pop_heap(heap.begin(), heap.end(), GenerationTaskLater{});
+			GenerationTask task = heap.back();
+			heap.pop_back();
+
+			int64_t key = chunkKey(task.coord);
+			auto pendingIt = pendingGenerationTasks.find(key);
+			if (pendingIt == pendingGenerationTasks.end() || pendingIt->second.sequence != task.sequence)
+			{
+				continue;
+			}
+			pendingGenerationTasks.erase(pendingIt);
+			coord = task.coord;
+			return true;
+		}
+		return false;
+	}
+
+	float chunkGenerationPriority(int cx, int cz, int64_t key, bool requireInterest) const
+	{
+		float bestPriority = GENERATION_UNWATCHED_PRIORITY;
+		for (const auto &entry : clients)
+		{
+			const ClientSession &session = entry.second;
+			if (!session.playerContext.playerSession.authenticated)
+			{
+				continue;
+			}
+			if (requireInterest &&
+				session.chunkStream.wantedChunks.find(key) == session.chunkStream.wantedChunks.end())
+			{
+				continue;
+			}
+
+			const PlayerState &state = session.playerContext.player.state;
+			ChunkView view = makeChunkView(
+				state.position.x,
+				state.position.z,
+				state.lookDirection.x,
+				state.lookDirection.z);
+			bestPriority = std::min(bestPriority, chunkViewPriority(view, cx, cz));
+		}
+		return bestPriority;
+	}
+
+	void markGenerationViewIfMoved(ClientSession &session)
+	{
+		const PlayerState &state = session.playerContext.player.state;
+		ChunkView view = makeChunkView(
+			state.position.x,
+			state.position.z,
+			state.lookDirection.x,
+			state.lookDirection.z);
+		if (!chunkViewChanged(session.chunkStream.generationView, view))
+		{
+			return;
+		}
+		session.chunkStream.generationView = view;
+		generationPrioritiesStale = true;
+	}
+
+	void refreshGenerationPrioritiesIfStale()
+	{
+		if (!generationPrioritiesStale)
+		{
+			return;
+		}
+		ZoneScopedN("Refresh Generation Priorities");
+		generationPrioritiesStale = false;
+
+		std::vector<PendingGenerationTask> pendingTasks;
+		{
+			std::lock_guard<std::mutex> lock(taskMutex);
+			pendingTasks.reserve(pendingGenerationTasks.size());
+			for (const auto &entry : pendingGenerationTasks)
+			{
+				pendingTasks.push_back(entry.second);
+			}
+		}
+
+		// Hors verrou: seul ce thread ajoute des tâches. Une tâche prise par un worker
+		// entre-temps laisse une entrée périmée, sautée au pop comme une annulation.
+		std::vector<GenerationTask> nextLoadHeap;
+		std::vector<GenerationTask> nextGenerationHeap;
+		for (const PendingGenerationTask &pending : pendingTasks)
+		{
+			GenerationTask task;
+			task.coord = pending.coord;
+			task.priority = chunkGenerationPriority(
+				pending.coord.x,
+				pending.coord.z,
+				chunkKey(pending.coord),
+				!pending.pinned);
+			task.sequence = pending.sequence;
+			(pending.fromStorage ? nextLoadHeap : nextGenerationHeap).push_back(task);
+		}
+		std::make_heap(nextLoadHeap.begin(), nextLoadHeap.end(), GenerationTaskLater{});
+		std::make_heap(nextGenerationHeap.begin(), nextGenerationHeap.end(), GenerationTaskLater{});
+
+		std::lock_guard<std::mutex> lock(taskMutex);
+		loadTaskHeap.swap(nextLoadHeap);
+		generationTaskHeap.swap(nextGenerationHeap);
+	}
+
+	void queueChunkForClient(ClientSession &session, int64_t key)
+	{
+		ClientSession::ClientChunkStreamState &chunkStream = session.chunkStream;
+		if (chunkStream.wantedChunks.find(key) == chunkStream.wantedChunks.end())
 		{
 			return;
 		}
@@ -2755,14 +4622,166 @@ struct WorldServer::Impl
 		{
 			return;
 		}
-		chunkStream.sendQueue.push_back(key);
+		chunkStream.sendQueue.push(key);
 		chunkStream.queuedChunks.insert(key);
+		subscribeToChunkUpdates(session, key);
 		profileQueuedForSendChunks++;
 	}
 
+	// Abonné = le chunk est chargé chez le client ou en attente dans sa sendQueue.
+	void subscribeToChunkUpdates(const ClientSession &session, int64_t key)
+	{
+		chunkSubscribers[key].insert(session.peer);
+	}
+
+	void unsubscribeFromChunkUpdatesIfUnused(const ClientSession &session, int64_t key)
+	{
+		const ClientSession::ClientChunkStreamState &chunkStream = session.chunkStream;
+		if (chunkStream.loadedChunks.find(key) != chunkStream.loadedChunks.end() ||
+			chunkStream.queuedChunks.find(key) != chunkStream.queuedChunks.end())
+		{
+			return;
+		}
+		auto subscribersIt = chunkSubscribers.find(key);
+		if (subscribersIt == chunkSubscribers.end())
+		{
+			return;
+		}
+		subscribersIt->second.erase(session.peer);
+		if (subscribersIt->second.empty())
+		{
+			chunkSubscribers.erase(subscribersIt);
+		}
+	}
+
+	// Un seul paquet fiable par client et par stream tick, quel que soit le nombre d'éditions.
+	void flushBlockUpdateBatches()
+	{
+		if (pendingBlockUpdates.empty())
+		{
+			return;
+		}
+
+		std::unordered_map<ENetPeer *, BlockUpdateBatchMessage> batches;
+		for (const auto &entry : pendingBlockUpdates)
+		{
+			auto subscribersIt = chunkSubscribers.find(entry.first);
+			if (subscribersIt == chunkSubscribers.end())
+			{
+				continue;
+			}
+			for (ENetPeer *peer : subscribersIt->second)
+			{
+				batches[peer].chunks.push_back(entry.second);
+			}
+		}
+		pendingBlockUpdates.clear();
+
+		for (const auto &entry : batches)
+		{
+			sendReliable(entry.first, encodeBlockUpdateBatch(entry.second));
+		}
+	}
+
 	void invalidateChunkSnapshotCache(int64_t key)
 	{
 		chunkSnapshotPayloadCache.erase(key);
+		chunkSnapshotCodecVariants.erase(key);
+		chunkSectionDeltaCache.erase(key);
+		// Un ré-encodage en vol sera ignoré: sa séquence ne correspondra plus.
+		chunkSnapshotReencodes.erase(key);
+	}
+
+	void recordChunkSectionEdit(int64_t key, const BlockUpdateBatchEntry &update, uint64_t revision)
+	{
+		std::deque<ChunkSectionEdit> &history = chunkSectionHistory[key];
+		if (!history.empty() && history.back().revision + 1 != revision)
+		{
+			history.clear();
+		}
+		ChunkSectionEdit edit;
+		edit.revision = revision;
+		edit.sections = VoxelChunkData::sectionBit(VoxelChunkData::sectionIndexFromY(update.localY));
+		edit.update = update;
+		history.push_back(edit);
+		while (history.size() > CHUNK_SECTION_HISTORY_LIMIT)
+		{
+			history.pop_front();
+		}
+	}
+
+	// nullptr si l'historique ne contient pas toutes les révisions de baseRevision + 1 à chunk.revision.
+	const std::deque<ChunkSectionEdit> *chunkEditsSince(int64_t key,
+														const VoxelChunkData &chunk,
+														uint64_t baseRevision) const
+	{
+		if (baseRevision >= chunk.revision)
+		{
+			return nullptr;
+		}
+		auto historyIt = chunkSectionHistory.find(key);
+		if (historyIt == chunkSectionHistory.end() || historyIt->second.empty())
+		{
+			return nullptr;
+		}
+		const std::deque<ChunkSectionEdit> &history = historyIt->second;
+		if (history.back().revision != chunk.revision || history.front().revision > baseRevision + 1)
+		{
+			return nullptr;
+		}
+		return &history;
+	}
+
+	bool chunkSectionsChangedSince(int64_t key,
+								   const VoxelChunkData &chunk,
+								   uint64_t baseRevision,
+								   ChunkSectionMask &outSections) const
+	{
+		outSections = 0;
+		if (baseRevision == chunk.revision)
+		{
+			return true;
+		}
+		const std::deque<ChunkSectionEdit> *history = chunkEditsSince(key, chunk, baseRevision);
+		if (history == nullptr)
+		{
+			return false;
+		}
+		for (const ChunkSectionEdit &edit : *history)
+		{
+			if (edit.revision > baseRevision)
+			{
+				outSections |= edit.sections;
+			}
+		}
+		return true;
+	}
+
+	// nullptr si l'historique ne couvre pas baseRevision: il faut alors un snapshot complet.
+	SharedSnapshotPayload chunkSectionDeltaPayload(int64_t key,
+												   const VoxelChunkData &chunk,
+												   uint64_t baseRevision)
+	{
+		auto cacheIt = chunkSectionDeltaCache.find(key);
+		if (cacheIt != chunkSectionDeltaCache.end() &&
+			cacheIt->second.revision == chunk.revision &&
+			cacheIt->second.baseRevision == baseRevision)
+		{
+			return cacheIt->second.payload;
+		}
+
+		ChunkSectionMask changedSections = 0;
+		if (!chunkSectionsChangedSince(key, chunk, baseRevision, changedSections))
+		{
+			return nullptr;
+		}
+
+		CachedChunkSectionDelta &cachedDelta = chunkSectionDeltaCache[key];
+		cachedDelta.baseRevision = baseRevision;
+		cachedDelta.revision = chunk.revision;
+		cachedDelta.payload = std::make_shared<const std::vector<uint8_t>>(
+			encodeChunkSectionDelta(chunk, baseRevision, changedSections));
+		return cachedDelta.payload;
 	}
 
 	const CachedChunkSnapshotPayload &cachedChunkSnapshotPayload(
@@ -2772,7 +4791,9 @@ struct WorldServer::Impl
 		auto cacheIt = chunkSnapshotPayloadCache.find(key);
 		if (cacheIt != chunkSnapshotPayloadCache.end())
 		{
-			if (cacheIt->second.revision == chunk.revision)
+			// Périmé mais rejouable: le ré-encodage reste en arrière-plan, l'appelant envoie le rejeu.
+			if (cacheIt->second.revision == chunk.revision ||
+				chunkEditsSince(key, chunk, cacheIt->second.revision) != nullptr)
 			{
 				return cacheIt->second;
 			}
@@ -2783,48 +4804,487 @@ struct WorldServer::Impl
 		cachedPayload.revision = chunk.revision;
 		cachedPayload.sectionCount = static_cast<uint8_t>(chunk.nonEmptySectionCount());
 		cachedPayload.rawBytes = chunkSnapshotRawPayloadBytes(chunk);
-		cachedPayload.payload = encodeChunkSnapshotNetwork(chunk);
+		cachedPayload.payload = std::make_shared<const std::vector<uint8_t>>(encodeChunkSnapshotNetwork(chunk));
 		return cachedPayload;
 	}
 
-	void sendQueuedChunks(ClientSession &session, size_t sendBudget)
+	// nullptr: utiliser le cache principal (codec Zstd, ou variante en cours d'encodage).
+	SharedSnapshotPayload chunkSnapshotCodecPayload(int64_t key, const VoxelChunkData &chunk, ChunkCodec codec)
 	{
-		size_t sentCount = 0;
+		if (codec == ChunkCodec::Zstd)
+		{
+			return nullptr;
+		}
+
+		ChunkSnapshotCodecVariant &variant = chunkSnapshotCodecVariants[key][static_cast<size_t>(codec)];
+		if (variant.payload != nullptr && variant.revision == chunk.revision)
+		{
+			return variant.payload;
+		}
+		variant.payload.reset();
+		if (codec == ChunkCodec::Sections)
+		{
+			// Une copie des sections: moins cher qu'un aller-retour par les workers.
+			variant.revision = chunk.revision;
+			variant.payload = std::make_shared<const std::vector<uint8_t>>(encodeChunkSnapshot(chunk));
+			return variant.payload;
+		}
+		if (!variant.encoding)
+		{
+			variant.encoding = true;
+			submitSnapshotCodecVariant(key, codec, chunk);
+		}
+		return nullptr;
+	}
+
+	void submitSnapshotCodecVariant(int64_t key, ChunkCodec codec, const VoxelChunkData &chunk)
+	{
+		CompletedSnapshotCodecVariant job;
+		job.key = key;
+		job.codec = codec;
+		job.revision = chunk.revision;
+		jobSystem.submit(JobPriority::Encode, [this, chunk = chunk, job = std::move(job)]() mutable
+						 {
+			ZoneScopedN("Job Encode Chunk Snapshot Variant");
+			job.payload = std::make_shared<const std::vector<uint8_t>>(encodeChunkSnapshotNetwork(chunk, job.codec));
+
+			std::lock_guard<std::mutex> lock(completedSnapshotReencodesMutex);
+			completedSnapshotCodecVariants.push_back(std::move(job)); });
+	}
+
+	void drainCompletedSnapshotCodecVariants()
+	{
+		std::vector<CompletedSnapshotCodecVariant> completed;
+		{
+			std::lock_guard<std::mutex> lock(completedSnapshotReencodesMutex);
+			completed.swap(completedSnapshotCodecVariants);
+		}
+
+		for (CompletedSnapshotCodecVariant &result : completed)
+		{
+			auto variantsIt = chunkSnapshotCodecVariants.find(result.key);
+			auto worldIt = worldChunks.find(result.key);
+			if (variantsIt == chunkSnapshotCodecVariants.end() || worldIt == worldChunks.end())
+			{
+				continue;
+			}
+			ChunkSnapshotCodecVariant &variant = variantsIt->second[static_cast<size_t>(result.codec)];
+			variant.encoding = false;
+			profileCodecVariantEncodes++;
+			// Chunk édité pendant l'encodage: la prochaine demande relancera un job.
+			if (worldIt->second.chunk->revision != result.revision)
+			{
+				continue;
+			}
+			variant.revision = result.revision;
+			variant.payload = std::move(result.payload);
+		}
+	}
+
+	bool chunkEncodingCpuConstrained() const
+	{
+		size_t pendingJobs =
+			jobSystem.pendingCount(JobPriority::Encode) +
+			jobSystem.pendingCount(JobPriority::Generate);
+		return pendingJobs > std::max<size_t>(workerCount, 1) * CHUNK_CODEC_CPU_BACKLOG_JOBS_PER_WORKER;
+	}
+
+	void updateChunkCodecs()
+	{
+		auto now = std::chrono::steady_clock::now();
+		bool cpuConstrained = chunkEncodingCpuConstrained();
+		uint32_t usedCodecs = 0;
+		for (auto &entry : clients)
+		{
+			ClientSession &session = entry.second;
+			ClientSession::ClientLinkState &link = session.link;
+			usedCodecs |= chunkCodecBit(link.chunkCodec);
+			auto elapsed = now - link.lastCodecEvaluation;
+			if (elapsed >= std::chrono::milliseconds(CHUNK_CODEC_EVALUATION_INTERVAL_MS))
+			{
+				double elapsedSeconds = std::chrono::duration<double>(elapsed).count();
+				double ackedBytesPerSecond = static_cast<double>(link.ackedChunkBytes) / elapsedSeconds;
+				link.ackedBytesPerSecond =
+					link.ackedBytesPerSecond * (1.0 - ACKED_THROUGHPUT_SMOOTHING) +
+					ackedBytesPerSecond * ACKED_THROUGHPUT_SMOOTHING;
+				link.ackedChunkBytes = 0;
+				link.lastCodecEvaluation = now;
+			}
+			// Premier choix dès le premier échantillon (RTT de la poignée de main):
+			// la rafale qui suit le login part déjà dans le bon codec.
+			else if (link.chunkCodecChosen)
+			{
+				continue;
+			}
+			if (!link.statsReceived)
+			{
+				continue;
+			}
+			link.chunkCodecChosen = true;
+
+			ChunkCodec codec = environmentOptions.forcedChunkCodec;
+			if (!environmentOptions.chunkCodecForced)
+			{
+				ChunkCodecLinkState linkState;
+				linkState.roundTripTimeMs = link.stats.roundTripTimeMs;
+				linkState.reliableDataInTransit = link.stats.reliableDataInTransit;
+				linkState.ackedBytesPerSecond = link.ackedBytesPerSecond;
+				linkState.cpuConstrained = cpuConstrained;
+				codec = chooseChunkCodec(linkState, link.supportedChunkCodecs, link.chunkCodec);
+			}
+			else if ((link.supportedChunkCodecs & chunkCodecBit(codec)) == 0)
+			{
+				codec = ChunkCodec::Zstd;
+			}
+			if (codec == link.chunkCodec)
+			{
+				continue;
+			}
+
+			if (profileWorkers)
+			{
+				std::cout << "Chunk codec for " << peerAddressString(session.address) << ": "
+						  << chunkCodecName(link.chunkCodec) << " -> " << chunkCodecName(codec)
+						  << " (rtt_ms=" << link.stats.roundTripTimeMs
+						  << " in_transit_bytes=" << link.stats.reliableDataInTransit
+						  << " acked_kib_s=" << link.ackedBytesPerSecond / 1024.0
+						  << " cpu_constrained=" << (cpuConstrained ? 1 : 0) << ")" << std::endl;
+			}
+			link.chunkCodec = codec;
+			usedCodecs |= chunkCodecBit(codec);
+		}
+		// Zstd est toujours encodé, Sections n'est qu'une copie faite à l'envoi.
+		usedCodecs &= ~(chunkCodecBit(ChunkCodec::Zstd) | chunkCodecBit(ChunkCodec::Sections));
+		extraChunkCodecs.store(usedCodecs, std::memory_order_relaxed);
+	}
+
+	void scheduleSnapshotReencode(int64_t key, int sectionIndex)
+	{
+		ChunkSnapshotReencode &reencode = chunkSnapshotReencodes[key];
+		reencode.staleSections |= VoxelChunkData::sectionBit(sectionIndex);
+		chunkSectionDeltaCache.erase(key);
+		if (reencode.queued)
+		{
+			return;
+		}
+		reencode.queued = true;
+		reencode.dueAt = std::chrono::steady_clock::now() +
+			std::chrono::milliseconds(SNAPSHOT_REENCODE_DEBOUNCE_MS);
+		queuedSnapshotReencodes.push_back(key);
+	}
+
+	void submitDueSnapshotReencodes()
+	{
+		if (queuedSnapshotReencodes.empty())
+		{
+			return;
+		}
+
+		auto now = std::chrono::steady_clock::now();
+		size_t keptCount = 0;
+		for (int64_t key : queuedSnapshotReencodes)
+		{
+			auto reencodeIt = chunkSnapshotReencodes.find(key);
+			auto worldIt = worldChunks.find(key);
+			if (reencodeIt == chunkSnapshotReencodes.end() || worldIt == worldChunks.end())
+			{
+				continue;
+			}
+			ChunkSnapshotReencode &reencode = reencodeIt->second;
+			// Un seul encodage en vol par chunk: les trames de sections restent cohérentes.
+			if (now < reencode.dueAt || reencode.inFlight)
+			{
+				queuedSnapshotReencodes[keptCount] = key;
+				keptCount++;
+				continue;
+			}
+			reencode.queued = false;
+			submitSnapshotReencode(key, reencode, *worldIt->second.chunk);
+		}
+		queuedSnapshotReencodes.resize(keptCount);
+	}
 
-		while (sentCount < sendBudget &&
+	void submitSnapshotReencode(int64_t key, ChunkSnapshotReencode &reencode, const VoxelChunkData &chunk)
+	{
+		CompletedSnapshotReencode job;
+		job.key = key;
+		job.sequence = nextSnapshotReencodeSequence;
+		nextSnapshotReencodeSequence++;
+		job.revision = chunk.revision;
+		for (int sectionIndex = 0; sectionIndex < CHUNK_SECTION_COUNT; sectionIndex++)
+		{
+			if ((reencode.staleSections & VoxelChunkData::sectionBit(sectionIndex)) == 0)
+			{
+				job.sectionFrames[sectionIndex] = reencode.sectionFrames[sectionIndex];
+			}
+		}
+		reencode.staleSections = 0;
+		reencode.inFlight = true;
+		reencode.sequence = job.sequence;
+
+		// Copie copy-on-write: les éditions suivantes cloneront leur section au lieu de la toucher.
+		jobSystem.submit(JobPriority::Encode, [this, chunk = chunk, job = std::move(job)]() mutable
+						 {
+			ZoneScopedN("Job Reencode Chunk Snapshot");
+			bool framesOk = true;
+			const std::vector<uint8_t> *frames[CHUNK_SECTION_COUNT] = {};
+			for (int sectionIndex = 0; sectionIndex < CHUNK_SECTION_COUNT; sectionIndex++)
+			{
+				SharedSnapshotPayload &frame = job.sectionFrames[sectionIndex];
+				if (chunk.sectionIfPresent(sectionIndex) == nullptr)
+				{
+					frame.reset();
+					continue;
+				}
+				if (frame == nullptr)
+				{
+					std::vector<uint8_t> compressedFrame;
+					if (!compressChunkSectionFrame(chunk, sectionIndex, compressedFrame))
+					{
+						framesOk = false;
+						continue;
+					}
+					frame = std::make_shared<const std::vector<uint8_t>>(std::move(compressedFrame));
+				}
+				frames[sectionIndex] = frame.get();
+			}
+
+			job.sectionCount = static_cast<uint8_t>(chunk.nonEmptySectionCount());
+			job.rawBytes = chunkSnapshotRawPayloadBytes(chunk);
+			if (framesOk)
+			{
+				job.payload = std::make_shared<const std::vector<uint8_t>>(encodeChunkSnapshotSectionFrames(chunk, frames));
+			}
+			else
+			{
+				job.payload = std::make_shared<const std::vector<uint8_t>>(encodeChunkSnapshotNetwork(chunk));
+			}
+
+			std::lock_guard<std::mutex> lock(completedSnapshotReencodesMutex);
+			completedSnapshotReencodes.push_back(std::move(job)); });
+	}
+
+	void drainCompletedSnapshotReencodes()
+	{
+		std::vector<CompletedSnapshotReencode> completed;
+		{
+			std::lock_guard<std::mutex> lock(completedSnapshotReencodesMutex);
+			completed.swap(completedSnapshotReencodes);
+		}
+
+		for (CompletedSnapshotReencode &result : completed)
+		{
+			auto reencodeIt = chunkSnapshotReencodes.find(result.key);
+			if (reencodeIt == chunkSnapshotReencodes.end() || reencodeIt->second.sequence != result.sequence)
+			{
+				continue;
+			}
+			ChunkSnapshotReencode &reencode = reencodeIt->second;
+			reencode.inFlight = false;
+			for (int sectionIndex = 0; sectionIndex < CHUNK_SECTION_COUNT; sectionIndex++)
+			{
+				reencode.sectionFrames[sectionIndex] = std::move(result.sectionFrames[sectionIndex]);
+			}
+			profileSnapshotReencodes++;
+
+			CachedChunkSnapshotPayload &cachedPayload = chunkSnapshotPayloadCache[result.key];
+			if (cachedPayload.payload != nullptr && cachedPayload.revision >= result.revision)
+			{
+				continue;
+			}
+			cachedPayload.revision = result.revision;
+			cachedPayload.sectionCount = result.sectionCount;
+			cachedPayload.rawBytes = result.rawBytes;
+			cachedPayload.payload = std::move(result.payload);
+		}
+	}
+
+	// Envoyé sur le canal chunk juste après le snapshot périmé: ENet garantit l'ordre d'application.
+	bool sendStaleSnapshotReplay(ClientSession &session, int64_t key, const VoxelChunkData &chunk, uint64_t payloadRevision)
+	{
+		const std::deque<ChunkSectionEdit> *history = chunkEditsSince(key, chunk, payloadRevision);
+		if (history == nullptr)
+		{
+			return false;
+		}
+
+		BlockUpdateBatchMessage replay;
+		BlockUpdateBatchChunk &replayChunk = replay.chunks.emplace_back();
+		replayChunk.chunkX = chunk.chunkX;
+		replayChunk.chunkZ = chunk.chunkZ;
+		replayChunk.revision = chunk.revision;
+		for (const ChunkSectionEdit &edit : *history)
+		{
+			if (edit.revision > payloadRevision)
+			{
+				replayChunk.updates.push_back(edit.update);
+			}
+		}
+		profileStaleSnapshotReplays++;
+		return sendReliable(session.peer, encodeBlockUpdateBatch(replay), WORLD_CHANNEL_CHUNK);
+	}
+
+	// Un paquet passe toujours quand rien n'est en vol, même plus gros que la fenêtre.
+	bool chunkSendWindowOpen(const ClientSession &session, size_t tickBytes, size_t tickByteBudget) const
+	{
+		if (session.chunkStream.pendingChunkBytes == 0)
+		{
+			return true;
+		}
+		return session.chunkStream.pendingChunkBytes < session.link.sendController.windowBytes() &&
+			tickBytes < tickByteBudget;
+	}
+
+	bool chunkInSendFrustum(const PlayerState &state, int64_t key) const
+	{
+		ChunkCoord coord = chunkCoordFromKey(key);
+		float toChunkX = static_cast<float>(coord.x * CHUNK_SIZE_X) + CHUNK_SIZE_X * 0.5f - state.position.x;
+		float toChunkZ = static_cast<float>(coord.z * CHUNK_SIZE_Z) + CHUNK_SIZE_Z * 0.5f - state.position.z;
+		float distance = std::sqrt(toChunkX * toChunkX + toChunkZ * toChunkZ);
+		float lookLength = std::sqrt(
+			state.lookDirection.x * state.lookDirection.x +
+			state.lookDirection.z * state.lookDirection.z);
+		if (distance <= static_cast<float>(SEND_FRUSTUM_NEAR_CHUNKS * CHUNK_SIZE_X) || lookLength <= 0.001f)
+		{
+			return true;
+		}
+		float alignment =
+			(toChunkX * state.lookDirection.x + toChunkZ * state.lookDirection.z) / (distance * lookLength);
+		return alignment >= SEND_FRUSTUM_MIN_ALIGNMENT;
+	}
+
+	uint32_t chunkSendWeight(ClientSession &session, std::chrono::steady_clock::time_point now) const
+	{
+		const ClientSession::ClientPlayerContext &playerContext = session.playerContext;
+		if (!playerContext.playerSession.authenticated ||
+			now - playerContext.authenticatedAt > std::chrono::milliseconds(NEW_PLAYER_SEND_BOOST_MS) ||
+			session.chunkStream.sendQueue.empty())
+		{
+			return 1;
+		}
+		return chunkInSendFrustum(playerContext.player.state, session.chunkStream.sendQueue.top())
+			? NEW_PLAYER_FRUSTUM_SEND_WEIGHT
+			: 1;
+	}
+
+	// Deficit round robin entre sessions: sous un plafond d'émission de l'hôte, l'ordre de
+	// clients (unordered_map) ne décide plus qui est servi.
+	void sendQueuedChunks()
+	{
+		clientSendTicks.clear();
+		chunkSendCandidates.clear();
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		for (auto &entry : clients)
+		{
+			ClientSession &session = entry.second;
+			if (session.chunkStream.sendQueue.empty())
+			{
+				session.link.sendFlow.deficitBytes = std::min<int64_t>(session.link.sendFlow.deficitBytes, 0);
+				continue;
+			}
+			ClientSendTick sendTick;
+			sendTick.session = &session;
+			sendTick.sendBudget = chunkSendBudgetForClientStreamTick(session.chunkStream);
+			sendTick.tickByteBudget = session.link.sendController.tickByteBudget(environmentOptions.streamTickMs);
+			clientSendTicks.push_back(sendTick);
+		}
+		std::sort(clientSendTicks.begin(), clientSendTicks.end(), [](const ClientSendTick &a, const ClientSendTick &b)
+				  { return a.session->replication.replicationId < b.session->replication.replicationId; });
+		for (const ClientSendTick &sendTick : clientSendTicks)
+		{
+			ChunkSendCandidate candidate;
+			candidate.id = sendTick.session->replication.replicationId;
+			candidate.flow = &sendTick.session->link.sendFlow;
+			candidate.weight = chunkSendWeight(*sendTick.session, now);
+			chunkSendCandidates.push_back(candidate);
+		}
+		chunkSendScheduler.schedule(now, chunkSendCandidates, [this](size_t index)
+									{ return sendNextQueuedChunk(clientSendTicks[index]); });
+	}
+
+	// Émet au plus un snapshot (ou delta) de la file; retourne ses octets, 0 si la session est à court.
+	size_t sendNextQueuedChunk(ClientSendTick &sendTick)
+	{
+		ClientSession &session = *sendTick.session;
+		while (sendTick.sentCount < sendTick.sendBudget &&
 			   pendingChunkPacketCountForClient(session.chunkStream) < MAX_PENDING_CHUNK_SNAPSHOTS_PER_CLIENT &&
+			   chunkSendWindowOpen(session, sendTick.tickBytes, sendTick.tickByteBudget) &&
 			   !session.chunkStream.sendQueue.empty())
 		{
-			int64_t key = session.chunkStream.sendQueue.front();
-			session.chunkStream.sendQueue.pop_front();
-			session.chunkStream.queuedChunks.erase(key);
+			int64_t key = session.chunkStream.sendQueue.top();
+			session.chunkStream.sendQueue.pop();
+			if (session.chunkStream.queuedChunks.erase(key) == 0)
+			{
+				continue;
+			}
 
 			if (session.chunkStream.wantedChunks.find(key) == session.chunkStream.wantedChunks.end())
 			{
+				unsubscribeFromChunkUpdatesIfUnused(session, key);
 				continue;
 			}
 
 			auto worldIt = worldChunks.find(key);
 			if (worldIt == worldChunks.end())
 			{
+				unsubscribeFromChunkUpdatesIfUnused(session, key);
 				continue;
 			}
 
-			const CachedChunkSnapshotPayload &cachedPayload =
-				cachedChunkSnapshotPayload(key, worldIt->second);
-			if (!sendChunkSnapshot(session, cachedPayload.payload))
+			const VoxelChunkData &chunk = *worldIt->second.chunk;
+			const CachedChunkSnapshotPayload &cachedPayload = cachedChunkSnapshotPayload(key, chunk);
+			// Variante pas encore prête: on envoie la Zstd du cache principal en attendant.
+			SharedSnapshotPayload codecPayload = chunkSnapshotCodecPayload(key, chunk, session.link.chunkCodec);
+			const SharedSnapshotPayload &snapshotPayload = codecPayload != nullptr ? codecPayload : cachedPayload.payload;
+			SharedSnapshotPayload deltaPayload;
+			auto knownIt = session.chunkStream.knownRevisions.find(key);
+			if (knownIt != session.chunkStream.knownRevisions.end())
+			{
+				deltaPayload = chunkSectionDeltaPayload(key, chunk, knownIt->second);
+				if (deltaPayload != nullptr && deltaPayload->size() >= snapshotPayload->size())
+				{
+					deltaPayload.reset();
+				}
+			}
+
+			const SharedSnapshotPayload &payload = deltaPayload != nullptr ? deltaPayload : snapshotPayload;
+			if (!sendChunkSnapshot(session, payload))
 			{
-				session.chunkStream.sendQueue.push_front(key);
+				// Même priorité: il repasse en tête au tick suivant.
+				session.chunkStream.sendQueue.push(key);
 				session.chunkStream.queuedChunks.insert(key);
-				break;
+				return 0;
+			}
+			sendTick.tickBytes += payload->size();
+			metrics.chunksSent.add();
+			metrics.chunkBytesSent.add(payload->size());
+			if (deltaPayload != nullptr)
+			{
+				profileSectionDeltaCount++;
+				profileSectionDeltaBytes += deltaPayload->size();
+			}
+			else
+			{
+				if (codecPayload == nullptr && cachedPayload.revision != chunk.revision)
+				{
+					sendStaleSnapshotReplay(session, key, chunk, cachedPayload.revision);
+				}
+				ChunkCodec sentCodec = codecPayload != nullptr ? session.link.chunkCodec : ChunkCodec::Zstd;
+				profileCodecSnapshots[static_cast<size_t>(sentCodec)]++;
+				profileSnapshotCount++;
+				profileSnapshotPayloadBytes += snapshotPayload->size();
+				profileSnapshotSectionCount += cachedPayload.sectionCount;
+				profileSnapshotRawBytes += cachedPayload.rawBytes;
+			}
+			if (knownIt != session.chunkStream.knownRevisions.end())
+			{
+				session.chunkStream.knownRevisions.erase(knownIt);
 			}
-			profileSnapshotCount++;
-			profileSnapshotPayloadBytes += cachedPayload.payload.size();
-			profileSnapshotSectionCount += cachedPayload.sectionCount;
-			profileSnapshotRawBytes += cachedPayload.rawBytes;
 			session.chunkStream.loadedChunks.insert(key);
-			sentCount++;
+			sendTick.sentCount++;
+			return payload->size();
 		}
+		return 0;
 	}
 
 	size_t chunkSendBudgetForClientStreamTick(const ClientSession::ClientChunkStreamState &chunkStream)
@@ -2863,39 +5323,53 @@ struct WorldServer::Impl
 		{
 			return;
 		}
-		Impl *server = static_cast<Impl *>(packet->userData);
-		if (server == nullptr)
+		ChunkPacketTag *tag = static_cast<ChunkPacketTag *>(packet->userData);
+		packet->userData = nullptr;
+		if (tag == nullptr)
 		{
 			return;
 		}
-		server->handleChunkSnapshotPacketFreed(packet);
+		// Appelé depuis le thread réseau (ack) ou depuis l'arrêt: on ne touche pas aux sessions ici.
+		{
+			std::lock_guard<std::mutex> lock(tag->server->freedChunkPacketsMutex);
+			tag->server->freedChunkPackets.push_back(tag->freed);
+		}
+		// Dernier paquet relâché: le buffer part avec lui si le cache l'a déjà remplacé.
+		delete tag;
 	}
 
-	void handleChunkSnapshotPacketFreed(ENetPacket *packet)
+	void drainFreedChunkPackets()
 	{
-		auto pendingIt = pendingChunkPackets.find(packet);
-		if (pendingIt == pendingChunkPackets.end())
+		std::vector<FreedChunkPacket> freedPackets;
 		{
-			return;
+			std::lock_guard<std::mutex> lock(freedChunkPacketsMutex);
+			freedPackets.swap(freedChunkPackets);
 		}
-
-		PendingChunkPacket pendingPacket = pendingIt->second;
-		pendingChunkPackets.erase(pendingIt);
-
-		auto sessionIt = clients.find(pendingPacket.peer);
-		if (sessionIt == clients.end())
+		for (const FreedChunkPacket &freed : freedPackets)
 		{
-			return;
+			auto sessionIt = clients.find(freed.peer);
+			if (sessionIt == clients.end())
+			{
+				continue;
+			}
+			ClientSession &session = sessionIt->second;
+			if (session.chunkStream.pendingPacketIds.erase(freed.packetId) == 0)
+			{
+				continue;
+			}
+			session.chunkStream.pendingChunkBytes -= std::min<size_t>(session.chunkStream.pendingChunkBytes, freed.bytes);
+			session.link.ackedChunkBytes += freed.bytes;
+			session.link.sendWindowAckedBytes += freed.bytes;
 		}
-		sessionIt->second.chunkStream.pendingPacketIds.erase(pendingPacket.packetId);
 	}
 
-	bool sendChunkSnapshot(ClientSession &session, const std::vector<uint8_t> &payload)
+	bool sendChunkSnapshot(ClientSession &session, const SharedSnapshotPayload &payload)
 	{
+		// Pas de copie par destinataire: ENet référence directement les octets du cache.
 		ENetPacket *packet = enet_packet_create(
-			payload.data(),
-			payload.size(),
-			ENET_PACKET_FLAG_RELIABLE);
+			payload->data(),
+			payload->size(),
+			ENET_PACKET_FLAG_RELIABLE | ENET_PACKET_FLAG_NO_ALLOCATE);
 		if (packet == nullptr)
 		{
 			return false;
@@ -2908,30 +5382,36 @@ struct WorldServer::Impl
 			nextChunkSnapshotPacketId = 1;
 		}
 
+		ChunkPacketTag *tag = new ChunkPacketTag{this, {session.peer, packetId, static_cast<uint32_t>(payload->size())}, payload};
 		packet->freeCallback = &Impl::onChunkSnapshotPacketFreed;
-		packet->userData = this;
-
-		PendingChunkPacket pendingPacket;
-		pendingPacket.peer = session.peer;
-		pendingPacket.packetId = packetId;
-		pendingChunkPackets[packet] = pendingPacket;
+		packet->userData = tag;
 		session.chunkStream.pendingPacketIds.insert(packetId);
 
-		int sendResult = enet_peer_send(session.peer, WORLD_CHANNEL_CHUNK, packet);
-		if (sendResult == 0)
+		// File sortante pleine: l'appelant remet le chunk dans sendQueue pour le tick suivant.
+		if (queueOutboundPacket(session.peer, session.connectId, WORLD_CHANNEL_CHUNK, packet, false))
 		{
+			session.chunkStream.pendingChunkBytes += payload->size();
+			session.chunkStream.peakPendingChunkBytes = std::max(
+				session.chunkStream.peakPendingChunkBytes,
+				session.chunkStream.pendingChunkBytes);
 			return true;
 		}
-		pendingChunkPackets.erase(packet);
 		session.chunkStream.pendingPacketIds.erase(packetId);
 		packet->freeCallback = nullptr;
 		packet->userData = nullptr;
+		delete tag;
 		enet_packet_destroy(packet);
 		return false;
 	}
 
-	bool sendReliable(ENetPeer *peer, const std::vector<uint8_t> &payload)
+	bool sendReliable(ENetPeer *peer, const std::vector<uint8_t> &payload, size_t channel = WORLD_CHANNEL_RELIABLE)
 	{
+		auto sessionIt = clients.find(peer);
+		if (sessionIt == clients.end())
+		{
+			return false;
+		}
+
 		ENetPacket *packet = enet_packet_create(
 			payload.data(),
 			payload.size(),
@@ -2941,8 +5421,7 @@ struct WorldServer::Impl
 			return false;
 		}
 
-		int sendResult = enet_peer_send(peer, WORLD_CHANNEL_RELIABLE, packet);
-		if (sendResult != 0)
+		if (!queueOutboundPacket(peer, sessionIt->second.connectId, static_cast<uint8_t>(channel), packet, true))
 		{
 			enet_packet_destroy(packet);
 			return false;
@@ -2965,7 +5444,9 @@ WorldServer::WorldServer(uint16_t port,
 						 std::string playerDatabasePath,
 						 std::string worldDatabasePath,
 						 bool persistGeneratedChunks,
-						 ServerEnvironmentOptions environmentOptions)
+						 ServerEnvironmentOptions environmentOptions,
+						 ShardLayout shard,
+						 std::string shardToken)
 {
 	m_impl = new Impl(
 		port,
@@ -2974,7 +5455,9 @@ WorldServer::WorldServer(uint16_t port,
 		std::move(playerDatabasePath),
 		std::move(worldDatabasePath),
 		persistGeneratedChunks,
-		environmentOptions);
+		environmentOptions,
+		shard,
+		shardToken);
 }
 
 WorldServer::~WorldServer()
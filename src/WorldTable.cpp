@@ -1,13 +1,12 @@
 #include <WorldTable.h>
 
+#include <ChunkZstdCodec.h>
+#include <ChunkZstdDictionary.h>
 #include <WorldProtocol.h>
 
-#include <zstd.h>
-
 #include <chrono>
 #include <cstdint>
 #include <cstring>
-#include <limits>
 #include <string>
 #include <vector>
 
@@ -16,16 +15,9 @@ namespace
 	constexpr const char *WORLD_STORAGE_FORMAT_VERSION = "1";
 	constexpr const char *WORLD_STORAGE_ENCODING = "chunk_snapshot_sections_zstd_v1";
 	constexpr int WORLD_STORAGE_ZSTD_LEVEL = 3;
-
-	struct PreparedChunkPayload
-	{
-		int64_t key = 0;
-		int chunkX = 0;
-		int chunkZ = 0;
-		uint64_t revision = 0;
-		uint64_t nowMs = 0;
-		std::vector<uint8_t> payload;
-	};
+	// chunk_encoding reste v1: l'id du dictionnaire est dans l'en-tête de chaque trame.
+	constexpr const char *WORLD_META_CHUNK_DICTIONARY_ID_KEY = "chunk_zstd_dictionary_id";
+	constexpr const char *WORLD_META_CHUNK_DICTIONARY_PREFIX = "chunk_zstd_dictionary:";
 
 	uint64_t systemNowMs()
 	{
@@ -34,68 +26,97 @@ namespace
 			std::chrono::duration_cast<std::chrono::milliseconds>(now).count());
 	}
 
-	bool tryDecodeChunkPayload(const void *blob, size_t blobSize, DecodedChunkSnapshot &decoded)
+	std::string encodeHex(const std::vector<uint8_t> &bytes)
 	{
-		if (blob == nullptr || blobSize == 0)
+		constexpr const char *HEX_DIGITS = "0123456789abcdef";
+		std::string text;
+		text.reserve(bytes.size() * 2);
+		for (uint8_t byte : bytes)
 		{
-			return false;
+			text.push_back(HEX_DIGITS[byte >> 4]);
+			text.push_back(HEX_DIGITS[byte & 0x0F]);
 		}
+		return text;
+	}
 
-		unsigned long long decompressedSize =
-			ZSTD_getFrameContentSize(blob, blobSize);
-		if (decompressedSize == ZSTD_CONTENTSIZE_ERROR ||
-			decompressedSize == ZSTD_CONTENTSIZE_UNKNOWN)
+	int hexDigitValue(char digit)
+	{
+		if (digit >= '0' && digit <= '9')
 		{
-			return false;
+			return digit - '0';
 		}
-		if (decompressedSize > static_cast<unsigned long long>(std::numeric_limits<size_t>::max()))
+		if (digit >= 'a' && digit <= 'f')
+		{
+			return digit - 'a' + 10;
+		}
+		if (digit >= 'A' && digit <= 'F')
+		{
+			return digit - 'A' + 10;
+		}
+		return -1;
+	}
+
+	bool decodeHex(const char *text, size_t length, std::vector<uint8_t> &outBytes)
+	{
+		outBytes.clear();
+		if (length % 2 != 0)
 		{
 			return false;
 		}
+		outBytes.reserve(length / 2);
+		for (size_t index = 0; index < length; index += 2)
+		{
+			int high = hexDigitValue(text[index]);
+			int low = hexDigitValue(text[index + 1]);
+			if (high < 0 || low < 0)
+			{
+				outBytes.clear();
+				return false;
+			}
+			outBytes.push_back(static_cast<uint8_t>((high << 4) | low));
+		}
+		return true;
+	}
+
+	// Tampons du worker de sauvegarde et des chargements, gardés d'un chunk à l'autre.
+	thread_local std::vector<uint8_t> encodedChunkScratch;
+	thread_local std::vector<uint8_t> compressedChunkScratch;
+	thread_local std::vector<uint8_t> decompressedChunkScratch;
 
-		std::vector<uint8_t> decompressedBuffer(
-			static_cast<size_t>(decompressedSize));
-		size_t result = ZSTD_decompress(
-			decompressedBuffer.data(),
-			decompressedBuffer.size(),
-			blob,
-			blobSize);
-		if (ZSTD_isError(result))
+	bool tryDecodeChunkPayload(const void *blob, size_t blobSize, DecodedChunkSnapshot &decoded)
+	{
+		if (blob == nullptr || blobSize == 0)
 		{
 			return false;
 		}
-		if (result != decompressedBuffer.size())
+
+		if (!decompressChunkZstdInto(blob, blobSize, 0, decompressedChunkScratch))
 		{
 			return false;
 		}
 
 		return decodeChunkSnapshot(
-			decompressedBuffer.data(),
-			decompressedBuffer.size(),
+			decompressedChunkScratch.data(),
+			decompressedChunkScratch.size(),
 			decoded);
 	}
 
 	bool prepareChunkPayload(
 		const VoxelChunkData &chunk,
-		PreparedChunkPayload &prepared,
+		WorldTablePreparedChunk &prepared,
 		std::string &error)
 	{
-		std::vector<uint8_t> encodedChunk = encodeChunkSnapshot(chunk);
-		size_t maxCompressedSize = ZSTD_compressBound(encodedChunk.size());
-		prepared.payload.resize(maxCompressedSize);
-		size_t compressedSize = ZSTD_compress(
-			prepared.payload.data(),
-			prepared.payload.size(),
-			encodedChunk.data(),
-			encodedChunk.size(),
-			WORLD_STORAGE_ZSTD_LEVEL);
-		if (ZSTD_isError(compressedSize))
-		{
-			error = "Failed to compress world chunk payload: ";
-			error += ZSTD_getErrorName(compressedSize);
+		encodeChunkSnapshotInto(chunk, encodedChunkScratch);
+		if (!compressChunkZstdInto(
+				encodedChunkScratch.data(),
+				encodedChunkScratch.size(),
+				WORLD_STORAGE_ZSTD_LEVEL,
+				compressedChunkScratch))
+		{
+			error = "Failed to compress world chunk payload";
 			return false;
 		}
-		prepared.payload.resize(compressedSize);
+		prepared.payload.assign(compressedChunkScratch.begin(), compressedChunkScratch.end());
 		prepared.key = chunkKey(chunk.chunkX, chunk.chunkZ);
 		prepared.chunkX = chunk.chunkX;
 		prepared.chunkZ = chunk.chunkZ;
@@ -163,6 +184,12 @@ bool WorldTable::open(const std::string &databasePath, const std::string &genera
 		return false;
 	}
 
+	if (!loadChunkDictionariesNoLock())
+	{
+		closeNoLock();
+		return false;
+	}
+
 	executeStatementNoLock("PRAGMA journal_mode=WAL;");
 	executeStatementNoLock("PRAGMA synchronous=NORMAL;");
 	if (!preparePersistentStatementsNoLock())
@@ -439,33 +466,186 @@ bool WorldTable::saveMetaValue(const std::string &key, const std::string &value)
 	return true;
 }
 
+bool WorldTable::saveChunkDictionary(const ChunkZstdDictionary &dictionary)
+{
+	std::string idText = std::to_string(dictionary.id());
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_lastError.clear();
+	if (m_db == nullptr)
+	{
+		m_lastError = "World database is not open";
+		return false;
+	}
+
+	const char *sql =
+		"INSERT OR REPLACE INTO world_meta (key, value) VALUES (?1, ?2);";
+	sqlite3_stmt *statement = nullptr;
+	if (!prepareStatementNoLock(sql, &statement))
+	{
+		return false;
+	}
+	if (!beginTransactionNoLock())
+	{
+		sqlite3_finalize(statement);
+		return false;
+	}
+
+	// Les anciens dictionnaires restent en base: des lignes peuvent encore en dépendre.
+	std::pair<std::string, std::string> rows[] = {
+		{std::string(WORLD_META_CHUNK_DICTIONARY_PREFIX) + idText, encodeHex(dictionary.content())},
+		{WORLD_META_CHUNK_DICTIONARY_ID_KEY, idText}};
+	for (const auto &[key, value] : rows)
+	{
+		sqlite3_reset(statement);
+		sqlite3_clear_bindings(statement);
+		if (sqlite3_bind_text(statement, 1, key.c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK ||
+			sqlite3_bind_text(statement, 2, value.c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK ||
+			sqlite3_step(statement) != SQLITE_DONE)
+		{
+			setLastErrorFromDatabaseNoLock("Failed to save world chunk dictionary");
+			sqlite3_finalize(statement);
+			rollbackTransactionNoLock();
+			return false;
+		}
+	}
+	sqlite3_finalize(statement);
+	if (!commitTransactionNoLock())
+	{
+		rollbackTransactionNoLock();
+		return false;
+	}
+	return true;
+}
+
+bool WorldTable::loadChunkDictionariesNoLock()
+{
+	const char *sql =
+		"SELECT key, value FROM world_meta WHERE key = ?1 OR substr(key, 1, ?2) = ?3;";
+	sqlite3_stmt *statement = nullptr;
+	if (!prepareStatementNoLock(sql, &statement))
+	{
+		return false;
+	}
+	std::string prefix = WORLD_META_CHUNK_DICTIONARY_PREFIX;
+	if (sqlite3_bind_text(statement, 1, WORLD_META_CHUNK_DICTIONARY_ID_KEY, -1, SQLITE_STATIC) != SQLITE_OK ||
+		sqlite3_bind_int(statement, 2, static_cast<int>(prefix.size())) != SQLITE_OK ||
+		sqlite3_bind_text(statement, 3, prefix.c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK)
+	{
+		setLastErrorFromDatabaseNoLock("Failed to bind world chunk dictionary query");
+		sqlite3_finalize(statement);
+		return false;
+	}
+
+	std::string activeIdText;
+	std::vector<std::shared_ptr<const ChunkZstdDictionary>> dictionaries;
+	while (true)
+	{
+		int stepResult = sqlite3_step(statement);
+		if (stepResult == SQLITE_DONE)
+		{
+			break;
+		}
+		if (stepResult != SQLITE_ROW)
+		{
+			setLastErrorFromDatabaseNoLock("Failed to read world chunk dictionaries");
+			sqlite3_finalize(statement);
+			return false;
+		}
+
+		const char *key = reinterpret_cast<const char *>(sqlite3_column_text(statement, 0));
+		const char *value = reinterpret_cast<const char *>(sqlite3_column_text(statement, 1));
+		int valueLength = sqlite3_column_bytes(statement, 1);
+		if (key == nullptr || value == nullptr)
+		{
+			continue;
+		}
+		if (std::strcmp(key, WORLD_META_CHUNK_DICTIONARY_ID_KEY) == 0)
+		{
+			activeIdText = value;
+			continue;
+		}
+
+		std::vector<uint8_t> content;
+		std::string dictionaryError;
+		std::shared_ptr<const ChunkZstdDictionary> dictionary;
+		if (decodeHex(value, static_cast<size_t>(valueLength), content))
+		{
+			dictionary = ChunkZstdDictionary::create(std::move(content), &dictionaryError);
+		}
+		if (dictionary == nullptr ||
+			std::to_string(dictionary->id()) != key + prefix.size())
+		{
+			m_lastError = "Invalid world chunk dictionary ";
+			m_lastError += key;
+			sqlite3_finalize(statement);
+			return false;
+		}
+		dictionaries.push_back(std::move(dictionary));
+	}
+	sqlite3_finalize(statement);
+
+	bool activeFound = activeIdText.empty();
+	for (std::shared_ptr<const ChunkZstdDictionary> &dictionary : dictionaries)
+	{
+		bool active = std::to_string(dictionary->id()) == activeIdText;
+		activeFound = activeFound || active;
+		registerChunkZstdDictionary(std::move(dictionary), active);
+	}
+	if (!activeFound)
+	{
+		m_lastError = "Active world chunk dictionary " + activeIdText + " is missing";
+		return false;
+	}
+	return true;
+}
+
 bool WorldTable::saveChunk(const VoxelChunkData &chunk)
 {
-	std::vector<VoxelChunkData> chunks;
-	chunks.push_back(chunk);
+	std::vector<const VoxelChunkData *> chunks;
+	chunks.push_back(&chunk);
 	return saveChunksBatch(chunks);
 }
 
-bool WorldTable::saveChunksBatch(const std::vector<VoxelChunkData> &chunks)
+bool WorldTable::saveChunksBatch(const std::vector<const VoxelChunkData *> &chunks)
 {
 	if (chunks.empty())
 	{
 		return true;
 	}
 
-	std::vector<PreparedChunkPayload> preparedChunks;
-	preparedChunks.reserve(chunks.size());
-	for (const VoxelChunkData &chunk : chunks)
+	std::vector<WorldTablePreparedChunk> preparedChunks;
+	if (!prepareChunksBatch(chunks, preparedChunks))
+	{
+		return false;
+	}
+	return savePreparedChunksBatch(preparedChunks);
+}
+
+bool WorldTable::prepareChunksBatch(const std::vector<const VoxelChunkData *> &chunks,
+									std::vector<WorldTablePreparedChunk> &outPrepared)
+{
+	outPrepared.clear();
+	outPrepared.reserve(chunks.size());
+	for (const VoxelChunkData *chunk : chunks)
 	{
-		PreparedChunkPayload prepared;
+		WorldTablePreparedChunk prepared;
 		std::string prepareError;
-		if (!prepareChunkPayload(chunk, prepared, prepareError))
+		if (!prepareChunkPayload(*chunk, prepared, prepareError))
 		{
 			std::lock_guard<std::mutex> lock(m_mutex);
 			m_lastError = std::move(prepareError);
 			return false;
 		}
-		preparedChunks.push_back(std::move(prepared));
+		outPrepared.push_back(std::move(prepared));
+	}
+	return true;
+}
+
+bool WorldTable::savePreparedChunksBatch(const std::vector<WorldTablePreparedChunk> &preparedChunks)
+{
+	if (preparedChunks.empty())
+	{
+		return true;
 	}
 
 	std::lock_guard<std::mutex> lock(m_mutex);
@@ -479,7 +659,7 @@ bool WorldTable::saveChunksBatch(const std::vector<VoxelChunkData> &chunks)
 	{
 		return false;
 	}
-	for (const PreparedChunkPayload &prepared : preparedChunks)
+	for (const WorldTablePreparedChunk &prepared : preparedChunks)
 	{
 		if (!saveChunkUsingPreparedStatementNoLock(
 				prepared.key,
@@ -1,43 +1,10 @@
 #include <client/gameplay/ChunkStreamingSystem.h>
 
-#include <algorithm>
-
-namespace
-{
-	float chunkCenterDistanceSqToPos(const glm::vec3 &pos, int chunkX, int chunkZ)
-	{
-		float centerX = chunkX * CHUNK_SIZE_X + CHUNK_SIZE_X * 0.5f;
-		float centerZ = chunkZ * CHUNK_SIZE_Z + CHUNK_SIZE_Z * 0.5f;
-		float dx = centerX - pos.x;
-		float dz = centerZ - pos.z;
-		return dx * dx + dz * dz;
-	}
-
-	bool usesOptimizedStreamingBudgets(bool hasWorldFrontier, const WorldFrontier &frontier)
-	{
-		if (!hasWorldFrontier)
-		{
-			return false;
-		}
-		if (frontier.mode == WorldGenerationMode::ClassicStreaming)
-		{
-			return true;
-		}
-		if (frontier.mode == WorldGenerationMode::ActivityFrontier)
-		{
-			return true;
-		}
-		return false;
-	}
-}
+#include <ChunkStreamPlanner.h>
 
 bool ChunkStreamingSystem::usesClassicStreaming(bool hasWorldFrontier, const WorldFrontier &frontier)
 {
-	if (!hasWorldFrontier)
-	{
-		return false;
-	}
-	return frontier.mode == WorldGenerationMode::ClassicStreaming;
+	return ChunkStreamPlanner::usesClassicStreaming(hasWorldFrontier, frontier);
 }
 
 bool ChunkStreamingSystem::canStreamChunk(bool hasWorldFrontier,
@@ -45,11 +12,7 @@ bool ChunkStreamingSystem::canStreamChunk(bool hasWorldFrontier,
 										  int chunkX,
 										  int chunkZ)
 {
-	if (usesClassicStreaming(hasWorldFrontier, frontier))
-	{
-		return true;
-	}
-	return frontier.generatedBounds.containsChunk(chunkX, chunkZ);
+	return ChunkStreamPlanner::canStreamChunk(hasWorldFrontier, frontier, chunkX, chunkZ);
 }
 
 size_t ChunkStreamingSystem::inflightChunkRequestCount(
@@ -84,6 +47,7 @@ void ChunkStreamingSystem::syncChunkStreaming(
 	size_t classicMaxChunkRequestsPerFrame,
 	std::unordered_set<int64_t> &streamedChunkKeys,
 	std::unordered_map<int64_t, ClientChunk *> &chunkMap,
+	const ClientRetainedChunkCache &retainedChunks,
 	size_t &profileChunkRequestsWindow,
 	size_t &profileChunkDropsWindow,
 	const std::function<void(int64_t)> &dropChunkByKey)
@@ -93,144 +57,45 @@ void ChunkStreamingSystem::syncChunkStreaming(
 		return;
 	}
 
-	int streamDistanceChunks = renderDistanceChunks;
-	if (usesOptimizedStreamingBudgets(hasWorldFrontier, frontier))
-	{
-		streamDistanceChunks += classicStreamingPaddingChunks;
-	}
-
-	float roundTripSec = roundTripTimeMs / 1000.0f;
-	float serverChunkReadyMs = std::max(serverTerrainGenMsAvg, serverSqliteLoadMsAvg);
-	float serverChunkReadySec = serverChunkReadyMs / 1000.0f;
-	// On prend le chemin serveur le plus lent entre lecture DB et génération.
-	// Cela évite de sous-estimer l'avance nécessaire quand les chunks viennent du disque.
-	float predictionTimeSec = (roundTripSec * 1.2f) + serverChunkReadySec;
-
-	// On anticipe la position du joueur avec la latence totale estimée
-	glm::vec3 predictedCameraPos = camera.Position + (cameraVelocity * predictionTimeSec);
-
-	int cameraChunkX = floorDiv(static_cast<int>(std::floor(predictedCameraPos.x)), CHUNK_SIZE_X);
-	int cameraChunkZ = floorDiv(static_cast<int>(std::floor(predictedCameraPos.z)), CHUNK_SIZE_Z);
-	int radiusSq = streamDistanceChunks * streamDistanceChunks;
-
-	struct ChunkRequestCandidate
-	{
-		int chunkX = 0;
-		int chunkZ = 0;
-		float distSq = 0.0f;
-		bool inFrustum = false;
-	};
-	std::vector<ChunkRequestCandidate> requestCandidates;
-
-	for (int dz = -streamDistanceChunks; dz <= streamDistanceChunks; dz++)
-	{
-		for (int dx = -streamDistanceChunks; dx <= streamDistanceChunks; dx++)
-		{
-			if (dx * dx + dz * dz > radiusSq)
-			{
-				continue;
-			}
-
-			int cx = cameraChunkX + dx;
-			int cz = cameraChunkZ + dz;
-			if (!canStreamChunk(hasWorldFrontier, frontier, cx, cz))
-			{
-				continue;
-			}
-
-			int64_t key = chunkKey(cx, cz);
-			if (streamedChunkKeys.find(key) == streamedChunkKeys.end())
-			{
-				ChunkRequestCandidate candidate;
-				candidate.chunkX = cx;
-				candidate.chunkZ = cz;
-				candidate.distSq = chunkCenterDistanceSqToPos(predictedCameraPos, cx, cz);
-				candidate.inFrustum = streamFrustum.isChunkVisible(cx, cz);
-				requestCandidates.push_back(candidate);
-			}
-		}
-	}
-
-	std::sort(requestCandidates.begin(), requestCandidates.end(),
-			  [](const ChunkRequestCandidate &left, const ChunkRequestCandidate &right)
-			  {
-				  if (left.inFrustum != right.inFrustum)
-				  {
-					  return left.inFrustum > right.inFrustum;
-				  }
-				  return left.distSq < right.distSq;
-			  });
-
-	size_t maxNewRequestsThisFrame = requestCandidates.size();
-	if (usesOptimizedStreamingBudgets(hasWorldFrontier, frontier))
+	ChunkStreamPlanInput input;
+	input.position = camera.Position;
+	input.velocity = cameraVelocity;
+	input.roundTripTimeMs = roundTripTimeMs;
+	input.serverTerrainGenMsAvg = serverTerrainGenMsAvg;
+	input.serverSqliteLoadMsAvg = serverSqliteLoadMsAvg;
+	input.deltaTime = deltaTime;
+	input.hasWorldFrontier = hasWorldFrontier;
+	input.frontier = frontier;
+	input.renderDistanceChunks = renderDistanceChunks;
+	input.classicStreamingPaddingChunks = classicStreamingPaddingChunks;
+	input.classicMaxInflightChunkRequests = classicMaxInflightChunkRequests;
+	input.classicMaxChunkRequestsPerFrame = classicMaxChunkRequestsPerFrame;
+
+	ChunkStreamPlan plan;
+	ChunkStreamPlanner::plan(
+		input,
+		streamFrustum,
+		streamedChunkKeys,
+		inflightChunkRequestCount(streamedChunkKeys, chunkMap),
+		plan);
+
+	for (const ChunkCoord &coord : plan.requests)
 	{
-		size_t frustumMissingChunks = 0;
-		for (const auto &candidate : requestCandidates)
+		int64_t key = chunkKey(coord);
+		uint64_t knownRevision = 0;
+		if (retainedChunks.knownRevision(key, knownRevision))
 		{
-			if (!candidate.inFrustum)
-			{
-				break;
-			}
-			frustumMissingChunks++;
+			worldClient.sendChunkRequest(coord.x, coord.z, knownRevision);
 		}
-
-		size_t inflightRequests = inflightChunkRequestCount(streamedChunkKeys, chunkMap);
-		size_t backgroundBudget = 0;
-		if (inflightRequests < classicMaxInflightChunkRequests)
+		else
 		{
-			backgroundBudget = classicMaxInflightChunkRequests - inflightRequests;
+			worldClient.sendChunkRequest(coord.x, coord.z);
 		}
-
-		size_t totalBudget = frustumMissingChunks + backgroundBudget;
-		maxNewRequestsThisFrame = std::min(maxNewRequestsThisFrame, totalBudget);
-
-		float distanceMoved = 0.0f;
-		if (deltaTime > 0.0f)
-		{
-			distanceMoved = glm::length(cameraVelocity) * deltaTime;
-		}
-
-		if (distanceMoved <= 2.0f)
-		{
-			size_t cappedLimit = std::min(maxNewRequestsThisFrame, classicMaxChunkRequestsPerFrame);
-			maxNewRequestsThisFrame = std::max(frustumMissingChunks, cappedLimit);
-		}
-	}
-	size_t sentRequestsThisFrame = 0;
-	for (const ChunkRequestCandidate &candidate : requestCandidates)
-	{
-		if (sentRequestsThisFrame >= maxNewRequestsThisFrame)
-		{
-			break;
-		}
-		worldClient.sendChunkRequest(candidate.chunkX, candidate.chunkZ);
-		streamedChunkKeys.insert(chunkKey(candidate.chunkX, candidate.chunkZ));
+		streamedChunkKeys.insert(key);
 		profileChunkRequestsWindow++;
-		sentRequestsThisFrame++;
-	}
-
-	int dropDistanceChunks = streamDistanceChunks;
-	if (usesOptimizedStreamingBudgets(hasWorldFrontier, frontier))
-	{
-		dropDistanceChunks += classicStreamingPaddingChunks;
-	}
-	int dropRadiusSq = dropDistanceChunks * dropDistanceChunks;
-
-	std::vector<int64_t> keysToDrop;
-	for (int64_t key : streamedChunkKeys)
-	{
-		int cx = static_cast<int>(key >> 32);
-		int cz = static_cast<int>(key & 0xFFFFFFFF);
-		int dx = cx - cameraChunkX;
-		int dz = cz - cameraChunkZ;
-
-		if (dx * dx + dz * dz > dropRadiusSq || !canStreamChunk(hasWorldFrontier, frontier, cx, cz))
-		{
-			keysToDrop.push_back(key);
-		}
 	}
 
-	for (int64_t key : keysToDrop)
+	for (int64_t key : plan.drops)
 	{
 		int cx = static_cast<int>(key >> 32);
 		int cz = static_cast<int>(key & 0xFFFFFFFF);
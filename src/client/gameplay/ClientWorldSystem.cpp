@@ -52,6 +52,7 @@ void ClientWorldSystem::clear(ClientWorldState &worldState, ChunkIndirectRendere
 	worldState.serverProfile = ServerProfileMessage{};
 	worldState.chatMessages.clear();
 	worldState.pendingMeshRevisions.clear();
+	worldState.retainedChunks.clear();
 	worldState.profileChunkRequestsWindow = 0;
 	worldState.profileChunkDropsWindow = 0;
 	worldState.profileChunkReceivesWindow = 0;
@@ -119,7 +120,32 @@ void ClientWorldSystem::handleEvents(WorldClient &worldClient,
 		}
 		if (event.type == WorldClientEvent::Type::ChunkReceived)
 		{
-			MeshBuildSystem::upsertChunkSnapshot(worldState.chunkMap, worldState.streamedChunkKeys, event.chunk);
+			if (MeshBuildSystem::upsertChunkSnapshot(worldState.chunkMap, worldState.streamedChunkKeys, event.chunk))
+			{
+				worldState.retainedChunks.entries.erase(chunkKey(event.chunk.chunkX, event.chunk.chunkZ));
+			}
+			worldState.profileChunkReceivesWindow++;
+			continue;
+		}
+		if (event.type == WorldClientEvent::Type::ChunkDeltaReceived)
+		{
+			const VoxelChunkData &deltaChunk = event.chunkDelta.chunk;
+			int64_t key = chunkKey(deltaChunk.chunkX, deltaChunk.chunkZ);
+			if (worldState.streamedChunkKeys.find(key) == worldState.streamedChunkKeys.end())
+			{
+				continue;
+			}
+			if (!MeshBuildSystem::applyChunkSectionDelta(
+					worldState.chunkMap,
+					worldState.retainedChunks,
+					event.chunkDelta))
+			{
+				// Base perdue de notre côté: on repart d'un snapshot complet.
+				worldState.retainedChunks.entries.erase(key);
+				worldClient.sendChunkDrop(deltaChunk.chunkX, deltaChunk.chunkZ);
+				worldClient.sendChunkRequest(deltaChunk.chunkX, deltaChunk.chunkZ);
+				continue;
+			}
 			worldState.profileChunkReceivesWindow++;
 			continue;
 		}
@@ -133,6 +159,11 @@ void ClientWorldSystem::handleEvents(WorldClient &worldClient,
 				event.blockUpdate.finalColor);
 			continue;
 		}
+		if (event.type == WorldClientEvent::Type::BlockBatchUpdated)
+		{
+			MeshBuildSystem::applyBlockUpdateBatch(worldState.chunkMap, event.blockUpdateBatch);
+			continue;
+		}
 		if (event.type == WorldClientEvent::Type::ChatMessageReceived)
 		{
 			ClientChatMessage message;
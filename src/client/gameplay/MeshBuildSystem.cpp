@@ -2,6 +2,12 @@
 
 #include <unordered_set>
 
+namespace
+{
+	// Quelques Mo de blocs palettisés: couvre les allers-retours autour du spawn.
+	constexpr size_t CLIENT_RETAINED_CHUNK_LIMIT = 1024;
+}
+
 ClientChunk *MeshBuildSystem::getChunkAt(const std::unordered_map<int64_t, ClientChunk *> &chunkMap, int cx, int cz)
 {
 	auto it = chunkMap.find(chunkKey(cx, cz));
@@ -98,6 +104,134 @@ void MeshBuildSystem::applyBlockUpdateLocal(std::unordered_map<int64_t, ClientCh
 	markChunkNeighborhoodDirty(chunkMap, cx, cz);
 }
 
+void MeshBuildSystem::applyBlockUpdateBatch(std::unordered_map<int64_t, ClientChunk *> &chunkMap,
+											const BlockUpdateBatchMessage &batch)
+{
+	for (const BlockUpdateBatchChunk &batchChunk : batch.chunks)
+	{
+		ClientChunk *chunk = getChunkAt(chunkMap, batchChunk.chunkX, batchChunk.chunkZ);
+		if (chunk == nullptr)
+		{
+			continue;
+		}
+
+		if (batchChunk.revision > chunk->serverRevision)
+		{
+			chunk->serverRevision = batchChunk.revision;
+		}
+
+		// Une seule invalidation du voisinage par chunk, même pour une rafale d'éditions.
+		bool changed = false;
+		for (const BlockUpdateBatchEntry &update : batchChunk.updates)
+		{
+			if (chunk->setBlock(update.localX, update.localY, update.localZ, update.finalColor))
+			{
+				changed = true;
+			}
+		}
+		if (changed)
+		{
+			markChunkNeighborhoodDirty(chunkMap, batchChunk.chunkX, batchChunk.chunkZ);
+		}
+	}
+}
+
+void MeshBuildSystem::retainChunkStorage(int64_t key,
+										 const std::unordered_map<int64_t, ClientChunk *> &chunkMap,
+										 ClientRetainedChunkCache &retainedChunks)
+{
+	auto chunkIt = chunkMap.find(key);
+	if (chunkIt == chunkMap.end())
+	{
+		return;
+	}
+
+	// Copie légère: les sections sont partagées en copy-on-write.
+	ClientRetainedChunkCache::Entry &entry = retainedChunks.entries[key];
+	entry.storage = chunkIt->second->storage;
+	entry.storage.revision = chunkIt->second->serverRevision;
+	entry.sequence = retainedChunks.nextSequence;
+	retainedChunks.nextSequence++;
+	retainedChunks.order.emplace_back(key, entry.sequence);
+
+	while (retainedChunks.entries.size() > CLIENT_RETAINED_CHUNK_LIMIT && !retainedChunks.order.empty())
+	{
+		auto [oldKey, oldSequence] = retainedChunks.order.front();
+		retainedChunks.order.pop_front();
+		auto oldIt = retainedChunks.entries.find(oldKey);
+		if (oldIt != retainedChunks.entries.end() && oldIt->second.sequence == oldSequence)
+		{
+			retainedChunks.entries.erase(oldIt);
+		}
+	}
+	// Les paires périmées s'accumulent si on ressort souvent les mêmes chunks.
+	if (retainedChunks.order.size() > CLIENT_RETAINED_CHUNK_LIMIT * 2)
+	{
+		std::deque<std::pair<int64_t, uint64_t>> liveOrder;
+		for (const auto &[orderKey, orderSequence] : retainedChunks.order)
+		{
+			auto liveIt = retainedChunks.entries.find(orderKey);
+			if (liveIt != retainedChunks.entries.end() && liveIt->second.sequence == orderSequence)
+			{
+				liveOrder.emplace_back(orderKey, orderSequence);
+			}
+		}
+		retainedChunks.order.swap(liveOrder);
+	}
+}
+
+bool MeshBuildSystem::applyChunkSectionDelta(std::unordered_map<int64_t, ClientChunk *> &chunkMap,
+											 ClientRetainedChunkCache &retainedChunks,
+											 const ChunkSectionDeltaMessage &delta)
+{
+	const VoxelChunkData &deltaChunk = delta.chunk;
+	int64_t key = chunkKey(deltaChunk.chunkX, deltaChunk.chunkZ);
+
+	VoxelChunkData base;
+	auto chunkIt = chunkMap.find(key);
+	auto retainedIt = retainedChunks.entries.find(key);
+	if (chunkIt != chunkMap.end() && chunkIt->second->serverRevision == delta.baseRevision)
+	{
+		base = chunkIt->second->storage;
+	}
+	else if (retainedIt != retainedChunks.entries.end() &&
+			 retainedIt->second.storage.revision == delta.baseRevision)
+	{
+		base = retainedIt->second.storage;
+	}
+	else
+	{
+		return false;
+	}
+
+	for (int sectionIndex = 0; sectionIndex < CHUNK_SECTION_COUNT; sectionIndex++)
+	{
+		if ((delta.changedSections & VoxelChunkData::sectionBit(sectionIndex)) != 0)
+		{
+			base.copySectionFrom(deltaChunk, sectionIndex);
+		}
+	}
+	base.revision = deltaChunk.revision;
+	if (retainedIt != retainedChunks.entries.end())
+	{
+		retainedChunks.entries.erase(retainedIt);
+	}
+
+	ClientChunk *chunk = nullptr;
+	if (chunkIt == chunkMap.end())
+	{
+		chunk = new ClientChunk(deltaChunk.chunkX, deltaChunk.chunkZ);
+		chunkMap[key] = chunk;
+	}
+	else
+	{
+		chunk = chunkIt->second;
+	}
+	chunk->copyFromData(base);
+	markChunkNeighborhoodDirty(chunkMap, deltaChunk.chunkX, deltaChunk.chunkZ);
+	return true;
+}
+
 bool MeshBuildSystem::upsertChunkSnapshot(std::unordered_map<int64_t, ClientChunk *> &chunkMap,
 										  const std::unordered_set<int64_t> &streamedChunkKeys,
 										  const VoxelChunkData &snapshot)
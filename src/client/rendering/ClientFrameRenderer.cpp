@@ -68,10 +68,12 @@ ClientFrameRenderResult ClientFrameRenderer::renderWorldFrame(
 		config.classicMaxChunkRequestsPerFrame,
 		worldState.streamedChunkKeys,
 		worldState.chunkMap,
+		worldState.retainedChunks,
 		worldState.profileChunkRequestsWindow,
 		worldState.profileChunkDropsWindow,
 		[&](int64_t key)
 		{
+			MeshBuildSystem::retainChunkStorage(key, worldState.chunkMap, worldState.retainedChunks);
 			MeshBuildSystem::removeClientChunkByKey(
 				key,
 				worldState.chunkMap,
@@ -0,0 +1,101 @@
+#include <server/core/AuthWorkerPool.h>
+
+#include <utility>
+
+AuthWorkerPool::~AuthWorkerPool()
+{
+	stop();
+}
+
+void AuthWorkerPool::start(size_t threadCount, size_t queueCapacity)
+{
+	stop();
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopRequested = false;
+		m_queueCapacity = queueCapacity;
+	}
+	if (threadCount == 0)
+	{
+		threadCount = 1;
+	}
+	m_threads.reserve(threadCount);
+	for (size_t threadIndex = 0; threadIndex < threadCount; threadIndex++)
+	{
+		m_threads.emplace_back(&AuthWorkerPool::workerLoop, this);
+	}
+}
+
+void AuthWorkerPool::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopRequested = true;
+		m_jobs.clear();
+	}
+	m_cv.notify_all();
+	for (std::thread &thread : m_threads)
+	{
+		if (thread.joinable())
+		{
+			thread.join();
+		}
+	}
+	m_threads.clear();
+}
+
+bool AuthWorkerPool::trySubmit(Job job)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_stopRequested || m_threads.empty() || m_jobs.size() >= m_queueCapacity)
+		{
+			return false;
+		}
+		m_jobs.push_back(std::move(job));
+	}
+	m_cv.notify_one();
+	return true;
+}
+
+size_t AuthWorkerPool::threadCount() const
+{
+	return m_threads.size();
+}
+
+size_t AuthWorkerPool::queuedCount() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_jobs.size();
+}
+
+size_t AuthWorkerPool::activeCount() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_activeJobs;
+}
+
+void AuthWorkerPool::workerLoop()
+{
+	while (true)
+	{
+		Job job;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_cv.wait(lock, [&]()
+					  { return m_stopRequested || !m_jobs.empty(); });
+			if (m_jobs.empty())
+			{
+				return;
+			}
+			job = std::move(m_jobs.front());
+			m_jobs.pop_front();
+			m_activeJobs++;
+		}
+		job();
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_activeJobs--;
+		}
+	}
+}
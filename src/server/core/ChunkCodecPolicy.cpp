@@ -0,0 +1,78 @@
+#include <server/core/ChunkCodecPolicy.h>
+
+namespace
+{
+	// Boucle locale / LAN: compresser coûte plus que transmettre.
+	constexpr uint32_t LAN_ENTER_RTT_MS = 4;
+	constexpr uint32_t LAN_LEAVE_RTT_MS = 8;
+	constexpr uint32_t FAST_LINK_RTT_MS = 30;
+	constexpr uint32_t SLOW_LINK_ENTER_RTT_MS = 150;
+	constexpr uint32_t SLOW_LINK_LEAVE_RTT_MS = 100;
+	// Lien saturé: plus de X secondes de débit acquitté encore en vol.
+	constexpr double BACKLOG_ENTER_SECONDS = 0.5;
+	constexpr double BACKLOG_LEAVE_SECONDS = 0.2;
+	constexpr uint32_t MIN_BACKLOG_BYTES = 256u * 1024u;
+
+	bool supportsCodec(uint32_t supportedCodecs, ChunkCodec codec)
+	{
+		return (supportedCodecs & chunkCodecBit(codec)) != 0;
+	}
+
+	bool isBandwidthLimited(const ChunkCodecLinkState &link, ChunkCodec currentCodec)
+	{
+		bool dense = currentCodec == ChunkCodec::ZstdDense;
+		uint32_t slowRttMs = dense ? SLOW_LINK_LEAVE_RTT_MS : SLOW_LINK_ENTER_RTT_MS;
+		if (link.roundTripTimeMs >= slowRttMs)
+		{
+			return true;
+		}
+		if (link.reliableDataInTransit < MIN_BACKLOG_BYTES)
+		{
+			return false;
+		}
+		double backlogSeconds = dense ? BACKLOG_LEAVE_SECONDS : BACKLOG_ENTER_SECONDS;
+		return static_cast<double>(link.reliableDataInTransit) > link.ackedBytesPerSecond * backlogSeconds;
+	}
+}
+
+ChunkCodec chooseChunkCodec(const ChunkCodecLinkState &link, uint32_t supportedCodecs, ChunkCodec currentCodec)
+{
+	ChunkCodec wanted = ChunkCodec::Zstd;
+	uint32_t lanRttMs = currentCodec == ChunkCodec::Sections ? LAN_LEAVE_RTT_MS : LAN_ENTER_RTT_MS;
+	if (isBandwidthLimited(link, currentCodec))
+	{
+		wanted = link.cpuConstrained ? ChunkCodec::Zstd : ChunkCodec::ZstdDense;
+	}
+	else if (link.roundTripTimeMs <= lanRttMs)
+	{
+		wanted = ChunkCodec::Sections;
+	}
+	else if (link.roundTripTimeMs <= FAST_LINK_RTT_MS && !link.cpuConstrained)
+	{
+		wanted = ChunkCodec::ZstdFast;
+	}
+
+	if (supportsCodec(supportedCodecs, wanted))
+	{
+		return wanted;
+	}
+	if (supportsCodec(supportedCodecs, ChunkCodec::Zstd))
+	{
+		return ChunkCodec::Zstd;
+	}
+	return ChunkCodec::Sections;
+}
+
+bool parseChunkCodecName(std::string_view name, ChunkCodec &codec)
+{
+	for (size_t index = 0; index < CHUNK_CODEC_COUNT; index++)
+	{
+		ChunkCodec candidate = static_cast<ChunkCodec>(index);
+		if (name == chunkCodecName(candidate))
+		{
+			codec = candidate;
+			return true;
+		}
+	}
+	return false;
+}
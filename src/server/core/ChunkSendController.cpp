@@ -0,0 +1,113 @@
+#include <server/core/ChunkSendController.h>
+
+#include <algorithm>
+
+namespace
+{
+	constexpr size_t MIN_WINDOW_BYTES = 64 * 1024;
+	constexpr size_t MAX_WINDOW_BYTES = 16 * 1024 * 1024;
+	constexpr size_t ADDITIVE_INCREASE_BYTES = 64 * 1024;
+	constexpr double MULTIPLICATIVE_DECREASE = 0.7;
+	// File d'attente tolérée au-dessus du RTT min avant de parler de congestion.
+	constexpr uint32_t MIN_QUEUE_DELAY_MS = 20;
+	constexpr float LOSS_RATE_CONGESTED = 0.02f;
+	constexpr float THROTTLE_CONGESTED = 0.5f;
+	// Un peu plus que fenêtre / RTT: la fenêtre reste le vrai plafond.
+	constexpr double PACING_GAIN = 1.25;
+}
+
+void ChunkSendController::onLinkSample(const ChunkSendLinkSample &sample)
+{
+	m_roundTripTimeMs = std::max<uint32_t>(sample.roundTripTimeMs, 1);
+	m_rttSamples[m_sampleCount % MIN_RTT_SAMPLES] = m_roundTripTimeMs;
+	if (sample.elapsedSeconds > 0.0)
+	{
+		m_deliveryRateSamples[m_sampleCount % DELIVERY_RATE_SAMPLES] =
+			static_cast<double>(sample.ackedBytes) / sample.elapsedSeconds;
+	}
+	m_sampleCount++;
+	m_secondsSinceDecrease += sample.elapsedSeconds;
+
+	if (isCongested(sample))
+	{
+		// Une seule baisse par RTT: les signaux d'une même rafale arrivent en plusieurs échantillons.
+		if (m_secondsSinceDecrease * 1000.0 < static_cast<double>(m_roundTripTimeMs))
+		{
+			return;
+		}
+		double bdpBytes = deliveryRateBytesPerSecond() * static_cast<double>(minRoundTripTimeMs()) / 1000.0;
+		size_t decreased = static_cast<size_t>(static_cast<double>(m_windowBytes) * MULTIPLICATIVE_DECREASE);
+		m_windowBytes = std::max(decreased, static_cast<size_t>(bdpBytes));
+		m_windowBytes = std::clamp(m_windowBytes, MIN_WINDOW_BYTES, MAX_WINDOW_BYTES);
+		m_slowStart = false;
+		m_secondsSinceDecrease = 0.0;
+		m_decreaseCount++;
+		return;
+	}
+
+	// Fenêtre pas utilisée (peu de chunks à envoyer): l'agrandir ne prouverait rien.
+	if (sample.peakInFlightBytes * 2 < m_windowBytes)
+	{
+		return;
+	}
+	m_windowBytes += m_slowStart ? m_windowBytes : ADDITIVE_INCREASE_BYTES;
+	m_windowBytes = std::clamp(m_windowBytes, MIN_WINDOW_BYTES, MAX_WINDOW_BYTES);
+}
+
+bool ChunkSendController::isCongested(const ChunkSendLinkSample &sample) const
+{
+	if (sample.lossRate > LOSS_RATE_CONGESTED || sample.throttle < THROTTLE_CONGESTED)
+	{
+		return true;
+	}
+	uint32_t minRttMs = minRoundTripTimeMs();
+	uint32_t queueDelayMs = std::max(minRttMs / 2, MIN_QUEUE_DELAY_MS);
+	return m_roundTripTimeMs > minRttMs + queueDelayMs;
+}
+
+size_t ChunkSendController::windowBytes() const
+{
+	return m_windowBytes;
+}
+
+size_t ChunkSendController::tickByteBudget(uint32_t streamTickMs) const
+{
+	uint32_t roundTripTimeMs = std::max(m_roundTripTimeMs, streamTickMs);
+	if (roundTripTimeMs == 0)
+	{
+		return m_windowBytes;
+	}
+	double budget = static_cast<double>(m_windowBytes) * PACING_GAIN *
+		static_cast<double>(streamTickMs) / static_cast<double>(roundTripTimeMs);
+	return std::max<size_t>(static_cast<size_t>(budget), 1);
+}
+
+uint32_t ChunkSendController::minRoundTripTimeMs() const
+{
+	size_t count = std::min(m_sampleCount, MIN_RTT_SAMPLES);
+	if (count == 0)
+	{
+		return m_roundTripTimeMs;
+	}
+	return *std::min_element(m_rttSamples.begin(), m_rttSamples.begin() + count);
+}
+
+double ChunkSendController::deliveryRateBytesPerSecond() const
+{
+	size_t count = std::min(m_sampleCount, DELIVERY_RATE_SAMPLES);
+	if (count == 0)
+	{
+		return 0.0;
+	}
+	return *std::max_element(m_deliveryRateSamples.begin(), m_deliveryRateSamples.begin() + count);
+}
+
+bool ChunkSendController::inSlowStart() const
+{
+	return m_slowStart;
+}
+
+uint64_t ChunkSendController::decreaseCount() const
+{
+	return m_decreaseCount;
+}
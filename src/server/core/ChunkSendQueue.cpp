@@ -0,0 +1,100 @@
+#include <server/core/ChunkSendQueue.h>
+
+#include <VoxelChunkData.h>
+
+#include <algorithm>
+
+void ChunkSendQueue::push(int64_t key)
+{
+	Entry entry;
+	entry.priority = priorityFor(key);
+	entry.sequence = m_nextSequence++;
+	entry.key = key;
+	m_heap.push_back(entry);
+	std::push_heap(m_heap.begin(), m_heap.end(), EntryLater{});
+}
+
+bool ChunkSendQueue::empty() const
+{
+	return m_heap.empty();
+}
+
+size_t ChunkSendQueue::size() const
+{
+	return m_heap.size();
+}
+
+int64_t ChunkSendQueue::top()
+{
+	rekeyIfStale();
+	return m_heap.front().key;
+}
+
+void ChunkSendQueue::pop()
+{
+	rekeyIfStale();
+	std::pop_heap(m_heap.begin(), m_heap.end(), EntryLater{});
+	m_heap.pop_back();
+}
+
+void ChunkSendQueue::clear()
+{
+	m_heap.clear();
+}
+
+void ChunkSendQueue::retainOnly(const std::unordered_set<int64_t> &keys)
+{
+	auto removed = std::remove_if(m_heap.begin(), m_heap.end(), [&](const Entry &entry)
+								  { return keys.find(entry.key) == keys.end(); });
+	if (removed == m_heap.end())
+	{
+		return;
+	}
+	m_heap.erase(removed, m_heap.end());
+	std::make_heap(m_heap.begin(), m_heap.end(), EntryLater{});
+}
+
+void ChunkSendQueue::updateView(float x, float z, float lookX, float lookZ)
+{
+	m_view = makeChunkView(x, z, lookX, lookZ);
+	if (chunkViewChanged(m_keyed, m_view))
+	{
+		m_stale = true;
+	}
+	if (m_heap.empty())
+	{
+		// Rien à recalculer: les prochains push prennent directement la nouvelle vue.
+		rekeyIfStale();
+	}
+}
+
+uint64_t ChunkSendQueue::rekeyCount() const
+{
+	return m_rekeyCount;
+}
+
+float ChunkSendQueue::priorityFor(int64_t key) const
+{
+	ChunkCoord coord = chunkCoordFromKey(key);
+	return chunkViewPriority(m_keyed, coord.x, coord.z);
+}
+
+void ChunkSendQueue::rekeyIfStale()
+{
+	if (!m_stale)
+	{
+		return;
+	}
+	m_stale = false;
+	m_keyed = m_view;
+	if (m_heap.empty())
+	{
+		return;
+	}
+	for (Entry &entry : m_heap)
+	{
+		entry.priority = priorityFor(entry.key);
+	}
+	std::make_heap(m_heap.begin(), m_heap.end(), EntryLater{});
+	m_rekeyCount++;
+}
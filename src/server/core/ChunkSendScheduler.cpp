@@ -0,0 +1,153 @@
+#include <server/core/ChunkSendScheduler.h>
+
+#include <algorithm>
+
+void ChunkSendScheduler::setHostBytesPerSecond(uint64_t bytesPerSecond)
+{
+	m_hostBytesPerSecond = bytesPerSecond;
+	m_hostTokens = 0;
+	m_refilled = false;
+}
+
+uint64_t ChunkSendScheduler::hostBytesPerSecond() const
+{
+	return m_hostBytesPerSecond;
+}
+
+uint64_t ChunkSendScheduler::hostLimitedTicks() const
+{
+	return m_hostLimitedTicks;
+}
+
+void ChunkSendScheduler::refill(std::chrono::steady_clock::time_point now)
+{
+	if (m_hostBytesPerSecond == 0)
+	{
+		return;
+	}
+	int64_t burstBytes = static_cast<int64_t>(m_hostBytesPerSecond * HOST_BURST_MS / 1000);
+	if (!m_refilled)
+	{
+		m_refilled = true;
+		m_lastRefill = now;
+		m_hostTokens = burstBytes;
+		return;
+	}
+
+	double elapsedSeconds = std::chrono::duration<double>(now - m_lastRefill).count();
+	m_lastRefill = now;
+	m_hostTokens += static_cast<int64_t>(elapsedSeconds * static_cast<double>(m_hostBytesPerSecond));
+	m_hostTokens = std::min(m_hostTokens, burstBytes);
+}
+
+bool ChunkSendScheduler::hostBudgetAvailable() const
+{
+	return m_hostBytesPerSecond == 0 || m_hostTokens > 0;
+}
+
+size_t ChunkSendScheduler::schedule(std::chrono::steady_clock::time_point now,
+									std::vector<ChunkSendCandidate> &candidates,
+									const std::function<size_t(size_t)> &sendNext)
+{
+	refill(now);
+	if (candidates.empty() || !hostBudgetAvailable())
+	{
+		if (!candidates.empty())
+		{
+			m_hostLimitedTicks++;
+		}
+		return 0;
+	}
+
+	// Reprise au premier slot >= m_nextId: celui qui a été coupé au tick précédent passe en tête.
+	size_t start = 0;
+	while (start < candidates.size() && candidates[start].id < m_nextId)
+	{
+		start++;
+	}
+	if (start == candidates.size())
+	{
+		start = 0;
+	}
+
+	std::vector<size_t> active;
+	active.reserve(candidates.size());
+	for (size_t offset = 0; offset < candidates.size(); offset++)
+	{
+		active.push_back((start + offset) % candidates.size());
+	}
+
+	bool resumeWithCredit = m_resumeWithCredit && candidates[start].id == m_nextId;
+	m_resumeWithCredit = false;
+
+	size_t totalBytes = 0;
+	while (!active.empty())
+	{
+		size_t kept = 0;
+		for (size_t position = 0; position < active.size(); position++)
+		{
+			size_t index = active[position];
+			ChunkSendCandidate &candidate = candidates[index];
+			ChunkSendFlow &flow = *candidate.flow;
+			if (!hostBudgetAvailable())
+			{
+				// Crédits conservés: le prochain tick reprend sur cette session.
+				m_nextId = candidate.id;
+				m_hostLimitedTicks++;
+				return totalBytes;
+			}
+
+			if (resumeWithCredit)
+			{
+				// Son quantum du tour interrompu n'a pas été consommé.
+				resumeWithCredit = false;
+			}
+			else
+			{
+				flow.deficitBytes += static_cast<int64_t>(QUANTUM_BYTES * std::max<uint32_t>(candidate.weight, 1));
+			}
+			bool drained = false;
+			while (flow.deficitBytes > 0 && hostBudgetAvailable())
+			{
+				size_t bytes = sendNext(index);
+				if (bytes == 0)
+				{
+					drained = true;
+					break;
+				}
+				flow.deficitBytes -= static_cast<int64_t>(bytes);
+				flow.servedBytes += bytes;
+				flow.servedBytesWindow += bytes;
+				if (candidate.weight > 1)
+				{
+					flow.boostedBytesWindow += bytes;
+				}
+				if (m_hostBytesPerSecond > 0)
+				{
+					m_hostTokens -= static_cast<int64_t>(bytes);
+				}
+				totalBytes += bytes;
+			}
+
+			if (!drained && flow.deficitBytes > 0)
+			{
+				m_nextId = candidate.id;
+				m_resumeWithCredit = true;
+				m_hostLimitedTicks++;
+				return totalBytes;
+			}
+			if (drained)
+			{
+				// DRR: une session qui n'a plus rien à émettre ne thésaurise pas de crédit.
+				flow.deficitBytes = std::min<int64_t>(flow.deficitBytes, 0);
+				continue;
+			}
+			active[kept++] = index;
+		}
+		active.resize(kept);
+	}
+
+	// Tout le monde a été servi: on fait tourner la tête du tour.
+	m_nextId = candidates[start].id + 1;
+	return totalBytes;
+}
@@ -0,0 +1,67 @@
+#include <server/core/ChunkViewPriority.h>
+
+#include <VoxelChunkData.h>
+
+#include <cmath>
+
+namespace
+{
+	// Les chunks à moins de 2 chunks ne sont pas pondérés: le joueur peut s'y retourner à tout moment.
+	constexpr float NEAR_DISTANCE_BLOCKS = 2.0f * CHUNK_SIZE_X;
+	// Un chunk juste derrière le joueur compte comme s'il était deux fois plus loin.
+	constexpr float BEHIND_VIEW_WEIGHT = 2.0f;
+	constexpr float REKEY_DISTANCE_BLOCKS = static_cast<float>(CHUNK_SIZE_X);
+	// cos(30°): au-delà de ce virage, l'ordre devant/derrière a trop changé.
+	constexpr float REKEY_MIN_LOOK_ALIGNMENT = 0.866f;
+}
+
+ChunkView makeChunkView(float x, float z, float lookX, float lookZ)
+{
+	ChunkView view;
+	view.x = x;
+	view.z = z;
+	float length = std::sqrt(lookX * lookX + lookZ * lookZ);
+	if (length <= 0.001f)
+	{
+		// Regard vertical: aucune direction privilégiée, seule la distance compte.
+		view.lookX = 0.0f;
+		view.lookZ = 0.0f;
+		return view;
+	}
+	view.lookX = lookX / length;
+	view.lookZ = lookZ / length;
+	return view;
+}
+
+float chunkViewPriority(const ChunkView &view, int chunkX, int chunkZ)
+{
+	float toChunkX = static_cast<float>(chunkX * CHUNK_SIZE_X) + CHUNK_SIZE_X * 0.5f - view.x;
+	float toChunkZ = static_cast<float>(chunkZ * CHUNK_SIZE_Z) + CHUNK_SIZE_Z * 0.5f - view.z;
+	float distance = std::sqrt(toChunkX * toChunkX + toChunkZ * toChunkZ);
+	if (distance <= NEAR_DISTANCE_BLOCKS || (view.lookX == 0.0f && view.lookZ == 0.0f))
+	{
+		return distance;
+	}
+
+	// 1 dans l'axe du regard, BEHIND_VIEW_WEIGHT dans le dos.
+	float alignment = (toChunkX * view.lookX + toChunkZ * view.lookZ) / distance;
+	return distance * (1.0f + (BEHIND_VIEW_WEIGHT - 1.0f) * 0.5f * (1.0f - alignment));
+}
+
+bool chunkViewChanged(const ChunkView &keyed, const ChunkView &current)
+{
+	float movedX = current.x - keyed.x;
+	float movedZ = current.z - keyed.z;
+	if (movedX * movedX + movedZ * movedZ > REKEY_DISTANCE_BLOCKS * REKEY_DISTANCE_BLOCKS)
+	{
+		return true;
+	}
+	bool keyedHasLook = keyed.lookX != 0.0f || keyed.lookZ != 0.0f;
+	bool currentHasLook = current.lookX != 0.0f || current.lookZ != 0.0f;
+	if (!keyedHasLook && !currentHasLook)
+	{
+		return false;
+	}
+	float lookAlignment = current.lookX * keyed.lookX + current.lookZ * keyed.lookZ;
+	return lookAlignment < REKEY_MIN_LOOK_ALIGNMENT;
+}
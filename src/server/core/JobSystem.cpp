@@ -0,0 +1,192 @@
+#include <server/core/JobSystem.h>
+
+#include <utility>
+
+namespace
+{
+	thread_local JobSystem *currentJobSystem = nullptr;
+	thread_local size_t currentWorkerIndex = 0;
+}
+
+JobSystem::~JobSystem()
+{
+	stop();
+}
+
+void JobSystem::start(size_t threadCount)
+{
+	stop();
+	m_queues.clear();
+	for (size_t i = 0; i < threadCount; i++)
+	{
+		m_queues.push_back(std::make_unique<WorkerQueue>());
+	}
+	for (size_t i = 0; i < threadCount; i++)
+	{
+		m_threads.emplace_back(&JobSystem::workerLoop, this, i);
+	}
+}
+
+void JobSystem::stop()
+{
+	if (m_threads.empty())
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		m_stopRequested = true;
+	}
+	m_sleepCv.notify_all();
+	for (std::thread &thread : m_threads)
+	{
+		if (thread.joinable())
+		{
+			thread.join();
+		}
+	}
+	m_threads.clear();
+	m_queues.clear();
+	m_stopRequested = false;
+}
+
+void JobSystem::submit(JobPriority priority, Job job)
+{
+	if (m_threads.empty())
+	{
+		job();
+		return;
+	}
+
+	size_t queueIndex = 0;
+	if (currentJobSystem == this)
+	{
+		// Un job qui en crée un autre le garde chez lui: les voisins le voleront s'ils chôment.
+		queueIndex = currentWorkerIndex;
+	}
+	else
+	{
+		queueIndex = m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+	}
+
+	size_t priorityIndex = static_cast<size_t>(priority);
+	m_pendingByPriority[priorityIndex].fetch_add(1);
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		m_pendingJobs.fetch_add(1);
+	}
+	{
+		WorkerQueue &queue = *m_queues[queueIndex];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.jobs[priorityIndex].push_back(std::move(job));
+	}
+	m_sleepCv.notify_one();
+}
+
+void JobSystem::waitIdle()
+{
+	if (m_threads.empty())
+	{
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(m_sleepMutex);
+	m_idleCv.wait(lock, [&]()
+				  { return m_pendingJobs.load() == 0 && m_activeJobs.load() == 0; });
+}
+
+size_t JobSystem::threadCount() const
+{
+	return m_threads.size();
+}
+
+size_t JobSystem::pendingCount(JobPriority priority) const
+{
+	return m_pendingByPriority[static_cast<size_t>(priority)].load(std::memory_order_relaxed);
+}
+
+uint64_t JobSystem::takeStealCount()
+{
+	return m_stealCount.exchange(0, std::memory_order_relaxed);
+}
+
+void JobSystem::workerLoop(size_t workerIndex)
+{
+	currentJobSystem = this;
+	currentWorkerIndex = workerIndex;
+
+	while (true)
+	{
+		Job job;
+		if (tryTakeJob(workerIndex, job))
+		{
+			job();
+			job = nullptr;
+			finishJob();
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_sleepMutex);
+		m_sleepCv.wait(lock, [&]()
+					   { return m_stopRequested || m_pendingJobs.load() > 0; });
+		if (m_stopRequested && m_pendingJobs.load() == 0)
+		{
+			break;
+		}
+	}
+
+	currentJobSystem = nullptr;
+}
+
+bool JobSystem::tryTakeJob(size_t workerIndex, Job &outJob)
+{
+	size_t queueCount = m_queues.size();
+	for (size_t priorityIndex = 0; priorityIndex < JOB_PRIORITY_COUNT; priorityIndex++)
+	{
+		if (m_pendingByPriority[priorityIndex].load(std::memory_order_relaxed) == 0)
+		{
+			continue;
+		}
+
+		for (size_t offset = 0; offset < queueCount; offset++)
+		{
+			size_t victimIndex = (workerIndex + offset) % queueCount;
+			WorkerQueue &queue = *m_queues[victimIndex];
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			std::deque<Job> &jobs = queue.jobs[priorityIndex];
+			if (jobs.empty())
+			{
+				continue;
+			}
+
+			// Propriétaire en LIFO (cache chaud), voleur en FIFO (le plus ancien).
+			if (offset == 0)
+			{
+				outJob = std::move(jobs.back());
+				jobs.pop_back();
+			}
+			else
+			{
+				outJob = std::move(jobs.front());
+				jobs.pop_front();
+				m_stealCount.fetch_add(1, std::memory_order_relaxed);
+			}
+			m_activeJobs.fetch_add(1);
+			m_pendingByPriority[priorityIndex].fetch_sub(1);
+			m_pendingJobs.fetch_sub(1);
+			return true;
+		}
+	}
+	return false;
+}
+
+void JobSystem::finishJob()
+{
+	m_activeJobs.fetch_sub(1);
+	if (m_activeJobs.load() == 0 && m_pendingJobs.load() == 0)
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		m_idleCv.notify_all();
+	}
+}
@@ -0,0 +1,215 @@
+#include <server/core/MetricsExporter.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string_view>
+
+namespace
+{
+	// Délai max entre deux regards sur m_stopRequested.
+	constexpr uint32_t EXPORTER_POLL_MS = 200;
+	// Un scrape lent ou bloqué ne doit pas retenir le thread (ni la ligne JSON suivante).
+	constexpr int SCRAPE_SOCKET_TIMEOUT_MS = 1000;
+	constexpr size_t MAX_SCRAPE_REQUEST_BYTES = 8192;
+
+	uint64_t systemNowMs()
+	{
+		auto now = std::chrono::system_clock::now().time_since_epoch();
+		return static_cast<uint64_t>(
+			std::chrono::duration_cast<std::chrono::milliseconds>(now).count());
+	}
+
+	void sendAll(ENetSocket connection, const std::string &data)
+	{
+		size_t offset = 0;
+		while (offset < data.size())
+		{
+			ENetBuffer buffer;
+			buffer.data = const_cast<char *>(data.data() + offset);
+			buffer.dataLength = data.size() - offset;
+			int sent = enet_socket_send(connection, nullptr, &buffer, 1);
+			if (sent <= 0)
+			{
+				return;
+			}
+			offset += static_cast<size_t>(sent);
+		}
+	}
+}
+
+MetricsExporter::~MetricsExporter()
+{
+	stop();
+}
+
+bool MetricsExporter::start(MetricsRegistry &registry, uint16_t port, const std::string &jsonlPath, uint32_t jsonlIntervalMs)
+{
+	stop();
+	m_lastError.clear();
+	m_registry = &registry;
+	m_jsonlIntervalMs = jsonlIntervalMs;
+
+	if (port != 0)
+	{
+		m_listenSocket = enet_socket_create(ENET_SOCKET_TYPE_STREAM);
+		if (m_listenSocket == ENET_SOCKET_NULL)
+		{
+			m_lastError = "Failed to create metrics socket";
+			return false;
+		}
+		ENetAddress address{};
+		address.port = port;
+		enet_address_set_host_ip(&address, "127.0.0.1");
+		enet_socket_set_option(m_listenSocket, ENET_SOCKOPT_REUSEADDR, 1);
+		if (enet_socket_bind(m_listenSocket, &address) < 0 || enet_socket_listen(m_listenSocket, 8) < 0)
+		{
+			m_lastError = "Failed to listen on 127.0.0.1:" + std::to_string(port);
+			enet_socket_destroy(m_listenSocket);
+			m_listenSocket = ENET_SOCKET_NULL;
+			return false;
+		}
+	}
+	if (!jsonlPath.empty())
+	{
+		m_jsonlFile.open(jsonlPath, std::ios::out | std::ios::app);
+		if (!m_jsonlFile.is_open())
+		{
+			m_lastError = "Failed to open metrics file " + jsonlPath;
+			stop();
+			return false;
+		}
+	}
+	if (m_listenSocket == ENET_SOCKET_NULL && !m_jsonlFile.is_open())
+	{
+		return true;
+	}
+
+	m_stopRequested = false;
+	m_thread = std::thread(&MetricsExporter::exporterLoop, this);
+	return true;
+}
+
+void MetricsExporter::stop()
+{
+	if (m_thread.joinable())
+	{
+		m_stopRequested = true;
+		m_thread.join();
+	}
+	if (m_listenSocket != ENET_SOCKET_NULL)
+	{
+		enet_socket_destroy(m_listenSocket);
+		m_listenSocket = ENET_SOCKET_NULL;
+	}
+	if (m_jsonlFile.is_open())
+	{
+		m_jsonlFile.close();
+	}
+}
+
+const std::string &MetricsExporter::lastError() const
+{
+	return m_lastError;
+}
+
+void MetricsExporter::exporterLoop()
+{
+	using clock = std::chrono::steady_clock;
+	clock::time_point nextJsonAt = clock::now() + std::chrono::milliseconds(m_jsonlIntervalMs);
+	while (!m_stopRequested)
+	{
+		uint32_t waitMs = EXPORTER_POLL_MS;
+		if (m_jsonlFile.is_open())
+		{
+			auto untilJson = std::chrono::duration_cast<std::chrono::milliseconds>(nextJsonAt - clock::now()).count();
+			waitMs = static_cast<uint32_t>(std::clamp<int64_t>(untilJson, 0, EXPORTER_POLL_MS));
+		}
+
+		if (m_listenSocket != ENET_SOCKET_NULL)
+		{
+			enet_uint32 condition = ENET_SOCKET_WAIT_RECEIVE;
+			if (enet_socket_wait(m_listenSocket, &condition, waitMs) == 0 &&
+				(condition & ENET_SOCKET_WAIT_RECEIVE) != 0)
+			{
+				ENetSocket connection = enet_socket_accept(m_listenSocket, nullptr);
+				if (connection != ENET_SOCKET_NULL)
+				{
+					serveConnection(connection);
+				}
+			}
+		}
+		else
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(waitMs));
+		}
+
+		if (m_jsonlFile.is_open() && clock::now() >= nextJsonAt)
+		{
+			writeJsonLine();
+			nextJsonAt = clock::now() + std::chrono::milliseconds(m_jsonlIntervalMs);
+		}
+	}
+	if (m_jsonlFile.is_open())
+	{
+		writeJsonLine();
+	}
+}
+
+void MetricsExporter::serveConnection(ENetSocket connection)
+{
+	enet_socket_set_option(connection, ENET_SOCKOPT_RCVTIMEO, SCRAPE_SOCKET_TIMEOUT_MS);
+	enet_socket_set_option(connection, ENET_SOCKOPT_SNDTIMEO, SCRAPE_SOCKET_TIMEOUT_MS);
+
+	std::string request;
+	char receiveBuffer[1024];
+	while (request.find("\r\n\r\n") == std::string::npos && request.size() < MAX_SCRAPE_REQUEST_BYTES)
+	{
+		ENetBuffer buffer;
+		buffer.data = receiveBuffer;
+		buffer.dataLength = sizeof(receiveBuffer);
+		int received = enet_socket_receive(connection, nullptr, &buffer, 1);
+		if (received <= 0)
+		{
+			break;
+		}
+		request.append(receiveBuffer, static_cast<size_t>(received));
+	}
+
+	std::string_view requestLine(request);
+	requestLine = requestLine.substr(0, requestLine.find("\r\n"));
+	std::string status = "404 Not Found";
+	std::string contentType = "text/plain; charset=utf-8";
+	std::string body = "Not found\n";
+	if (requestLine.starts_with("GET /metrics ") || requestLine.starts_with("GET / "))
+	{
+		status = "200 OK";
+		contentType = "text/plain; version=0.0.4; charset=utf-8";
+		body = m_registry->renderPrometheus();
+	}
+	else if (!requestLine.starts_with("GET "))
+	{
+		status = "405 Method Not Allowed";
+		body = "Only GET is supported\n";
+	}
+
+	std::string response = "HTTP/1.1 " + status + "\r\n"
+		"Content-Type: " + contentType + "\r\n"
+		"Content-Length: " + std::to_string(body.size()) + "\r\n"
+		"Connection: close\r\n\r\n";
+	sendAll(connection, response);
+	sendAll(connection, body);
+	enet_socket_shutdown(connection, ENET_SOCKET_SHUTDOWN_READ_WRITE);
+	enet_socket_destroy(connection);
+}
+
+void MetricsExporter::writeJsonLine()
+{
+	m_jsonlFile << m_registry->renderJsonLine(systemNowMs()) << '\n';
+	m_jsonlFile.flush();
+	if (!m_jsonlFile)
+	{
+		std::cerr << "Failed to append server metrics line" << std::endl;
+		m_jsonlFile.clear();
+	}
+}
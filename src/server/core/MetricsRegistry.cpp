@@ -0,0 +1,314 @@
+#include <server/core/MetricsRegistry.h>
+
+#include <algorithm>
+#include <bit>
+#include <sstream>
+#include <unordered_set>
+
+namespace
+{
+	// Bornes « le » exportées vers Prometheus: un sous-seau sur quatre (4 par puissance de deux).
+	constexpr size_t PROMETHEUS_BUCKET_STRIDE = 4;
+	constexpr double JSON_QUANTILES[] = {0.5, 0.9, 0.99, 0.999};
+	constexpr const char *JSON_QUANTILE_NAMES[] = {"p50", "p90", "p99", "p999"};
+
+	void appendSeriesName(std::ostringstream &out, const std::string &name, const std::string &suffix,
+						  const std::string &labels, const std::string &extraLabel)
+	{
+		out << name << suffix;
+		if (labels.empty() && extraLabel.empty())
+		{
+			return;
+		}
+		out << '{' << labels;
+		if (!labels.empty() && !extraLabel.empty())
+		{
+			out << ',';
+		}
+		out << extraLabel << '}';
+	}
+
+	void appendJsonString(std::ostringstream &out, const std::string &name, const std::string &labels)
+	{
+		out << '"' << name;
+		if (!labels.empty())
+		{
+			out << '{';
+			for (char character : labels)
+			{
+				if (character == '"' || character == '\\')
+				{
+					out << '\\';
+				}
+				out << character;
+			}
+			out << '}';
+		}
+		out << '"';
+	}
+}
+
+void MetricsHistogram::record(uint64_t value)
+{
+	m_buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+	m_count.fetch_add(1, std::memory_order_relaxed);
+	m_sum.fetch_add(value, std::memory_order_relaxed);
+}
+
+size_t MetricsHistogram::bucketIndex(uint64_t value)
+{
+	if (value < SUB_BUCKET_COUNT)
+	{
+		return static_cast<size_t>(value);
+	}
+	uint32_t exponent = static_cast<uint32_t>(std::bit_width(value)) - 1;
+	uint32_t shift = exponent - SUB_BUCKET_BITS;
+	size_t subBucket = static_cast<size_t>(value >> shift) - SUB_BUCKET_COUNT;
+	return SUB_BUCKET_COUNT + static_cast<size_t>(shift) * SUB_BUCKET_COUNT + subBucket;
+}
+
+uint64_t MetricsHistogram::bucketLowerBound(size_t index)
+{
+	if (index < SUB_BUCKET_COUNT)
+	{
+		return index;
+	}
+	size_t shift = (index - SUB_BUCKET_COUNT) / SUB_BUCKET_COUNT;
+	size_t subBucket = (index - SUB_BUCKET_COUNT) % SUB_BUCKET_COUNT;
+	return static_cast<uint64_t>(SUB_BUCKET_COUNT + subBucket) << shift;
+}
+
+uint64_t MetricsHistogram::bucketUpperBound(size_t index)
+{
+	if (index < SUB_BUCKET_COUNT)
+	{
+		return index;
+	}
+	size_t shift = (index - SUB_BUCKET_COUNT) / SUB_BUCKET_COUNT;
+	return bucketLowerBound(index) + ((uint64_t{1} << shift) - 1);
+}
+
+MetricsCounter &MetricsRegistry::counter(std::string_view name, std::string_view help, std::string_view labels)
+{
+	return *findOrCreate(Kind::Counter, name, help, labels).counter;
+}
+
+MetricsGauge &MetricsRegistry::gauge(std::string_view name, std::string_view help, std::string_view labels)
+{
+	return *findOrCreate(Kind::Gauge, name, help, labels).gauge;
+}
+
+MetricsHistogram &MetricsRegistry::histogram(std::string_view name, std::string_view help, std::string_view labels)
+{
+	return *findOrCreate(Kind::Histogram, name, help, labels).histogram;
+}
+
+MetricsRegistry::Entry &MetricsRegistry::findOrCreate(Kind kind, std::string_view name, std::string_view help, std::string_view labels)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (const std::unique_ptr<Entry> &entry : m_entries)
+	{
+		if (entry->kind == kind && entry->name == name && entry->labels == labels)
+		{
+			return *entry;
+		}
+	}
+
+	std::unique_ptr<Entry> entry = std::make_unique<Entry>();
+	entry->kind = kind;
+	entry->name = name;
+	entry->help = help;
+	entry->labels = labels;
+	switch (kind)
+	{
+	case Kind::Counter:
+		entry->counter = std::make_unique<MetricsCounter>();
+		break;
+	case Kind::Gauge:
+		entry->gauge = std::make_unique<MetricsGauge>();
+		break;
+	case Kind::Histogram:
+		entry->histogram = std::make_unique<MetricsHistogram>();
+		entry->lastBuckets.assign(MetricsHistogram::BUCKET_COUNT, 0);
+		break;
+	}
+	m_entries.push_back(std::move(entry));
+	return *m_entries.back();
+}
+
+std::string MetricsRegistry::renderPrometheus() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	std::ostringstream out;
+	// Une famille (HELP/TYPE) par nom, toutes ses étiquettes à la suite.
+	std::unordered_set<std::string> renderedNames;
+	for (const std::unique_ptr<Entry> &family : m_entries)
+	{
+		if (!renderedNames.insert(family->name).second)
+		{
+			continue;
+		}
+		out << "# HELP " << family->name << ' ' << family->help << '\n';
+		const char *typeName = "histogram";
+		if (family->kind == Kind::Counter)
+		{
+			typeName = "counter";
+		}
+		else if (family->kind == Kind::Gauge)
+		{
+			typeName = "gauge";
+		}
+		out << "# TYPE " << family->name << ' ' << typeName << '\n';
+
+		for (const std::unique_ptr<Entry> &entry : m_entries)
+		{
+			if (entry->name != family->name || entry->kind != family->kind)
+			{
+				continue;
+			}
+			if (entry->kind == Kind::Counter)
+			{
+				appendSeriesName(out, entry->name, "", entry->labels, "");
+				out << ' ' << entry->counter->value() << '\n';
+				continue;
+			}
+			if (entry->kind == Kind::Gauge)
+			{
+				appendSeriesName(out, entry->name, "", entry->labels, "");
+				out << ' ' << entry->gauge->value() << '\n';
+				continue;
+			}
+
+			const MetricsHistogram &histogram = *entry->histogram;
+			size_t lastUsedBucket = 0;
+			for (size_t index = 0; index < MetricsHistogram::BUCKET_COUNT; index++)
+			{
+				if (histogram.bucketCount(index) != 0)
+				{
+					lastUsedBucket = index;
+				}
+			}
+			// _count = somme des seaux lus, pour rester cohérent avec +Inf malgré les écritures concurrentes.
+			uint64_t cumulative = 0;
+			for (size_t index = 0; index < MetricsHistogram::BUCKET_COUNT; index++)
+			{
+				cumulative += histogram.bucketCount(index);
+				if (index % PROMETHEUS_BUCKET_STRIDE != PROMETHEUS_BUCKET_STRIDE - 1)
+				{
+					continue;
+				}
+				appendSeriesName(out, entry->name, "_bucket", entry->labels,
+								 "le=\"" + std::to_string(MetricsHistogram::bucketUpperBound(index)) + "\"");
+				out << ' ' << cumulative << '\n';
+				if (index >= lastUsedBucket)
+				{
+					break;
+				}
+			}
+			for (size_t index = lastUsedBucket + 1; index < MetricsHistogram::BUCKET_COUNT; index++)
+			{
+				cumulative += histogram.bucketCount(index);
+			}
+			appendSeriesName(out, entry->name, "_bucket", entry->labels, "le=\"+Inf\"");
+			out << ' ' << cumulative << '\n';
+			appendSeriesName(out, entry->name, "_sum", entry->labels, "");
+			out << ' ' << histogram.sum() << '\n';
+			appendSeriesName(out, entry->name, "_count", entry->labels, "");
+			out << ' ' << cumulative << '\n';
+		}
+	}
+	return out.str();
+}
+
+std::string MetricsRegistry::renderJsonLine(uint64_t timestampMs)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	uint64_t intervalMs = static_cast<uint64_t>(
+		std::chrono::duration_cast<std::chrono::milliseconds>(now - m_lastJsonAt).count());
+	m_lastJsonAt = now;
+
+	std::ostringstream out;
+	out << "{\"ts_ms\":" << timestampMs << ",\"interval_ms\":" << intervalMs;
+
+	const char *sectionNames[] = {"counters", "gauges", "histograms"};
+	const Kind sectionKinds[] = {Kind::Counter, Kind::Gauge, Kind::Histogram};
+	std::vector<uint64_t> windowBuckets(MetricsHistogram::BUCKET_COUNT);
+	for (size_t section = 0; section < 3; section++)
+	{
+		out << ",\"" << sectionNames[section] << "\":{";
+		bool first = true;
+		for (const std::unique_ptr<Entry> &entry : m_entries)
+		{
+			if (entry->kind != sectionKinds[section])
+			{
+				continue;
+			}
+			if (!first)
+			{
+				out << ',';
+			}
+			first = false;
+			appendJsonString(out, entry->name, entry->labels);
+			out << ':';
+			if (entry->kind == Kind::Counter)
+			{
+				out << entry->counter->value();
+				continue;
+			}
+			if (entry->kind == Kind::Gauge)
+			{
+				out << entry->gauge->value();
+				continue;
+			}
+
+			// Fenêtre = différence avec l'état du précédent appel.
+			const MetricsHistogram &histogram = *entry->histogram;
+			uint64_t windowCount = 0;
+			size_t lastUsedBucket = 0;
+			for (size_t index = 0; index < MetricsHistogram::BUCKET_COUNT; index++)
+			{
+				uint64_t current = histogram.bucketCount(index);
+				windowBuckets[index] = current - entry->lastBuckets[index];
+				entry->lastBuckets[index] = current;
+				windowCount += windowBuckets[index];
+				if (windowBuckets[index] != 0)
+				{
+					lastUsedBucket = index;
+				}
+			}
+			uint64_t sum = histogram.sum();
+			uint64_t windowSum = sum - entry->lastSum;
+			entry->lastSum = sum;
+
+			out << "{\"count\":" << windowCount;
+			if (windowCount == 0)
+			{
+				out << '}';
+				continue;
+			}
+			out << ",\"mean\":" << windowSum / windowCount;
+			for (size_t quantileIndex = 0; quantileIndex < std::size(JSON_QUANTILES); quantileIndex++)
+			{
+				uint64_t rank = std::max<uint64_t>(
+					1, static_cast<uint64_t>(JSON_QUANTILES[quantileIndex] * static_cast<double>(windowCount) + 0.999999));
+				uint64_t seen = 0;
+				size_t index = 0;
+				for (; index < MetricsHistogram::BUCKET_COUNT; index++)
+				{
+					seen += windowBuckets[index];
+					if (seen >= rank)
+					{
+						break;
+					}
+				}
+				index = std::min(index, lastUsedBucket);
+				out << ",\"" << JSON_QUANTILE_NAMES[quantileIndex] << "\":" << MetricsHistogram::bucketUpperBound(index);
+			}
+			out << ",\"max\":" << MetricsHistogram::bucketUpperBound(lastUsedBucket) << '}';
+		}
+		out << '}';
+	}
+	out << '}';
+	return out.str();
+}
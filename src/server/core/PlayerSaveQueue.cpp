@@ -0,0 +1,242 @@
+#include <server/core/PlayerSaveQueue.h>
+
+#include <server/core/MetricsRegistry.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	// Un joueur qui bouge est réécrit au plus une fois par intervalle.
+	constexpr auto FLUSH_INTERVAL = std::chrono::milliseconds(1000);
+	// Au-delà, inutile d'attendre la fin de l'intervalle (sauvegarde générale, vague de départs).
+	constexpr size_t FLUSH_EARLY_PENDING_PLAYERS = 128;
+	// Après un échec, l'attente double (base pleine, disque en lecture seule...) jusqu'à ce plafond.
+	constexpr auto FAILED_FLUSH_MAX_BACKOFF = std::chrono::milliseconds(30000);
+	// À l'arrêt: une base occupée (SQLITE_BUSY au-delà du busy timeout) a encore sa chance.
+	constexpr int STOP_FLUSH_ATTEMPTS = 5;
+	constexpr auto STOP_FLUSH_FIRST_BACKOFF = std::chrono::milliseconds(250);
+}
+
+PlayerSaveQueue::~PlayerSaveQueue()
+{
+	close();
+}
+
+bool PlayerSaveQueue::open(const std::string &databasePath)
+{
+	close();
+	m_lastError.clear();
+	if (!m_table.open(databasePath))
+	{
+		m_lastError = m_table.lastError();
+		return false;
+	}
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopRequested = false;
+	}
+	m_thread = std::thread(&PlayerSaveQueue::writerLoop, this);
+	return true;
+}
+
+bool PlayerSaveQueue::close()
+{
+	bool flushed = true;
+	if (m_thread.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stopRequested = true;
+		}
+		m_cv.notify_all();
+		m_thread.join();
+		if (!m_closeError.empty())
+		{
+			m_lastError = std::move(m_closeError);
+			m_closeError.clear();
+			flushed = false;
+		}
+	}
+	m_table.close();
+	return flushed;
+}
+
+bool PlayerSaveQueue::isOpen() const
+{
+	return m_table.isOpen();
+}
+
+void PlayerSaveQueue::enqueue(const Player &player)
+{
+	if (player.profile.playerId == 0)
+	{
+		return;
+	}
+	bool flushEarly = false;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_windowStats.enqueued++;
+		if (!m_pending.insert_or_assign(player.profile.playerId, player).second)
+		{
+			m_windowStats.coalesced++;
+		}
+		flushEarly = m_pending.size() >= FLUSH_EARLY_PENDING_PLAYERS;
+	}
+	if (flushEarly)
+	{
+		m_cv.notify_one();
+	}
+}
+
+bool PlayerSaveQueue::pendingPlayer(const std::string &username, Player &player) const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	// Le plus récent d'abord: ce qui attend passe devant le lot en cours d'écriture.
+	for (const std::unordered_map<uint64_t, Player> *players : {&m_pending, &m_writing})
+	{
+		for (const auto &entry : *players)
+		{
+			if (entry.second.profile.username == username)
+			{
+				player = entry.second;
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+void PlayerSaveQueue::setCommitHistogram(MetricsHistogram *histogram)
+{
+	m_commitHistogram = histogram;
+}
+
+size_t PlayerSaveQueue::pendingCount() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_pending.size() + m_writing.size();
+}
+
+PlayerSaveQueueStats PlayerSaveQueue::takeWindowStats()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return std::exchange(m_windowStats, PlayerSaveQueueStats{});
+}
+
+const std::string &PlayerSaveQueue::lastError() const
+{
+	return m_lastError;
+}
+
+void PlayerSaveQueue::writerLoop()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	std::chrono::milliseconds retryDelay{0};
+	while (true)
+	{
+		if (retryDelay.count() == 0)
+		{
+			m_cv.wait_for(lock, FLUSH_INTERVAL, [&]()
+						  { return m_stopRequested || m_pending.size() >= FLUSH_EARLY_PENDING_PLAYERS; });
+		}
+		else
+		{
+			// Le lot rejeté est revenu dans m_pending: sans cette attente pleine, le seuil de
+			// vidage anticipé relancerait savePlayers en boucle contre une base qui échoue.
+			m_cv.wait_for(lock, retryDelay, [&]()
+						  { return m_stopRequested; });
+		}
+		if (m_stopRequested)
+		{
+			flushBeforeStop(lock);
+			return;
+		}
+		if (m_pending.empty())
+		{
+			continue;
+		}
+		if (writeBatch(lock))
+		{
+			retryDelay = std::chrono::milliseconds{0};
+		}
+		else
+		{
+			retryDelay = retryDelay.count() == 0
+							 ? std::chrono::duration_cast<std::chrono::milliseconds>(FLUSH_INTERVAL)
+							 : std::min(retryDelay * 2, FAILED_FLUSH_MAX_BACKOFF);
+		}
+	}
+}
+
+void PlayerSaveQueue::flushBeforeStop(std::unique_lock<std::mutex> &lock)
+{
+	std::chrono::milliseconds backoff = STOP_FLUSH_FIRST_BACKOFF;
+	for (int attempt = 1; !m_pending.empty(); attempt++)
+	{
+		if (writeBatch(lock))
+		{
+			continue;
+		}
+		if (attempt >= STOP_FLUSH_ATTEMPTS)
+		{
+			m_closeError = "Dropped " + std::to_string(m_pending.size()) +
+						   " unsaved player state(s) at shutdown: " + m_table.lastError();
+			return;
+		}
+		lock.unlock();
+		std::this_thread::sleep_for(backoff);
+		lock.lock();
+		backoff *= 2;
+	}
+}
+
+bool PlayerSaveQueue::writeBatch(std::unique_lock<std::mutex> &lock)
+{
+	m_writing.swap(m_pending);
+	lock.unlock();
+
+	// Seul ce thread modifie m_writing: le lire sans verrou ne gêne que d'autres lecteurs.
+	std::vector<Player> batch;
+	batch.reserve(m_writing.size());
+	for (const auto &entry : m_writing)
+	{
+		batch.push_back(entry.second);
+	}
+	std::chrono::steady_clock::time_point startedAt = std::chrono::steady_clock::now();
+	bool saved = m_table.savePlayers(batch);
+	uint64_t commitMicros = static_cast<uint64_t>(
+		std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startedAt).count());
+	if (!saved)
+	{
+		std::cerr << "Failed to save " << batch.size()
+				  << " player(s): " << m_table.lastError() << std::endl;
+	}
+
+	lock.lock();
+	if (saved)
+	{
+		m_windowStats.written += batch.size();
+		m_windowStats.batches++;
+		m_windowStats.commitMicrosMax = std::max(m_windowStats.commitMicrosMax, commitMicros);
+		if (m_commitHistogram != nullptr)
+		{
+			m_commitHistogram->record(commitMicros);
+		}
+	}
+	else
+	{
+		// On retentera au prochain intervalle, sans écraser un état plus récent arrivé entre-temps.
+		m_windowStats.failedBatches++;
+		for (auto &entry : m_writing)
+		{
+			m_pending.try_emplace(entry.first, std::move(entry.second));
+		}
+	}
+	m_writing.clear();
+	return saved;
+}
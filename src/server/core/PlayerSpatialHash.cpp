@@ -0,0 +1,122 @@
+#include <server/core/PlayerSpatialHash.h>
+
+#include <VoxelChunkData.h>
+
+#include <algorithm>
+#include <cmath>
+
+PlayerSpatialHash::PlayerSpatialHash(int cellSizeChunks)
+	: m_cellSizeBlocks(std::max(cellSizeChunks, 1) * CHUNK_SIZE_X)
+{
+}
+
+int PlayerSpatialHash::cellCoord(float value) const
+{
+	return static_cast<int>(std::floor(value / static_cast<float>(m_cellSizeBlocks)));
+}
+
+void PlayerSpatialHash::update(uint16_t id, float x, float z)
+{
+	int64_t cellKey = chunkKey(cellCoord(x), cellCoord(z));
+	auto entryIt = m_entries.find(id);
+	if (entryIt != m_entries.end())
+	{
+		Entry &entry = entryIt->second;
+		if (entry.cellKey == cellKey)
+		{
+			CellEntry &cellEntry = m_cells[cellKey][entry.slot];
+			cellEntry.x = x;
+			cellEntry.z = z;
+			return;
+		}
+		removeFromCell(entry.cellKey, entry.slot);
+		std::vector<CellEntry> &cell = m_cells[cellKey];
+		entry.cellKey = cellKey;
+		entry.slot = cell.size();
+		cell.push_back(CellEntry{id, x, z});
+		return;
+	}
+
+	std::vector<CellEntry> &cell = m_cells[cellKey];
+	Entry entry;
+	entry.cellKey = cellKey;
+	entry.slot = cell.size();
+	cell.push_back(CellEntry{id, x, z});
+	m_entries.emplace(id, entry);
+}
+
+void PlayerSpatialHash::remove(uint16_t id)
+{
+	auto entryIt = m_entries.find(id);
+	if (entryIt == m_entries.end())
+	{
+		return;
+	}
+	Entry entry = entryIt->second;
+	m_entries.erase(entryIt);
+	removeFromCell(entry.cellKey, entry.slot);
+}
+
+void PlayerSpatialHash::removeFromCell(int64_t cellKey, size_t slot)
+{
+	auto cellIt = m_cells.find(cellKey);
+	if (cellIt == m_cells.end())
+	{
+		return;
+	}
+	// Échange avec le dernier: l'entrée déplacée garde un slot exact.
+	std::vector<CellEntry> &cell = cellIt->second;
+	cell[slot] = cell.back();
+	cell.pop_back();
+	if (slot < cell.size())
+	{
+		m_entries[cell[slot].id].slot = slot;
+	}
+	if (cell.empty())
+	{
+		m_cells.erase(cellIt);
+	}
+}
+
+bool PlayerSpatialHash::contains(uint16_t id) const
+{
+	return m_entries.find(id) != m_entries.end();
+}
+
+size_t PlayerSpatialHash::size() const
+{
+	return m_entries.size();
+}
+
+size_t PlayerSpatialHash::queryRadius(float x, float z, float radius, std::vector<uint16_t> &outIds) const
+{
+	outIds.clear();
+	int minCellX = cellCoord(x - radius);
+	int maxCellX = cellCoord(x + radius);
+	int minCellZ = cellCoord(z - radius);
+	int maxCellZ = cellCoord(z + radius);
+	float radiusSq = radius * radius;
+	size_t examined = 0;
+	for (int cellX = minCellX; cellX <= maxCellX; cellX++)
+	{
+		for (int cellZ = minCellZ; cellZ <= maxCellZ; cellZ++)
+		{
+			auto cellIt = m_cells.find(chunkKey(cellX, cellZ));
+			if (cellIt == m_cells.end())
+			{
+				continue;
+			}
+			for (const CellEntry &cellEntry : cellIt->second)
+			{
+				examined++;
+				float dx = cellEntry.x - x;
+				float dz = cellEntry.z - z;
+				if (dx * dx + dz * dz <= radiusSq)
+				{
+					outIds.push_back(cellEntry.id);
+				}
+			}
+		}
+	}
+	return examined;
+}
@@ -1,6 +1,9 @@
 #include <server/core/ServerLaunch.h>
 
+#include <server/core/ChunkCodecPolicy.h>
+
 #include <algorithm>
+#include <charconv>
 #include <cstdlib>
 #include <iostream>
 #include <string_view>
@@ -83,6 +86,47 @@ namespace
 		return true;
 	}
 
+	bool parseShardLayout(std::string_view rawShard, ShardLayout &shard)
+	{
+		size_t separator = rawShard.find('/');
+		if (separator == std::string_view::npos)
+		{
+			return false;
+		}
+		uint16_t index = 0;
+		uint16_t count = 0;
+		std::from_chars_result indexResult = std::from_chars(rawShard.data(), rawShard.data() + separator, index);
+		std::from_chars_result countResult = std::from_chars(rawShard.data() + separator + 1, rawShard.data() + rawShard.size(), count);
+		if (indexResult.ec != std::errc() || indexResult.ptr != rawShard.data() + separator ||
+			countResult.ec != std::errc() || countResult.ptr != rawShard.data() + rawShard.size())
+		{
+			return false;
+		}
+		if (count == 0 || count > MAX_SHARD_COUNT || index >= count)
+		{
+			return false;
+		}
+		shard.index = index;
+		shard.count = count;
+		return true;
+	}
+
+	bool readShardToken(std::string &token)
+	{
+		const char *rawToken = std::getenv(SHARD_TOKEN_ENV);
+		if (rawToken == nullptr)
+		{
+			return false;
+		}
+		std::string_view value = rawToken;
+		if (value.size() < SHARD_TOKEN_MIN_LENGTH || value.size() > SHARD_TOKEN_MAX_LENGTH)
+		{
+			return false;
+		}
+		token = value;
+		return true;
+	}
+
 	std::string defaultPlayerDatabasePath(WorldGenerationMode generationMode)
 	{
 		if (generationMode == WorldGenerationMode::ClassicStreaming)
@@ -105,12 +149,15 @@ namespace
 
 void printServerUsage(const char *programName)
 {
-	std::cout << "Usage: " << programName << " [--classic-gen] [--port <port>] [--db <path>] [--world-db <path>] [--full-db] [--help]" << std::endl;
+	std::cout << "Usage: " << programName << " [--classic-gen] [--port <port>] [--db <path>] [--world-db <path>] [--full-db] [--shard <i>/<n>] [--help]" << std::endl;
 	std::cout << "  --classic-gen  Enable classic streaming generation around player movement" << std::endl;
 	std::cout << "  --port <port>  Override server listen port (default: " << DEFAULT_SERVER_PORT << ")" << std::endl;
 	std::cout << "  --db <path>    SQLite file for player persistence" << std::endl;
 	std::cout << "  --world-db <path> SQLite file for world chunk persistence" << std::endl;
 	std::cout << "  --full-db      Persist generated chunks in the world database (default: modified-only)" << std::endl;
+	std::cout << "  --shard <i>/<n> Serve only region shard i of n on 127.0.0.1, behind VoxPlaceGateway" << std::endl;
+	std::cout << "                 (requires " << SHARD_TOKEN_ENV << ", " << SHARD_TOKEN_MIN_LENGTH << "-"
+			  << SHARD_TOKEN_MAX_LENGTH << " characters, identical for the gateway and every shard)" << std::endl;
 	std::cout << "  --help         Show this help message" << std::endl;
 }
 
@@ -180,11 +227,35 @@ ServerLaunchParseResult parseServerLaunchOptions(int argc, char **argv, ServerLa
 				options.persistGeneratedChunks = true;
 				continue;
 			}
+		if (argument == "--shard")
+		{
+			argumentIndex++;
+			if (argumentIndex >= argc)
+			{
+				std::cerr << "Missing value after --shard" << std::endl;
+				printServerUsage(argv[0]);
+				return ServerLaunchParseResult::Error;
+			}
+			if (!parseShardLayout(argv[argumentIndex], options.shard))
+			{
+				std::cerr << "Invalid shard: " << argv[argumentIndex] << std::endl;
+				printServerUsage(argv[0]);
+				return ServerLaunchParseResult::Error;
+			}
+			continue;
+		}
 			std::cerr << "Unknown argument: " << argument << std::endl;
 			printServerUsage(argv[0]);
 		return ServerLaunchParseResult::Error;
 	}
 
+	if (options.shard.isSharded() && !readShardToken(options.shardToken))
+	{
+		std::cerr << "--shard requires " << SHARD_TOKEN_ENV << " (" << SHARD_TOKEN_MIN_LENGTH << "-"
+				  << SHARD_TOKEN_MAX_LENGTH << " characters)" << std::endl;
+		return ServerLaunchParseResult::Error;
+	}
+
 	if (!playerDatabasePathOverridden)
 	{
 		options.playerDatabasePath = defaultPlayerDatabasePath(options.generationMode);
@@ -218,5 +289,65 @@ ServerEnvironmentOptions loadServerEnvironmentOptions()
 		options.streamTickMs = static_cast<uint32_t>(overrideStreamTickMs);
 	}
 
+	int overridePlayerViewRadius = 0;
+	if (tryReadEnvInt("VOXPLACE_PLAYER_VIEW_RADIUS", overridePlayerViewRadius))
+	{
+		overridePlayerViewRadius = std::clamp(overridePlayerViewRadius, 16, 1024);
+		options.playerViewRadiusBlocks = static_cast<uint32_t>(overridePlayerViewRadius);
+	}
+
+	int overrideAuthWorkers = 0;
+	if (tryReadEnvInt("VOXPLACE_AUTH_WORKERS", overrideAuthWorkers) && overrideAuthWorkers > 0)
+	{
+		options.authWorkerCount = static_cast<size_t>(std::clamp(overrideAuthWorkers, 1, 16));
+	}
+
+	int overrideHostEgress = 0;
+	if (tryReadEnvInt("VOXPLACE_HOST_EGRESS_BYTES_PER_SECOND", overrideHostEgress) && overrideHostEgress > 0)
+	{
+		// En dessous, un seul snapshot dense prend plusieurs ticks.
+		options.hostEgressBytesPerSecond = static_cast<uint64_t>(std::max(overrideHostEgress, 64 * 1024));
+	}
+
+	const char *metricsPort = std::getenv("VOXPLACE_METRICS_PORT");
+	if (metricsPort != nullptr && metricsPort[0] != '\0' && std::string_view(metricsPort) != "0" &&
+		!parsePort(metricsPort, options.metricsPort))
+	{
+		std::cerr << "Ignoring VOXPLACE_METRICS_PORT=" << metricsPort << std::endl;
+	}
+
+	const char *metricsJsonlPath = std::getenv("VOXPLACE_METRICS_JSONL");
+	if (metricsJsonlPath != nullptr)
+	{
+		options.metricsJsonlPath = metricsJsonlPath;
+	}
+
+	int overrideMetricsInterval = 0;
+	if (tryReadEnvInt("VOXPLACE_METRICS_JSONL_INTERVAL_MS", overrideMetricsInterval))
+	{
+		overrideMetricsInterval = std::clamp(overrideMetricsInterval, 1000, 3600000);
+		options.metricsJsonlIntervalMs = static_cast<uint32_t>(overrideMetricsInterval);
+	}
+
+	const char *packetTracePath = std::getenv("VOXPLACE_PACKET_TRACE");
+	if (packetTracePath != nullptr)
+	{
+		options.packetTracePath = packetTracePath;
+	}
+
+	const char *forcedChunkCodec = std::getenv("VOXPLACE_CHUNK_CODEC");
+	if (forcedChunkCodec != nullptr && forcedChunkCodec[0] != '\0')
+	{
+		if (parseChunkCodecName(forcedChunkCodec, options.forcedChunkCodec))
+		{
+			options.chunkCodecForced = true;
+		}
+		else
+		{
+			std::cerr << "Ignoring VOXPLACE_CHUNK_CODEC=" << forcedChunkCodec
+					  << " (expected sections, zstd_fast, zstd or zstd_dense)" << std::endl;
+		}
+	}
+
 	return options;
 }
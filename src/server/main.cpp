@@ -50,6 +50,10 @@ int main(int argc, char **argv)
 	std::cout << "Persistence mode: "
 			  << (launchOptions.persistGeneratedChunks ? "full-db" : "modified-only")
 			  << std::endl;
+	if (launchOptions.shard.isSharded())
+	{
+		std::cout << "Shard: " << launchOptions.shard.index << "/" << launchOptions.shard.count << std::endl;
+	}
 
 	WorldServer server(
 		launchOptions.port,
@@ -58,7 +62,9 @@ int main(int argc, char **argv)
 		launchOptions.playerDatabasePath,
 		launchOptions.worldDatabasePath,
 		launchOptions.persistGeneratedChunks,
-		environmentOptions);
+		environmentOptions,
+		launchOptions.shard,
+		launchOptions.shardToken);
 	if (!server.start())
 	{
 		std::cerr << "Failed to start VoxPlaceServer" << std::endl;
@@ -1,3 +1,5 @@
+#include <ChunkZstdCodec.h>
+#include <ChunkZstdDictionary.h>
 #include <TerrainGenerator.h>
 #include <VoxelChunkData.h>
 #include <WorldProtocol.h>
@@ -26,6 +28,9 @@
 namespace
 {
 	constexpr int BENCH_ZSTD_LEVEL = 3;
+	constexpr size_t TRAIN_DICT_DEFAULT_GENERATED_SAMPLES = 512;
+	constexpr size_t TRAIN_DICT_MAX_PERSISTED_SAMPLES = 1024;
+	constexpr size_t TRAIN_DICT_DEFAULT_CAPACITY = 64 * 1024;
 
 	struct ChunkSnapshotRleRun
 	{
@@ -184,7 +189,8 @@ namespace
 		std::vector<ChunkSnapshotRleRun> runs;
 		runs.reserve(CHUNK_BLOCK_COUNT);
 
-		const uint32_t *values = &chunk.blocks[0][0][0];
+		std::vector<uint32_t> values(CHUNK_BLOCK_COUNT);
+		chunk.copyBlocksTo(values.data());
 		size_t index = 0;
 		while (index < CHUNK_BLOCK_COUNT)
 		{
@@ -227,20 +233,7 @@ namespace
 		int compressionLevel,
 		std::vector<uint8_t> &payload)
 	{
-		size_t maxCompressedSize = ZSTD_compressBound(size);
-		payload.resize(maxCompressedSize);
-		size_t compressedSize = ZSTD_compress(
-			payload.data(),
-			payload.size(),
-			data,
-			size,
-			compressionLevel);
-		if (ZSTD_isError(compressedSize))
-		{
-			return false;
-		}
-		payload.resize(compressedSize);
-		return true;
+		return compressChunkZstdInto(data, size, compressionLevel, payload);
 	}
 
 	bool decodeCompressedChunkPayload(
@@ -248,35 +241,109 @@ namespace
 		size_t payloadSize,
 		DecodedChunkSnapshot &decoded)
 	{
-		unsigned long long decompressedSize =
-			ZSTD_getFrameContentSize(payloadData, payloadSize);
-		if (decompressedSize == ZSTD_CONTENTSIZE_ERROR ||
-			decompressedSize == ZSTD_CONTENTSIZE_UNKNOWN)
-		{
-			return false;
-		}
-		if (decompressedSize >
-			static_cast<unsigned long long>(std::numeric_limits<size_t>::max()))
+		static std::vector<uint8_t> decompressedBuffer;
+		if (!decompressChunkZstdInto(payloadData, payloadSize, 0, decompressedBuffer))
 		{
 			return false;
 		}
 
-		std::vector<uint8_t> decompressedBuffer(
-			static_cast<size_t>(decompressedSize));
-		size_t result = ZSTD_decompress(
+		return decodeChunkSnapshot(
 			decompressedBuffer.data(),
 			decompressedBuffer.size(),
-			payloadData,
-			payloadSize);
-		if (ZSTD_isError(result) || result != decompressedBuffer.size())
+			decoded);
+	}
+
+	struct CodecThroughput
+	{
+		double compressMs = 0.0;
+		double decompressMs = 0.0;
+	};
+
+	// Ancien chemin: ZSTD_compress / ZSTD_decompress, contexte et vecteurs neufs à chaque chunk.
+	bool measureOneShotZstd(const std::vector<std::vector<uint8_t>> &payloads, CodecThroughput &result)
+	{
+		std::vector<std::vector<uint8_t>> compressed;
+		compressed.reserve(payloads.size());
+		auto start = std::chrono::steady_clock::now();
+		for (const std::vector<uint8_t> &payload : payloads)
 		{
-			return false;
+			std::vector<uint8_t> output(ZSTD_compressBound(payload.size()));
+			size_t compressedSize = ZSTD_compress(
+				output.data(),
+				output.size(),
+				payload.data(),
+				payload.size(),
+				BENCH_ZSTD_LEVEL);
+			if (ZSTD_isError(compressedSize))
+			{
+				return false;
+			}
+			output.resize(compressedSize);
+			compressed.push_back(std::move(output));
 		}
+		auto middle = std::chrono::steady_clock::now();
+		for (size_t index = 0; index < payloads.size(); index++)
+		{
+			std::vector<uint8_t> output(payloads[index].size());
+			size_t decompressedSize = ZSTD_decompress(
+				output.data(),
+				output.size(),
+				compressed[index].data(),
+				compressed[index].size());
+			if (ZSTD_isError(decompressedSize) || output != payloads[index])
+			{
+				return false;
+			}
+		}
+		auto stop = std::chrono::steady_clock::now();
+		result.compressMs = std::chrono::duration<double, std::milli>(middle - start).count();
+		result.decompressMs = std::chrono::duration<double, std::milli>(stop - middle).count();
+		return true;
+	}
 
-		return decodeChunkSnapshot(
-			decompressedBuffer.data(),
-			decompressedBuffer.size(),
-			decoded);
+	// Nouveau chemin: contextes par thread et tampons réutilisés.
+	bool measureCodecZstd(const std::vector<std::vector<uint8_t>> &payloads, CodecThroughput &result)
+	{
+		std::vector<std::vector<uint8_t>> compressed(payloads.size());
+		std::vector<uint8_t> scratch;
+		auto start = std::chrono::steady_clock::now();
+		for (size_t index = 0; index < payloads.size(); index++)
+		{
+			if (!compressChunkZstdInto(
+					payloads[index].data(),
+					payloads[index].size(),
+					BENCH_ZSTD_LEVEL,
+					scratch))
+			{
+				return false;
+			}
+			compressed[index].assign(scratch.begin(), scratch.end());
+		}
+		auto middle = std::chrono::steady_clock::now();
+		for (size_t index = 0; index < payloads.size(); index++)
+		{
+			if (!decompressChunkZstdInto(
+					compressed[index].data(),
+					compressed[index].size(),
+					payloads[index].size(),
+					scratch) ||
+				scratch != payloads[index])
+			{
+				return false;
+			}
+		}
+		auto stop = std::chrono::steady_clock::now();
+		result.compressMs = std::chrono::duration<double, std::milli>(middle - start).count();
+		result.decompressMs = std::chrono::duration<double, std::milli>(stop - middle).count();
+		return true;
+	}
+
+	void printCodecThroughput(const char *label, const CodecThroughput &result, size_t rawBytes)
+	{
+		double megabytes = static_cast<double>(rawBytes) / (1024.0 * 1024.0);
+		std::cout << label << ": compress_mb_s=" << megabytes / (result.compressMs / 1000.0)
+				  << ", decompress_mb_s=" << megabytes / (result.decompressMs / 1000.0)
+				  << std::endl;
 	}
 
 	bool writeIndexedWorldFile(
@@ -532,10 +599,273 @@ namespace
 		sqlite3_close(db);
 		return ok;
 	}
+
+	bool readGenerationMode(const std::string &databasePath, std::string &outMode)
+	{
+		sqlite3 *db = nullptr;
+		if (sqlite3_open_v2(databasePath.c_str(), &db, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK)
+		{
+			sqlite3_close(db);
+			return false;
+		}
+
+		bool found = false;
+		sqlite3_stmt *statement = nullptr;
+		if (sqlite3_prepare_v2(db,
+							   "SELECT value FROM world_meta WHERE key = 'generation_mode';",
+							   -1,
+							   &statement,
+							   nullptr) == SQLITE_OK &&
+			sqlite3_step(statement) == SQLITE_ROW)
+		{
+			const unsigned char *value = sqlite3_column_text(statement, 0);
+			if (value != nullptr)
+			{
+				outMode = reinterpret_cast<const char *>(value);
+				found = true;
+			}
+		}
+		sqlite3_finalize(statement);
+		sqlite3_close(db);
+		return found;
+	}
+
+	struct DictionaryRunResult
+	{
+		size_t totalBytes = 0;
+		double totalMs = 0.0;
+	};
+
+	bool compressSamples(const std::vector<std::vector<uint8_t>> &samples,
+						 int compressionLevel,
+						 const ChunkZstdDictionary *dictionary,
+						 DictionaryRunResult &result)
+	{
+		std::vector<uint8_t> output;
+		auto start = std::chrono::steady_clock::now();
+		for (const std::vector<uint8_t> &sample : samples)
+		{
+			output.resize(ZSTD_compressBound(sample.size()));
+			size_t compressedSize = compressChunkZstd(
+				output.data(),
+				output.size(),
+				sample.data(),
+				sample.size(),
+				compressionLevel,
+				dictionary);
+			if (ZSTD_isError(compressedSize))
+			{
+				return false;
+			}
+
+			// Vérifie l'aller-retour: l'id du dictionnaire doit suffire au décodeur.
+			std::vector<uint8_t> roundTrip(sample.size());
+			size_t decompressedSize = decompressChunkZstd(
+				roundTrip.data(),
+				roundTrip.size(),
+				output.data(),
+				compressedSize);
+			if (ZSTD_isError(decompressedSize) || roundTrip != sample)
+			{
+				return false;
+			}
+			result.totalBytes += compressedSize;
+		}
+		auto stop = std::chrono::steady_clock::now();
+		result.totalMs = std::chrono::duration<double, std::milli>(stop - start).count();
+		return true;
+	}
+
+	void printDictionaryRun(const char *label, const DictionaryRunResult &result, size_t sampleCount)
+	{
+		std::cout << label << ": avg_bytes="
+				  << static_cast<double>(result.totalBytes) / static_cast<double>(sampleCount)
+				  << ", total_ms=" << result.totalMs
+				  << " (compress+verify)" << std::endl;
+	}
+
+	void appendDictionarySamples(const VoxelChunkData &chunk,
+								 std::vector<std::vector<uint8_t>> &samples,
+								 std::vector<std::vector<uint8_t>> &sectionSamples)
+	{
+		samples.push_back(encodeChunkSnapshot(chunk));
+		for (int sectionIndex = 0; sectionIndex < CHUNK_SECTION_COUNT; sectionIndex++)
+		{
+			if (chunk.sectionIfPresent(sectionIndex) != nullptr)
+			{
+				sectionSamples.push_back(encodeChunkSectionData(chunk, sectionIndex));
+			}
+		}
+	}
+
+	bool reportDictionaryGain(const char *label,
+							  const std::vector<std::vector<uint8_t>> &samples,
+							  const ChunkZstdDictionary &dictionary)
+	{
+		if (samples.empty())
+		{
+			return true;
+		}
+
+		size_t rawBytes = 0;
+		for (const std::vector<uint8_t> &sample : samples)
+		{
+			rawBytes += sample.size();
+		}
+		std::cout << label << "_raw: avg_bytes="
+				  << static_cast<double>(rawBytes) / static_cast<double>(samples.size()) << std::endl;
+
+		for (int level : {1, BENCH_ZSTD_LEVEL})
+		{
+			DictionaryRunResult plain;
+			DictionaryRunResult withDictionary;
+			if (!compressSamples(samples, level, nullptr, plain) ||
+				!compressSamples(samples, level, &dictionary, withDictionary))
+			{
+				std::cerr << "Chunk dictionary round trip failed at level " << level << std::endl;
+				return false;
+			}
+			std::string plainLabel = std::string(label) + "_zstd_l" + std::to_string(level);
+			std::string dictionaryLabel = plainLabel + "_dict";
+			printDictionaryRun(plainLabel.c_str(), plain, samples.size());
+			printDictionaryRun(dictionaryLabel.c_str(), withDictionary, samples.size());
+			if (withDictionary.totalBytes > 0)
+			{
+				std::cout << plainLabel << "_dict_gain="
+						  << static_cast<double>(plain.totalBytes) /
+								 static_cast<double>(withDictionary.totalBytes)
+						  << "x" << std::endl;
+			}
+		}
+		return true;
+	}
+
+	// train-dict <world-db> [generated-samples] [dictionary-bytes]
+	int runTrainDictionary(int argc, char **argv)
+	{
+		if (argc < 3)
+		{
+			std::cerr << "Usage: " << argv[0]
+					  << " train-dict <world-db> [generated-samples] [dictionary-bytes]" << std::endl;
+			return 1;
+		}
+		std::string databasePath = argv[2];
+		size_t generatedSampleCount = TRAIN_DICT_DEFAULT_GENERATED_SAMPLES;
+		size_t dictionaryCapacity = TRAIN_DICT_DEFAULT_CAPACITY;
+		if (argc >= 4)
+		{
+			generatedSampleCount = static_cast<size_t>(std::strtoull(argv[3], nullptr, 10));
+		}
+		if (argc >= 5)
+		{
+			dictionaryCapacity = static_cast<size_t>(std::strtoull(argv[4], nullptr, 10));
+		}
+
+		std::string generationMode;
+		if (!readGenerationMode(databasePath, generationMode))
+		{
+			std::cerr << "Not a VoxPlace world database: " << databasePath << std::endl;
+			return 1;
+		}
+
+		// Ouvre aussi les dictionnaires déjà en base, pour relire les lignes qui en dépendent.
+		WorldTable worldTable;
+		if (!worldTable.open(databasePath, generationMode))
+		{
+			std::cerr << "Failed to open world database: " << worldTable.lastErrorCopy() << std::endl;
+			return 1;
+		}
+
+		// Snapshots entiers (disque, premier envoi) et sections seules (trames, deltas).
+		std::vector<std::vector<uint8_t>> samples;
+		std::vector<std::vector<uint8_t>> sectionSamples;
+		TerrainGenerator generator(42);
+		for (const auto &[cx, cz] : buildCoords(generatedSampleCount))
+		{
+			VoxelChunkData chunk(cx, cz);
+			generator.fillChunk(chunk);
+			appendDictionarySamples(chunk, samples, sectionSamples);
+		}
+		size_t generatedSamples = samples.size();
+
+		std::vector<int64_t> persistedKeys;
+		if (!worldTable.loadAllChunkKeys(persistedKeys))
+		{
+			std::cerr << "Failed to list persisted chunks: " << worldTable.lastErrorCopy() << std::endl;
+			return 1;
+		}
+		size_t persistedStride = persistedKeys.size() / TRAIN_DICT_MAX_PERSISTED_SAMPLES + 1;
+		for (size_t index = 0; index < persistedKeys.size(); index += persistedStride)
+		{
+			int64_t key = persistedKeys[index];
+			int cx = static_cast<int>(key >> 32);
+			int cz = static_cast<int>(static_cast<int32_t>(key & 0xFFFFFFFFll));
+			VoxelChunkData chunk(cx, cz);
+			if (!worldTable.loadChunk(cx, cz, chunk))
+			{
+				std::cerr << "Skipping unreadable chunk " << cx << "," << cz
+						  << ": " << worldTable.lastErrorCopy() << std::endl;
+				continue;
+			}
+			appendDictionarySamples(chunk, samples, sectionSamples);
+		}
+
+		std::cout << "Training chunk dictionary" << std::endl;
+		std::cout << "samples: generated=" << generatedSamples
+				  << ", persisted=" << samples.size() - generatedSamples
+				  << ", sections=" << sectionSamples.size() << std::endl;
+
+		std::vector<std::vector<uint8_t>> trainingSamples = samples;
+		trainingSamples.insert(trainingSamples.end(), sectionSamples.begin(), sectionSamples.end());
+		std::vector<uint8_t> content;
+		std::string trainError;
+		auto trainStart = std::chrono::steady_clock::now();
+		if (!trainChunkZstdDictionary(trainingSamples, dictionaryCapacity, content, trainError))
+		{
+			std::cerr << trainError << std::endl;
+			return 1;
+		}
+		auto trainStop = std::chrono::steady_clock::now();
+		std::shared_ptr<const ChunkZstdDictionary> dictionary =
+			ChunkZstdDictionary::create(std::move(content), &trainError);
+		if (dictionary == nullptr)
+		{
+			std::cerr << trainError << std::endl;
+			return 1;
+		}
+		registerChunkZstdDictionary(dictionary, false);
+		std::cout << "dictionary: id=" << dictionary->id()
+				  << ", bytes=" << dictionary->content().size()
+				  << ", train_ms="
+				  << std::chrono::duration<double, std::milli>(trainStop - trainStart).count()
+				  << std::endl;
+
+		if (!reportDictionaryGain("snapshot", samples, *dictionary) ||
+			!reportDictionaryGain("section", sectionSamples, *dictionary))
+		{
+			return 1;
+		}
+
+		if (!worldTable.saveChunkDictionary(*dictionary))
+		{
+			std::cerr << "Failed to save chunk dictionary: " << worldTable.lastErrorCopy() << std::endl;
+			return 1;
+		}
+		std::cout << "Saved chunk dictionary " << dictionary->id()
+				  << " to " << databasePath
+				  << " (active at next server start; existing rows are re-compressed on their next save)"
+				  << std::endl;
+		return 0;
+	}
 }
 
 int main(int argc, char **argv)
 {
+	if (argc >= 2 && std::strcmp(argv[1], "train-dict") == 0)
+	{
+		return runTrainDictionary(argc, argv);
+	}
+
 	size_t chunkCount = 512;
 	if (argc >= 2)
 	{
@@ -585,6 +915,20 @@ int main(int argc, char **argv)
 		printTimer("generate", generation);
 	}
 
+	std::vector<std::vector<uint32_t>> denseChunks;
+	denseChunks.reserve(chunkCount);
+	{
+		size_t totalBytes = 0;
+		for (const VoxelChunkData &chunk : chunks)
+		{
+			std::vector<uint32_t> dense(CHUNK_BLOCK_COUNT);
+			chunk.copyBlocksTo(dense.data());
+			denseChunks.push_back(std::move(dense));
+			totalBytes += chunk.storedBlockBytes();
+		}
+		printSize("palette_memory_size", buildSizeResultWithRaw(totalBytes, chunkCount));
+	}
+
 	std::vector<std::vector<uint8_t>> sectionPayloads;
 	sectionPayloads.reserve(chunkCount);
 	{
@@ -620,10 +964,7 @@ int main(int argc, char **argv)
 						  << index << std::endl;
 				return 1;
 			}
-			if (std::memcmp(
-					decoded.chunk.blocks,
-					chunks[index].blocks,
-					sizeof(chunks[index].blocks)) != 0)
+			if (!decoded.chunk.sameBlocks(chunks[index]))
 			{
 				std::cerr << "Decoded section payload mismatch for chunk "
 						  << index << std::endl;
@@ -673,10 +1014,7 @@ int main(int argc, char **argv)
 						  << index << std::endl;
 				return 1;
 			}
-			if (std::memcmp(
-					decoded.chunk.blocks,
-					chunks[index].blocks,
-					sizeof(chunks[index].blocks)) != 0)
+			if (!decoded.chunk.sameBlocks(chunks[index]))
 			{
 				std::cerr << "Decoded RLE payload mismatch for chunk "
 						  << index << std::endl;
@@ -697,12 +1035,12 @@ int main(int argc, char **argv)
 	{
 		auto start = std::chrono::steady_clock::now();
 		size_t totalBytes = 0;
-		for (const VoxelChunkData &chunk : chunks)
+		for (const std::vector<uint32_t> &dense : denseChunks)
 		{
 			std::vector<uint8_t> payload;
 			if (!compressZstdPayload(
-					reinterpret_cast<const uint8_t *>(&chunk.blocks[0][0][0]),
-					sizeof(chunk.blocks),
+					reinterpret_cast<const uint8_t *>(dense.data()),
+					CHUNK_BLOCK_COUNT * sizeof(uint32_t),
 					BENCH_ZSTD_LEVEL,
 					payload))
 			{
@@ -729,7 +1067,7 @@ int main(int argc, char **argv)
 		{
 			size_t result = ZSTD_decompress(
 				scratch.data(),
-				sizeof(chunks[index].blocks),
+				CHUNK_BLOCK_COUNT * sizeof(uint32_t),
 				zstdRawPayloads[index].data(),
 				zstdRawPayloads[index].size());
 			if (ZSTD_isError(result))
@@ -737,11 +1075,11 @@ int main(int argc, char **argv)
 				std::cerr << "Failed to decode raw ZSTD chunk" << std::endl;
 				return 1;
 			}
-			if (result != sizeof(chunks[index].blocks) ||
+			if (result != CHUNK_BLOCK_COUNT * sizeof(uint32_t) ||
 				std::memcmp(
 					scratch.data(),
-					chunks[index].blocks,
-					sizeof(chunks[index].blocks)) != 0)
+					denseChunks[index].data(),
+					CHUNK_BLOCK_COUNT * sizeof(uint32_t)) != 0)
 			{
 				std::cerr << "Decoded raw ZSTD payload mismatch for chunk "
 						  << index << std::endl;
@@ -802,10 +1140,7 @@ int main(int argc, char **argv)
 						  << index << std::endl;
 				return 1;
 			}
-			if (std::memcmp(
-					decoded.chunk.blocks,
-					chunks[index].blocks,
-					sizeof(chunks[index].blocks)) != 0)
+			if (!decoded.chunk.sameBlocks(chunks[index]))
 			{
 				std::cerr << "Decoded ZSTD section payload mismatch for chunk "
 						  << index << std::endl;
@@ -821,6 +1156,28 @@ int main(int argc, char **argv)
 		printTimer("decode_zstd_sections_lvl3", decodeZstdSections);
 	}
 
+	{
+		size_t rawBytes = 0;
+		for (const std::vector<uint8_t> &sectionPayload : sectionPayloads)
+		{
+			rawBytes += sectionPayload.size();
+		}
+		// Deux passes: la première chauffe les caches et crée les contextes du thread.
+		CodecThroughput oneShot;
+		CodecThroughput codec;
+		for (int pass = 0; pass < 2; pass++)
+		{
+			if (!measureOneShotZstd(sectionPayloads, oneShot) ||
+				!measureCodecZstd(sectionPayloads, codec))
+			{
+				std::cerr << "ZSTD codec round trip failed" << std::endl;
+				return 1;
+			}
+		}
+		printCodecThroughput("zstd_oneshot_lvl3 (before)", oneShot, rawBytes);
+		printCodecThroughput("zstd_codec_lvl3 (after)", codec, rawBytes);
+	}
+
 	std::filesystem::path databasePath =
 		std::filesystem::temp_directory_path() / "voxplace_world_storage_bench.sqlite3";
 	std::filesystem::path databaseMissPath =
@@ -0,0 +1,909 @@
+#include <ChunkPalette.h>
+#include <ChunkStreamPlanner.h>
+#include <Frustum.h>
+#include <PlayerUsername.h>
+#include <VoxelChunkData.h>
+#include <WorldClient.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Des centaines de clients sans rendu dans un seul processus: chaque bot se connecte avec son
+// propre compte, suit une trajectoire, streame sa distance de rendu avec la même logique que
+// le client (ChunkStreamPlanner) et pose/casse des blocs. Mesure la latence de livraison des
+// chunks côté client, le débit reçu, et relaie les stats de tick envoyées par le serveur.
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	constexpr int BOT_TICK_MS = 50;
+	constexpr int MOVE_SYNC_INTERVAL_MS = 100;
+	constexpr int SERVICE_ROUNDS_PER_PASS = 8;
+	constexpr int REPORT_INTERVAL_SECONDS = 5;
+	constexpr int LOGIN_ATTEMPTS = 3;
+	constexpr int LOGIN_RETRY_DELAY_MS = 500;
+	constexpr size_t LOGIN_ERRORS_LOGGED = 5;
+	constexpr size_t DEFAULT_LOGIN_THREADS = 4;
+	constexpr size_t MAX_DEFAULT_SIM_THREADS = 8;
+
+	// Budgets du client (ClientLaunch) ramenés à l'échelle d'un bot: des centaines de
+	// bots à 192 requêtes en vol noieraient la mesure dans la file du serveur.
+	constexpr int BOT_STREAMING_PADDING_CHUNKS = 2;
+	constexpr size_t BOT_MAX_INFLIGHT_CHUNK_REQUESTS = 64;
+	constexpr size_t BOT_MAX_CHUNK_REQUESTS_PER_TICK = 16;
+
+	constexpr float BOT_FLIGHT_ALTITUDE = 80.0f;
+	constexpr float BOT_LOOK_PITCH_Y = -0.35f;
+	constexpr float BOT_FOV_DEGREES = 70.0f;
+	constexpr float BOT_ASPECT_RATIO = 16.0f / 9.0f;
+	constexpr float RANDOM_WALK_TURN_RATE = 1.5f;
+	constexpr int RANDOM_WALK_RADIUS_CHUNKS = 16;
+	constexpr int ORBIT_RADIUS_CHUNKS = 6;
+	constexpr int SPAWN_SPREAD_CHUNKS = 24;
+
+	std::atomic<bool> stopRequested = false;
+
+	void handleStopSignal(int)
+	{
+		stopRequested.store(true);
+	}
+
+	enum class FlightPath
+	{
+		RandomWalk,
+		Line,
+		Orbit,
+		Mixed
+	};
+
+	struct SwarmOptions
+	{
+		std::string host;
+		uint16_t port = 0;
+		size_t botCount = 0;
+		FlightPath path = FlightPath::Mixed;
+		int durationSeconds = 60;
+		int renderDistanceChunks = 8;
+		double editsPerMinute = 0.0;
+		float speed = 10.0f;
+		std::string usernamePrefix = "swarm";
+		std::string password = "swarm-pass";
+		size_t loginThreads = DEFAULT_LOGIN_THREADS;
+		size_t simThreads = 1;
+	};
+
+	struct Bot
+	{
+		size_t index = 0;
+		std::unique_ptr<WorldClient> client;
+		FlightPath path = FlightPath::RandomWalk;
+		std::mt19937 rng;
+		glm::vec3 origin = glm::vec3(0.0f);
+		glm::vec3 position = glm::vec3(0.0f);
+		glm::vec3 velocity = glm::vec3(0.0f);
+		glm::vec3 lookDirection = glm::vec3(0.0f, 0.0f, -1.0f);
+		float heading = 0.0f;
+		float orbitAngle = 0.0f;
+		bool connected = true;
+		bool hasWorldFrontier = false;
+		WorldFrontier frontier;
+		float serverTerrainGenMsAvg = 0.0f;
+		float serverSqliteLoadMsAvg = 0.0f;
+		// Chunks demandés et pas lâchés; ceux encore sans réponse, avec l'heure de la demande.
+		std::unordered_set<int64_t> streamedChunkKeys;
+		std::unordered_map<int64_t, Clock::time_point> pendingRequests;
+		Clock::time_point lastTickAt;
+		Clock::time_point lastMoveSyncAt;
+		Clock::time_point nextEditAt;
+		bool hasPlacedBlock = false;
+		int placedX = 0;
+		int placedY = 0;
+		int placedZ = 0;
+		uint64_t lastReceivedBytes = 0;
+	};
+
+	struct SwarmWindow
+	{
+		std::vector<uint32_t> chunkLatencyMicros;
+		uint64_t chunksReceived = 0;
+		uint64_t chunkRequests = 0;
+		uint64_t chunkDrops = 0;
+		uint64_t cancelledRequests = 0;
+		uint64_t receivedBytes = 0;
+		uint64_t editsSent = 0;
+		uint64_t editsThrottled = 0;
+		uint64_t blockUpdatesReceived = 0;
+		uint64_t disconnects = 0;
+
+		bool empty() const
+		{
+			return chunksReceived == 0 && chunkRequests == 0 && chunkDrops == 0 && receivedBytes == 0 &&
+				   editsSent == 0 && editsThrottled == 0 && blockUpdatesReceived == 0 && disconnects == 0;
+		}
+
+		void merge(SwarmWindow &other)
+		{
+			chunkLatencyMicros.insert(chunkLatencyMicros.end(), other.chunkLatencyMicros.begin(), other.chunkLatencyMicros.end());
+			chunksReceived += other.chunksReceived;
+			chunkRequests += other.chunkRequests;
+			chunkDrops += other.chunkDrops;
+			cancelledRequests += other.cancelledRequests;
+			receivedBytes += other.receivedBytes;
+			editsSent += other.editsSent;
+			editsThrottled += other.editsThrottled;
+			blockUpdatesReceived += other.blockUpdatesReceived;
+			disconnects += other.disconnects;
+			other = SwarmWindow{};
+		}
+	};
+
+	struct SwarmStats
+	{
+		std::mutex mutex;
+		SwarmWindow window;
+		bool hasServerProfile = false;
+		ServerProfileMessage serverProfile;
+		std::atomic<size_t> botsConnected = 0;
+		std::atomic<size_t> loginsFailed = 0;
+	};
+
+	// Bots connectés par les threads de login, en attente de leur thread de simulation.
+	struct SimulationInbox
+	{
+		std::mutex mutex;
+		std::vector<std::unique_ptr<Bot>> bots;
+	};
+
+	const char *flightPathName(FlightPath path)
+	{
+		switch (path)
+		{
+		case FlightPath::RandomWalk:
+			return "random";
+		case FlightPath::Line:
+			return "line";
+		case FlightPath::Orbit:
+			return "orbit";
+		case FlightPath::Mixed:
+			return "mixed";
+		}
+		return "unknown";
+	}
+
+	void printUsage(const char *programName)
+	{
+		std::cout << "Usage:" << std::endl;
+		std::cout
+			<< "  " << programName
+			<< " <host> <port> <bot_count> [path=mixed] [duration_s=60] [render_distance=8]"
+			<< " [edits_per_min=0] [speed=10]"
+			<< std::endl;
+		std::cout << "Paths: random, line, orbit, mixed (one third each)." << std::endl;
+		std::cout << "Environment: VOXPLACE_SWARM_PREFIX (swarm), VOXPLACE_SWARM_PASSWORD (swarm-pass),"
+				  << " VOXPLACE_SWARM_LOGIN_THREADS (4), VOXPLACE_SWARM_SIM_THREADS (cores, max 8)." << std::endl;
+		std::cout << "Example (200 bots for 2 minutes, one edit every 10 s each):" << std::endl;
+		std::cout << "  " << programName << " 127.0.0.1 28713 200 mixed 120 8 6" << std::endl;
+	}
+
+	bool parseUnsigned(const char *raw, unsigned long maxValue, unsigned long &value)
+	{
+		if (raw == nullptr || raw[0] == '\0')
+		{
+			return false;
+		}
+		char *end = nullptr;
+		unsigned long parsed = std::strtoul(raw, &end, 10);
+		if (end == raw || end == nullptr || *end != '\0' || parsed > maxValue)
+		{
+			return false;
+		}
+		value = parsed;
+		return true;
+	}
+
+	bool parseDouble(const char *raw, double &value)
+	{
+		if (raw == nullptr || raw[0] == '\0')
+		{
+			return false;
+		}
+		char *end = nullptr;
+		double parsed = std::strtod(raw, &end);
+		if (end == raw || end == nullptr || *end != '\0' || !std::isfinite(parsed))
+		{
+			return false;
+		}
+		value = parsed;
+		return true;
+	}
+
+	bool parseFlightPath(const std::string &raw, FlightPath &path)
+	{
+		if (raw == "random")
+		{
+			path = FlightPath::RandomWalk;
+			return true;
+		}
+		if (raw == "line")
+		{
+			path = FlightPath::Line;
+			return true;
+		}
+		if (raw == "orbit")
+		{
+			path = FlightPath::Orbit;
+			return true;
+		}
+		if (raw == "mixed")
+		{
+			path = FlightPath::Mixed;
+			return true;
+		}
+		return false;
+	}
+
+	std::string botUsername(const SwarmOptions &options, size_t index)
+	{
+		return options.usernamePrefix + std::to_string(index);
+	}
+
+	bool parseOptions(int argc, char **argv, SwarmOptions &options)
+	{
+		if (argc < 4 || argc > 9)
+		{
+			printUsage(argv[0]);
+			return false;
+		}
+
+		unsigned long value = 0;
+		options.host = argv[1];
+		if (!parseUnsigned(argv[2], 65535, value) || value == 0)
+		{
+			std::cerr << "Invalid port: " << argv[2] << std::endl;
+			return false;
+		}
+		options.port = static_cast<uint16_t>(value);
+		if (!parseUnsigned(argv[3], 100000, value) || value == 0)
+		{
+			std::cerr << "Invalid bot_count: " << argv[3] << std::endl;
+			return false;
+		}
+		options.botCount = static_cast<size_t>(value);
+
+		if (argc >= 5 && !parseFlightPath(argv[4], options.path))
+		{
+			std::cerr << "Invalid path: " << argv[4] << std::endl;
+			return false;
+		}
+		if (argc >= 6)
+		{
+			if (!parseUnsigned(argv[5], 86400, value) || value == 0)
+			{
+				std::cerr << "Invalid duration_s: " << argv[5] << std::endl;
+				return false;
+			}
+			options.durationSeconds = static_cast<int>(value);
+		}
+		if (argc >= 7)
+		{
+			if (!parseUnsigned(argv[6], 64, value) || value == 0)
+			{
+				std::cerr << "Invalid render_distance: " << argv[6] << std::endl;
+				return false;
+			}
+			options.renderDistanceChunks = static_cast<int>(value);
+		}
+		if (argc >= 8 && (!parseDouble(argv[7], options.editsPerMinute) || options.editsPerMinute < 0.0))
+		{
+			std::cerr << "Invalid edits_per_min: " << argv[7] << std::endl;
+			return false;
+		}
+		double speed = options.speed;
+		if (argc >= 9 && (!parseDouble(argv[8], speed) || speed < 0.0))
+		{
+			std::cerr << "Invalid speed: " << argv[8] << std::endl;
+			return false;
+		}
+		options.speed = static_cast<float>(speed);
+
+		if (const char *prefix = std::getenv("VOXPLACE_SWARM_PREFIX"))
+		{
+			options.usernamePrefix = prefix;
+		}
+		if (const char *password = std::getenv("VOXPLACE_SWARM_PASSWORD"))
+		{
+			options.password = password;
+		}
+		PlayerUsernameValidationError usernameError =
+			validatePlayerUsername(botUsername(options, options.botCount - 1));
+		if (usernameError == PlayerUsernameValidationError::None)
+		{
+			usernameError = validatePlayerUsername(botUsername(options, 0));
+		}
+		if (usernameError != PlayerUsernameValidationError::None)
+		{
+			std::cerr << "Invalid VOXPLACE_SWARM_PREFIX: " << playerUsernameValidationErrorText(usernameError) << std::endl;
+			return false;
+		}
+		if (options.password.empty())
+		{
+			std::cerr << "VOXPLACE_SWARM_PASSWORD must not be empty" << std::endl;
+			return false;
+		}
+
+		unsigned int cores = std::thread::hardware_concurrency();
+		options.simThreads = std::clamp<size_t>(cores, 1, MAX_DEFAULT_SIM_THREADS);
+		if (const char *raw = std::getenv("VOXPLACE_SWARM_SIM_THREADS"))
+		{
+			if (!parseUnsigned(raw, 256, value) || value == 0)
+			{
+				std::cerr << "Invalid VOXPLACE_SWARM_SIM_THREADS: " << raw << std::endl;
+				return false;
+			}
+			options.simThreads = static_cast<size_t>(value);
+		}
+		if (const char *raw = std::getenv("VOXPLACE_SWARM_LOGIN_THREADS"))
+		{
+			if (!parseUnsigned(raw, 256, value) || value == 0)
+			{
+				std::cerr << "Invalid VOXPLACE_SWARM_LOGIN_THREADS: " << raw << std::endl;
+				return false;
+			}
+			options.loginThreads = static_cast<size_t>(value);
+		}
+		options.simThreads = std::min(options.simThreads, options.botCount);
+		options.loginThreads = std::min(options.loginThreads, options.botCount);
+		return true;
+	}
+
+	float secondsBetween(Clock::time_point from, Clock::time_point to)
+	{
+		return std::chrono::duration<float>(to - from).count();
+	}
+
+	Clock::time_point scheduleNextEdit(Bot &bot, const SwarmOptions &options, Clock::time_point now)
+	{
+		// Poisson: les bots ne s'alignent pas sur la même milliseconde.
+		std::exponential_distribution<double> interval(options.editsPerMinute / 60.0);
+		return now + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(interval(bot.rng)));
+	}
+
+	std::unique_ptr<Bot> makeBot(size_t index, std::unique_ptr<WorldClient> client, const SwarmOptions &options)
+	{
+		std::unique_ptr<Bot> bot = std::make_unique<Bot>();
+		bot->index = index;
+		bot->rng.seed(static_cast<uint32_t>(index * 2654435761u + 1));
+		bot->path = options.path;
+		if (bot->path == FlightPath::Mixed)
+		{
+			const FlightPath paths[] = {FlightPath::RandomWalk, FlightPath::Line, FlightPath::Orbit};
+			bot->path = paths[index % std::size(paths)];
+		}
+
+		std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+		float spreadBlocks = static_cast<float>(SPAWN_SPREAD_CHUNKS * CHUNK_SIZE_X) * std::sqrt(unit(bot->rng));
+		float spreadAngle = angle(bot->rng);
+		glm::vec3 spawn = client->localPlayer().state.position;
+		bot->origin = glm::vec3(
+			spawn.x + std::cos(spreadAngle) * spreadBlocks,
+			BOT_FLIGHT_ALTITUDE,
+			spawn.z + std::sin(spreadAngle) * spreadBlocks);
+		bot->heading = angle(bot->rng);
+		bot->orbitAngle = angle(bot->rng);
+		bot->position = bot->origin;
+		if (bot->path == FlightPath::Orbit)
+		{
+			float radius = static_cast<float>(ORBIT_RADIUS_CHUNKS * CHUNK_SIZE_X);
+			bot->position += glm::vec3(std::cos(bot->orbitAngle) * radius, 0.0f, std::sin(bot->orbitAngle) * radius);
+		}
+
+		Clock::time_point now = Clock::now();
+		bot->lastTickAt = now;
+		bot->lastMoveSyncAt = Clock::time_point{};
+		bot->nextEditAt = now;
+		if (options.editsPerMinute > 0.0)
+		{
+			bot->nextEditAt = scheduleNextEdit(*bot, options, now);
+		}
+		bot->client = std::move(client);
+		return bot;
+	}
+
+	void advanceFlight(Bot &bot, float speed, float deltaTime)
+	{
+		glm::vec3 next = bot.position;
+		switch (bot.path)
+		{
+		case FlightPath::RandomWalk:
+		{
+			std::uniform_real_distribution<float> turn(-RANDOM_WALK_TURN_RATE, RANDOM_WALK_TURN_RATE);
+			bot.heading += turn(bot.rng) * deltaTime;
+			// Demi-tour vers l'origine une fois sorti de la zone, pour ne pas dériver à l'infini.
+			float offsetX = bot.position.x - bot.origin.x;
+			float offsetZ = bot.position.z - bot.origin.z;
+			float radius = static_cast<float>(RANDOM_WALK_RADIUS_CHUNKS * CHUNK_SIZE_X);
+			if (offsetX * offsetX + offsetZ * offsetZ > radius * radius)
+			{
+				bot.heading = std::atan2(-offsetZ, -offsetX);
+			}
+			next += glm::vec3(std::cos(bot.heading), 0.0f, std::sin(bot.heading)) * speed * deltaTime;
+			break;
+		}
+		case FlightPath::Line:
+			next += glm::vec3(std::cos(bot.heading), 0.0f, std::sin(bot.heading)) * speed * deltaTime;
+			break;
+		case FlightPath::Orbit:
+		{
+			float radius = static_cast<float>(ORBIT_RADIUS_CHUNKS * CHUNK_SIZE_X);
+			bot.orbitAngle += speed / radius * deltaTime;
+			next = bot.origin + glm::vec3(std::cos(bot.orbitAngle) * radius, 0.0f, std::sin(bot.orbitAngle) * radius);
+			break;
+		}
+		case FlightPath::Mixed:
+			break;
+		}
+
+		if (deltaTime > 0.0f)
+		{
+			bot.velocity = (next - bot.position) / deltaTime;
+		}
+		bot.position = next;
+		glm::vec2 horizontal(bot.velocity.x, bot.velocity.z);
+		if (glm::length(horizontal) > 0.001f)
+		{
+			horizontal = glm::normalize(horizontal);
+			bot.lookDirection = glm::normalize(glm::vec3(horizontal.x, BOT_LOOK_PITCH_Y, horizontal.y));
+		}
+	}
+
+	Frustum botFrustum(const Bot &bot, int streamDistanceChunks)
+	{
+		float farPlane = static_cast<float>((streamDistanceChunks + 1) * CHUNK_SIZE_X);
+		glm::mat4 projection = glm::perspective(glm::radians(BOT_FOV_DEGREES), BOT_ASPECT_RATIO, 0.1f, farPlane);
+		glm::mat4 view = glm::lookAt(bot.position, bot.position + bot.lookDirection, glm::vec3(0.0f, 1.0f, 0.0f));
+		Frustum frustum;
+		frustum.extractFromVP(projection * view);
+		return frustum;
+	}
+
+	void handleBotEvent(Bot &bot, const WorldClientEvent &event, SwarmWindow &window, SwarmStats &stats)
+	{
+		switch (event.type)
+		{
+		case WorldClientEvent::Type::Disconnected:
+			bot.connected = false;
+			window.disconnects++;
+			break;
+		case WorldClientEvent::Type::FrontierUpdated:
+			bot.hasWorldFrontier = true;
+			bot.frontier = event.frontier;
+			break;
+		case WorldClientEvent::Type::ChunkReceived:
+		{
+			window.chunksReceived++;
+			auto pendingIt = bot.pendingRequests.find(chunkKey(event.chunk.chunkX, event.chunk.chunkZ));
+			if (pendingIt == bot.pendingRequests.end())
+			{
+				break;
+			}
+			window.chunkLatencyMicros.push_back(static_cast<uint32_t>(std::min<int64_t>(
+				std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - pendingIt->second).count(),
+				UINT32_MAX)));
+			bot.pendingRequests.erase(pendingIt);
+			break;
+		}
+		case WorldClientEvent::Type::ChunkDeltaReceived:
+		case WorldClientEvent::Type::BlockUpdated:
+		case WorldClientEvent::Type::BlockBatchUpdated:
+			window.blockUpdatesReceived++;
+			break;
+		case WorldClientEvent::Type::ServerProfileUpdated:
+		{
+			bot.serverTerrainGenMsAvg = event.serverProfile.terrainGenChunkMsAvg;
+			bot.serverSqliteLoadMsAvg = event.serverProfile.sqliteLoadChunkMsAvg;
+			std::lock_guard<std::mutex> lock(stats.mutex);
+			stats.hasServerProfile = true;
+			stats.serverProfile = event.serverProfile;
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	bool serviceBot(Bot &bot, WorldClientEvent &event, SwarmWindow &window, SwarmStats &stats)
+	{
+		bool hadEvent = false;
+		for (int round = 0; round < SERVICE_ROUNDS_PER_PASS && bot.connected; round++)
+		{
+			bot.client->service();
+			bool roundHadEvent = false;
+			while (bot.client->popEvent(event))
+			{
+				roundHadEvent = true;
+				handleBotEvent(bot, event, window, stats);
+			}
+			if (!roundHadEvent)
+			{
+				break;
+			}
+			hadEvent = true;
+		}
+
+		uint64_t receivedBytes = bot.client->receivedPayloadBytes();
+		window.receivedBytes += receivedBytes - bot.lastReceivedBytes;
+		bot.lastReceivedBytes = receivedBytes;
+		return hadEvent;
+	}
+
+	void tryBlockEdit(Bot &bot, SwarmWindow &window)
+	{
+		if (bot.client->remainingBlockActionCooldownMs() > 0)
+		{
+			window.editsThrottled++;
+			return;
+		}
+
+		// Pose puis casse au même endroit: le monde revient à son état une fois la paire jouée.
+		if (bot.hasPlacedBlock)
+		{
+			bot.client->sendBreakBlock(bot.placedX, bot.placedY, bot.placedZ);
+			bot.hasPlacedBlock = false;
+			window.editsSent++;
+			return;
+		}
+
+		int chunkX = floorDiv(static_cast<int>(std::floor(bot.position.x)), CHUNK_SIZE_X);
+		int chunkZ = floorDiv(static_cast<int>(std::floor(bot.position.z)), CHUNK_SIZE_Z);
+		int64_t key = chunkKey(chunkX, chunkZ);
+		if (bot.streamedChunkKeys.find(key) == bot.streamedChunkKeys.end() ||
+			bot.pendingRequests.find(key) != bot.pendingRequests.end())
+		{
+			return;
+		}
+
+		std::uniform_int_distribution<int> local(0, CHUNK_SIZE_X - 1);
+		std::uniform_int_distribution<int> height(CHUNK_SIZE_Y / 2, CHUNK_SIZE_Y - 1);
+		std::uniform_int_distribution<int> color(0, static_cast<int>(PLAYER_COLOR_PALETTE_SIZE) - 1);
+		bot.placedX = chunkX * CHUNK_SIZE_X + local(bot.rng);
+		bot.placedY = height(bot.rng);
+		bot.placedZ = chunkZ * CHUNK_SIZE_Z + local(bot.rng);
+		bot.client->sendPlaceBlock(bot.placedX, bot.placedY, bot.placedZ, static_cast<uint8_t>(color(bot.rng)));
+		bot.hasPlacedBlock = true;
+		window.editsSent++;
+	}
+
+	void tickBot(Bot &bot, const SwarmOptions &options, Clock::time_point now, ChunkStreamPlan &plan, SwarmWindow &window)
+	{
+		float deltaTime = secondsBetween(bot.lastTickAt, now);
+		bot.lastTickAt = now;
+		advanceFlight(bot, options.speed, deltaTime);
+
+		if (now - bot.lastMoveSyncAt >= std::chrono::milliseconds(MOVE_SYNC_INTERVAL_MS))
+		{
+			bot.client->sendPlayerMoveUpdate(bot.position, bot.lookDirection);
+			bot.lastMoveSyncAt = now;
+		}
+
+		ChunkStreamPlanInput input;
+		input.position = bot.position;
+		input.velocity = bot.velocity;
+		input.roundTripTimeMs = bot.client->getRoundTripTime();
+		input.serverTerrainGenMsAvg = bot.serverTerrainGenMsAvg;
+		input.serverSqliteLoadMsAvg = bot.serverSqliteLoadMsAvg;
+		input.deltaTime = deltaTime;
+		input.hasWorldFrontier = bot.hasWorldFrontier;
+		input.frontier = bot.frontier;
+		input.renderDistanceChunks = options.renderDistanceChunks;
+		input.classicStreamingPaddingChunks = BOT_STREAMING_PADDING_CHUNKS;
+		input.classicMaxInflightChunkRequests = BOT_MAX_INFLIGHT_CHUNK_REQUESTS;
+		input.classicMaxChunkRequestsPerFrame = BOT_MAX_CHUNK_REQUESTS_PER_TICK;
+		ChunkStreamPlanner::plan(
+			input,
+			botFrustum(bot, options.renderDistanceChunks + BOT_STREAMING_PADDING_CHUNKS),
+			bot.streamedChunkKeys,
+			bot.pendingRequests.size(),
+			plan);
+
+		for (const ChunkCoord &coord : plan.requests)
+		{
+			int64_t key = chunkKey(coord);
+			bot.client->sendChunkRequest(coord.x, coord.z);
+			bot.streamedChunkKeys.insert(key);
+			bot.pendingRequests[key] = now;
+			window.chunkRequests++;
+		}
+		for (int64_t key : plan.drops)
+		{
+			bot.client->sendChunkDrop(static_cast<int>(key >> 32), static_cast<int>(key & 0xFFFFFFFF));
+			bot.streamedChunkKeys.erase(key);
+			if (bot.pendingRequests.erase(key) > 0)
+			{
+				window.cancelledRequests++;
+			}
+			window.chunkDrops++;
+		}
+
+		if (options.editsPerMinute > 0.0 && now >= bot.nextEditAt)
+		{
+			tryBlockEdit(bot, window);
+			bot.nextEditAt = scheduleNextEdit(bot, options, now);
+		}
+	}
+
+	void runSimulationThread(const SwarmOptions &options,
+							 SimulationInbox &inbox,
+							 SwarmStats &stats,
+							 const std::atomic<bool> &simulationStop)
+	{
+		std::vector<std::unique_ptr<Bot>> bots;
+		WorldClientEvent event;
+		ChunkStreamPlan plan;
+		SwarmWindow window;
+		while (!simulationStop.load())
+		{
+			{
+				std::lock_guard<std::mutex> lock(inbox.mutex);
+				for (std::unique_ptr<Bot> &bot : inbox.bots)
+				{
+					bots.push_back(std::move(bot));
+				}
+				inbox.bots.clear();
+			}
+
+			bool hadEvent = false;
+			for (std::unique_ptr<Bot> &bot : bots)
+			{
+				if (!bot->connected)
+				{
+					continue;
+				}
+				hadEvent = serviceBot(*bot, event, window, stats) || hadEvent;
+				Clock::time_point now = Clock::now();
+				if (bot->connected && now - bot->lastTickAt >= std::chrono::milliseconds(BOT_TICK_MS))
+				{
+					tickBot(*bot, options, now, plan, window);
+				}
+			}
+
+			if (!window.empty())
+			{
+				std::lock_guard<std::mutex> lock(stats.mutex);
+				stats.window.merge(window);
+			}
+			if (!hadEvent)
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+		}
+
+		for (std::unique_ptr<Bot> &bot : bots)
+		{
+			bot->client->disconnect();
+		}
+	}
+
+	void runLoginThread(const SwarmOptions &options,
+						std::atomic<size_t> &nextBotIndex,
+						std::vector<SimulationInbox> &inboxes,
+						SwarmStats &stats,
+						std::mutex &logMutex)
+	{
+		while (!stopRequested.load())
+		{
+			size_t index = nextBotIndex.fetch_add(1);
+			if (index >= options.botCount)
+			{
+				return;
+			}
+
+			std::string username = botUsername(options, index);
+			std::unique_ptr<WorldClient> client;
+			for (int attempt = 0; attempt < LOGIN_ATTEMPTS && !stopRequested.load(); attempt++)
+			{
+				// Nouveau client à chaque essai: un échec peut laisser l'hôte ENet dans un état quelconque.
+				std::unique_ptr<WorldClient> candidate = std::make_unique<WorldClient>();
+				if (candidate->connectToServer(options.host, options.port, username, options.password))
+				{
+					client = std::move(candidate);
+					break;
+				}
+				if (attempt + 1 == LOGIN_ATTEMPTS)
+				{
+					size_t failedCount = stats.loginsFailed.fetch_add(1);
+					if (failedCount < LOGIN_ERRORS_LOGGED)
+					{
+						std::lock_guard<std::mutex> lock(logMutex);
+						std::cerr << "[swarm] login failed for " << username << ": "
+								  << candidate->lastConnectionError() << std::endl;
+					}
+					break;
+				}
+				std::this_thread::sleep_for(std::chrono::milliseconds(LOGIN_RETRY_DELAY_MS));
+			}
+			if (client == nullptr)
+			{
+				continue;
+			}
+
+			SimulationInbox &inbox = inboxes[index % inboxes.size()];
+			{
+				std::lock_guard<std::mutex> lock(inbox.mutex);
+				inbox.bots.push_back(makeBot(index, std::move(client), options));
+			}
+			stats.botsConnected.fetch_add(1);
+		}
+	}
+
+	double latencyPercentileMs(const std::vector<uint32_t> &sorted, double quantile)
+	{
+		if (sorted.empty())
+		{
+			return 0.0;
+		}
+		size_t rank = static_cast<size_t>(std::ceil(quantile * static_cast<double>(sorted.size())));
+		rank = std::clamp<size_t>(rank, 1, sorted.size());
+		return static_cast<double>(sorted[rank - 1]) / 1000.0;
+	}
+
+	void printReport(std::ostream &out,
+					 const char *label,
+					 double elapsedSeconds,
+					 double windowSeconds,
+					 SwarmWindow &window,
+					 const SwarmStats &stats,
+					 const SwarmOptions &options)
+	{
+		std::sort(window.chunkLatencyMicros.begin(), window.chunkLatencyMicros.end());
+		double bytesPerSecond = 0.0;
+		double chunksPerSecond = 0.0;
+		if (windowSeconds > 0.0)
+		{
+			bytesPerSecond = static_cast<double>(window.receivedBytes) / windowSeconds;
+			chunksPerSecond = static_cast<double>(window.chunksReceived) / windowSeconds;
+		}
+
+		out << label << " t=" << elapsedSeconds << "s"
+			<< " bots=" << stats.botsConnected.load() << "/" << options.botCount
+			<< " login_failed=" << stats.loginsFailed.load()
+			<< " disconnects=" << window.disconnects
+			<< " chunks=" << window.chunksReceived
+			<< " chunks_per_sec=" << chunksPerSecond
+			<< " kib_per_sec=" << bytesPerSecond / 1024.0
+			<< " requests=" << window.chunkRequests
+			<< " drops=" << window.chunkDrops
+			<< " cancelled=" << window.cancelledRequests
+			<< " latency_ms_p50=" << latencyPercentileMs(window.chunkLatencyMicros, 0.50)
+			<< " p90=" << latencyPercentileMs(window.chunkLatencyMicros, 0.90)
+			<< " p99=" << latencyPercentileMs(window.chunkLatencyMicros, 0.99)
+			<< " max=" << latencyPercentileMs(window.chunkLatencyMicros, 1.0)
+			<< " edits=" << window.editsSent
+			<< " edits_throttled=" << window.editsThrottled
+			<< " block_updates=" << window.blockUpdatesReceived;
+		if (stats.hasServerProfile)
+		{
+			const ServerProfileMessage &profile = stats.serverProfile;
+			out << " | server tps=" << profile.ticksPerSecond
+				<< " clients=" << profile.clientCount
+				<< " world_chunks=" << profile.worldChunkCount
+				<< " tasks=" << profile.tasksNow
+				<< " ready=" << profile.readyNow
+				<< " send_queue=" << profile.sendQueueNow
+				<< " dirty=" << profile.dirtyQueueNow
+				<< " generated=" << profile.generatedFreshWindow
+				<< " loaded=" << profile.loadedWindow
+				<< " gen_ms_avg=" << profile.terrainGenChunkMsAvg
+				<< " gen_ms_max=" << profile.terrainGenChunkMsMax
+				<< " load_ms_avg=" << profile.sqliteLoadChunkMsAvg
+				<< " saved=" << profile.savedChunksWindow;
+		}
+		out << std::endl;
+	}
+}
+
+int main(int argc, char **argv)
+{
+	SwarmOptions options;
+	if (!parseOptions(argc, argv, options))
+	{
+		return 1;
+	}
+	std::signal(SIGINT, handleStopSignal);
+	std::signal(SIGTERM, handleStopSignal);
+
+	std::cout << "Starting bot swarm against " << options.host << ":" << options.port
+			  << " bots=" << options.botCount
+			  << " path=" << flightPathName(options.path)
+			  << " duration_s=" << options.durationSeconds
+			  << " render_distance=" << options.renderDistanceChunks
+			  << " edits_per_min=" << options.editsPerMinute
+			  << " speed=" << options.speed
+			  << " sim_threads=" << options.simThreads
+			  << " login_threads=" << options.loginThreads
+			  << std::endl;
+
+	SwarmStats stats;
+	std::mutex logMutex;
+	std::atomic<bool> simulationStop = false;
+	std::atomic<size_t> nextBotIndex = 0;
+	std::vector<SimulationInbox> inboxes(options.simThreads);
+
+	std::vector<std::thread> simulationThreads;
+	for (SimulationInbox &inbox : inboxes)
+	{
+		simulationThreads.emplace_back(runSimulationThread, std::cref(options), std::ref(inbox), std::ref(stats),
+									   std::cref(simulationStop));
+	}
+	std::vector<std::thread> loginThreads;
+	for (size_t threadIndex = 0; threadIndex < options.loginThreads; threadIndex++)
+	{
+		loginThreads.emplace_back(runLoginThread, std::cref(options), std::ref(nextBotIndex), std::ref(inboxes),
+								  std::ref(stats), std::ref(logMutex));
+	}
+
+	Clock::time_point startTime = Clock::now();
+	Clock::time_point endTime = startTime + std::chrono::seconds(options.durationSeconds);
+	Clock::time_point lastReportAt = startTime;
+	SwarmWindow total;
+	while (!stopRequested.load())
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		Clock::time_point now = Clock::now();
+		bool finished = now >= endTime;
+		if (!finished && now - lastReportAt < std::chrono::seconds(REPORT_INTERVAL_SECONDS))
+		{
+			continue;
+		}
+
+		SwarmWindow window;
+		{
+			std::lock_guard<std::mutex> lock(stats.mutex);
+			window.merge(stats.window);
+			std::lock_guard<std::mutex> logLock(logMutex);
+			printReport(std::cout, "[swarm]", secondsBetween(startTime, now), secondsBetween(lastReportAt, now),
+						window, stats, options);
+		}
+		total.merge(window);
+		lastReportAt = now;
+		if (finished)
+		{
+			break;
+		}
+	}
+
+	stopRequested.store(true);
+	for (std::thread &thread : loginThreads)
+	{
+		thread.join();
+	}
+	simulationStop.store(true);
+	for (std::thread &thread : simulationThreads)
+	{
+		thread.join();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(stats.mutex);
+		total.merge(stats.window);
+	}
+	printReport(std::cout, "Swarm complete:", secondsBetween(startTime, Clock::now()),
+				secondsBetween(startTime, Clock::now()), total, stats, options);
+	return 0;
+}
@@ -0,0 +1,804 @@
+#include <ShardLayout.h>
+#include <WorldProtocol.h>
+
+#include <enet/enet.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Passerelle devant un monde shardé: termine les connexions ENet des clients et ouvre, pour
+// chacun, une connexion par shard (VoxPlaceServer --shard i/n). Les chunks et les actions de
+// bloc vont au shard propriétaire de la région; login, mouvements et Hello vont à tous;
+// chat et commandes au primaire (shard 0). La frontière du primaire est relayée aux autres,
+// sur un lien de contrôle authentifié par VOXPLACE_SHARD_TOKEN.
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	constexpr size_t GATEWAY_CHANNEL_COUNT = 2;
+	// ENET_PROTOCOL_MAXIMUM_PEER_ID, partagé entre toutes les connexions amont.
+	constexpr size_t GATEWAY_MAX_UPSTREAM_PEERS = 4095;
+	constexpr size_t GATEWAY_MAX_CLIENTS = 1024;
+	constexpr uint32_t MAX_SERVICE_WAIT_MS = 5;
+	constexpr int STATS_INTERVAL_SECONDS = 5;
+	constexpr int CONTROL_RECONNECT_SECONDS = 1;
+
+	std::atomic<bool> stopRequested = false;
+
+	void handleStopSignal(int)
+	{
+		stopRequested.store(true);
+	}
+
+	struct GatewayOptions
+	{
+		uint16_t listenPort = 0;
+		std::vector<ENetAddress> shards;
+		std::string shardToken;
+	};
+
+	struct QueuedPacket
+	{
+		uint8_t channel = 0;
+		ENetPacket *packet = nullptr;
+	};
+
+	struct GatewayClient
+	{
+		ENetPeer *downstream = nullptr;
+		// Indexé par shard; nullptr une fois la connexion perdue.
+		std::vector<ENetPeer *> upstream;
+		size_t connectedUpstreamCount = 0;
+		// Paquets du client arrivés avant que tous les shards aient accepté la connexion.
+		std::deque<QueuedPacket> pendingUpstream;
+
+		// Tant que tous les shards n'ont pas accepté le login, rien ne descend au client.
+		bool loginPending = false;
+		std::vector<bool> loginAccepted;
+		std::deque<QueuedPacket> heldDownstream;
+
+		// Cooldown de bloc du dernier PlayerState reçu: chaque shard ne voit que ses propres actions.
+		uint64_t blockActionReadyAtMs = 0;
+		uint16_t blockActionShard = 0;
+		std::vector<uint8_t> lastPlayerState;
+	};
+
+	struct ControlLink
+	{
+		ENetPeer *peer = nullptr;
+		bool connected = false;
+	};
+
+	struct GatewayStats
+	{
+		uint64_t clientsAccepted = 0;
+		uint64_t clientsClosedByShard = 0;
+		uint64_t loginsRejected = 0;
+		uint64_t packetsUp = 0;
+		uint64_t bytesUp = 0;
+		uint64_t packetsDown = 0;
+		uint64_t bytesDown = 0;
+		uint64_t packetsFiltered = 0;
+		uint64_t crossShardEditsRejected = 0;
+		uint64_t frontierRelays = 0;
+		std::vector<uint64_t> packetsUpByShard;
+	};
+
+	struct Gateway
+	{
+		ShardLayout layout;
+		std::vector<ENetAddress> shardAddresses;
+		ENetHost *downstreamHost = nullptr;
+		ENetHost *upstreamHost = nullptr;
+		// unordered_map: les adresses restent stables, peer->data pointe dessus.
+		std::unordered_map<ENetPeer *, GatewayClient> clients;
+		std::vector<ControlLink> controls;
+		Clock::time_point lastControlAttemptAt{};
+		std::string shardToken;
+		// Dernière WorldFrontier du primaire, telle que reçue, et sa ShardFrontierSync signée.
+		std::vector<uint8_t> primaryFrontier;
+		std::vector<uint8_t> frontierSync;
+		GatewayStats stats;
+	};
+
+	void printUsage(const char *programName)
+	{
+		std::cout << "Usage:" << std::endl;
+		std::cout << "  " << programName << " <listen_port> <shard_host:port>..." << std::endl;
+		std::cout << SHARD_TOKEN_ENV << " (" << SHARD_TOKEN_MIN_LENGTH << "-" << SHARD_TOKEN_MAX_LENGTH
+				  << " characters) must be set to the same value for the gateway and every shard." << std::endl;
+		std::cout << "Shards are listed in index order: the first one must run with --shard 0/<n>, the next with"
+				  << " --shard 1/<n>, and so on. Each shard needs its own --world-db and --db." << std::endl;
+		std::cout << "Example (two shards on one machine, with " << SHARD_TOKEN_ENV << " exported):" << std::endl;
+		std::cout << "  VoxPlaceServer --shard 0/2 --port 28801 --world-db shard0.sqlite3 --db players0.sqlite3" << std::endl;
+		std::cout << "  VoxPlaceServer --shard 1/2 --port 28802 --world-db shard1.sqlite3 --db players1.sqlite3" << std::endl;
+		std::cout << "  " << programName << " 28713 127.0.0.1:28801 127.0.0.1:28802" << std::endl;
+	}
+
+	bool parsePort(const char *raw, uint16_t &port)
+	{
+		char *end = nullptr;
+		unsigned long parsed = std::strtoul(raw, &end, 10);
+		if (end == raw || *end != '\0' || parsed == 0 || parsed > 65535)
+		{
+			return false;
+		}
+		port = static_cast<uint16_t>(parsed);
+		return true;
+	}
+
+	bool parseOptions(int argc, char **argv, GatewayOptions &options)
+	{
+		if (argc < 3)
+		{
+			printUsage(argv[0]);
+			return false;
+		}
+		if (!parsePort(argv[1], options.listenPort))
+		{
+			std::cerr << "Invalid port: " << argv[1] << std::endl;
+			return false;
+		}
+		const char *shardToken = std::getenv(SHARD_TOKEN_ENV);
+		if (shardToken == nullptr || std::strlen(shardToken) < SHARD_TOKEN_MIN_LENGTH ||
+			std::strlen(shardToken) > SHARD_TOKEN_MAX_LENGTH)
+		{
+			std::cerr << SHARD_TOKEN_ENV << " must hold " << SHARD_TOKEN_MIN_LENGTH << "-"
+					  << SHARD_TOKEN_MAX_LENGTH << " characters" << std::endl;
+			return false;
+		}
+		options.shardToken = shardToken;
+		if (static_cast<size_t>(argc - 2) > MAX_SHARD_COUNT)
+		{
+			std::cerr << "At most " << MAX_SHARD_COUNT << " shards are supported" << std::endl;
+			return false;
+		}
+
+		for (int argumentIndex = 2; argumentIndex < argc; argumentIndex++)
+		{
+			std::string endpoint = argv[argumentIndex];
+			size_t separator = endpoint.rfind(':');
+			if (separator == std::string::npos || separator == 0)
+			{
+				std::cerr << "Invalid shard endpoint (expected host:port): " << endpoint << std::endl;
+				return false;
+			}
+			ENetAddress address{};
+			std::string host = endpoint.substr(0, separator);
+			std::string port = endpoint.substr(separator + 1);
+			if (!parsePort(port.c_str(), address.port))
+			{
+				std::cerr << "Invalid shard port: " << endpoint << std::endl;
+				return false;
+			}
+			if (enet_address_set_host(&address, host.c_str()) != 0)
+			{
+				std::cerr << "Failed to resolve shard host: " << host << std::endl;
+				return false;
+			}
+			options.shards.push_back(address);
+		}
+		return true;
+	}
+
+	bool isRegionPayload(PacketType type)
+	{
+		switch (type)
+		{
+		case PacketType::ChunkSnapshot:
+		case PacketType::ChunkSnapshotRle:
+		case PacketType::ChunkSnapshotSections:
+		case PacketType::ChunkSnapshotSectionsZstd:
+		case PacketType::ChunkSnapshotSectionFrames:
+		case PacketType::ChunkSectionDelta:
+		case PacketType::ChunkZstdDictionary:
+		case PacketType::ChunkDrop:
+		case PacketType::BlockUpdateBroadcast:
+		case PacketType::BlockUpdateBatch:
+		case PacketType::PlayerState:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	void releaseIfUnsent(ENetPacket *packet)
+	{
+		if (packet->referenceCount == 0)
+		{
+			enet_packet_destroy(packet);
+		}
+	}
+
+	void sendCopy(ENetPeer *peer, const std::vector<uint8_t> &payload)
+	{
+		ENetPacket *packet = enet_packet_create(payload.data(), payload.size(), ENET_PACKET_FLAG_RELIABLE);
+		if (packet == nullptr)
+		{
+			return;
+		}
+		if (enet_peer_send(peer, 0, packet) != 0)
+		{
+			enet_packet_destroy(packet);
+		}
+	}
+
+	void connectControls(Gateway &gateway)
+	{
+		for (size_t shard = 0; shard < gateway.controls.size(); shard++)
+		{
+			ControlLink &control = gateway.controls[shard];
+			if (control.peer != nullptr)
+			{
+				continue;
+			}
+			control.peer = enet_host_connect(gateway.upstreamHost, &gateway.shardAddresses[shard], GATEWAY_CHANNEL_COUNT, 0);
+		}
+		gateway.lastControlAttemptAt = Clock::now();
+	}
+
+	std::vector<uint8_t> encodeFrontierSync(const Gateway &gateway, const WorldFrontier &frontier)
+	{
+		ShardFrontierSyncMessage sync;
+		std::memcpy(sync.token, gateway.shardToken.data(), gateway.shardToken.size());
+		sync.frontier = frontier;
+		return encodeShardFrontierSync(sync);
+	}
+
+	void syncShardFrontiers(Gateway &gateway)
+	{
+		if (gateway.frontierSync.empty())
+		{
+			return;
+		}
+		for (size_t shard = 1; shard < gateway.controls.size(); shard++)
+		{
+			if (gateway.controls[shard].connected)
+			{
+				sendCopy(gateway.controls[shard].peer, gateway.frontierSync);
+			}
+		}
+	}
+
+	void relayFrontier(Gateway &gateway, const ENetPacket *packet)
+	{
+		std::vector<uint8_t> payload(packet->data, packet->data + packet->dataLength);
+		WorldFrontier frontier;
+		if (payload == gateway.primaryFrontier || !decodeWorldFrontier(payload.data(), payload.size(), frontier))
+		{
+			return;
+		}
+		gateway.primaryFrontier = std::move(payload);
+		gateway.frontierSync = encodeFrontierSync(gateway, frontier);
+		syncShardFrontiers(gateway);
+		gateway.stats.frontierRelays++;
+	}
+
+	void closeClient(Gateway &gateway, GatewayClient &client)
+	{
+		for (ENetPeer *&peer : client.upstream)
+		{
+			if (peer != nullptr)
+			{
+				peer->data = nullptr;
+				enet_peer_disconnect_later(peer, 0);
+				peer = nullptr;
+			}
+		}
+		for (QueuedPacket &queued : client.pendingUpstream)
+		{
+			releaseIfUnsent(queued.packet);
+		}
+		for (QueuedPacket &queued : client.heldDownstream)
+		{
+			releaseIfUnsent(queued.packet);
+		}
+		ENetPeer *downstream = client.downstream;
+		downstream->data = nullptr;
+		enet_peer_disconnect_later(downstream, 0);
+		gateway.clients.erase(downstream);
+	}
+
+	void sendUpstream(Gateway &gateway, GatewayClient &client, uint16_t shard, uint8_t channel, ENetPacket *packet)
+	{
+		ENetPeer *peer = client.upstream[shard];
+		if (peer == nullptr || enet_peer_send(peer, channel, packet) != 0)
+		{
+			return;
+		}
+		gateway.stats.packetsUpByShard[shard]++;
+	}
+
+	// Un client pressé peut enchaîner des actions sur deux shards qui ignorent chacun le
+	// cooldown posé par l'autre: la passerelle fait respecter le dernier connu.
+	bool blockActionAllowed(Gateway &gateway, GatewayClient &client, uint16_t owner)
+	{
+		if (owner == client.blockActionShard || client.blockActionReadyAtMs == 0)
+		{
+			return true;
+		}
+		uint64_t nowMs = static_cast<uint64_t>(
+			std::chrono::duration_cast<std::chrono::milliseconds>(
+				std::chrono::system_clock::now().time_since_epoch())
+				.count());
+		if (nowMs >= client.blockActionReadyAtMs)
+		{
+			return true;
+		}
+		gateway.stats.crossShardEditsRejected++;
+		if (!client.lastPlayerState.empty())
+		{
+			sendCopy(client.downstream, client.lastPlayerState);
+		}
+		return false;
+	}
+
+	void routeUpstream(Gateway &gateway, GatewayClient &client, uint8_t channel, ENetPacket *packet)
+	{
+		gateway.stats.packetsUp++;
+		gateway.stats.bytesUp += packet->dataLength;
+		PacketType type = static_cast<PacketType>(packet->data[0]);
+		switch (type)
+		{
+		case PacketType::Hello:
+		case PacketType::LoginRequest:
+		case PacketType::AccountDeleteRequest:
+		case PacketType::PlayerMoveUpdate:
+			if (type == PacketType::LoginRequest)
+			{
+				client.loginPending = true;
+				client.loginAccepted.assign(gateway.layout.count, false);
+			}
+			for (uint16_t shard = 0; shard < gateway.layout.count; shard++)
+			{
+				sendUpstream(gateway, client, shard, channel, packet);
+			}
+			break;
+		case PacketType::ChunkRequest:
+		{
+			ChunkRequestMessage request;
+			if (decodeChunkRequest(packet->data, packet->dataLength, request))
+			{
+				sendUpstream(gateway, client, gateway.layout.ownerOf(request.chunkX, request.chunkZ), channel, packet);
+			}
+			break;
+		}
+		case PacketType::ChunkDrop:
+		{
+			ChunkDropMessage drop;
+			if (decodeChunkDrop(packet->data, packet->dataLength, drop))
+			{
+				sendUpstream(gateway, client, gateway.layout.ownerOf(drop.chunkX, drop.chunkZ), channel, packet);
+			}
+			break;
+		}
+		case PacketType::BlockActionRequest:
+		{
+			BlockActionRequestMessage request;
+			if (!decodeBlockActionRequest(packet->data, packet->dataLength, request))
+			{
+				break;
+			}
+			uint16_t owner = gateway.layout.ownerOf(
+				floorDiv(request.worldX, CHUNK_SIZE_X),
+				floorDiv(request.worldZ, CHUNK_SIZE_Z));
+			if (blockActionAllowed(gateway, client, owner))
+			{
+				sendUpstream(gateway, client, owner, channel, packet);
+			}
+			break;
+		}
+		case PacketType::ShardFrontierSync:
+			// Réservé au lien de contrôle.
+			gateway.stats.packetsFiltered++;
+			break;
+		default:
+			sendUpstream(gateway, client, 0, channel, packet);
+			break;
+		}
+		releaseIfUnsent(packet);
+	}
+
+	void sendDownstream(Gateway &gateway, GatewayClient &client, uint8_t channel, ENetPacket *packet)
+	{
+		gateway.stats.packetsDown++;
+		gateway.stats.bytesDown += packet->dataLength;
+		if (enet_peer_send(client.downstream, channel, packet) != 0)
+		{
+			enet_packet_destroy(packet);
+		}
+	}
+
+	void finishLogin(Gateway &gateway, GatewayClient &client)
+	{
+		client.loginPending = false;
+		for (QueuedPacket &queued : client.heldDownstream)
+		{
+			sendDownstream(gateway, client, queued.channel, queued.packet);
+		}
+		client.heldDownstream.clear();
+	}
+
+	void handleShardLoginResponse(Gateway &gateway, GatewayClient &client, uint16_t shard, uint8_t channel, ENetPacket *packet)
+	{
+		LoginResponseMessage response;
+		if (!client.loginPending || !decodeLoginResponse(packet->data, packet->dataLength, response))
+		{
+			enet_packet_destroy(packet);
+			return;
+		}
+		if (response.status != LoginStatus::Accepted)
+		{
+			// Un refus d'un seul shard vaut refus: les autres ont peut-être déjà ouvert la session.
+			gateway.stats.loginsRejected++;
+			for (QueuedPacket &queued : client.heldDownstream)
+			{
+				enet_packet_destroy(queued.packet);
+			}
+			client.heldDownstream.clear();
+			client.loginPending = false;
+			sendDownstream(gateway, client, channel, packet);
+			closeClient(gateway, client);
+			return;
+		}
+
+		client.loginAccepted[shard] = true;
+		if (shard == 0)
+		{
+			client.heldDownstream.push_back(QueuedPacket{channel, packet});
+		}
+		else
+		{
+			enet_packet_destroy(packet);
+		}
+		if (std::all_of(client.loginAccepted.begin(), client.loginAccepted.end(), [](bool accepted)
+						{ return accepted; }))
+		{
+			finishLogin(gateway, client);
+		}
+	}
+
+	void handleShardPacket(Gateway &gateway, GatewayClient &client, uint16_t shard, uint8_t channel, ENetPacket *packet)
+	{
+		if (packet->dataLength == 0)
+		{
+			enet_packet_destroy(packet);
+			return;
+		}
+		PacketType type = static_cast<PacketType>(packet->data[0]);
+		if (type == PacketType::LoginResponse)
+		{
+			handleShardLoginResponse(gateway, client, shard, channel, packet);
+			return;
+		}
+		if (shard == 0 && type == PacketType::WorldFrontier)
+		{
+			relayFrontier(gateway, packet);
+		}
+		// Les autres shards ne parlent que de leurs régions; le reste vient du primaire.
+		if (shard != 0 && !isRegionPayload(type))
+		{
+			gateway.stats.packetsFiltered++;
+			enet_packet_destroy(packet);
+			return;
+		}
+		if (type == PacketType::PlayerState)
+		{
+			PlayerStateMessage state;
+			if (decodePlayerState(packet->data, packet->dataLength, state))
+			{
+				client.blockActionReadyAtMs = state.blockActionReadyAtMs;
+				client.blockActionShard = shard;
+				client.lastPlayerState.assign(packet->data, packet->data + packet->dataLength);
+			}
+		}
+		if (client.loginPending)
+		{
+			client.heldDownstream.push_back(QueuedPacket{channel, packet});
+			return;
+		}
+		sendDownstream(gateway, client, channel, packet);
+	}
+
+	void handleDownstreamEvent(Gateway &gateway, ENetEvent &event)
+	{
+		if (event.type == ENET_EVENT_TYPE_CONNECT)
+		{
+			enet_peer_throttle_configure(event.peer, 5000, 6, 3);
+			GatewayClient &client = gateway.clients[event.peer];
+			client.downstream = event.peer;
+			client.upstream.assign(gateway.layout.count, nullptr);
+			event.peer->data = &client;
+			for (uint16_t shard = 0; shard < gateway.layout.count; shard++)
+			{
+				ENetPeer *peer = enet_host_connect(gateway.upstreamHost, &gateway.shardAddresses[shard], GATEWAY_CHANNEL_COUNT, 0);
+				if (peer == nullptr)
+				{
+					std::cerr << "No upstream slot left for shard " << shard << std::endl;
+					closeClient(gateway, client);
+					return;
+				}
+				peer->data = &client;
+				client.upstream[shard] = peer;
+			}
+			gateway.stats.clientsAccepted++;
+			return;
+		}
+
+		GatewayClient *client = static_cast<GatewayClient *>(event.peer->data);
+		if (event.type == ENET_EVENT_TYPE_RECEIVE)
+		{
+			if (client == nullptr || event.packet->dataLength == 0)
+			{
+				enet_packet_destroy(event.packet);
+				return;
+			}
+			if (client->connectedUpstreamCount < gateway.layout.count)
+			{
+				client->pendingUpstream.push_back(QueuedPacket{event.channelID, event.packet});
+				return;
+			}
+			routeUpstream(gateway, *client, event.channelID, event.packet);
+			return;
+		}
+		if (event.type == ENET_EVENT_TYPE_DISCONNECT && client != nullptr)
+		{
+			closeClient(gateway, *client);
+		}
+	}
+
+	uint16_t upstreamShard(const GatewayClient &client, const ENetPeer *peer)
+	{
+		for (size_t shard = 0; shard < client.upstream.size(); shard++)
+		{
+			if (client.upstream[shard] == peer)
+			{
+				return static_cast<uint16_t>(shard);
+			}
+		}
+		return 0;
+	}
+
+	bool handleControlEvent(Gateway &gateway, ENetEvent &event)
+	{
+		for (size_t shard = 0; shard < gateway.controls.size(); shard++)
+		{
+			ControlLink &control = gateway.controls[shard];
+			if (control.peer != event.peer)
+			{
+				continue;
+			}
+			if (event.type == ENET_EVENT_TYPE_CONNECT)
+			{
+				control.connected = true;
+				std::cout << "Shard " << shard << " connected" << std::endl;
+				if (shard == 0)
+				{
+					// Le primaire répond à une synchro par sa propre frontière.
+					sendCopy(control.peer, encodeFrontierSync(gateway, WorldFrontier{}));
+				}
+				else if (!gateway.frontierSync.empty())
+				{
+					sendCopy(control.peer, gateway.frontierSync);
+				}
+			}
+			else if (event.type == ENET_EVENT_TYPE_RECEIVE)
+			{
+				if (shard == 0 && event.packet->dataLength > 0 &&
+					static_cast<PacketType>(event.packet->data[0]) == PacketType::WorldFrontier)
+				{
+					relayFrontier(gateway, event.packet);
+				}
+				enet_packet_destroy(event.packet);
+			}
+			else if (event.type == ENET_EVENT_TYPE_DISCONNECT)
+			{
+				if (control.connected)
+				{
+					std::cerr << "Lost control link to shard " << shard << std::endl;
+				}
+				control.peer = nullptr;
+				control.connected = false;
+			}
+			return true;
+		}
+		return false;
+	}
+
+	void handleUpstreamEvent(Gateway &gateway, ENetEvent &event)
+	{
+		if (handleControlEvent(gateway, event))
+		{
+			return;
+		}
+		GatewayClient *client = static_cast<GatewayClient *>(event.peer->data);
+		if (client == nullptr)
+		{
+			if (event.type == ENET_EVENT_TYPE_RECEIVE)
+			{
+				enet_packet_destroy(event.packet);
+			}
+			return;
+		}
+
+		uint16_t shard = upstreamShard(*client, event.peer);
+		if (event.type == ENET_EVENT_TYPE_CONNECT)
+		{
+			client->connectedUpstreamCount++;
+			if (client->connectedUpstreamCount < gateway.layout.count)
+			{
+				return;
+			}
+			std::deque<QueuedPacket> pending = std::move(client->pendingUpstream);
+			client->pendingUpstream.clear();
+			for (QueuedPacket &queued : pending)
+			{
+				routeUpstream(gateway, *client, queued.channel, queued.packet);
+			}
+			return;
+		}
+		if (event.type == ENET_EVENT_TYPE_RECEIVE)
+		{
+			handleShardPacket(gateway, *client, shard, event.channelID, event.packet);
+			return;
+		}
+		if (event.type == ENET_EVENT_TYPE_DISCONNECT)
+		{
+			// Un joueur sans un de ses shards verrait des trous dans le monde: on coupe tout.
+			client->upstream[shard] = nullptr;
+			event.peer->data = nullptr;
+			gateway.stats.clientsClosedByShard++;
+			closeClient(gateway, *client);
+		}
+	}
+
+	void printStats(const char *label, const Gateway &gateway)
+	{
+		const GatewayStats &stats = gateway.stats;
+		size_t connectedControls = static_cast<size_t>(std::count_if(
+			gateway.controls.begin(), gateway.controls.end(), [](const ControlLink &control)
+			{ return control.connected; }));
+		std::cout << label
+				  << " clients=" << gateway.clients.size()
+				  << " accepted=" << stats.clientsAccepted
+				  << " closed_by_shard=" << stats.clientsClosedByShard
+				  << " logins_rejected=" << stats.loginsRejected
+				  << " shards_up=" << connectedControls << "/" << gateway.layout.count
+				  << " packets_up=" << stats.packetsUp
+				  << " kib_up=" << stats.bytesUp / 1024.0
+				  << " packets_down=" << stats.packetsDown
+				  << " kib_down=" << stats.bytesDown / 1024.0
+				  << " filtered=" << stats.packetsFiltered
+				  << " cross_shard_edits_rejected=" << stats.crossShardEditsRejected
+				  << " frontier_relays=" << stats.frontierRelays
+				  << " up_by_shard=";
+		for (size_t shard = 0; shard < stats.packetsUpByShard.size(); shard++)
+		{
+			if (shard > 0)
+			{
+				std::cout << ',';
+			}
+			std::cout << stats.packetsUpByShard[shard];
+		}
+		std::cout << std::endl;
+	}
+}
+
+int main(int argc, char **argv)
+{
+	GatewayOptions options;
+	if (enet_initialize() != 0)
+	{
+		std::cerr << "ENet initialization failed" << std::endl;
+		return 1;
+	}
+	if (!parseOptions(argc, argv, options))
+	{
+		enet_deinitialize();
+		return 1;
+	}
+
+	Gateway gateway;
+	gateway.layout.count = static_cast<uint16_t>(options.shards.size());
+	gateway.shardAddresses = options.shards;
+	gateway.shardToken = options.shardToken;
+	gateway.controls.resize(options.shards.size());
+	gateway.stats.packetsUpByShard.assign(options.shards.size(), 0);
+	size_t maxClients = std::min(GATEWAY_MAX_CLIENTS,
+								 (GATEWAY_MAX_UPSTREAM_PEERS - options.shards.size()) / options.shards.size());
+
+	ENetAddress listenAddress{};
+	listenAddress.host = ENET_HOST_ANY;
+	listenAddress.port = options.listenPort;
+	gateway.downstreamHost = enet_host_create(&listenAddress, maxClients, GATEWAY_CHANNEL_COUNT, 0, 0);
+	gateway.upstreamHost = enet_host_create(nullptr, maxClients * options.shards.size() + options.shards.size(),
+											GATEWAY_CHANNEL_COUNT, 0, 0);
+	if (gateway.downstreamHost == nullptr || gateway.upstreamHost == nullptr)
+	{
+		std::cerr << "Failed to create ENet hosts (is port " << options.listenPort << " free?)" << std::endl;
+		if (gateway.downstreamHost != nullptr)
+		{
+			enet_host_destroy(gateway.downstreamHost);
+		}
+		if (gateway.upstreamHost != nullptr)
+		{
+			enet_host_destroy(gateway.upstreamHost);
+		}
+		enet_deinitialize();
+		return 1;
+	}
+	std::signal(SIGINT, handleStopSignal);
+	std::signal(SIGTERM, handleStopSignal);
+
+	std::cout << "VoxPlaceGateway listening on port " << options.listenPort
+			  << " for " << options.shards.size() << " shard(s), "
+			  << SHARD_REGION_SIZE_CHUNKS << "x" << SHARD_REGION_SIZE_CHUNKS << " chunk regions, up to "
+			  << maxClients << " client(s)" << std::endl;
+	connectControls(gateway);
+
+	Clock::time_point lastStatsAt = Clock::now();
+	while (!stopRequested.load())
+	{
+		ENetEvent event{};
+		uint32_t waitMs = MAX_SERVICE_WAIT_MS;
+		while (enet_host_service(gateway.downstreamHost, &event, waitMs) > 0)
+		{
+			waitMs = 0;
+			handleDownstreamEvent(gateway, event);
+		}
+		while (enet_host_service(gateway.upstreamHost, &event, 0) > 0)
+		{
+			handleUpstreamEvent(gateway, event);
+		}
+		// Les envois vers un hôte ne partent qu'au prochain service: on ne les laisse pas attendre 5 ms.
+		enet_host_flush(gateway.downstreamHost);
+		enet_host_flush(gateway.upstreamHost);
+
+		Clock::time_point now = Clock::now();
+		if (now - gateway.lastControlAttemptAt >= std::chrono::seconds(CONTROL_RECONNECT_SECONDS))
+		{
+			connectControls(gateway);
+			// Un shard n'avance que d'un anneau par synchro: le renvoi lui laisse rattraper son retard.
+			syncShardFrontiers(gateway);
+		}
+		if (now - lastStatsAt >= std::chrono::seconds(STATS_INTERVAL_SECONDS))
+		{
+			printStats("[gateway]", gateway);
+			lastStatsAt = now;
+		}
+	}
+
+	std::vector<ENetPeer *> downstreamPeers;
+	for (auto &entry : gateway.clients)
+	{
+		downstreamPeers.push_back(entry.first);
+	}
+	for (ENetPeer *peer : downstreamPeers)
+	{
+		closeClient(gateway, *static_cast<GatewayClient *>(peer->data));
+	}
+	for (ControlLink &control : gateway.controls)
+	{
+		if (control.peer != nullptr)
+		{
+			enet_peer_disconnect_now(control.peer, 0);
+		}
+	}
+	enet_host_flush(gateway.downstreamHost);
+	enet_host_flush(gateway.upstreamHost);
+	enet_host_destroy(gateway.downstreamHost);
+	enet_host_destroy(gateway.upstreamHost);
+	enet_deinitialize();
+	printStats("Gateway stopped:", gateway);
+	return 0;
+}
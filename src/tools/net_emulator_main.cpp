@@ -0,0 +1,452 @@
+#include <enet/enet.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+// Relais UDP entre des clients et un serveur, avec latence, gigue, pertes et débit limité
+// par sens: de quoi régler le streaming comme sur un vrai lien WAN, sans tc/netem.
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	constexpr size_t MAX_DATAGRAM_BYTES = 65536;
+	constexpr uint32_t MAX_WAIT_MS = 5;
+	constexpr int STATS_INTERVAL_SECONDS = 5;
+	constexpr int IDLE_RELAY_TIMEOUT_SECONDS = 60;
+
+	struct EmulatorOptions
+	{
+		uint16_t listenPort = 0;
+		std::string serverHost;
+		uint16_t serverPort = 0;
+		uint32_t delayMs = 50;
+		uint32_t jitterMs = 5;
+		double lossPercent = 0.0;
+		uint32_t bandwidthKbit = 0;
+		uint32_t queueMs = 200;
+	};
+
+	struct DelayedDatagram
+	{
+		Clock::time_point releaseAt;
+		ENetSocket socket = ENET_SOCKET_NULL;
+		ENetAddress destination{};
+		std::vector<uint8_t> bytes;
+	};
+
+	// Un sens du lien: file de sérialisation au débit choisi, puis délai de propagation.
+	struct EmulatedLink
+	{
+		const char *name = "";
+		std::deque<DelayedDatagram> inFlight;
+		Clock::time_point linkFreeAt = Clock::now();
+		Clock::time_point lastReleaseAt = Clock::now();
+		uint64_t forwardedPackets = 0;
+		uint64_t forwardedBytes = 0;
+		uint64_t lostPackets = 0;
+		uint64_t queueDroppedPackets = 0;
+	};
+
+	struct ClientRelay
+	{
+		ENetAddress client{};
+		ENetSocket upstream = ENET_SOCKET_NULL;
+		Clock::time_point lastActivity = Clock::now();
+	};
+
+	void printUsage(const char *programName)
+	{
+		std::cout << "Usage:" << std::endl;
+		std::cout
+			<< "  " << programName
+			<< " <listen_port> <server_host> <server_port> [delay_ms=50] [jitter_ms=5] [loss_percent=0]"
+			<< " [bandwidth_kbit=0] [queue_ms=200]"
+			<< std::endl;
+		std::cout << "Delay, jitter, loss and bandwidth apply to each direction; bandwidth 0 means unlimited." << std::endl;
+		std::cout << "Example (80 ms RTT, 4 Mbit/s, 1% loss):" << std::endl;
+		std::cout << "  " << programName << " 28714 127.0.0.1 28713 40 5 1 4000" << std::endl;
+	}
+
+	bool parseUnsigned(const char *raw, unsigned long maxValue, unsigned long &value)
+	{
+		if (raw == nullptr || raw[0] == '\0')
+		{
+			return false;
+		}
+		char *end = nullptr;
+		unsigned long parsed = std::strtoul(raw, &end, 10);
+		if (end == raw || end == nullptr || *end != '\0' || parsed > maxValue)
+		{
+			return false;
+		}
+		value = parsed;
+		return true;
+	}
+
+	bool parseOptions(int argc, char **argv, EmulatorOptions &options)
+	{
+		if (argc < 4 || argc > 9)
+		{
+			printUsage(argv[0]);
+			return false;
+		}
+
+		unsigned long value = 0;
+		if (!parseUnsigned(argv[1], 65535, value) || value == 0)
+		{
+			std::cerr << "Invalid listen port: " << argv[1] << std::endl;
+			return false;
+		}
+		options.listenPort = static_cast<uint16_t>(value);
+		options.serverHost = argv[2];
+		if (!parseUnsigned(argv[3], 65535, value) || value == 0)
+		{
+			std::cerr << "Invalid server port: " << argv[3] << std::endl;
+			return false;
+		}
+		options.serverPort = static_cast<uint16_t>(value);
+
+		uint32_t *optionalValues[] = {&options.delayMs, &options.jitterMs, nullptr, &options.bandwidthKbit, &options.queueMs};
+		for (int argIndex = 4; argIndex < argc; argIndex++)
+		{
+			if (argIndex == 6)
+			{
+				char *end = nullptr;
+				options.lossPercent = std::strtod(argv[argIndex], &end);
+				if (end == argv[argIndex] || *end != '\0' || options.lossPercent < 0.0 || options.lossPercent > 100.0)
+				{
+					std::cerr << "Invalid loss percent: " << argv[argIndex] << std::endl;
+					return false;
+				}
+				continue;
+			}
+			if (!parseUnsigned(argv[argIndex], 10000000, value))
+			{
+				std::cerr << "Invalid value: " << argv[argIndex] << std::endl;
+				return false;
+			}
+			*optionalValues[argIndex - 4] = static_cast<uint32_t>(value);
+		}
+		return true;
+	}
+
+	ENetSocket createDatagramSocket(uint16_t port)
+	{
+		ENetSocket socket = enet_socket_create(ENET_SOCKET_TYPE_DATAGRAM);
+		if (socket == ENET_SOCKET_NULL)
+		{
+			return socket;
+		}
+		ENetAddress address{};
+		address.host = ENET_HOST_ANY;
+		address.port = port;
+		if (enet_socket_bind(socket, &address) < 0)
+		{
+			enet_socket_destroy(socket);
+			return ENET_SOCKET_NULL;
+		}
+		enet_socket_set_option(socket, ENET_SOCKOPT_NONBLOCK, 1);
+		enet_socket_set_option(socket, ENET_SOCKOPT_RCVBUF, 4 * 1024 * 1024);
+		enet_socket_set_option(socket, ENET_SOCKOPT_SNDBUF, 4 * 1024 * 1024);
+		return socket;
+	}
+
+	class NetEmulator
+	{
+	public:
+		explicit NetEmulator(const EmulatorOptions &options)
+			: m_options(options),
+			  m_random(std::random_device{}())
+		{
+			m_uplink.name = "client->server";
+			m_downlink.name = "server->client";
+		}
+
+		~NetEmulator()
+		{
+			for (ClientRelay &relay : m_relays)
+			{
+				enet_socket_destroy(relay.upstream);
+			}
+			if (m_listenSocket != ENET_SOCKET_NULL)
+			{
+				enet_socket_destroy(m_listenSocket);
+			}
+		}
+
+		bool start()
+		{
+			if (enet_address_set_host(&m_serverAddress, m_options.serverHost.c_str()) != 0)
+			{
+				std::cerr << "Failed to resolve " << m_options.serverHost << std::endl;
+				return false;
+			}
+			m_serverAddress.port = m_options.serverPort;
+			m_listenSocket = createDatagramSocket(m_options.listenPort);
+			if (m_listenSocket == ENET_SOCKET_NULL)
+			{
+				std::cerr << "Failed to bind UDP port " << m_options.listenPort << std::endl;
+				return false;
+			}
+			return true;
+		}
+
+		void run()
+		{
+			std::vector<uint8_t> buffer(MAX_DATAGRAM_BYTES);
+			Clock::time_point nextStats = Clock::now() + std::chrono::seconds(STATS_INTERVAL_SECONDS);
+			while (true)
+			{
+				waitForTraffic();
+				receiveFromClients(buffer);
+				receiveFromServer(buffer);
+				releaseDue(m_uplink);
+				releaseDue(m_downlink);
+
+				Clock::time_point now = Clock::now();
+				if (now >= nextStats)
+				{
+					printStats();
+					dropIdleRelays(now);
+					nextStats = now + std::chrono::seconds(STATS_INTERVAL_SECONDS);
+				}
+			}
+		}
+
+	private:
+		EmulatorOptions m_options;
+		std::mt19937 m_random;
+		ENetAddress m_serverAddress{};
+		ENetSocket m_listenSocket = ENET_SOCKET_NULL;
+		std::vector<ClientRelay> m_relays;
+		EmulatedLink m_uplink;
+		EmulatedLink m_downlink;
+
+		void waitForTraffic()
+		{
+			uint32_t waitMs = MAX_WAIT_MS;
+			Clock::time_point now = Clock::now();
+			for (const EmulatedLink *link : {&m_uplink, &m_downlink})
+			{
+				if (link->inFlight.empty())
+				{
+					continue;
+				}
+				auto untilRelease = std::chrono::duration_cast<std::chrono::milliseconds>(
+					link->inFlight.front().releaseAt - now);
+				waitMs = std::min<uint32_t>(waitMs, static_cast<uint32_t>(std::max<int64_t>(untilRelease.count(), 0)));
+			}
+
+			ENetSocketSet readSet;
+			ENET_SOCKETSET_EMPTY(readSet);
+			ENET_SOCKETSET_ADD(readSet, m_listenSocket);
+			ENetSocket maxSocket = m_listenSocket;
+			for (const ClientRelay &relay : m_relays)
+			{
+				ENET_SOCKETSET_ADD(readSet, relay.upstream);
+				maxSocket = std::max(maxSocket, relay.upstream);
+			}
+			enet_socketset_select(maxSocket, &readSet, nullptr, waitMs);
+		}
+
+		ClientRelay *relayForClient(const ENetAddress &client)
+		{
+			for (ClientRelay &relay : m_relays)
+			{
+				if (relay.client.host == client.host && relay.client.port == client.port)
+				{
+					return &relay;
+				}
+			}
+
+			ClientRelay relay;
+			relay.client = client;
+			relay.upstream = createDatagramSocket(0);
+			if (relay.upstream == ENET_SOCKET_NULL)
+			{
+				return nullptr;
+			}
+			m_relays.push_back(relay);
+			std::cout << "New client relay (" << m_relays.size() << " active)" << std::endl;
+			return &m_relays.back();
+		}
+
+		void receiveFromClients(std::vector<uint8_t> &buffer)
+		{
+			while (true)
+			{
+				ENetAddress sender{};
+				ENetBuffer receiveBuffer{buffer.data(), buffer.size()};
+				int received = enet_socket_receive(m_listenSocket, &sender, &receiveBuffer, 1);
+				if (received <= 0)
+				{
+					return;
+				}
+				ClientRelay *relay = relayForClient(sender);
+				if (relay == nullptr)
+				{
+					continue;
+				}
+				relay->lastActivity = Clock::now();
+				enqueue(m_uplink, relay->upstream, m_serverAddress, buffer.data(), static_cast<size_t>(received));
+			}
+		}
+
+		void receiveFromServer(std::vector<uint8_t> &buffer)
+		{
+			for (ClientRelay &relay : m_relays)
+			{
+				while (true)
+				{
+					ENetAddress sender{};
+					ENetBuffer receiveBuffer{buffer.data(), buffer.size()};
+					int received = enet_socket_receive(relay.upstream, &sender, &receiveBuffer, 1);
+					if (received <= 0)
+					{
+						break;
+					}
+					relay.lastActivity = Clock::now();
+					enqueue(m_downlink, m_listenSocket, relay.client, buffer.data(), static_cast<size_t>(received));
+				}
+			}
+		}
+
+		void enqueue(EmulatedLink &link,
+					 ENetSocket socket,
+					 const ENetAddress &destination,
+					 const uint8_t *data,
+					 size_t size)
+		{
+			std::uniform_real_distribution<double> lossRoll(0.0, 100.0);
+			if (m_options.lossPercent > 0.0 && lossRoll(m_random) < m_options.lossPercent)
+			{
+				link.lostPackets++;
+				return;
+			}
+
+			Clock::time_point now = Clock::now();
+			Clock::time_point departAt = std::max(now, link.linkFreeAt);
+			if (m_options.bandwidthKbit > 0)
+			{
+				auto serializationMicros = static_cast<int64_t>(size) * 8 * 1000 / m_options.bandwidthKbit;
+				departAt += std::chrono::microseconds(serializationMicros);
+				// File du goulot pleine: perte en queue, comme un routeur.
+				if (departAt - now > std::chrono::milliseconds(m_options.queueMs))
+				{
+					link.queueDroppedPackets++;
+					return;
+				}
+			}
+			link.linkFreeAt = departAt;
+
+			std::uniform_int_distribution<uint32_t> jitter(0, m_options.jitterMs);
+			Clock::time_point releaseAt = departAt + std::chrono::milliseconds(m_options.delayMs + jitter(m_random));
+			// Pas de réordonnancement: la gigue ne fait que retarder la file.
+			releaseAt = std::max(releaseAt, link.lastReleaseAt);
+			link.lastReleaseAt = releaseAt;
+
+			DelayedDatagram datagram;
+			datagram.releaseAt = releaseAt;
+			datagram.socket = socket;
+			datagram.destination = destination;
+			datagram.bytes.assign(data, data + size);
+			link.inFlight.push_back(std::move(datagram));
+		}
+
+		void releaseDue(EmulatedLink &link)
+		{
+			Clock::time_point now = Clock::now();
+			while (!link.inFlight.empty() && link.inFlight.front().releaseAt <= now)
+			{
+				DelayedDatagram &datagram = link.inFlight.front();
+				ENetBuffer sendBuffer{datagram.bytes.data(), datagram.bytes.size()};
+				enet_socket_send(datagram.socket, &datagram.destination, &sendBuffer, 1);
+				link.forwardedPackets++;
+				link.forwardedBytes += datagram.bytes.size();
+				link.inFlight.pop_front();
+			}
+		}
+
+		void dropIdleRelays(Clock::time_point now)
+		{
+			auto idle = [&](const ClientRelay &relay)
+			{
+				return now - relay.lastActivity > std::chrono::seconds(IDLE_RELAY_TIMEOUT_SECONDS);
+			};
+			for (ClientRelay &relay : m_relays)
+			{
+				if (idle(relay))
+				{
+					enet_socket_destroy(relay.upstream);
+				}
+			}
+			m_relays.erase(std::remove_if(m_relays.begin(), m_relays.end(), idle), m_relays.end());
+		}
+
+		void printStats()
+		{
+			for (EmulatedLink *link : {&m_uplink, &m_downlink})
+			{
+				auto queueMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+					std::max(link->linkFreeAt, Clock::now()) - Clock::now());
+				std::cout << "[netemu] " << link->name
+						  << " packets=" << link->forwardedPackets
+						  << " kib=" << link->forwardedBytes / 1024
+						  << " kbit_s=" << link->forwardedBytes * 8 / 1000 / STATS_INTERVAL_SECONDS
+						  << " lost=" << link->lostPackets
+						  << " queue_dropped=" << link->queueDroppedPackets
+						  << " queue_ms_now=" << queueMs.count()
+						  << std::endl;
+				link->forwardedPackets = 0;
+				link->forwardedBytes = 0;
+				link->lostPackets = 0;
+				link->queueDroppedPackets = 0;
+			}
+		}
+	};
+}
+
+int main(int argc, char **argv)
+{
+	EmulatorOptions options;
+	if (!parseOptions(argc, argv, options))
+	{
+		return 1;
+	}
+	if (enet_initialize() != 0)
+	{
+		std::cerr << "Failed to initialize ENet" << std::endl;
+		return 1;
+	}
+
+	int exitCode = 0;
+	{
+		NetEmulator emulator(options);
+		if (emulator.start())
+		{
+			std::cout << "Relaying UDP :" << options.listenPort
+					  << " -> " << options.serverHost << ":" << options.serverPort
+					  << " delay_ms=" << options.delayMs
+					  << " jitter_ms=" << options.jitterMs
+					  << " loss_percent=" << options.lossPercent
+					  << " bandwidth_kbit=" << options.bandwidthKbit
+					  << " queue_ms=" << options.queueMs
+					  << std::endl;
+			emulator.run();
+		}
+		else
+		{
+			exitCode = 1;
+		}
+	}
+	enet_deinitialize();
+	return exitCode;
+}
@@ -0,0 +1,460 @@
+#include <PacketTrace.h>
+#include <WorldProtocol.h>
+
+#include <enet/enet.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+// Rejoue une trace VOXPLACE_PACKET_TRACE contre un serveur: une connexion ENet par session
+// enregistrée, chaque message renvoyé à son instant d'origine (divisé par speed). Les mots de
+// passe ne sont pas tracés: toutes les sessions se connectent avec celui du rejeu, donc contre
+// un serveur neuf qui crée les comptes à la première connexion.
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	// ENET_PROTOCOL_MAXIMUM_PEER_ID: au-delà, les connexions de la trace sont refusées.
+	constexpr size_t REPLAY_MAX_PEERS = 4095;
+	constexpr size_t REPLAY_CHANNEL_COUNT = 2;
+	constexpr uint32_t MAX_SERVICE_WAIT_MS = 5;
+	constexpr int STATS_INTERVAL_SECONDS = 5;
+	constexpr int DRAIN_TIMEOUT_SECONDS = 5;
+
+	std::atomic<bool> stopRequested = false;
+
+	void handleStopSignal(int)
+	{
+		stopRequested.store(true);
+	}
+
+	struct ReplayOptions
+	{
+		std::string tracePath;
+		std::string host;
+		uint16_t port = 0;
+		// 0 = sans attente, aussi vite que le serveur suit.
+		double speed = 1.0;
+		std::string password = "replay-pass";
+	};
+
+	struct ReplaySession
+	{
+		uint32_t sessionId = 0;
+		ENetPeer *peer = nullptr;
+		bool connected = false;
+		bool disconnectRequested = false;
+		// Messages arrivés avant que la connexion soit établie.
+		std::deque<PacketTraceRecord> pending;
+	};
+
+	struct ReplayStats
+	{
+		uint64_t records = 0;
+		uint64_t sessionsOpened = 0;
+		uint64_t sessionsRefused = 0;
+		uint64_t sessionsDroppedByServer = 0;
+		uint64_t packetsSent = 0;
+		uint64_t bytesSent = 0;
+		uint64_t packetsSkipped = 0;
+		uint64_t packetsReceived = 0;
+		uint64_t bytesReceived = 0;
+		uint64_t lagUs = 0;
+		uint64_t maxLagUs = 0;
+		std::array<uint64_t, 256> sentByType{};
+	};
+
+	void printUsage(const char *programName)
+	{
+		std::cout << "Usage:" << std::endl;
+		std::cout << "  " << programName << " <trace_file> <host> <port> [speed=1] [password=replay-pass]" << std::endl;
+		std::cout << "Record a trace with VOXPLACE_PACKET_TRACE=<file> on the server, then replay it against a"
+				  << " fresh server. speed 4 replays four times faster, 0 as fast as possible." << std::endl;
+		std::cout << "Example:" << std::endl;
+		std::cout << "  " << programName << " evening.vptrace 127.0.0.1 28713 4" << std::endl;
+	}
+
+	bool parseOptions(int argc, char **argv, ReplayOptions &options)
+	{
+		if (argc < 4 || argc > 6)
+		{
+			printUsage(argv[0]);
+			return false;
+		}
+
+		options.tracePath = argv[1];
+		options.host = argv[2];
+		char *end = nullptr;
+		unsigned long port = std::strtoul(argv[3], &end, 10);
+		if (end == argv[3] || *end != '\0' || port == 0 || port > 65535)
+		{
+			std::cerr << "Invalid port: " << argv[3] << std::endl;
+			return false;
+		}
+		options.port = static_cast<uint16_t>(port);
+
+		if (argc >= 5)
+		{
+			options.speed = std::strtod(argv[4], &end);
+			if (end == argv[4] || *end != '\0' || !(options.speed >= 0.0))
+			{
+				std::cerr << "Invalid speed: " << argv[4] << std::endl;
+				return false;
+			}
+		}
+		if (argc >= 6)
+		{
+			options.password = argv[5];
+		}
+		if (options.password.empty())
+		{
+			std::cerr << "Password must not be empty" << std::endl;
+			return false;
+		}
+		return true;
+	}
+
+	const char *clientPacketTypeName(uint8_t type)
+	{
+		switch (static_cast<PacketType>(type))
+		{
+		case PacketType::Hello:
+			return "hello";
+		case PacketType::ChunkRequest:
+			return "chunk_request";
+		case PacketType::ChunkDrop:
+			return "chunk_drop";
+		case PacketType::BlockActionRequest:
+			return "block_action";
+		case PacketType::LoginRequest:
+			return "login";
+		case PacketType::PlayerMoveUpdate:
+			return "move";
+		case PacketType::CommandRequest:
+			return "command";
+		case PacketType::ChatMessageRequest:
+			return "chat";
+		case PacketType::AccountDeleteRequest:
+			return "account_delete";
+		default:
+			return nullptr;
+		}
+	}
+
+	void sendRecord(ReplaySession &session, PacketTraceRecord &record, const ReplayOptions &options, ReplayStats &stats)
+	{
+		if (record.payload.empty())
+		{
+			stats.packetsSkipped++;
+			return;
+		}
+		(void)replacePacketTracePassword(record.payload, options.password);
+		uint8_t channel = static_cast<uint8_t>(std::min<size_t>(record.channel, REPLAY_CHANNEL_COUNT - 1));
+		ENetPacket *packet = enet_packet_create(record.payload.data(), record.payload.size(), ENET_PACKET_FLAG_RELIABLE);
+		if (packet == nullptr || enet_peer_send(session.peer, channel, packet) != 0)
+		{
+			if (packet != nullptr)
+			{
+				enet_packet_destroy(packet);
+			}
+			stats.packetsSkipped++;
+			return;
+		}
+		stats.packetsSent++;
+		stats.bytesSent += record.payload.size();
+		stats.sentByType[record.payload[0]]++;
+	}
+
+	void applyRecord(ENetHost *host,
+					 const ENetAddress &address,
+					 std::unordered_map<uint32_t, ReplaySession> &sessions,
+					 PacketTraceRecord &record,
+					 const ReplayOptions &options,
+					 ReplayStats &stats)
+	{
+		stats.records++;
+		if (record.kind == PacketTraceRecordKind::Connect)
+		{
+			ENetPeer *peer = enet_host_connect(host, &address, REPLAY_CHANNEL_COUNT, 0);
+			if (peer == nullptr)
+			{
+				stats.sessionsRefused++;
+				return;
+			}
+			ReplaySession &session = sessions[record.sessionId];
+			session.sessionId = record.sessionId;
+			session.peer = peer;
+			peer->data = &session;
+			stats.sessionsOpened++;
+			return;
+		}
+
+		auto sessionIt = sessions.find(record.sessionId);
+		if (sessionIt == sessions.end())
+		{
+			if (record.kind == PacketTraceRecordKind::Packet)
+			{
+				stats.packetsSkipped++;
+			}
+			return;
+		}
+		ReplaySession &session = sessionIt->second;
+		if (record.kind == PacketTraceRecordKind::Disconnect)
+		{
+			session.disconnectRequested = true;
+			if (session.connected)
+			{
+				enet_peer_disconnect_later(session.peer, 0);
+			}
+			return;
+		}
+		if (session.disconnectRequested)
+		{
+			stats.packetsSkipped++;
+			return;
+		}
+		if (!session.connected)
+		{
+			session.pending.push_back(std::move(record));
+			return;
+		}
+		sendRecord(session, record, options, stats);
+	}
+
+	void handleEvent(const ENetEvent &event,
+					 std::unordered_map<uint32_t, ReplaySession> &sessions,
+					 const ReplayOptions &options,
+					 ReplayStats &stats)
+	{
+		ReplaySession *session = static_cast<ReplaySession *>(event.peer->data);
+		if (event.type == ENET_EVENT_TYPE_RECEIVE)
+		{
+			stats.packetsReceived++;
+			stats.bytesReceived += event.packet->dataLength;
+			enet_packet_destroy(event.packet);
+			return;
+		}
+		if (session == nullptr)
+		{
+			return;
+		}
+		if (event.type == ENET_EVENT_TYPE_CONNECT)
+		{
+			session->connected = true;
+			for (PacketTraceRecord &record : session->pending)
+			{
+				sendRecord(*session, record, options, stats);
+			}
+			session->pending.clear();
+			if (session->disconnectRequested)
+			{
+				enet_peer_disconnect_later(session->peer, 0);
+			}
+			return;
+		}
+		if (event.type == ENET_EVENT_TYPE_DISCONNECT)
+		{
+			if (!session->disconnectRequested)
+			{
+				stats.sessionsDroppedByServer++;
+			}
+			event.peer->data = nullptr;
+			sessions.erase(session->sessionId);
+		}
+	}
+
+	void printStats(const char *label,
+					double traceSeconds,
+					double replaySeconds,
+					size_t openSessions,
+					const ReplayStats &stats)
+	{
+		std::cout << label
+				  << " trace_t=" << traceSeconds << "s"
+				  << " replay_t=" << replaySeconds << "s"
+				  << " lag_ms=" << stats.lagUs / 1000.0
+				  << " max_lag_ms=" << stats.maxLagUs / 1000.0
+				  << " sessions_open=" << openSessions
+				  << " sessions=" << stats.sessionsOpened
+				  << " refused=" << stats.sessionsRefused
+				  << " dropped_by_server=" << stats.sessionsDroppedByServer
+				  << " packets_sent=" << stats.packetsSent
+				  << " skipped=" << stats.packetsSkipped
+				  << " kib_sent=" << stats.bytesSent / 1024.0
+				  << " packets_received=" << stats.packetsReceived
+				  << " kib_received=" << stats.bytesReceived / 1024.0
+				  << std::endl;
+	}
+}
+
+int main(int argc, char **argv)
+{
+	ReplayOptions options;
+	if (!parseOptions(argc, argv, options))
+	{
+		return 1;
+	}
+
+	PacketTraceReader reader;
+	if (!reader.open(options.tracePath))
+	{
+		std::cerr << reader.lastError() << std::endl;
+		return 1;
+	}
+	if (enet_initialize() != 0)
+	{
+		std::cerr << "ENet initialization failed" << std::endl;
+		return 1;
+	}
+
+	ENetAddress address{};
+	address.port = options.port;
+	if (enet_address_set_host(&address, options.host.c_str()) != 0)
+	{
+		std::cerr << "Failed to resolve server host: " << options.host << std::endl;
+		enet_deinitialize();
+		return 1;
+	}
+	ENetHost *host = enet_host_create(nullptr, REPLAY_MAX_PEERS, REPLAY_CHANNEL_COUNT, 0, 0);
+	if (host == nullptr)
+	{
+		std::cerr << "Failed to create ENet client host" << std::endl;
+		enet_deinitialize();
+		return 1;
+	}
+	std::signal(SIGINT, handleStopSignal);
+	std::signal(SIGTERM, handleStopSignal);
+
+	std::cout << "Replaying " << options.tracePath
+			  << " (recorded at unix_ms=" << reader.startedAtMs() << ")"
+			  << " against " << options.host << ":" << options.port
+			  << " speed=" << options.speed
+			  << std::endl;
+
+	// unordered_map: les adresses des sessions restent stables, peer->data pointe dessus.
+	std::unordered_map<uint32_t, ReplaySession> sessions;
+	ReplayStats stats;
+	PacketTraceRecord record;
+	bool hasRecord = reader.next(record);
+	uint64_t lastTraceUs = 0;
+	Clock::time_point startedAt = Clock::now();
+	Clock::time_point lastStatsAt = startedAt;
+	Clock::time_point drainStartedAt{};
+	bool draining = false;
+
+	while (!stopRequested.load())
+	{
+		Clock::time_point now = Clock::now();
+		uint64_t replayUs = static_cast<uint64_t>(
+			std::chrono::duration_cast<std::chrono::microseconds>(now - startedAt).count());
+		uint64_t nextDueUs = replayUs;
+		while (hasRecord)
+		{
+			uint64_t dueUs = 0;
+			if (options.speed > 0.0)
+			{
+				dueUs = static_cast<uint64_t>(static_cast<double>(record.timeUs) / options.speed);
+			}
+			if (dueUs > replayUs)
+			{
+				nextDueUs = dueUs;
+				break;
+			}
+			if (options.speed > 0.0)
+			{
+				stats.lagUs = replayUs - dueUs;
+				stats.maxLagUs = std::max(stats.maxLagUs, stats.lagUs);
+			}
+			lastTraceUs = record.timeUs;
+			applyRecord(host, address, sessions, record, options, stats);
+			hasRecord = reader.next(record);
+		}
+
+		if (!hasRecord && !draining)
+		{
+			// Fin de trace: les sessions encore ouvertes (serveur arrêté pendant la capture) partent proprement.
+			for (auto &entry : sessions)
+			{
+				ReplaySession &session = entry.second;
+				if (!session.disconnectRequested)
+				{
+					session.disconnectRequested = true;
+					if (session.connected)
+					{
+						enet_peer_disconnect_later(session.peer, 0);
+					}
+				}
+			}
+			draining = true;
+			drainStartedAt = now;
+		}
+		if (draining &&
+			(sessions.empty() || now - drainStartedAt >= std::chrono::seconds(DRAIN_TIMEOUT_SECONDS)))
+		{
+			break;
+		}
+
+		uint32_t waitMs = MAX_SERVICE_WAIT_MS;
+		if (hasRecord)
+		{
+			waitMs = static_cast<uint32_t>(std::min<uint64_t>(MAX_SERVICE_WAIT_MS, (nextDueUs - replayUs) / 1000));
+		}
+		ENetEvent event{};
+		while (enet_host_service(host, &event, waitMs) > 0)
+		{
+			waitMs = 0;
+			handleEvent(event, sessions, options, stats);
+		}
+
+		if (now - lastStatsAt >= std::chrono::seconds(STATS_INTERVAL_SECONDS))
+		{
+			printStats("[replay]", lastTraceUs / 1e6, std::chrono::duration<double>(now - startedAt).count(),
+					   sessions.size(), stats);
+			lastStatsAt = now;
+		}
+	}
+
+	if (!reader.lastError().empty())
+	{
+		std::cerr << "Trace ended early: " << reader.lastError() << std::endl;
+	}
+	for (auto &entry : sessions)
+	{
+		enet_peer_reset(entry.second.peer);
+	}
+	enet_host_flush(host);
+	enet_host_destroy(host);
+	enet_deinitialize();
+
+	printStats("Replay complete:", lastTraceUs / 1e6, std::chrono::duration<double>(Clock::now() - startedAt).count(),
+			   0, stats);
+	std::cout << "Sent by type:";
+	for (size_t type = 0; type < stats.sentByType.size(); type++)
+	{
+		if (stats.sentByType[type] == 0)
+		{
+			continue;
+		}
+		const char *name = clientPacketTypeName(static_cast<uint8_t>(type));
+		if (name != nullptr)
+		{
+			std::cout << ' ' << name << '=' << stats.sentByType[type];
+		}
+		else
+		{
+			std::cout << " type" << type << '=' << stats.sentByType[type];
+		}
+	}
+	std::cout << std::endl;
+	return 0;
+}